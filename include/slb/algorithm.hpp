@@ -0,0 +1,87 @@
+/*
+  SLB.Algorithm
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_ALGORITHM_HPP
+#define SLB_ALGORITHM_HPP
+
+/*
+
+Header <algorithm> synopsis [algorithm.syn]
+
+namespace std {
+  // [alg.swap], swap
+  template<class ForwardIterator1, class ForwardIterator2>
+    ForwardIterator2 swap_ranges(ForwardIterator1 first1,
+                                 ForwardIterator1 last1,
+                                 ForwardIterator2 first2);
+  template<class ForwardIterator1, class ForwardIterator2>
+    void iter_swap(ForwardIterator1 a, ForwardIterator2 b);
+}
+
+*/
+
+#include <algorithm>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "detail/config.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+namespace slb {
+
+// [alg.swap], swap
+
+namespace detail {
+
+template <typename It1, typename It2>
+struct is_bitwise_swappable_range : std::false_type {};
+
+template <typename T>
+struct is_bitwise_swappable_range<T*, T*>
+    : slb::bool_constant<detail::is_bitwise_swappable<T>::value> {};
+
+template <typename T>
+T* swap_ranges(std::true_type, T* first1, T* last1, T* first2) {
+  std::size_t const n = static_cast<std::size_t>(last1 - first1);
+  detail::swap_bytes(first1, first2, n * sizeof(T));
+  return first2 + n;
+}
+
+template <typename ForwardIt1, typename ForwardIt2>
+ForwardIt2 swap_ranges(std::false_type,
+                       ForwardIt1 first1,
+                       ForwardIt1 last1,
+                       ForwardIt2 first2) {
+  using std::swap;
+  for (; first1 != last1; ++first1, (void)++first2) {
+    swap(*first1, *first2);
+  }
+  return first2;
+}
+
+} // namespace detail
+
+template <typename ForwardIt1, typename ForwardIt2>
+ForwardIt2 swap_ranges(ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2) {
+  return detail::swap_ranges(
+      detail::is_bitwise_swappable_range<ForwardIt1, ForwardIt2>{},
+      first1,
+      last1,
+      first2);
+}
+
+using std::iter_swap;
+
+} // namespace slb
+
+#endif // SLB_ALGORITHM_HPP
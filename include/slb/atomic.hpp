@@ -0,0 +1,545 @@
+/*
+  SLB.Atomic
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_ATOMIC_HPP
+#define SLB_ATOMIC_HPP
+
+/*
+
+Header <atomic> synopsis
+
+namespace std {
+  // [atomics.ref.generic], class template atomic_ref
+  template<class T> struct atomic_ref {
+    using value_type = T;
+    static constexpr size_t required_alignment = implementation-defined;
+
+    static constexpr bool is_always_lock_free = implementation-defined;
+    bool is_lock_free() const noexcept;
+
+    explicit atomic_ref(T&);
+    atomic_ref(const atomic_ref&) noexcept;
+    atomic_ref& operator=(const atomic_ref&) = delete;
+
+    void store(T, memory_order = memory_order::seq_cst) const noexcept;
+    T operator=(T) const noexcept;
+    T load(memory_order = memory_order::seq_cst) const noexcept;
+    operator T() const noexcept;
+
+    T exchange(T, memory_order = memory_order::seq_cst) const noexcept;
+    bool compare_exchange_weak(T&, T,
+                               memory_order, memory_order) const noexcept;
+    bool compare_exchange_strong(T&, T,
+                                 memory_order, memory_order) const noexcept;
+    bool compare_exchange_weak(T&, T,
+                               memory_order = memory_order::seq_cst)
+      const noexcept;
+    bool compare_exchange_strong(T&, T,
+                                 memory_order = memory_order::seq_cst)
+      const noexcept;
+
+    void wait(T, memory_order = memory_order::seq_cst) const noexcept;
+    void notify_one() const noexcept;
+    void notify_all() const noexcept;
+  };
+
+  // [atomics.ref.int], specializations for integral types
+  template<> struct atomic_ref<integral> {
+    using value_type = integral;
+    using difference_type = value_type;
+
+    // ... members of the primary template ...
+
+    integral fetch_add(integral,
+                       memory_order = memory_order::seq_cst) const noexcept;
+    integral fetch_sub(integral,
+                       memory_order = memory_order::seq_cst) const noexcept;
+    integral fetch_and(integral,
+                       memory_order = memory_order::seq_cst) const noexcept;
+    integral fetch_or(integral,
+                      memory_order = memory_order::seq_cst) const noexcept;
+    integral fetch_xor(integral,
+                       memory_order = memory_order::seq_cst) const noexcept;
+
+    integral operator++(int) const noexcept;
+    integral operator--(int) const noexcept;
+    integral operator++() const noexcept;
+    integral operator--() const noexcept;
+    integral operator+=(integral) const noexcept;
+    integral operator-=(integral) const noexcept;
+    integral operator&=(integral) const noexcept;
+    integral operator|=(integral) const noexcept;
+    integral operator^=(integral) const noexcept;
+  };
+
+  // [atomics.ref.float], specializations for floating-point types
+  template<> struct atomic_ref<floating-point> {
+    using value_type = floating-point;
+    using difference_type = value_type;
+
+    // ... members of the primary template ...
+
+    floating-point fetch_add(floating-point,
+                             memory_order = memory_order::seq_cst)
+      const noexcept;
+    floating-point fetch_sub(floating-point,
+                             memory_order = memory_order::seq_cst)
+      const noexcept;
+
+    floating-point operator+=(floating-point) const noexcept;
+    floating-point operator-=(floating-point) const noexcept;
+  };
+
+  // [atomics.ref.pointer], partial specialization for pointers
+  template<class T> struct atomic_ref<T*> {
+    using value_type = T*;
+    using difference_type = ptrdiff_t;
+
+    // ... members of the primary template ...
+
+    T* fetch_add(difference_type,
+                 memory_order = memory_order::seq_cst) const noexcept;
+    T* fetch_sub(difference_type,
+                 memory_order = memory_order::seq_cst) const noexcept;
+
+    T* operator++(int) const noexcept;
+    T* operator--(int) const noexcept;
+    T* operator++() const noexcept;
+    T* operator--() const noexcept;
+    T* operator+=(difference_type) const noexcept;
+    T* operator-=(difference_type) const noexcept;
+  };
+
+  // [atomics.nonmembers], non-member functions
+  template<class T>
+    void atomic_wait(const atomic<T>*,
+                     typename atomic<T>::value_type) noexcept;
+  template<class T>
+    void atomic_wait_explicit(const atomic<T>*,
+                              typename atomic<T>::value_type,
+                              memory_order) noexcept;
+  template<class T>
+    void atomic_notify_one(atomic<T>*) noexcept;
+  template<class T>
+    void atomic_notify_all(atomic<T>*) noexcept;
+}
+
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "detail/atomic_wait.hpp"
+#include "detail/config.hpp"
+#include "type_traits.hpp"
+
+// Without the standard one, `atomic_ref` is built on the `__atomic` builtins.
+#if __cpp_lib_atomic_ref || defined(__GNUC__) || defined(__clang__)
+#define SLB_HAS_ATOMIC_REF 1
+#else
+#define SLB_HAS_ATOMIC_REF 0 // not available
+#endif
+
+namespace slb {
+
+// [atomics.ref.generic], class template atomic_ref
+
+#if __cpp_lib_atomic_ref // C++20
+using std::atomic_ref;
+#elif SLB_HAS_ATOMIC_REF
+namespace detail {
+
+constexpr int atomic_order(std::memory_order order) noexcept {
+  return order == std::memory_order_relaxed
+             ? __ATOMIC_RELAXED
+             : order == std::memory_order_consume
+                   ? __ATOMIC_CONSUME
+                   : order == std::memory_order_acquire
+                         ? __ATOMIC_ACQUIRE
+                         : order == std::memory_order_release
+                               ? __ATOMIC_RELEASE
+                               : order == std::memory_order_acq_rel
+                                     ? __ATOMIC_ACQ_REL
+                                     : __ATOMIC_SEQ_CST;
+}
+
+// The failure order of a compare-exchange can not include a release.
+constexpr int atomic_failure_order(std::memory_order order) noexcept {
+  return order == std::memory_order_acq_rel
+             ? __ATOMIC_ACQUIRE
+             : order == std::memory_order_release
+                   ? __ATOMIC_RELAXED
+                   : detail::atomic_order(order);
+}
+
+// Objects whose size is a power of two up to 16 are aligned to their size, so
+// that they can be accessed with a single instruction where one exists.
+template <typename T>
+struct atomic_ref_alignment
+    : std::integral_constant<
+          std::size_t,
+          ((sizeof(T) & (sizeof(T) - 1)) == 0 && sizeof(T) <= 16 &&
+           sizeof(T) > alignof(T))
+              ? sizeof(T)
+              : alignof(T)> {};
+
+#if SLB_TRIVIALITY_TRAITS
+template <typename T>
+using is_atomic_ref_value = slb::is_trivially_copyable<T>;
+#else
+template <typename T>
+using is_atomic_ref_value = std::is_trivial<T>;
+#endif
+
+template <typename T>
+class atomic_ref_base {
+  static_assert(is_atomic_ref_value<T>::value,
+                "atomic_ref requires a trivially copyable type");
+
+public:
+  using value_type = T;
+
+  static constexpr std::size_t required_alignment =
+      atomic_ref_alignment<T>::value;
+
+  static constexpr bool is_always_lock_free =
+      __atomic_always_lock_free(sizeof(T), 0);
+
+  // The object is aligned to `required_alignment`, which a pointer value with
+  // just that alignment conveys, so that the query folds to a constant.
+  bool is_lock_free() const noexcept {
+    return __atomic_is_lock_free(
+        sizeof(T),
+        reinterpret_cast<void*>(std::uintptr_t(0) - required_alignment));
+  }
+
+  void store(T desired,
+             std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    __atomic_store(ptr_, std::addressof(desired), detail::atomic_order(order));
+  }
+
+  T load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+    alignas(T) unsigned char buffer[sizeof(T)];
+    T* const result = reinterpret_cast<T*>(buffer);
+    __atomic_load(ptr_, result, detail::atomic_order(order));
+    return *result;
+  }
+
+  operator T() const noexcept { return load(); }
+
+  T exchange(T desired,
+             std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    alignas(T) unsigned char buffer[sizeof(T)];
+    T* const result = reinterpret_cast<T*>(buffer);
+    __atomic_exchange(
+        ptr_, std::addressof(desired), result, detail::atomic_order(order));
+    return *result;
+  }
+
+  bool compare_exchange_weak(T& expected,
+                             T desired,
+                             std::memory_order success,
+                             std::memory_order failure) const noexcept {
+    return __atomic_compare_exchange(ptr_,
+                                     std::addressof(expected),
+                                     std::addressof(desired),
+                                     true,
+                                     detail::atomic_order(success),
+                                     detail::atomic_order(failure));
+  }
+
+  bool compare_exchange_strong(T& expected,
+                               T desired,
+                               std::memory_order success,
+                               std::memory_order failure) const noexcept {
+    return __atomic_compare_exchange(ptr_,
+                                     std::addressof(expected),
+                                     std::addressof(desired),
+                                     false,
+                                     detail::atomic_order(success),
+                                     detail::atomic_order(failure));
+  }
+
+  bool compare_exchange_weak(
+      T& expected,
+      T desired,
+      std::memory_order order = std::memory_order_seq_cst) const noexcept {
+    return __atomic_compare_exchange(ptr_,
+                                     std::addressof(expected),
+                                     std::addressof(desired),
+                                     true,
+                                     detail::atomic_order(order),
+                                     detail::atomic_failure_order(order));
+  }
+
+  bool compare_exchange_strong(
+      T& expected,
+      T desired,
+      std::memory_order order = std::memory_order_seq_cst) const noexcept {
+    return __atomic_compare_exchange(ptr_,
+                                     std::addressof(expected),
+                                     std::addressof(desired),
+                                     false,
+                                     detail::atomic_order(order),
+                                     detail::atomic_failure_order(order));
+  }
+
+  void wait(T old, std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    detail::atomic_wait_address(
+        ptr_, old, [this, order] { return this->load(order); });
+  }
+
+  void notify_one() const noexcept {
+    detail::atomic_notify_address<T>(ptr_, false);
+  }
+
+  void notify_all() const noexcept {
+    detail::atomic_notify_address<T>(ptr_, true);
+  }
+
+protected:
+  explicit atomic_ref_base(T& obj) noexcept : ptr_(std::addressof(obj)) {}
+
+  T* ptr_;
+};
+
+template <typename T>
+constexpr std::size_t atomic_ref_base<T>::required_alignment;
+
+template <typename T>
+constexpr bool atomic_ref_base<T>::is_always_lock_free;
+
+template <typename T>
+struct atomic_ref_kind
+    : std::integral_constant<
+          int,
+          (std::is_integral<T>::value && !std::is_same<T, bool>::value)
+              ? 1
+              : std::is_floating_point<T>::value ? 2 : 0> {};
+
+template <typename T, int Kind = atomic_ref_kind<T>::value>
+class atomic_ref_ops : public atomic_ref_base<T> {
+protected:
+  using atomic_ref_base<T>::atomic_ref_base;
+};
+
+// [atomics.ref.int], specializations for integral types
+template <typename T>
+class atomic_ref_ops<T, 1> : public atomic_ref_base<T> {
+public:
+  using difference_type = T;
+
+  T fetch_add(T operand,
+              std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    return __atomic_fetch_add(this->ptr_, operand, detail::atomic_order(order));
+  }
+
+  T fetch_sub(T operand,
+              std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    return __atomic_fetch_sub(this->ptr_, operand, detail::atomic_order(order));
+  }
+
+  T fetch_and(T operand,
+              std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    return __atomic_fetch_and(this->ptr_, operand, detail::atomic_order(order));
+  }
+
+  T fetch_or(T operand,
+             std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    return __atomic_fetch_or(this->ptr_, operand, detail::atomic_order(order));
+  }
+
+  T fetch_xor(T operand,
+              std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    return __atomic_fetch_xor(this->ptr_, operand, detail::atomic_order(order));
+  }
+
+  T operator++(int) const noexcept { return fetch_add(1); }
+
+  T operator--(int) const noexcept { return fetch_sub(1); }
+
+  T operator++() const noexcept {
+    return __atomic_add_fetch(this->ptr_, 1, __ATOMIC_SEQ_CST);
+  }
+
+  T operator--() const noexcept {
+    return __atomic_sub_fetch(this->ptr_, 1, __ATOMIC_SEQ_CST);
+  }
+
+  T operator+=(T operand) const noexcept {
+    return __atomic_add_fetch(this->ptr_, operand, __ATOMIC_SEQ_CST);
+  }
+
+  T operator-=(T operand) const noexcept {
+    return __atomic_sub_fetch(this->ptr_, operand, __ATOMIC_SEQ_CST);
+  }
+
+  T operator&=(T operand) const noexcept {
+    return __atomic_and_fetch(this->ptr_, operand, __ATOMIC_SEQ_CST);
+  }
+
+  T operator|=(T operand) const noexcept {
+    return __atomic_or_fetch(this->ptr_, operand, __ATOMIC_SEQ_CST);
+  }
+
+  T operator^=(T operand) const noexcept {
+    return __atomic_xor_fetch(this->ptr_, operand, __ATOMIC_SEQ_CST);
+  }
+
+protected:
+  using atomic_ref_base<T>::atomic_ref_base;
+};
+
+// [atomics.ref.float], specializations for floating-point types
+template <typename T>
+class atomic_ref_ops<T, 2> : public atomic_ref_base<T> {
+public:
+  using difference_type = T;
+
+  T fetch_add(T operand,
+              std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    T expected = this->load(std::memory_order_relaxed);
+    while (!this->compare_exchange_weak(expected, expected + operand, order)) {
+    }
+    return expected;
+  }
+
+  T fetch_sub(T operand,
+              std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    T expected = this->load(std::memory_order_relaxed);
+    while (!this->compare_exchange_weak(expected, expected - operand, order)) {
+    }
+    return expected;
+  }
+
+  T operator+=(T operand) const noexcept {
+    return fetch_add(operand) + operand;
+  }
+
+  T operator-=(T operand) const noexcept {
+    return fetch_sub(operand) - operand;
+  }
+
+protected:
+  using atomic_ref_base<T>::atomic_ref_base;
+};
+
+// [atomics.ref.pointer], partial specialization for pointers
+template <typename T>
+class atomic_ref_ops<T*, 0> : public atomic_ref_base<T*> {
+public:
+  using difference_type = std::ptrdiff_t;
+
+  // The builtins operate on pointers as on `uintptr_t`, in bytes.
+  T* fetch_add(std::ptrdiff_t operand,
+               std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    return __atomic_fetch_add(this->ptr_,
+                              operand * static_cast<std::ptrdiff_t>(sizeof(T)),
+                              detail::atomic_order(order));
+  }
+
+  T* fetch_sub(std::ptrdiff_t operand,
+               std::memory_order order = std::memory_order_seq_cst) const
+      noexcept {
+    return __atomic_fetch_sub(this->ptr_,
+                              operand * static_cast<std::ptrdiff_t>(sizeof(T)),
+                              detail::atomic_order(order));
+  }
+
+  T* operator++(int) const noexcept { return fetch_add(1); }
+
+  T* operator--(int) const noexcept { return fetch_sub(1); }
+
+  T* operator++() const noexcept { return fetch_add(1) + 1; }
+
+  T* operator--() const noexcept { return fetch_sub(1) - 1; }
+
+  T* operator+=(std::ptrdiff_t operand) const noexcept {
+    return fetch_add(operand) + operand;
+  }
+
+  T* operator-=(std::ptrdiff_t operand) const noexcept {
+    return fetch_sub(operand) - operand;
+  }
+
+protected:
+  using atomic_ref_base<T*>::atomic_ref_base;
+};
+
+} // namespace detail
+
+template <typename T>
+class atomic_ref : public detail::atomic_ref_ops<T> {
+public:
+  explicit atomic_ref(T& obj) noexcept : detail::atomic_ref_ops<T>(obj) {}
+
+  atomic_ref(atomic_ref const&) noexcept = default;
+
+  atomic_ref& operator=(atomic_ref const&) = delete;
+
+  T operator=(T desired) const noexcept {
+    this->store(desired);
+    return desired;
+  }
+};
+#endif
+
+// [atomics.nonmembers], non-member functions
+
+#if __cpp_lib_atomic_wait // C++20
+using std::atomic_wait;
+using std::atomic_wait_explicit;
+using std::atomic_notify_one;
+using std::atomic_notify_all;
+#else
+// A thread blocks on a 32-bit object directly, with a `futex` on Linux; any
+// other object is waited on through a table of counters keyed by address.
+template <typename T>
+void atomic_wait_explicit(std::atomic<T> const* object,
+                          typename slb::type_identity<T>::type old,
+                          std::memory_order order) noexcept {
+  detail::atomic_wait_address(
+      object, old, [object, order] { return object->load(order); });
+}
+
+template <typename T>
+void atomic_wait(std::atomic<T> const* object,
+                 typename slb::type_identity<T>::type old) noexcept {
+  slb::atomic_wait_explicit(object, old, std::memory_order_seq_cst);
+}
+
+template <typename T>
+void atomic_notify_one(std::atomic<T>* object) noexcept {
+  detail::atomic_notify_address<T>(object, false);
+}
+
+template <typename T>
+void atomic_notify_all(std::atomic<T>* object) noexcept {
+  detail::atomic_notify_address<T>(object, true);
+}
+#endif
+
+} // namespace slb
+
+#endif // SLB_ATOMIC_HPP
@@ -0,0 +1,158 @@
+/*
+  SLB.Barrier
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_BARRIER_HPP
+#define SLB_BARRIER_HPP
+
+/*
+
+Header <barrier> synopsis
+
+namespace std {
+  // [thread.barrier.class], class template barrier
+  template<class CompletionFunction = see below>
+    class barrier {
+    public:
+      using arrival_token = see below;
+
+      static constexpr ptrdiff_t max() noexcept;
+
+      constexpr explicit barrier(ptrdiff_t expected,
+                                 CompletionFunction f = CompletionFunction());
+      ~barrier();
+
+      barrier(const barrier&) = delete;
+      barrier& operator=(const barrier&) = delete;
+
+      arrival_token arrive(ptrdiff_t update = 1);
+      void wait(arrival_token&& arrival) const;
+
+      void arrive_and_wait();
+      void arrive_and_drop();
+    };
+}
+
+*/
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/atomic_wait.hpp"
+#include "detail/config.hpp"
+#include "detail/invoke.hpp"
+
+#if __has_include(<barrier>)
+#include <barrier>
+#endif
+
+namespace slb {
+
+// [thread.barrier.class], class template barrier
+
+#if __cpp_lib_barrier // C++20
+using std::barrier;
+#else
+namespace detail {
+
+struct barrier_completion {
+  void operator()() const noexcept {}
+};
+
+} // namespace detail
+
+// The phase and the number of arrivals it still expects share one atomic
+// word, so that each arrival learns the phase it counts toward from the same
+// read-modify-write that counts it. Waiters block on a separate 32-bit copy
+// of the phase, which the last arrival updates after the completion step.
+template <typename CompletionFunction = detail::barrier_completion>
+class barrier {
+public:
+  class arrival_token {
+  public:
+    arrival_token(arrival_token&&) = default;
+    arrival_token& operator=(arrival_token&&) = default;
+
+  private:
+    friend class barrier;
+    explicit arrival_token(std::uint32_t phase) noexcept : phase_(phase) {}
+
+    std::uint32_t phase_;
+  };
+
+  static constexpr std::ptrdiff_t max() noexcept { return INT_MAX; }
+
+  explicit barrier(std::ptrdiff_t expected,
+                   CompletionFunction f = CompletionFunction())
+      : state_(static_cast<std::uint32_t>(expected)),
+        expected_(static_cast<std::uint32_t>(expected)),
+        phase_(0),
+        completion_(SLB_MOVE(f)) {}
+
+  barrier(barrier const&) = delete;
+  barrier& operator=(barrier const&) = delete;
+
+  arrival_token arrive(std::ptrdiff_t update = 1) {
+    std::uint64_t const old = state_.fetch_sub(
+        static_cast<std::uint64_t>(update), std::memory_order_acq_rel);
+    std::uint32_t const phase = static_cast<std::uint32_t>(old >> 32);
+    if (static_cast<std::uint32_t>(old) == static_cast<std::uint32_t>(update)) {
+      detail::invoke(completion_);
+      std::uint32_t const next = phase + 1;
+      state_.store((static_cast<std::uint64_t>(next) << 32) |
+                       expected_.load(std::memory_order_relaxed),
+                   std::memory_order_release);
+      phase_.store(next, std::memory_order_release);
+      detail::platform_notify(phase_, INT_MAX);
+    }
+    return arrival_token(phase);
+  }
+
+  void wait(arrival_token&& arrival) const {
+    std::uint32_t const phase = arrival.phase_;
+    if (detail::atomic_spin([this, phase] {
+          return completed(phase, phase_.load(std::memory_order_acquire));
+        })) {
+      return;
+    }
+    for (;;) {
+      std::uint32_t const current = phase_.load(std::memory_order_acquire);
+      if (completed(phase, current)) {
+        return;
+      }
+      detail::platform_wait(phase_, current);
+    }
+  }
+
+  void arrive_and_wait() { wait(arrive()); }
+
+  void arrive_and_drop() {
+    expected_.fetch_sub(1, std::memory_order_relaxed);
+    (void)arrive();
+  }
+
+private:
+  // Whether `phase` completed, given the latest `current` phase. The copy in
+  // `phase_` may still trail the phase an arrival saw by one.
+  static bool completed(std::uint32_t phase, std::uint32_t current) noexcept {
+    return current - phase - 1 < (std::uint32_t(1) << 31);
+  }
+
+  std::atomic<std::uint64_t> state_;
+  std::atomic<std::uint32_t> expected_;
+  std::atomic<std::uint32_t> phase_;
+  CompletionFunction completion_;
+};
+#endif
+
+} // namespace slb
+
+#endif // SLB_BARRIER_HPP
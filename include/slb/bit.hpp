@@ -0,0 +1,393 @@
+/*
+  SLB.Bit
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_BIT_HPP
+#define SLB_BIT_HPP
+
+/*
+
+Header <bit> synopsis [bit.syn]
+
+namespace std {
+  // [bit.cast], bit_cast
+  template<class To, class From>
+    constexpr To bit_cast(const From& from) noexcept;
+
+  // [bit.byteswap], byteswap
+  template<class T>
+    constexpr T byteswap(T value) noexcept;
+
+  // [bit.pow.two], integral powers of 2
+  template<class T>
+    constexpr bool has_single_bit(T x) noexcept;
+  template<class T>
+    constexpr T bit_ceil(T x);
+  template<class T>
+    constexpr T bit_floor(T x) noexcept;
+  template<class T>
+    constexpr int bit_width(T x) noexcept;
+
+  // [bit.rotate], rotating
+  template<class T>
+    [[nodiscard]] constexpr T rotl(T x, int s) noexcept;
+  template<class T>
+    [[nodiscard]] constexpr T rotr(T x, int s) noexcept;
+
+  // [bit.count], counting
+  template<class T>
+    constexpr int countl_zero(T x) noexcept;
+  template<class T>
+    constexpr int countl_one(T x) noexcept;
+  template<class T>
+    constexpr int countr_zero(T x) noexcept;
+  template<class T>
+    constexpr int countr_one(T x) noexcept;
+  template<class T>
+    constexpr int popcount(T x) noexcept;
+
+  // [bit.endian], endian
+  enum class endian {
+    little = see below,
+    big    = see below,
+    native = see below
+  };
+}
+
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "detail/config.hpp"
+#include "type_traits.hpp"
+
+#if __has_include(<bit>)
+#include <bit>
+#endif
+
+namespace slb {
+
+namespace detail {
+
+// The functions in `<bit>` other than `bit_cast` and `byteswap` only
+// participate in overload resolution for unsigned integer types.
+template <typename T>
+struct is_bit_uint
+    : slb::bool_constant<std::is_same<T, unsigned char>::value ||
+                         std::is_same<T, unsigned short>::value ||
+                         std::is_same<T, unsigned int>::value ||
+                         std::is_same<T, unsigned long>::value ||
+                         std::is_same<T, unsigned long long>::value> {};
+
+} // namespace detail
+
+// [bit.cast], bit_cast
+
+#if __cpp_lib_bit_cast // C++20
+using std::bit_cast;
+#else
+namespace detail {
+#if SLB_TRIVIALITY_TRAITS
+template <typename T>
+using is_bit_castable = slb::is_trivially_copyable<T>;
+#else
+template <typename T>
+using is_bit_castable = std::is_trivial<T>;
+#endif
+} // namespace detail
+
+// Without `__builtin_bit_cast`, `bit_cast` copies the object representation
+// into suitably aligned storage, which implicitly creates the `To` object
+// (P0593), and can not be used in constant expressions.
+#if __has_builtin(__builtin_bit_cast)
+template <typename To, typename From>
+constexpr typename std::enable_if<sizeof(To) == sizeof(From) &&
+                                      detail::is_bit_castable<To>::value &&
+                                      detail::is_bit_castable<From>::value,
+                                  To>::type
+bit_cast(From const& from) noexcept {
+  return __builtin_bit_cast(To, from);
+}
+#else
+template <typename To, typename From>
+typename std::enable_if<sizeof(To) == sizeof(From) &&
+                            detail::is_bit_castable<To>::value &&
+                            detail::is_bit_castable<From>::value,
+                        To>::type
+bit_cast(From const& from) noexcept {
+  typename std::aligned_storage<sizeof(To), alignof(To)>::type storage;
+  std::memcpy(&storage, &from, sizeof(To));
+  return *reinterpret_cast<To*>(&storage);
+}
+#endif
+#endif
+
+// [bit.byteswap], byteswap
+
+#if __cpp_lib_byteswap // C++23
+using std::byteswap;
+#else
+namespace detail {
+
+template <std::size_t Size>
+struct byteswap_uint;
+
+template <>
+struct byteswap_uint<1> {
+  using type = std::uint8_t;
+};
+
+template <>
+struct byteswap_uint<2> {
+  using type = std::uint16_t;
+};
+
+template <>
+struct byteswap_uint<4> {
+  using type = std::uint32_t;
+};
+
+template <>
+struct byteswap_uint<8> {
+  using type = std::uint64_t;
+};
+
+constexpr std::uint8_t byteswap(std::uint8_t x) noexcept { return x; }
+
+#if __has_builtin(__builtin_bswap16) || defined(__GNUC__)
+constexpr std::uint16_t byteswap(std::uint16_t x) noexcept {
+  return __builtin_bswap16(x);
+}
+
+constexpr std::uint32_t byteswap(std::uint32_t x) noexcept {
+  return __builtin_bswap32(x);
+}
+
+constexpr std::uint64_t byteswap(std::uint64_t x) noexcept {
+  return __builtin_bswap64(x);
+}
+#else
+constexpr std::uint16_t byteswap(std::uint16_t x) noexcept {
+  return static_cast<std::uint16_t>((x << 8) | (x >> 8));
+}
+
+constexpr std::uint32_t byteswap(std::uint32_t x) noexcept {
+  return (x << 24) | ((x << 8) & 0x00FF0000u) | ((x >> 8) & 0x0000FF00u) |
+         (x >> 24);
+}
+
+constexpr std::uint64_t byteswap(std::uint64_t x) noexcept {
+  return (static_cast<std::uint64_t>(
+              detail::byteswap(static_cast<std::uint32_t>(x)))
+          << 32) |
+         detail::byteswap(static_cast<std::uint32_t>(x >> 32));
+}
+#endif
+
+} // namespace detail
+
+template <typename T>
+constexpr typename std::enable_if<std::is_integral<T>::value, T>::type
+byteswap(T value) noexcept {
+  return static_cast<T>(detail::byteswap(
+      static_cast<typename detail::byteswap_uint<sizeof(T)>::type>(value)));
+}
+#endif
+
+// [bit.count], counting
+
+#if __cpp_lib_bitops // C++20
+using std::countl_zero;
+using std::countl_one;
+using std::countr_zero;
+using std::countr_one;
+using std::popcount;
+#else
+namespace detail {
+
+// Unsigned integer types narrower than `unsigned int` are widened to it.
+template <typename T>
+using bit_uint =
+    typename std::conditional<(std::numeric_limits<T>::digits <=
+                               std::numeric_limits<unsigned int>::digits),
+                              unsigned int,
+                              T>::type;
+
+#if __has_builtin(__builtin_popcount) || defined(__GNUC__)
+constexpr int popcount(unsigned int x) noexcept {
+  return __builtin_popcount(x);
+}
+
+constexpr int popcount(unsigned long x) noexcept {
+  return __builtin_popcountl(x);
+}
+
+constexpr int popcount(unsigned long long x) noexcept {
+  return __builtin_popcountll(x);
+}
+
+// `clz` and `ctz` require a non-zero argument.
+constexpr int clz(unsigned int x) noexcept { return __builtin_clz(x); }
+constexpr int clz(unsigned long x) noexcept { return __builtin_clzl(x); }
+constexpr int clz(unsigned long long x) noexcept { return __builtin_clzll(x); }
+
+constexpr int ctz(unsigned int x) noexcept { return __builtin_ctz(x); }
+constexpr int ctz(unsigned long x) noexcept { return __builtin_ctzl(x); }
+constexpr int ctz(unsigned long long x) noexcept { return __builtin_ctzll(x); }
+#else
+// The intrinsics MSVC provides (`__popcnt`, `_BitScanReverse`, ...) are not
+// usable in constant expressions, so we fall back to bit manipulation that
+// optimizers recognize.
+constexpr int popcount_fold(unsigned long long x) noexcept {
+  return static_cast<int>(((x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full) *
+                              0x0101010101010101ull >>
+                          56);
+}
+
+constexpr int popcount_pairs(unsigned long long x) noexcept {
+  return detail::popcount_fold((x & 0x3333333333333333ull) +
+                               ((x >> 2) & 0x3333333333333333ull));
+}
+
+constexpr int popcount(unsigned long long x) noexcept {
+  return detail::popcount_pairs(x - ((x >> 1) & 0x5555555555555555ull));
+}
+
+// Sets every bit below the most significant set bit.
+template <typename T>
+constexpr T smear(T x, int shift = 1) noexcept {
+  return shift >= std::numeric_limits<T>::digits
+             ? x
+             : detail::smear(static_cast<T>(x | (x >> shift)), shift * 2);
+}
+
+template <typename T>
+constexpr int clz(T x) noexcept {
+  return std::numeric_limits<T>::digits - detail::popcount(detail::smear(x));
+}
+
+template <typename T>
+constexpr int ctz(T x) noexcept {
+  return detail::popcount(static_cast<T>(~x & (x - 1)));
+}
+#endif
+
+} // namespace detail
+
+template <typename T>
+constexpr typename std::enable_if<detail::is_bit_uint<T>::value, int>::type
+countl_zero(T x) noexcept {
+  return x == 0 ? std::numeric_limits<T>::digits
+                : detail::clz(static_cast<detail::bit_uint<T>>(x)) -
+                      (std::numeric_limits<detail::bit_uint<T>>::digits -
+                       std::numeric_limits<T>::digits);
+}
+
+template <typename T>
+constexpr typename std::enable_if<detail::is_bit_uint<T>::value, int>::type
+countl_one(T x) noexcept {
+  return slb::countl_zero(static_cast<T>(~x));
+}
+
+template <typename T>
+constexpr typename std::enable_if<detail::is_bit_uint<T>::value, int>::type
+countr_zero(T x) noexcept {
+  return x == 0 ? std::numeric_limits<T>::digits
+                : detail::ctz(static_cast<detail::bit_uint<T>>(x));
+}
+
+template <typename T>
+constexpr typename std::enable_if<detail::is_bit_uint<T>::value, int>::type
+countr_one(T x) noexcept {
+  return slb::countr_zero(static_cast<T>(~x));
+}
+
+template <typename T>
+constexpr typename std::enable_if<detail::is_bit_uint<T>::value, int>::type
+popcount(T x) noexcept {
+  return detail::popcount(static_cast<detail::bit_uint<T>>(x));
+}
+#endif
+
+// [bit.rotate], rotating
+
+#if __cpp_lib_bitops // C++20
+using std::rotl;
+using std::rotr;
+#else
+namespace detail {
+
+// `r` is in `(-digits, digits)`.
+template <typename T>
+constexpr T rotate(T x, int r) noexcept {
+  return r == 0 ? x
+                : r > 0 ? static_cast<T>(
+                              (x << r) |
+                              (x >> (std::numeric_limits<T>::digits - r)))
+                        : static_cast<T>(
+                              (x >> -r) |
+                              (x << (std::numeric_limits<T>::digits + r)));
+}
+
+} // namespace detail
+
+template <typename T>
+constexpr typename std::enable_if<detail::is_bit_uint<T>::value, T>::type
+rotl(T x, int s) noexcept {
+  return detail::rotate(x, s % std::numeric_limits<T>::digits);
+}
+
+template <typename T>
+constexpr typename std::enable_if<detail::is_bit_uint<T>::value, T>::type
+rotr(T x, int s) noexcept {
+  return detail::rotate(x, -(s % std::numeric_limits<T>::digits));
+}
+#endif
+
+// [bit.pow.two], integral powers of 2
+
+#if __cpp_lib_int_pow2 >= 202002L // C++20
+using std::has_single_bit;
+using std::bit_ceil;
+using std::bit_floor;
+using std::bit_width;
+#else
+template <typename T>
+constexpr typename std::enable_if<detail::is_bit_uint<T>::value, bool>::type
+has_single_bit(T x) noexcept {
+  return x != 0 && (x & (x - 1)) == 0;
+}
+
+template <typename T>
+constexpr typename std::enable_if<detail::is_bit_uint<T>::value, int>::type
+bit_width(T x) noexcept {
+  return std::numeric_limits<T>::digits - slb::countl_zero(x);
+}
+
+template <typename T>
+constexpr typename std::enable_if<detail::is_bit_uint<T>::value, T>::type
+bit_floor(T x) noexcept {
+  return x == 0 ? T(0) : static_cast<T>(T(1) << (slb::bit_width(x) - 1));
+}
+
+template <typename T>
+constexpr typename std::enable_if<detail::is_bit_uint<T>::value, T>::type
+bit_ceil(T x) {
+  return x <= 1u ? T(1)
+                 : static_cast<T>(T(1)
+                                  << slb::bit_width(static_cast<T>(x - 1)));
+}
+#endif
+
+} // namespace slb
+
+#endif // SLB_BIT_HPP
@@ -0,0 +1,109 @@
+/*
+  SLB.CachePadded
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_CACHE_PADDED_HPP
+#define SLB_CACHE_PADDED_HPP
+
+/*
+
+Header <slb/cache_padded.hpp> synopsis
+
+namespace slb {
+  template<class T>
+    class cache_padded {
+    public:
+      using value_type = T;
+      static constexpr size_t alignment = see below;
+
+      constexpr cache_padded();
+      constexpr cache_padded(const T& value);
+      constexpr cache_padded(T&& value);
+      template<class... Args>
+        constexpr explicit cache_padded(in_place_t, Args&&... args);
+
+      constexpr T& get() noexcept;
+      constexpr const T& get() const noexcept;
+      constexpr T& operator*() noexcept;
+      constexpr const T& operator*() const noexcept;
+      constexpr T* operator->() noexcept;
+      constexpr const T* operator->() const noexcept;
+    };
+}
+
+*/
+
+#include <cstddef>
+#include <type_traits>
+
+#include "detail/config.hpp"
+#include "utility.hpp"
+
+namespace slb {
+
+namespace detail {
+
+// The padding is not taken from `hardware_destructive_interference_size`,
+// which may vary with the tuning flags and would change the layout. Adjacent
+// cache lines are fetched in pairs on x86-64, and the lines themselves are
+// 128 bytes on some AArch64 and POWER processors.
+enum : std::size_t {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) ||          \
+    defined(_M_ARM64) || defined(__powerpc64__)
+  cache_padded_alignment = 128
+#else
+  cache_padded_alignment = 64
+#endif
+};
+
+} // namespace detail
+
+// Holds a `T` on cache lines of its own, so that writes to neighboring
+// objects, for instance to the other elements of an array of `cache_padded`,
+// do not contend with accesses to it (false sharing). Dynamic allocation
+// honors the alignment only as of C++17.
+template <typename T>
+class alignas(detail::cache_padded_alignment) cache_padded {
+public:
+  using value_type = T;
+
+  static constexpr std::size_t alignment = detail::cache_padded_alignment;
+
+  constexpr cache_padded() : value_() {}
+
+  constexpr cache_padded(T const& value) : value_(value) {}
+
+  constexpr cache_padded(T&& value) : value_(SLB_MOVE(value)) {}
+
+  template <typename... Args,
+            typename std::enable_if<
+                std::is_constructible<T, Args&&...>::value,
+                int>::type = 0>
+  constexpr explicit cache_padded(in_place_t, Args&&... args)
+      : value_(SLB_FORWARD(Args, args)...) {}
+
+  SLB_CXX14_CONSTEXPR T& get() noexcept { return value_; }
+  constexpr T const& get() const noexcept { return value_; }
+
+  SLB_CXX14_CONSTEXPR T& operator*() noexcept { return value_; }
+  constexpr T const& operator*() const noexcept { return value_; }
+
+  SLB_CXX14_CONSTEXPR T* operator->() noexcept { return &value_; }
+  constexpr T const* operator->() const noexcept { return &value_; }
+
+private:
+  T value_;
+};
+
+template <typename T>
+constexpr std::size_t cache_padded<T>::alignment;
+
+} // namespace slb
+
+#endif // SLB_CACHE_PADDED_HPP
@@ -0,0 +1,1377 @@
+/*
+  SLB.CharConv
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_CHARCONV_HPP
+#define SLB_CHARCONV_HPP
+
+/*
+
+Header <charconv> synopsis [charconv.syn]
+
+namespace std {
+  // floating-point format for primitive numerical conversion
+  enum class chars_format {
+    scientific = unspecified,
+    fixed = unspecified,
+    hex = unspecified,
+    general = fixed | scientific
+  };
+
+  // [charconv.to.chars], primitive numerical output conversion
+  struct to_chars_result {
+    char* ptr;
+    errc ec;
+  };
+
+  to_chars_result to_chars(char* first, char* last, see below value,
+                           int base = 10);
+  to_chars_result to_chars(char* first, char* last, bool value,
+                           int base = 10) = delete;
+
+  to_chars_result to_chars(char* first, char* last, float value);
+  to_chars_result to_chars(char* first, char* last, double value);
+  to_chars_result to_chars(char* first, char* last, long double value);
+
+  to_chars_result to_chars(char* first, char* last, float value,
+                           chars_format fmt);
+  to_chars_result to_chars(char* first, char* last, double value,
+                           chars_format fmt);
+  to_chars_result to_chars(char* first, char* last, long double value,
+                           chars_format fmt);
+
+  to_chars_result to_chars(char* first, char* last, float value,
+                           chars_format fmt, int precision);
+  to_chars_result to_chars(char* first, char* last, double value,
+                           chars_format fmt, int precision);
+  to_chars_result to_chars(char* first, char* last, long double value,
+                           chars_format fmt, int precision);
+
+  // [charconv.from.chars], primitive numerical input conversion
+  struct from_chars_result {
+    const char* ptr;
+    errc ec;
+  };
+
+  from_chars_result from_chars(const char* first, const char* last,
+                               see below& value, int base = 10);
+
+  from_chars_result from_chars(const char* first, const char* last,
+                               float& value,
+                               chars_format fmt = chars_format::general);
+  from_chars_result from_chars(const char* first, const char* last,
+                               double& value,
+                               chars_format fmt = chars_format::general);
+  from_chars_result from_chars(const char* first, const char* last,
+                               long double& value,
+                               chars_format fmt = chars_format::general);
+}
+
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include "bit.hpp"
+#include "detail/config.hpp"
+#include "detail/pow10.hpp"
+#include "type_traits.hpp"
+
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+
+namespace slb {
+
+#if __cpp_lib_to_chars // C++17
+using std::chars_format;
+using std::to_chars_result;
+using std::from_chars_result;
+using std::to_chars;
+using std::from_chars;
+#else
+enum class chars_format {
+  scientific = 0x1,
+  fixed = 0x2,
+  hex = 0x4,
+  general = fixed | scientific
+};
+
+// `chars_format` is a bitmask type.
+constexpr chars_format operator&(chars_format lhs, chars_format rhs) noexcept {
+  return static_cast<chars_format>(static_cast<int>(lhs) &
+                                   static_cast<int>(rhs));
+}
+
+constexpr chars_format operator|(chars_format lhs, chars_format rhs) noexcept {
+  return static_cast<chars_format>(static_cast<int>(lhs) |
+                                   static_cast<int>(rhs));
+}
+
+constexpr chars_format operator^(chars_format lhs, chars_format rhs) noexcept {
+  return static_cast<chars_format>(static_cast<int>(lhs) ^
+                                   static_cast<int>(rhs));
+}
+
+constexpr chars_format operator~(chars_format x) noexcept {
+  return static_cast<chars_format>(~static_cast<int>(x) & 0x7);
+}
+
+inline SLB_CXX14_CONSTEXPR chars_format& operator&=(chars_format& lhs,
+                                                   chars_format rhs) noexcept {
+  return lhs = lhs & rhs;
+}
+
+inline SLB_CXX14_CONSTEXPR chars_format& operator|=(chars_format& lhs,
+                                                   chars_format rhs) noexcept {
+  return lhs = lhs | rhs;
+}
+
+inline SLB_CXX14_CONSTEXPR chars_format& operator^=(chars_format& lhs,
+                                                   chars_format rhs) noexcept {
+  return lhs = lhs ^ rhs;
+}
+
+// [charconv.to.chars], primitive numerical output conversion
+
+struct to_chars_result {
+  char* ptr;
+  std::errc ec;
+};
+
+// [charconv.from.chars], primitive numerical input conversion
+
+struct from_chars_result {
+  const char* ptr;
+  std::errc ec;
+};
+
+namespace detail {
+
+// The integer overloads participate in overload resolution for the signed and
+// unsigned integer types and `char`.
+template <typename T>
+struct is_charconv_integer
+    : slb::bool_constant<std::is_same<T, char>::value ||
+                         std::is_same<T, signed char>::value ||
+                         std::is_same<T, unsigned char>::value ||
+                         std::is_same<T, short>::value ||
+                         std::is_same<T, unsigned short>::value ||
+                         std::is_same<T, int>::value ||
+                         std::is_same<T, unsigned int>::value ||
+                         std::is_same<T, long>::value ||
+                         std::is_same<T, unsigned long>::value ||
+                         std::is_same<T, long long>::value ||
+                         std::is_same<T, unsigned long long>::value> {};
+
+// Integers narrower than `unsigned int` are converted through it, wider ones
+// through `unsigned long long`.
+template <typename T>
+using charconv_uint = typename std::conditional<
+    (sizeof(T) <= sizeof(unsigned int)),
+    unsigned int,
+    unsigned long long>::type;
+
+template <typename = void>
+struct charconv_tables {
+  static constexpr char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+  static constexpr char digit_pairs[] =
+      "00010203040506070809"
+      "10111213141516171819"
+      "20212223242526272829"
+      "30313233343536373839"
+      "40414243444546474849"
+      "50515253545556575859"
+      "60616263646566676869"
+      "70717273747576777879"
+      "80818283848586878889"
+      "90919293949596979899";
+  static constexpr std::uint64_t pow10[] = {1u,
+                                            10u,
+                                            100u,
+                                            1000u,
+                                            10000u,
+                                            100000u,
+                                            1000000u,
+                                            10000000u,
+                                            100000000u,
+                                            1000000000u,
+                                            10000000000u,
+                                            100000000000u,
+                                            1000000000000u,
+                                            10000000000000u,
+                                            100000000000000u,
+                                            1000000000000000u,
+                                            10000000000000000u,
+                                            100000000000000000u,
+                                            1000000000000000000u,
+                                            10000000000000000000u};
+};
+
+template <typename T>
+constexpr char charconv_tables<T>::digits[];
+template <typename T>
+constexpr char charconv_tables<T>::digit_pairs[];
+template <typename T>
+constexpr std::uint64_t charconv_tables<T>::pow10[];
+
+// `bit_width(x) * 1233 >> 12` is `floor(bit_width(x) * log10(2))`, which is
+// either the number of decimal digits of `x` or one less; a single comparison
+// against a power of 10 tells which.
+template <typename U>
+int count_digits10(U x) noexcept {
+  U const y = static_cast<U>(x | 1u);
+  int const t = (slb::bit_width(y) * 1233) >> 12;
+  return t + 1 - (y < charconv_tables<>::pow10[t]);
+}
+
+// Writes the decimal digits of `x` backwards, two at a time, ending at `last`.
+template <typename U>
+void write_digits10(char* last, U x) noexcept {
+  while (x >= 100u) {
+    U const r = static_cast<U>(x % 100u);
+    x = static_cast<U>(x / 100u);
+    last -= 2;
+    std::memcpy(last, charconv_tables<>::digit_pairs + 2 * r, 2);
+  }
+  if (x >= 10u) {
+    std::memcpy(last - 2, charconv_tables<>::digit_pairs + 2 * x, 2);
+  } else {
+    last[-1] = static_cast<char>('0' + x);
+  }
+}
+
+template <typename U>
+to_chars_result to_chars_unsigned(char* first,
+                                  char* last,
+                                  U x,
+                                  int base) noexcept {
+  U const b = static_cast<U>(base);
+  if (base == 10) {
+    int const n = detail::count_digits10(x);
+    if (last - first < n) {
+      return {last, std::errc::value_too_large};
+    }
+    detail::write_digits10(first + n, x);
+    return {first + n, std::errc()};
+  }
+  if ((base & (base - 1)) == 0) {
+    int const shift = slb::countr_zero(static_cast<unsigned int>(base));
+    int const n = (slb::bit_width(static_cast<U>(x | 1u)) + shift - 1) / shift;
+    if (last - first < n) {
+      return {last, std::errc::value_too_large};
+    }
+    char* p = first + n;
+    do {
+      *--p = charconv_tables<>::digits[x & (b - 1)];
+      x = static_cast<U>(x >> shift);
+    } while (x != 0);
+    return {first + n, std::errc()};
+  }
+  int n = 1;
+  for (U t = x; t >= b; t = static_cast<U>(t / b)) {
+    ++n;
+  }
+  if (last - first < n) {
+    return {last, std::errc::value_too_large};
+  }
+  char* p = first + n;
+  do {
+    *--p = charconv_tables<>::digits[x % b];
+    x = static_cast<U>(x / b);
+  } while (x != 0);
+  return {first + n, std::errc()};
+}
+
+template <typename T>
+to_chars_result to_chars_integer(std::false_type,
+                                 char* first,
+                                 char* last,
+                                 T value,
+                                 int base) noexcept {
+  return detail::to_chars_unsigned(
+      first, last, static_cast<charconv_uint<T>>(value), base);
+}
+
+template <typename T>
+to_chars_result to_chars_integer(std::true_type,
+                                 char* first,
+                                 char* last,
+                                 T value,
+                                 int base) noexcept {
+  using U = charconv_uint<T>;
+  U x = static_cast<U>(value);
+  if (value < 0) {
+    if (first == last) {
+      return {last, std::errc::value_too_large};
+    }
+    *first++ = '-';
+    x = static_cast<U>(0u - x);
+  }
+  return detail::to_chars_unsigned(first, last, x, base);
+}
+
+// Returns the value of the digit `c` in base 36, or 36 if it is not a digit.
+inline unsigned int char_digit(char c) noexcept {
+  unsigned int const u = static_cast<unsigned char>(c);
+  if (u - '0' < 10u) {
+    return u - '0';
+  }
+  unsigned int const l = (u | 0x20u) - 'a';
+  return l < 26u ? l + 10 : 36;
+}
+
+template <typename T, typename U>
+T from_magnitude(std::false_type, bool, U x) noexcept {
+  return static_cast<T>(x);
+}
+
+template <typename T, typename U>
+T from_magnitude(std::true_type, bool negative, U x) noexcept {
+  // `x - 1` is representable in `T` even when `-x` is not.
+  return negative && x != 0 ? static_cast<T>(-static_cast<T>(x - 1) - 1)
+                            : static_cast<T>(x);
+}
+
+template <typename T>
+from_chars_result from_chars_integer(const char* first,
+                                     const char* last,
+                                     T& value,
+                                     int base) noexcept {
+  using U = charconv_uint<T>;
+  const char* p = first;
+  bool const negative = std::is_signed<T>::value && p != last && *p == '-';
+  if (negative) {
+    ++p;
+  }
+  U const limit = static_cast<U>(static_cast<U>(std::numeric_limits<T>::max()) +
+                                 (negative ? 1u : 0u));
+  U const b = static_cast<U>(base);
+  U const cutoff = static_cast<U>(limit / b);
+  U const cutlim = static_cast<U>(limit % b);
+
+  const char* const digits = p;
+  U x = 0;
+  bool overflow = false;
+  for (; p != last; ++p) {
+    unsigned int const d = detail::char_digit(*p);
+    if (d >= static_cast<unsigned int>(base)) {
+      break;
+    }
+    if (x > cutoff || (x == cutoff && d > cutlim)) {
+      overflow = true;
+    } else {
+      x = static_cast<U>(x * b + d);
+    }
+  }
+  if (p == digits) {
+    return {first, std::errc::invalid_argument};
+  }
+  if (overflow) {
+    return {p, std::errc::result_out_of_range};
+  }
+  value = detail::from_magnitude<T>(std::is_signed<T>{}, negative, x);
+  return {p, std::errc()};
+}
+
+// Floating-point conversions assume the IEEE-754 binary32 and binary64
+// formats.
+template <typename T>
+struct float_traits;
+
+template <>
+struct float_traits<float> {
+  static_assert(std::numeric_limits<float>::is_iec559 &&
+                    std::numeric_limits<float>::digits == 24,
+                "`float` shall be IEEE-754 binary32.");
+
+  using bits_type = std::uint32_t;
+  static constexpr int significand_bits = 23;
+  static constexpr int exponent_bits = 8;
+  static constexpr int exponent_bias = 127;
+  // Decimal exponents outside of this range round a 19-digit significand to
+  // zero or infinity.
+  static constexpr int min_decimal_exponent = -65;
+  static constexpr int max_decimal_exponent = 38;
+  // Decimal exponents for which a product may be exactly halfway between two
+  // consecutive values.
+  static constexpr int min_round_to_even_exponent = -17;
+  static constexpr int max_round_to_even_exponent = 10;
+};
+
+template <>
+struct float_traits<double> {
+  static_assert(std::numeric_limits<double>::is_iec559 &&
+                    std::numeric_limits<double>::digits == 53,
+                "`double` shall be IEEE-754 binary64.");
+
+  using bits_type = std::uint64_t;
+  static constexpr int significand_bits = 52;
+  static constexpr int exponent_bits = 11;
+  static constexpr int exponent_bias = 1023;
+  static constexpr int min_decimal_exponent = -342;
+  static constexpr int max_decimal_exponent = 308;
+  static constexpr int min_round_to_even_exponent = -4;
+  static constexpr int max_round_to_even_exponent = 23;
+};
+
+struct uint128 {
+  std::uint64_t hi;
+  std::uint64_t lo;
+};
+
+inline uint128 umul128(std::uint64_t a, std::uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128_t;
+  uint128_t const p = static_cast<uint128_t>(a) * b;
+  return {static_cast<std::uint64_t>(p >> 64), static_cast<std::uint64_t>(p)};
+#elif defined(_MSC_VER) && defined(_M_X64)
+  std::uint64_t hi;
+  std::uint64_t const lo = _umul128(a, b, &hi);
+  return {hi, lo};
+#else
+  std::uint64_t const a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+  std::uint64_t const b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+  std::uint64_t const ll = a_lo * b_lo, lh = a_lo * b_hi;
+  std::uint64_t const hl = a_hi * b_lo, hh = a_hi * b_hi;
+  std::uint64_t const mid =
+      (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+  return {hh + (lh >> 32) + (hl >> 32) + (mid >> 32),
+          (mid << 32) | (ll & 0xFFFFFFFFu)};
+#endif
+}
+
+// The 128 most significant bits of `10^e`, rounded down.
+inline uint128 pow10_significand(int e) noexcept {
+  std::uint64_t const* p =
+      pow10<>::significands + 2 * (e - pow10<>::min_exponent);
+  return {p[0], p[1]};
+}
+
+// `floor(e * log10(2))`, `floor(log10(3/4 * 2^e))` and `floor(e * log2(10))`,
+// exact for `e` in `[-1500, 1500]`, `[-1500, 1500]` and `[-1233, 1233]`.
+constexpr int floor_log10_pow2(int e) noexcept { return (e * 1262611) >> 22; }
+
+constexpr int floor_log10_three_quarters_pow2(int e) noexcept {
+  return (e * 1262611 - 524031) >> 22;
+}
+
+constexpr int floor_log2_pow10(int e) noexcept { return (e * 1741647) >> 19; }
+
+// An arbitrary-precision unsigned integer with room for the exact comparisons
+// and conversions of `float` and `double` values.
+class bigint {
+public:
+  explicit bigint(std::uint64_t x) noexcept : size_(0) {
+    for (; x != 0; x >>= 32) {
+      limbs_[size_++] = static_cast<std::uint32_t>(x);
+    }
+  }
+
+  // `*this = *this * m + a`
+  void mul_add(std::uint32_t m, std::uint32_t a) noexcept {
+    std::uint64_t carry = a;
+    for (int i = 0; i < size_; ++i) {
+      std::uint64_t const t = static_cast<std::uint64_t>(limbs_[i]) * m + carry;
+      limbs_[i] = static_cast<std::uint32_t>(t);
+      carry = t >> 32;
+    }
+    if (carry != 0) {
+      limbs_[size_++] = static_cast<std::uint32_t>(carry);
+    }
+  }
+
+  void mul_pow10(int n) noexcept {
+    for (; n >= 9; n -= 9) {
+      mul_add(1000000000u, 0);
+    }
+    if (n > 0) {
+      mul_add(static_cast<std::uint32_t>(charconv_tables<>::pow10[n]), 0);
+    }
+  }
+
+  void shift_left(int n) noexcept {
+    if (size_ == 0) {
+      return;
+    }
+    int const words = n / 32;
+    int const bits = n % 32;
+    if (bits != 0) {
+      std::uint32_t carry = 0;
+      for (int i = 0; i < size_; ++i) {
+        std::uint32_t const limb = limbs_[i];
+        limbs_[i] = (limb << bits) | carry;
+        carry = limb >> (32 - bits);
+      }
+      if (carry != 0) {
+        limbs_[size_++] = carry;
+      }
+    }
+    if (words != 0) {
+      for (int i = size_ - 1; i >= 0; --i) {
+        limbs_[i + words] = limbs_[i];
+      }
+      for (int i = 0; i < words; ++i) {
+        limbs_[i] = 0;
+      }
+      size_ += words;
+    }
+  }
+
+  // Divides by `d` and returns the remainder.
+  std::uint32_t div_mod(std::uint32_t d) noexcept {
+    std::uint64_t r = 0;
+    for (int i = size_ - 1; i >= 0; --i) {
+      std::uint64_t const t = (r << 32) | limbs_[i];
+      limbs_[i] = static_cast<std::uint32_t>(t / d);
+      r = t % d;
+    }
+    while (size_ > 0 && limbs_[size_ - 1] == 0) {
+      --size_;
+    }
+    return static_cast<std::uint32_t>(r);
+  }
+
+  bool is_zero() const noexcept { return size_ == 0; }
+
+  friend int compare(bigint const& lhs, bigint const& rhs) noexcept {
+    if (lhs.size_ != rhs.size_) {
+      return lhs.size_ < rhs.size_ ? -1 : 1;
+    }
+    for (int i = lhs.size_ - 1; i >= 0; --i) {
+      if (lhs.limbs_[i] != rhs.limbs_[i]) {
+        return lhs.limbs_[i] < rhs.limbs_[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+private:
+  // The largest value needed is about `10^1145 * 2^54`, in `from_chars`.
+  std::uint32_t limbs_[128];
+  int size_;
+};
+
+// [charconv.to.chars], primitive numerical output conversion
+
+struct decimal_fp {
+  std::uint64_t significand;
+  int exponent;
+};
+
+// Rounds `g * cp / 2^128` to odd, `g` being an over-approximation by less
+// than one unit of a power of 10.
+inline std::uint64_t round_to_odd(uint128 g, std::uint64_t cp) noexcept {
+  uint128 const x = detail::umul128(g.lo, cp);
+  uint128 y = detail::umul128(g.hi, cp);
+  y.lo += x.hi;
+  y.hi += y.lo < x.hi;
+  return y.hi | (y.lo > 1);
+}
+
+// The shortest decimal that rounds back to the positive finite value with the
+// representation `bits`, as computed by Schubfach (Giulietti, "The Schubfach
+// way to render doubles"). Trailing zeros are not removed.
+template <typename T>
+decimal_fp to_shortest_decimal(
+    typename float_traits<T>::bits_type bits) noexcept {
+  using traits = float_traits<T>;
+  std::uint64_t const hidden = std::uint64_t(1) << traits::significand_bits;
+  std::uint64_t const fraction = bits & (hidden - 1);
+  int const biased_exponent =
+      static_cast<int>(bits >> traits::significand_bits);
+
+  std::uint64_t c;
+  int q;
+  if (biased_exponent != 0) {
+    c = hidden | fraction;
+    q = biased_exponent - traits::exponent_bias - traits::significand_bits;
+    // Integers below `2^(significand_bits + 1)` are their own shortest
+    // representation.
+    if (0 <= -q && -q <= traits::significand_bits &&
+        (c & ((std::uint64_t(1) << -q) - 1)) == 0) {
+      return {c >> -q, 0};
+    }
+  } else {
+    c = fraction;
+    q = 1 - traits::exponent_bias - traits::significand_bits;
+  }
+
+  bool const is_even = c % 2 == 0;
+  bool const lower_boundary_is_closer = fraction == 0 && biased_exponent > 1;
+
+  std::uint64_t const cbl = 4 * c - 2 + lower_boundary_is_closer;
+  std::uint64_t const cb = 4 * c;
+  std::uint64_t const cbr = 4 * c + 2;
+
+  int const k = lower_boundary_is_closer
+                    ? detail::floor_log10_three_quarters_pow2(q)
+                    : detail::floor_log10_pow2(q);
+  int const h = q + detail::floor_log2_pow10(-k) + 1;
+
+  uint128 g = detail::pow10_significand(-k);
+  g.lo += 1;
+  g.hi += g.lo == 0;
+
+  std::uint64_t const vbl = detail::round_to_odd(g, cbl << h);
+  std::uint64_t const vb = detail::round_to_odd(g, cb << h);
+  std::uint64_t const vbr = detail::round_to_odd(g, cbr << h);
+
+  std::uint64_t const lower = vbl + !is_even;
+  std::uint64_t const upper = vbr - !is_even;
+
+  std::uint64_t const s = vb / 4;
+  if (s >= 10) {
+    std::uint64_t const sp = s / 10;
+    bool const up_inside = lower <= 40 * sp;
+    bool const wp_inside = 40 * sp + 40 <= upper;
+    if (up_inside != wp_inside) {
+      return {sp + wp_inside, k + 1};
+    }
+  }
+
+  bool const u_inside = lower <= 4 * s;
+  bool const w_inside = 4 * s + 4 <= upper;
+  if (u_inside != w_inside) {
+    return {s + w_inside, k};
+  }
+
+  std::uint64_t const mid = 4 * s + 2;
+  bool const round_up = vb > mid || (vb == mid && (s & 1) != 0);
+  return {s + round_up, k};
+}
+
+inline int scientific_length(int n, int x) noexcept {
+  return n + (n > 1) + 2 + (x <= -100 || x >= 100 ? 3 : 2);
+}
+
+// Writes `v` in the requested format; `chars_format{}` selects whichever of
+// fixed or scientific is shorter, preferring fixed.
+inline to_chars_result to_chars_decimal(char* first,
+                                        char* last,
+                                        bool negative,
+                                        decimal_fp v,
+                                        chars_format fmt) noexcept {
+  char digits[20];
+  int const n = detail::count_digits10(v.significand);
+  detail::write_digits10(digits + n, v.significand);
+
+  int const x = v.exponent + n - 1;
+  int const sci_length = detail::scientific_length(n, x);
+  int const fixed_length =
+      v.exponent >= 0 ? n + v.exponent : x >= 0 ? n + 1 : n + 1 - x;
+  bool scientific;
+  switch (fmt) {
+    case chars_format::scientific: scientific = true; break;
+    case chars_format::fixed: scientific = false; break;
+    // Like `%g` with a precision of 6, but with the shortest digits.
+    case chars_format::general: scientific = x < -4 || x >= 6; break;
+    default: scientific = sci_length < fixed_length; break;
+  }
+
+  if (last - first < negative + (scientific ? sci_length : fixed_length)) {
+    return {last, std::errc::value_too_large};
+  }
+  char* p = first;
+  if (negative) {
+    *p++ = '-';
+  }
+  if (scientific) {
+    *p++ = digits[0];
+    if (n > 1) {
+      *p++ = '.';
+      std::memcpy(p, digits + 1, static_cast<std::size_t>(n - 1));
+      p += n - 1;
+    }
+    *p++ = 'e';
+    *p++ = x < 0 ? '-' : '+';
+    int e = x < 0 ? -x : x;
+    if (e >= 100) {
+      *p++ = static_cast<char>('0' + e / 100);
+      e %= 100;
+    }
+    std::memcpy(p, charconv_tables<>::digit_pairs + 2 * e, 2);
+    p += 2;
+  } else if (v.exponent >= 0) {
+    std::memcpy(p, digits, static_cast<std::size_t>(n));
+    p += n;
+    std::memset(p, '0', static_cast<std::size_t>(v.exponent));
+    p += v.exponent;
+  } else if (x >= 0) {
+    std::memcpy(p, digits, static_cast<std::size_t>(x + 1));
+    p += x + 1;
+    *p++ = '.';
+    std::memcpy(p, digits + x + 1, static_cast<std::size_t>(n - x - 1));
+    p += n - x - 1;
+  } else {
+    *p++ = '0';
+    *p++ = '.';
+    std::memset(p, '0', static_cast<std::size_t>(-x - 1));
+    p += -x - 1;
+    std::memcpy(p, digits, static_cast<std::size_t>(n));
+    p += n;
+  }
+  return {p, std::errc()};
+}
+
+// Values of `c * 2^q` with `q > 0` are integers above `2^(significand_bits +
+// 1)`. In fixed notation, all representations of them have the same length,
+// and the exact value is the closest one.
+inline to_chars_result to_chars_exact_integer(char* first,
+                                              char* last,
+                                              bool negative,
+                                              std::uint64_t c,
+                                              int q,
+                                              decimal_fp v,
+                                              chars_format fmt) noexcept {
+  char buffer[320];
+  char* const end = buffer + sizeof(buffer);
+  char* begin = end;
+  bigint x(c);
+  x.shift_left(q);
+  for (;;) {
+    std::uint32_t chunk = x.div_mod(1000000000u);
+    if (x.is_zero()) {
+      detail::write_digits10(begin, chunk);
+      begin -= detail::count_digits10(chunk);
+      break;
+    }
+    begin -= 9;
+    for (int i = 8; i >= 0; --i) {
+      begin[i] = static_cast<char>('0' + chunk % 10);
+      chunk /= 10;
+    }
+  }
+  int const n = static_cast<int>(end - begin);
+  if (fmt != chars_format::fixed) {
+    int const digits = detail::count_digits10(v.significand);
+    if (detail::scientific_length(digits, v.exponent + digits - 1) < n) {
+      return detail::to_chars_decimal(first, last, negative, v, fmt);
+    }
+  }
+
+  if (last - first < negative + n) {
+    return {last, std::errc::value_too_large};
+  }
+  if (negative) {
+    *first++ = '-';
+  }
+  std::memcpy(first, begin, static_cast<std::size_t>(n));
+  return {first + n, std::errc()};
+}
+
+template <typename T>
+to_chars_result to_chars_hex(
+    char* first,
+    char* last,
+    bool negative,
+    typename float_traits<T>::bits_type bits) noexcept {
+  using traits = float_traits<T>;
+  int const nibbles = (traits::significand_bits + 3) / 4;
+  std::uint64_t const hidden = std::uint64_t(1) << traits::significand_bits;
+  std::uint64_t fraction = (bits & (hidden - 1))
+                           << (nibbles * 4 - traits::significand_bits);
+  int const biased_exponent =
+      static_cast<int>(bits >> traits::significand_bits);
+
+  char const lead = biased_exponent != 0 ? '1' : '0';
+  int const e = biased_exponent != 0
+                    ? biased_exponent - traits::exponent_bias
+                    : bits != 0 ? 1 - traits::exponent_bias : 0;
+  int n = fraction != 0 ? nibbles : 0;
+  for (; n != 0 && (fraction & 0xF) == 0; --n) {
+    fraction >>= 4;
+  }
+  unsigned int const abs_e = static_cast<unsigned int>(e < 0 ? -e : e);
+  int const exp_length = detail::count_digits10(abs_e);
+
+  if (last - first <
+      negative + 1 + (n != 0 ? n + 1 : 0) + 2 + exp_length) {
+    return {last, std::errc::value_too_large};
+  }
+  char* p = first;
+  if (negative) {
+    *p++ = '-';
+  }
+  *p++ = lead;
+  if (n != 0) {
+    *p++ = '.';
+    for (int i = n - 1; i >= 0; --i) {
+      p[i] = charconv_tables<>::digits[fraction & 0xF];
+      fraction >>= 4;
+    }
+    p += n;
+  }
+  *p++ = 'p';
+  *p++ = e < 0 ? '-' : '+';
+  detail::write_digits10(p + exp_length, abs_e);
+  return {p + exp_length, std::errc()};
+}
+
+template <typename T>
+to_chars_result to_chars_float(char* first,
+                               char* last,
+                               T value,
+                               chars_format fmt) noexcept {
+  using traits = float_traits<T>;
+  using bits_type = typename traits::bits_type;
+  int const width = traits::significand_bits + traits::exponent_bits;
+  bits_type const bits = slb::bit_cast<bits_type>(value);
+  bool const negative = (bits >> width) != 0;
+  bits_type const magnitude =
+      static_cast<bits_type>(bits & ((bits_type(1) << width) - 1));
+  int const biased_exponent =
+      static_cast<int>(magnitude >> traits::significand_bits);
+
+  if (biased_exponent == (1 << traits::exponent_bits) - 1) {
+    bool const is_nan =
+        (magnitude & ((bits_type(1) << traits::significand_bits) - 1)) != 0;
+    if (last - first < negative + 3) {
+      return {last, std::errc::value_too_large};
+    }
+    if (negative) {
+      *first++ = '-';
+    }
+    std::memcpy(first, is_nan ? "nan" : "inf", 3);
+    return {first + 3, std::errc()};
+  }
+  if (fmt == chars_format::hex) {
+    return detail::to_chars_hex<T>(first, last, negative, magnitude);
+  }
+  if (magnitude == 0) {
+    return detail::to_chars_decimal(first, last, negative, {0, 0}, fmt);
+  }
+
+  decimal_fp v = detail::to_shortest_decimal<T>(magnitude);
+  while (v.significand % 10 == 0) {
+    v.significand /= 10;
+    ++v.exponent;
+  }
+  int const q =
+      biased_exponent - traits::exponent_bias - traits::significand_bits;
+  if (v.exponent > 0 && q > 0 &&
+      (fmt == chars_format::fixed || fmt == chars_format{})) {
+    std::uint64_t const c =
+        (std::uint64_t(1) << traits::significand_bits) |
+        (magnitude & ((bits_type(1) << traits::significand_bits) - 1));
+    return detail::to_chars_exact_integer(
+        first, last, negative, c, q, v, fmt);
+  }
+  return detail::to_chars_decimal(first, last, negative, v, fmt);
+}
+
+// [charconv.from.chars], primitive numerical input conversion
+
+// A significand without its hidden bit, and a biased exponent.
+struct adjusted_mantissa {
+  std::uint64_t mantissa;
+  int power2;
+};
+
+inline bool operator==(adjusted_mantissa lhs, adjusted_mantissa rhs) noexcept {
+  return lhs.mantissa == rhs.mantissa && lhs.power2 == rhs.power2;
+}
+
+// Rounds `w * 10^q`, with a non-zero `w`, to the nearest `T`, as computed by
+// the Eisel-Lemire algorithm (Lemire, "Number Parsing at a Gigabyte per
+// Second"). The result is exact for any `w` (Mushtak and Lemire, "Fast number
+// parsing without fallback").
+template <typename T>
+adjusted_mantissa compute_float(int q, std::uint64_t w) noexcept {
+  using traits = float_traits<T>;
+  int const infinite_power = (1 << traits::exponent_bits) - 1;
+  if (q < traits::min_decimal_exponent) {
+    return {0, 0};
+  }
+  if (q > traits::max_decimal_exponent) {
+    return {0, infinite_power};
+  }
+
+  int const lz = slb::countl_zero(w);
+  w <<= lz;
+
+  // For `q` in `[-27, 0)`, `5^-q` fits in 64 bits and its reciprocal is
+  // rounded up instead of down.
+  uint128 power = detail::pow10_significand(q);
+  if (q >= -27 && q < 0) {
+    power.lo += 1;
+    power.hi += power.lo == 0;
+  }
+  std::uint64_t const precision_mask =
+      ~std::uint64_t(0) >> (traits::significand_bits + 3);
+  uint128 product = detail::umul128(w, power.hi);
+  if ((product.hi & precision_mask) == precision_mask) {
+    uint128 const low = detail::umul128(w, power.lo);
+    product.lo += low.hi;
+    product.hi += low.hi > product.lo;
+  }
+
+  int const upper_bit = static_cast<int>(product.hi >> 63);
+  int const shift = upper_bit + 64 - traits::significand_bits - 3;
+  adjusted_mantissa am;
+  am.mantissa = product.hi >> shift;
+  am.power2 = (((152170 + 65536) * q) >> 16) + 63 + upper_bit - lz +
+              traits::exponent_bias;
+
+  if (am.power2 <= 0) { // subnormal
+    if (-am.power2 + 1 >= 64) {
+      return {0, 0};
+    }
+    am.mantissa >>= -am.power2 + 1;
+    am.mantissa += am.mantissa & 1;
+    am.mantissa >>= 1;
+    am.power2 =
+        am.mantissa < (std::uint64_t(1) << traits::significand_bits) ? 0 : 1;
+    am.mantissa &= ~(std::uint64_t(1) << traits::significand_bits);
+    return am;
+  }
+
+  // Exactly halfway between two values: round to even.
+  if (product.lo <= 1 && q >= traits::min_round_to_even_exponent &&
+      q <= traits::max_round_to_even_exponent && (am.mantissa & 3) == 1 &&
+      (am.mantissa << shift) == product.hi) {
+    am.mantissa &= ~std::uint64_t(1);
+  }
+  am.mantissa += am.mantissa & 1;
+  am.mantissa >>= 1;
+  if (am.mantissa >= (std::uint64_t(2) << traits::significand_bits)) {
+    am.mantissa = std::uint64_t(1) << traits::significand_bits;
+    ++am.power2;
+  }
+  am.mantissa &= ~(std::uint64_t(1) << traits::significand_bits);
+  if (am.power2 >= infinite_power) {
+    return {0, infinite_power};
+  }
+  return am;
+}
+
+inline bool is_digit(char c) noexcept {
+  return static_cast<unsigned int>(c - '0') < 10u;
+}
+
+// The digits `[first, last)` of a decimal number, with at most one '.', and
+// the exponent of the last digit.
+struct decimal_digits {
+  const char* first;
+  const char* last;
+  long long exponent;
+};
+
+// Decides between `am` and the next value up for a number with more than 19
+// significant digits, by comparing it exactly against the halfway point
+// between them. Beyond 800 significant digits, which is more than halfway
+// points have, the remaining ones only matter for whether they are all zero.
+template <typename T>
+adjusted_mantissa compare_halfway(decimal_digits const& d,
+                                  adjusted_mantissa am) noexcept {
+  using traits = float_traits<T>;
+  int const max_digits = 800;
+
+  bigint n(0);
+  int count = 0;
+  std::uint32_t chunk = 0;
+  int chunk_length = 0;
+  const char* p = d.first;
+  for (; p != d.last && (*p == '0' || *p == '.'); ++p) {
+  }
+  long long exponent = d.exponent;
+  for (; p != d.last; ++p) {
+    if (*p == '.') {
+      continue;
+    }
+    if (count == max_digits) {
+      break;
+    }
+    chunk = chunk * 10 + static_cast<std::uint32_t>(*p - '0');
+    ++count;
+    if (++chunk_length == 9) {
+      n.mul_add(1000000000u, chunk);
+      chunk = 0;
+      chunk_length = 0;
+    }
+  }
+  bool sticky = false;
+  for (; p != d.last; ++p) {
+    if (*p != '.') {
+      sticky |= *p != '0';
+      ++exponent;
+    }
+  }
+  if (chunk_length != 0) {
+    n.mul_add(
+        static_cast<std::uint32_t>(charconv_tables<>::pow10[chunk_length]),
+        chunk);
+  }
+  if (sticky) {
+    n.mul_add(10, 1);
+    --exponent;
+  }
+
+  std::uint64_t const hidden = std::uint64_t(1) << traits::significand_bits;
+  std::uint64_t const m = am.power2 == 0 ? am.mantissa : am.mantissa | hidden;
+  int const e = (am.power2 == 0 ? 1 : am.power2) - traits::exponent_bias -
+                traits::significand_bits;
+
+  // Compare `n * 10^exponent` against `(2 * m + 1) * 2^(e - 1)`.
+  bigint halfway(2 * m + 1);
+  if (exponent >= 0) {
+    n.mul_pow10(static_cast<int>(exponent));
+  } else {
+    halfway.mul_pow10(static_cast<int>(-exponent));
+  }
+  if (e - 1 >= 0) {
+    halfway.shift_left(e - 1);
+  } else {
+    n.shift_left(1 - e);
+  }
+
+  int const cmp = compare(n, halfway);
+  if (cmp > 0 || (cmp == 0 && (m & 1) != 0)) {
+    std::uint64_t const next =
+        ((static_cast<std::uint64_t>(am.power2) << traits::significand_bits) |
+         am.mantissa) +
+        1;
+    return {next & (hidden - 1),
+            static_cast<int>(next >> traits::significand_bits)};
+  }
+  return am;
+}
+
+template <typename T>
+T make_float(bool negative, std::uint64_t magnitude) noexcept {
+  using traits = float_traits<T>;
+  using bits_type = typename traits::bits_type;
+  int const width = traits::significand_bits + traits::exponent_bits;
+  return slb::bit_cast<T>(static_cast<bits_type>(
+      (static_cast<bits_type>(negative) << width) | magnitude));
+}
+
+inline bool match_ignore_case(const char* first,
+                              const char* last,
+                              const char* lowercase) noexcept {
+  for (; *lowercase != '\0'; ++first, ++lowercase) {
+    if (first == last || (*first | 0x20) != *lowercase) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+from_chars_result from_chars_decimal(const char* first,
+                                     const char* p,
+                                     const char* last,
+                                     bool negative,
+                                     T& value,
+                                     chars_format fmt) noexcept {
+  using traits = float_traits<T>;
+  int const max_digits = 19;
+
+  std::uint64_t w = 0;
+  int taken = 0;
+  long long significant = 0;
+  bool truncated = false;
+
+  decimal_digits digits = {p, p, 0};
+  bool has_point = false;
+  for (;; ++p) {
+    if (p != last && *p == '.' && !has_point) {
+      has_point = true;
+      continue;
+    }
+    if (p == last || !detail::is_digit(*p)) {
+      break;
+    }
+    unsigned int const d = static_cast<unsigned int>(*p - '0');
+    if (has_point) {
+      --digits.exponent;
+    }
+    if (taken == 0 && d == 0) {
+      continue;
+    }
+    ++significant;
+    if (taken < max_digits) {
+      w = w * 10 + d;
+      ++taken;
+    } else if (d != 0) {
+      truncated = true;
+    }
+  }
+  digits.last = p;
+  if (digits.last - digits.first == has_point) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  // The exponent is required in scientific format, and optional in general.
+  if ((fmt & chars_format::scientific) == chars_format::scientific) {
+    bool has_exponent = false;
+    if (p != last && (*p == 'e' || *p == 'E')) {
+      const char* e = p + 1;
+      bool const negative_exponent = e != last && *e == '-';
+      if (e != last && (*e == '-' || *e == '+')) {
+        ++e;
+      }
+      if (e != last && detail::is_digit(*e)) {
+        long long exponent = 0;
+        for (; e != last && detail::is_digit(*e); ++e) {
+          if (exponent < 100000000) {
+            exponent = exponent * 10 + (*e - '0');
+          }
+        }
+        digits.exponent += negative_exponent ? -exponent : exponent;
+        has_exponent = true;
+        p = e;
+      }
+    }
+    if (!has_exponent && fmt == chars_format::scientific) {
+      return {first, std::errc::invalid_argument};
+    }
+  }
+
+  if (w == 0) {
+    value = detail::make_float<T>(negative, 0);
+    return {p, std::errc()};
+  }
+
+  long long const exponent = digits.exponent + significant - taken;
+  int const q = exponent < -100000 ? -100000
+                                   : exponent > 100000
+                                         ? 100000
+                                         : static_cast<int>(exponent);
+  adjusted_mantissa am = detail::compute_float<T>(q, w);
+  if (truncated && !(am == detail::compute_float<T>(q, w + 1))) {
+    am = detail::compare_halfway<T>(digits, am);
+  }
+
+  int const infinite_power = (1 << traits::exponent_bits) - 1;
+  if (am.power2 >= infinite_power || (am.power2 == 0 && am.mantissa == 0)) {
+    return {p, std::errc::result_out_of_range};
+  }
+  value = detail::make_float<T>(
+      negative,
+      (static_cast<std::uint64_t>(am.power2) << traits::significand_bits) |
+          am.mantissa);
+  return {p, std::errc()};
+}
+
+template <typename T>
+from_chars_result from_chars_hex(const char* first,
+                                 const char* p,
+                                 const char* last,
+                                 bool negative,
+                                 T& value) noexcept {
+  using traits = float_traits<T>;
+  int const max_nibbles = 15;
+
+  std::uint64_t m = 0;
+  int taken = 0;
+  long long exponent = 0;
+  bool sticky = false;
+
+  const char* const digits = p;
+  bool has_point = false;
+  for (;; ++p) {
+    if (p != last && *p == '.' && !has_point) {
+      has_point = true;
+      continue;
+    }
+    unsigned int const d = p != last ? detail::char_digit(*p) : 16;
+    if (d >= 16) {
+      break;
+    }
+    if (m == 0 && d == 0) {
+      exponent -= has_point ? 4 : 0;
+    } else if (taken < max_nibbles) {
+      m = (m << 4) | d;
+      ++taken;
+      exponent -= has_point ? 4 : 0;
+    } else {
+      sticky |= d != 0;
+      exponent += has_point ? 0 : 4;
+    }
+  }
+  if (p - digits == has_point) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  if (p != last && (*p == 'p' || *p == 'P')) {
+    const char* e = p + 1;
+    bool const negative_exponent = e != last && *e == '-';
+    if (e != last && (*e == '-' || *e == '+')) {
+      ++e;
+    }
+    if (e != last && detail::is_digit(*e)) {
+      long long x = 0;
+      for (; e != last && detail::is_digit(*e); ++e) {
+        if (x < 100000000) {
+          x = x * 10 + (*e - '0');
+        }
+      }
+      exponent += negative_exponent ? -x : x;
+      p = e;
+    }
+  }
+
+  if (m == 0) {
+    value = detail::make_float<T>(negative, 0);
+    return {p, std::errc()};
+  }
+
+  // `m * 2^exponent` is in `[2^top, 2^(top + 1))`.
+  int const length = slb::bit_width(m);
+  long long const top = exponent + length - 1;
+  int const min_exponent = 1 - traits::exponent_bias - traits::significand_bits;
+  if (top > traits::exponent_bias || top < min_exponent - 1) {
+    return {p, std::errc::result_out_of_range};
+  }
+
+  // Round to a multiple of `2^unit`, to nearest and ties to even.
+  int const unit = top - traits::significand_bits > min_exponent
+                       ? static_cast<int>(top) - traits::significand_bits
+                       : min_exponent;
+  int const shift = unit - static_cast<int>(exponent);
+  std::uint64_t significand;
+  if (shift <= 0) {
+    significand = m << -shift;
+  } else {
+    significand = m >> shift;
+    std::uint64_t const rest = m & ((std::uint64_t(1) << shift) - 1);
+    std::uint64_t const half = std::uint64_t(1) << (shift - 1);
+    if (rest > half || (rest == half && (sticky || (significand & 1) != 0))) {
+      ++significand;
+    }
+  }
+
+  // A significand carried into the next binade increments the exponent.
+  std::uint64_t const magnitude =
+      significand + (static_cast<std::uint64_t>(unit - min_exponent)
+                     << traits::significand_bits);
+  std::uint64_t const infinity =
+      static_cast<std::uint64_t>((1 << traits::exponent_bits) - 1)
+      << traits::significand_bits;
+  if (magnitude >= infinity || magnitude == 0) {
+    return {p, std::errc::result_out_of_range};
+  }
+  value = detail::make_float<T>(negative, magnitude);
+  return {p, std::errc()};
+}
+
+template <typename T>
+from_chars_result from_chars_float(const char* first,
+                                   const char* last,
+                                   T& value,
+                                   chars_format fmt) noexcept {
+  const char* p = first;
+  bool const negative = p != last && *p == '-';
+  if (negative) {
+    ++p;
+  }
+
+  if (detail::match_ignore_case(p, last, "inf")) {
+    p += 3;
+    if (detail::match_ignore_case(p, last, "inity")) {
+      p += 5;
+    }
+    value = negative ? -std::numeric_limits<T>::infinity()
+                     : std::numeric_limits<T>::infinity();
+    return {p, std::errc()};
+  }
+  if (detail::match_ignore_case(p, last, "nan")) {
+    p += 3;
+    if (p != last && *p == '(') {
+      const char* s = p + 1;
+      for (; s != last && (detail::char_digit(*s) < 36 || *s == '_'); ++s) {
+      }
+      if (s != last && *s == ')') {
+        p = s + 1;
+      }
+    }
+    value = negative ? -std::numeric_limits<T>::quiet_NaN()
+                     : std::numeric_limits<T>::quiet_NaN();
+    return {p, std::errc()};
+  }
+
+  if (fmt == chars_format::hex) {
+    return detail::from_chars_hex(first, p, last, negative, value);
+  }
+  return detail::from_chars_decimal(first, p, last, negative, value, fmt);
+}
+
+} // namespace detail
+
+template <typename T>
+typename std::enable_if<detail::is_charconv_integer<T>::value,
+                        to_chars_result>::type
+to_chars(char* first, char* last, T value, int base = 10) {
+  return detail::to_chars_integer(
+      std::is_signed<T>{}, first, last, value, base);
+}
+
+to_chars_result to_chars(char* first,
+                         char* last,
+                         bool value,
+                         int base = 10) = delete;
+
+// Without a `chars_format`, the shortest of the fixed and scientific
+// representations is produced.
+inline to_chars_result to_chars(char* first, char* last, float value) {
+  return detail::to_chars_float(first, last, value, chars_format{});
+}
+
+inline to_chars_result to_chars(char* first, char* last, double value) {
+  return detail::to_chars_float(first, last, value, chars_format{});
+}
+
+inline to_chars_result to_chars(char* first,
+                                char* last,
+                                float value,
+                                chars_format fmt) {
+  return detail::to_chars_float(first, last, value, fmt);
+}
+
+inline to_chars_result to_chars(char* first,
+                                char* last,
+                                double value,
+                                chars_format fmt) {
+  return detail::to_chars_float(first, last, value, fmt);
+}
+
+template <typename T>
+typename std::enable_if<detail::is_charconv_integer<T>::value,
+                        from_chars_result>::type
+from_chars(const char* first, const char* last, T& value, int base = 10) {
+  return detail::from_chars_integer(first, last, value, base);
+}
+
+inline from_chars_result from_chars(const char* first,
+                                    const char* last,
+                                    float& value,
+                                    chars_format fmt = chars_format::general) {
+  return detail::from_chars_float(first, last, value, fmt);
+}
+
+inline from_chars_result from_chars(const char* first,
+                                    const char* last,
+                                    double& value,
+                                    chars_format fmt = chars_format::general) {
+  return detail::from_chars_float(first, last, value, fmt);
+}
+#endif
+
+} // namespace slb
+
+#endif // SLB_CHARCONV_HPP
@@ -0,0 +1,256 @@
+/*
+  SLB.CpuFeatures
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_CPU_FEATURES_HPP
+#define SLB_CPU_FEATURES_HPP
+
+/*
+
+Header <slb/cpu_features.hpp> synopsis
+
+namespace slb {
+  enum class cpu_feature : unsigned {
+    sse2, sse3, ssse3, sse4_1, sse4_2, popcnt, avx, avx2, fma, bmi1, bmi2,
+    avx512f, avx512dq, avx512cd, avx512bw, avx512vl
+  };
+
+  class cpu_features {
+  public:
+    constexpr cpu_features() noexcept;
+
+    static const cpu_features& get() noexcept;
+
+    constexpr bool has(cpu_feature f) const noexcept;
+    void set(cpu_feature f, bool value = true) noexcept;
+  };
+
+  template<class Signature,
+           Signature* (*Resolve)(const cpu_features&)>
+    struct cpu_dispatch;
+
+  template<class R, class... Args,
+           R (*(*Resolve)(const cpu_features&))(Args...)>
+    struct cpu_dispatch<R(Args...), Resolve> {
+      using function_type = R(Args...);
+
+      static function_type* resolve() noexcept;
+      static R call(Args... args);
+      R operator()(Args... args) const;
+    };
+}
+
+*/
+
+#include <atomic>
+#include <cstdint>
+
+#include "detail/config.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) ||            \
+    defined(_M_IX86)
+#define SLB_HAS_CPUID 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define SLB_HAS_CPUID 0
+#endif
+
+namespace slb {
+
+// The instruction set extensions that can be queried at runtime. The ones
+// that use the AVX or AVX-512 register state are only reported when the
+// operating system saves that state on context switches.
+enum class cpu_feature : unsigned {
+  sse2,
+  sse3,
+  ssse3,
+  sse4_1,
+  sse4_2,
+  popcnt,
+  avx,
+  avx2,
+  fma,
+  bmi1,
+  bmi2,
+  avx512f,
+  avx512dq,
+  avx512cd,
+  avx512bw,
+  avx512vl
+};
+
+namespace detail {
+
+constexpr std::uint32_t cpu_feature_bit(cpu_feature f) noexcept {
+  return std::uint32_t(1) << static_cast<unsigned>(f);
+}
+
+#if SLB_HAS_CPUID
+struct cpuid_result {
+  std::uint32_t eax, ebx, ecx, edx;
+};
+
+inline cpuid_result cpuid(unsigned leaf, unsigned subleaf) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int regs[4];
+  __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+  return {static_cast<std::uint32_t>(regs[0]),
+          static_cast<std::uint32_t>(regs[1]),
+          static_cast<std::uint32_t>(regs[2]),
+          static_cast<std::uint32_t>(regs[3])};
+#else
+  unsigned eax, ebx, ecx, edx;
+  __cpuid_count(leaf, subleaf, eax, ebx, ecx, edx);
+  return {eax, ebx, ecx, edx};
+#endif
+}
+
+// The register state enabled by the operating system, as reported by
+// `XGETBV`; requires `OSXSAVE`.
+inline std::uint64_t xgetbv() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+  return _xgetbv(0);
+#else
+  unsigned eax, edx;
+  __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+inline std::uint32_t detect_cpu_features() noexcept {
+  std::uint32_t features = 0;
+  auto const test = [&](std::uint32_t reg, int bit, cpu_feature f) {
+    if ((reg >> bit) & 1) {
+      features |= detail::cpu_feature_bit(f);
+    }
+  };
+
+  unsigned const max_leaf = detail::cpuid(0, 0).eax;
+  if (max_leaf < 1) {
+    return features;
+  }
+
+  cpuid_result const leaf1 = detail::cpuid(1, 0);
+  test(leaf1.edx, 26, cpu_feature::sse2);
+  test(leaf1.ecx, 0, cpu_feature::sse3);
+  test(leaf1.ecx, 9, cpu_feature::ssse3);
+  test(leaf1.ecx, 19, cpu_feature::sse4_1);
+  test(leaf1.ecx, 20, cpu_feature::sse4_2);
+  test(leaf1.ecx, 23, cpu_feature::popcnt);
+
+  // XCR0 bits 1 and 2 are the SSE and AVX state; bits 5 to 7 are the
+  // AVX-512 opmask and upper register state.
+  std::uint64_t const xcr0 = ((leaf1.ecx >> 27) & 1) ? detail::xgetbv() : 0;
+  bool const os_avx = (xcr0 & 0x06) == 0x06;
+  bool const os_avx512 = (xcr0 & 0xE6) == 0xE6;
+  if (os_avx) {
+    test(leaf1.ecx, 28, cpu_feature::avx);
+    test(leaf1.ecx, 12, cpu_feature::fma);
+  }
+
+  if (max_leaf < 7) {
+    return features;
+  }
+
+  cpuid_result const leaf7 = detail::cpuid(7, 0);
+  test(leaf7.ebx, 3, cpu_feature::bmi1);
+  test(leaf7.ebx, 8, cpu_feature::bmi2);
+  if (os_avx) {
+    test(leaf7.ebx, 5, cpu_feature::avx2);
+  }
+  if (os_avx512) {
+    test(leaf7.ebx, 16, cpu_feature::avx512f);
+    test(leaf7.ebx, 17, cpu_feature::avx512dq);
+    test(leaf7.ebx, 28, cpu_feature::avx512cd);
+    test(leaf7.ebx, 30, cpu_feature::avx512bw);
+    test(leaf7.ebx, 31, cpu_feature::avx512vl);
+  }
+  return features;
+}
+#else
+inline std::uint32_t detect_cpu_features() noexcept { return 0; }
+#endif
+
+} // namespace detail
+
+class cpu_features {
+public:
+  constexpr cpu_features() noexcept : bits_(0) {}
+
+  // The features of the executing processor, detected on the first call.
+  static cpu_features const& get() noexcept {
+    static cpu_features const features(detail::detect_cpu_features());
+    return features;
+  }
+
+  constexpr bool has(cpu_feature f) const noexcept {
+    return (bits_ & detail::cpu_feature_bit(f)) != 0;
+  }
+
+  void set(cpu_feature f, bool value = true) noexcept {
+    bits_ = value ? bits_ | detail::cpu_feature_bit(f)
+                  : bits_ & ~detail::cpu_feature_bit(f);
+  }
+
+private:
+  explicit cpu_features(std::uint32_t bits) noexcept : bits_(bits) {}
+
+  std::uint32_t bits_;
+};
+
+// Calls the implementation that `Resolve` selects for the features of the
+// executing processor. The selection happens on the first call, which then
+// replaces the entry point, so that every later call is a single indirect
+// call through a constant-initialized pointer.
+template <typename Signature, Signature* (*Resolve)(cpu_features const&)>
+struct cpu_dispatch;
+
+template <typename R,
+          typename... Args,
+          R (*(*Resolve)(cpu_features const&))(Args...)>
+struct cpu_dispatch<R(Args...), Resolve> {
+  using function_type = R(Args...);
+
+  static function_type* resolve() noexcept {
+    function_type* const fn = Resolve(cpu_features::get());
+    // Any thread that races here stores the same value.
+    entry_.store(fn, std::memory_order_relaxed);
+    return fn;
+  }
+
+  static R call(Args... args) {
+    return entry_.load(std::memory_order_relaxed)(
+        static_cast<Args&&>(args)...);
+  }
+
+  R operator()(Args... args) const {
+    return cpu_dispatch::call(static_cast<Args&&>(args)...);
+  }
+
+private:
+  static R first_call(Args... args) {
+    return cpu_dispatch::resolve()(static_cast<Args&&>(args)...);
+  }
+
+  static std::atomic<function_type*> entry_;
+};
+
+template <typename R,
+          typename... Args,
+          R (*(*Resolve)(cpu_features const&))(Args...)>
+std::atomic<R (*)(Args...)> cpu_dispatch<R(Args...), Resolve>::entry_{
+    &cpu_dispatch<R(Args...), Resolve>::first_call};
+
+} // namespace slb
+
+#endif // SLB_CPU_FEATURES_HPP
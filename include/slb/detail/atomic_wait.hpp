@@ -0,0 +1,293 @@
+/*
+  SLB.Detail.AtomicWait
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_DETAIL_ATOMIC_WAIT_HPP
+#define SLB_DETAIL_ATOMIC_WAIT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#include "../cache_padded.hpp"
+#include "config.hpp"
+
+// Linux blocks on a 32-bit word with the `futex` system call; elsewhere, the
+// waiters park on a condition variable from a small table keyed by address.
+#if defined(__linux__)
+#define SLB_HAS_FUTEX 1
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#define SLB_HAS_FUTEX 0
+#include <condition_variable>
+#include <mutex>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__) &&                                \
+    (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace slb {
+namespace detail {
+
+// Hints to the processor that the caller is in a spin-wait loop.
+inline void cpu_relax() noexcept {
+#if (defined(__GNUC__) || defined(__clang__)) &&                               \
+    (defined(__x86_64__) || defined(__i386__))
+  __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+  __asm__ __volatile__("yield");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_pause();
+#endif
+}
+
+// Polls `pred` before the caller blocks in the kernel: first between runs of
+// spin-wait hints that double in length, then by yielding the time slice. A
+// handoff between running threads completes within this phase, without a
+// system call on either side.
+template <typename Pred>
+bool atomic_spin(Pred pred) {
+  for (int spins = 1; spins <= 32; spins *= 2) {
+    if (pred()) {
+      return true;
+    }
+    for (int i = 0; i < spins; ++i) {
+      detail::cpu_relax();
+    }
+  }
+  for (int i = 0; i < 4; ++i) {
+    if (pred()) {
+      return true;
+    }
+    std::this_thread::yield();
+  }
+  return pred();
+}
+
+// Blocks while `a` holds `old`, until a call to `platform_notify` on `a`, or
+// for at most `rel_time`. May return spuriously.
+template <typename T>
+void platform_wait(std::atomic<T> const& a, T old);
+
+template <typename T>
+void platform_wait_for(std::atomic<T> const& a,
+                       T old,
+                       std::chrono::nanoseconds rel_time);
+
+// Wakes up to `count` of the threads blocked on `a`.
+template <typename T>
+void platform_notify(std::atomic<T> const& a, int count);
+
+#if SLB_HAS_FUTEX
+inline long futex(void const* addr,
+                  int op,
+                  std::uint32_t value,
+                  struct timespec const* timeout = nullptr) noexcept {
+  return syscall(SYS_futex, addr, op, value, timeout, nullptr, 0);
+}
+
+template <typename T>
+std::uint32_t futex_word(T value) noexcept {
+  static_assert(sizeof(T) == 4, "a futex is a 32-bit word");
+  std::uint32_t word;
+  std::memcpy(&word, &value, sizeof(word));
+  return word;
+}
+
+template <typename T>
+void platform_wait(std::atomic<T> const& a, T old) {
+  detail::futex(&a, FUTEX_WAIT_PRIVATE, detail::futex_word(old));
+}
+
+template <typename T>
+void platform_wait_for(std::atomic<T> const& a,
+                       T old,
+                       std::chrono::nanoseconds rel_time) {
+  if (rel_time.count() <= 0) {
+    return;
+  }
+  std::chrono::seconds const secs =
+      std::chrono::duration_cast<std::chrono::seconds>(rel_time);
+  struct timespec timeout;
+  timeout.tv_sec = static_cast<time_t>(secs.count());
+  timeout.tv_nsec = static_cast<long>((rel_time - secs).count());
+  detail::futex(&a, FUTEX_WAIT_PRIVATE, detail::futex_word(old), &timeout);
+}
+
+template <typename T>
+void platform_notify(std::atomic<T> const& a, int count) {
+  detail::futex(&a, FUTEX_WAKE_PRIVATE, static_cast<std::uint32_t>(count));
+}
+#else
+struct wait_bucket {
+  std::mutex mutex;
+  std::condition_variable cv;
+};
+
+inline wait_bucket& wait_bucket_for(void const* addr) noexcept {
+  enum : std::size_t { bucket_count = 16 };
+  static wait_bucket buckets[bucket_count];
+  std::uintptr_t const key = reinterpret_cast<std::uintptr_t>(addr);
+  return buckets[(key >> 4) % bucket_count];
+}
+
+template <typename T>
+void platform_wait(std::atomic<T> const& a, T old) {
+  wait_bucket& bucket = detail::wait_bucket_for(&a);
+  std::unique_lock<std::mutex> lock(bucket.mutex);
+  if (a.load(std::memory_order_relaxed) == old) {
+    bucket.cv.wait(lock);
+  }
+}
+
+template <typename T>
+void platform_wait_for(std::atomic<T> const& a,
+                       T old,
+                       std::chrono::nanoseconds rel_time) {
+  wait_bucket& bucket = detail::wait_bucket_for(&a);
+  std::unique_lock<std::mutex> lock(bucket.mutex);
+  if (a.load(std::memory_order_relaxed) == old) {
+    bucket.cv.wait_for(lock, rel_time);
+  }
+}
+
+// The bucket may be shared with unrelated waiters, so all of them are woken.
+// Taking the lock orders the notification after any waiter that saw the old
+// value has started waiting.
+template <typename T>
+void platform_notify(std::atomic<T> const& a, int /*count*/) {
+  wait_bucket& bucket = detail::wait_bucket_for(&a);
+  { std::lock_guard<std::mutex> lock(bucket.mutex); }
+  bucket.cv.notify_all();
+}
+#endif
+
+// The threads blocked on objects that hash to the same bucket share its
+// count, so that a notification makes a system call only when some thread
+// may be blocked. The kernel waits on 32-bit objects directly; any other
+// object is waited on through the version of its bucket, which every
+// notification on the bucket increments.
+struct waiter_bucket {
+  std::atomic<std::uint32_t> version;
+  std::atomic<int> waiters;
+};
+
+inline waiter_bucket& waiter_bucket_for(void const* addr) noexcept {
+  enum : std::size_t { bucket_count = 32 };
+  static cache_padded<waiter_bucket> buckets[bucket_count];
+  std::uintptr_t const key = reinterpret_cast<std::uintptr_t>(addr);
+  return *buckets[((key >> 2) ^ (key >> 9)) % bucket_count];
+}
+
+// Whether a thread waiting for `Object`, holding a `T`, blocks on the object
+// itself.
+template <typename Object, typename T>
+struct atomic_wait_direct
+    : std::integral_constant<bool,
+                             SLB_HAS_FUTEX && sizeof(Object) == 4 &&
+                                 sizeof(T) == 4> {};
+
+#if SLB_HAS_FUTEX
+template <typename Object, typename T, typename Changed>
+void atomic_wait_block(Object const* object,
+                       T const& old,
+                       waiter_bucket&,
+                       Changed changed,
+                       std::true_type) {
+  std::uint32_t const word = detail::futex_word(old);
+  while (!changed()) {
+    detail::futex(object, FUTEX_WAIT_PRIVATE, word);
+  }
+}
+
+template <typename Object>
+void atomic_notify_block(Object const* object,
+                         waiter_bucket&,
+                         bool all,
+                         std::true_type) {
+  detail::futex(object, FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1);
+}
+#endif
+
+template <typename Object, typename T, typename Changed>
+void atomic_wait_block(Object const*,
+                       T const&,
+                       waiter_bucket& bucket,
+                       Changed changed,
+                       std::false_type) {
+  for (;;) {
+    std::uint32_t const version =
+        bucket.version.load(std::memory_order_seq_cst);
+    if (changed()) {
+      return;
+    }
+    detail::platform_wait(bucket.version, version);
+  }
+}
+
+template <typename Object>
+void atomic_notify_block(Object const*,
+                         waiter_bucket& bucket,
+                         bool,
+                         std::false_type) {
+  detail::platform_notify(bucket.version, INT_MAX);
+}
+
+// Blocks until the value representation of `load()` differs from that of
+// `old`.
+template <typename Object, typename T, typename Load>
+void atomic_wait_address(Object const* object, T const& old, Load load) {
+  auto const changed = [&old, &load] {
+    T const current = load();
+    return std::memcmp(std::addressof(current),
+                       std::addressof(old),
+                       sizeof(T)) != 0;
+  };
+  if (detail::atomic_spin(changed)) {
+    return;
+  }
+
+  waiter_bucket& bucket = detail::waiter_bucket_for(object);
+  bucket.waiters.fetch_add(1, std::memory_order_seq_cst);
+  detail::atomic_wait_block(
+      object, old, bucket, changed, atomic_wait_direct<Object, T>{});
+  bucket.waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// Unblocks one or all of the threads waiting on `object`. Unblocking through
+// the bucket's version wakes all of its waiters, which then check their own
+// objects.
+template <typename T, typename Object>
+void atomic_notify_address(Object const* object, bool all) {
+  using direct = atomic_wait_direct<Object, T>;
+  waiter_bucket& bucket = detail::waiter_bucket_for(object);
+  // Together with the increment of `waiters` by a blocking thread, at least
+  // one side sees the other's write. Direct waiters don't use the version,
+  // but its increment also orders the caller's store for them.
+  bucket.version.fetch_add(1, std::memory_order_seq_cst);
+  if (bucket.waiters.load(std::memory_order_seq_cst) != 0) {
+    detail::atomic_notify_block(object, bucket, all, direct{});
+  }
+}
+
+} // namespace detail
+} // namespace slb
+
+#endif // SLB_DETAIL_ATOMIC_WAIT_HPP
@@ -57,4 +57,59 @@
 #define SLB_CXX17_INLINE_VARIABLE
 #endif
 
+// `__builtin_is_constant_evaluated`, which implements the C++20
+// `std::is_constant_evaluated`, is available in all language modes.
+#if __has_builtin(__builtin_is_constant_evaluated) ||                          \
+    (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) ||             \
+    (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define SLB_HAS_IS_CONSTANT_EVALUATED 1
+#else
+#define SLB_HAS_IS_CONSTANT_EVALUATED 0
+#endif
+
+// SSE2 is part of the x86-64 baseline, and can be enabled for 32-bit x86.
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SLB_HAS_SSE2 1
+#else
+#define SLB_HAS_SSE2 0
+#endif
+
+// GCC and Clang provide generic vector types, declared with the `vector_size`
+// attribute, that support element-wise operators and subscripting.
+#if defined(__GNUC__) || defined(__clang__)
+#define SLB_HAS_VECTOR_EXTENSIONS 1
+#else
+#define SLB_HAS_VECTOR_EXTENSIONS 0
+#endif
+
+// `SLB_INLINE_CASTS`: When nonzero (the default), `forward` and `move` are
+// spelled as plain casts within the library, and the casts SLB provides itself
+// are forcibly inlined, so that unoptimized builds don't emit a call for each.
+// Define it to `0` to go through the function templates instead.
+#ifndef SLB_INLINE_CASTS
+#define SLB_INLINE_CASTS 1
+#endif
+
+#if SLB_INLINE_CASTS
+#if defined(__GNUC__) || defined(__clang__)
+#define SLB_INLINE_CAST __attribute__((__always_inline__)) inline
+#elif defined(_MSC_VER)
+#define SLB_INLINE_CAST __forceinline
+#else
+#define SLB_INLINE_CAST inline
+#endif
+
+#define SLB_FORWARD(T, ...) static_cast<T&&>(__VA_ARGS__)
+#define SLB_MOVE(...)                                                          \
+  static_cast<                                                                 \
+      typename std::remove_reference<decltype((__VA_ARGS__))>::type&&>(        \
+      __VA_ARGS__)
+#else
+#define SLB_INLINE_CAST inline
+
+#define SLB_FORWARD(T, ...) std::forward<T>(__VA_ARGS__)
+#define SLB_MOVE(...) std::move(__VA_ARGS__)
+#endif
+
 #endif // SLB_DETAIL_CONFIG_HPP
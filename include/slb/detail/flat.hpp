@@ -0,0 +1,103 @@
+/*
+  SLB.Detail.Flat
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_DETAIL_FLAT_HPP
+#define SLB_DETAIL_FLAT_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "config.hpp"
+#include "lib.hpp"
+
+#if __has_include(<flat_map>)
+#include <flat_map>
+#endif
+#if __has_include(<flat_set>)
+#include <flat_set>
+#endif
+
+namespace slb {
+
+// Shared by `<flat_map>` and `<flat_set>`.
+#if __cpp_lib_flat_map || __cpp_lib_flat_set // C++23
+using std::sorted_unique_t;
+using std::sorted_unique;
+#else
+struct sorted_unique_t {
+  explicit sorted_unique_t() = default;
+};
+
+SLB_CXX17_INLINE_VARIABLE constexpr sorted_unique_t sorted_unique{};
+#endif
+
+namespace detail {
+
+template <typename Compare, typename = void>
+struct is_transparent : std::false_type {};
+
+template <typename Compare>
+struct is_transparent<
+    Compare,
+    typename lib::always_void<typename Compare::is_transparent>::type>
+    : std::true_type {};
+
+// Depends on `K` so that member templates of the flat containers are
+// SFINAE-constrained on it, rather than rejected as the class is instantiated.
+template <typename Compare, typename K>
+struct is_transparent_for : is_transparent<Compare> {};
+
+template <typename Compare, typename K>
+using enable_if_transparent =
+    typename std::enable_if<is_transparent_for<Compare, K>::value>::type;
+
+// Binary searches over the sorted keys of the flat containers. Each step
+// halves the range without branching on the outcome of the comparison, which
+// compiles to a conditional move rather than a hard-to-predict branch, and the
+// number of steps depends only on the size of the range.
+template <typename RandomIt, typename K, typename Compare>
+RandomIt flat_lower_bound(RandomIt first,
+                          RandomIt last,
+                          K const& key,
+                          Compare const& comp) {
+  auto n = last - first;
+  if (n == 0) {
+    return first;
+  }
+  while (n > 1) {
+    auto const half = n / 2;
+    first = comp(first[half], key) ? first + half : first;
+    n -= half;
+  }
+  return comp(*first, key) ? first + 1 : first;
+}
+
+template <typename RandomIt, typename K, typename Compare>
+RandomIt flat_upper_bound(RandomIt first,
+                          RandomIt last,
+                          K const& key,
+                          Compare const& comp) {
+  auto n = last - first;
+  if (n == 0) {
+    return first;
+  }
+  while (n > 1) {
+    auto const half = n / 2;
+    first = comp(key, first[half]) ? first : first + half;
+    n -= half;
+  }
+  return comp(key, *first) ? first : first + 1;
+}
+
+} // namespace detail
+} // namespace slb
+
+#endif // SLB_DETAIL_FLAT_HPP
@@ -34,110 +34,22 @@ struct ref_tag {};
 struct ref_wrapper_tag {};
 struct ptr_tag {};
 
-template <typename C, typename T, typename Enable = void>
-struct dispatch_mem_ptr;
-
 // `ref_tag` when `pm` is a pointer to member of a class `C` and
 // `is_base_of_v<C, remove_reference_t<T>>` is `true`;
-template <typename C, typename T>
-struct dispatch_mem_ptr<
-    C,
-    T,
-    typename std::enable_if<
-        std::is_base_of<C, typename std::remove_reference<T>::type>::value>::
-        type> {
-  using type = ref_tag;
-};
-
 // `ref_wrapper_tag` when `pm` is a pointer to member of a class `C` and
 // `remove_cvref_t<T>` is a specialization of `reference_wrapper`;
-template <typename C, typename T>
-struct dispatch_mem_ptr<
-    C,
-    T,
-    typename std::enable_if<is_reference_wrapper<
-        typename detail::lib::remove_cvref<T>::type>::value>::type> {
-  using type = ref_wrapper_tag;
-};
-
 // `ptr_tag` when `pm` is a pointer to member of a class `C` and `T` does not
 // satisfy the previous two items;
-template <typename C, typename T, typename Enable>
-struct dispatch_mem_ptr {
-  using type = ptr_tag;
-};
-
-////////////////////////////////////////////////////////////////////////////////
-template <typename Tag, typename T, typename Enable = void>
-struct mem_obj_ptr_result {};
-
-template <typename F, typename T1>
-struct mem_obj_ptr_result<ref_tag,
-                          F(T1),
-                          decltype(
-                              (void)(std::declval<T1>().*std::declval<F&>()))> {
-  using type = decltype(std::declval<T1>().*std::declval<F&>());
-};
-
-template <typename F, typename T1>
-struct mem_obj_ptr_result<ref_wrapper_tag,
-                          F(T1),
-                          decltype((void)(std::declval<T1>().get().*
-                                          std::declval<F&>()))> {
-  using type = decltype(std::declval<T1>().get().*std::declval<F&>());
-};
-
-template <typename F, typename T1>
-struct mem_obj_ptr_result<ptr_tag,
-                          F(T1),
-                          decltype((void)((*std::declval<T1>()).*
-                                          std::declval<F&>()))> {
-  using type = decltype((*std::declval<T1>()).*std::declval<F&>());
-};
-
-////////////////////////////////////////////////////////////////////////////////
-template <typename T>
-class mem_obj_ptr;
-
-template <typename T, typename C>
-class mem_obj_ptr<T C::*> {
-  T C::*pm;
-
-private:
-  // `t1.*pm` when `N == 1` and `pm` is a pointer to data member of a class `C`
-  // and `is_base_of_v<C, remove_reference_t<decltype(t1)>>` is `true`;
-  template <typename R, typename T1>
-  static constexpr R call(ref_tag, T C::*pm, T1&& t1) noexcept {
-    return std::forward<T1>(t1).*pm;
-  }
-
-  // `t1.get().*pm` when `N == 1` and `pm` is a pointer to data member of a
-  // class `C` and `remove_cvref_t<decltype(t1)>` is a specialization of
-  // `reference_wrapper`;
-  template <typename R, typename T1>
-  static constexpr R call(ref_wrapper_tag, T C::*pm, T1&& t1) noexcept {
-    return t1.get().*pm;
-  }
-
-  // `(*t1).*pm` when `N == 1` and `pm` is a pointer to data member of a class
-  // `C` and `t1` does not satisfy the previous two items;
-  template <typename R, typename T1>
-  static constexpr R
-  call(ptr_tag, T C::*pm, T1&& t1) noexcept(noexcept(*std::forward<T1>(t1))) {
-    return (*std::forward<T1>(t1)).*pm;
-  }
-
-public:
-  constexpr mem_obj_ptr(T C::*pm) noexcept : pm(pm) {}
-
-  template <typename T1,
-            typename Tag = typename dispatch_mem_ptr<C, T1>::type,
-            typename R = typename mem_obj_ptr_result<Tag, T C::*(T1&&)>::type>
-  constexpr R operator()(T1&& t1) const
-      noexcept(noexcept(call<R>(Tag{}, pm, std::forward<T1>(t1)))) {
-    return call<R>(Tag{}, pm, std::forward<T1>(t1));
-  }
-};
+template <typename C,
+          typename T,
+          typename U = typename std::remove_reference<T>::type>
+using dispatch_mem_ptr = typename std::conditional<
+    std::is_base_of<C, U>::value,
+    ref_tag,
+    typename std::conditional<
+        is_reference_wrapper<typename std::remove_cv<U>::type>::value,
+        ref_wrapper_tag,
+        ptr_tag>::type>::type;
 
 ////////////////////////////////////////////////////////////////////////////////
 template <typename F, typename T1>
@@ -205,134 +117,146 @@ struct apply_clang_workaround<C, R(Args..., ...), T1>
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
-template <typename Tag, typename T, typename Enable = void>
-struct mem_fun_ptr_result {};
-
-template <typename F, typename T1, typename... Tn>
-struct mem_fun_ptr_result<ref_tag,
-                          F(T1, Tn...),
-                          decltype(
-                              (void)((std::declval<T1>().*std::declval<F&>())(
-                                  std::declval<Tn>()...)))> {
-  using type =
-      decltype((std::declval<T1>().*std::declval<F&>())(std::declval<Tn>()...));
-};
+// The member pointer cases are overloaded on whether `pm` is a pointer to
+// member function, and on how `t1` is applied to it, so that a call reaches
+// the `.*` expression without going through intermediate class templates.
+
+// `(t1.*pm)(t2, ..., tN)` when `pm` is a pointer to a member function of a
+// class `C` and `is_base_of_v<C, remove_reference_t<decltype(t1)>>` is
+// `true`;
+template <typename T,
+          typename C,
+          typename T1,
+          typename... Tn,
+          typename PT1 = typename p0704<T, T1>::type,
+          typename = typename apply_clang_workaround<C, T, T1>::type>
+constexpr auto
+invoke_mem_ptr(std::true_type, ref_tag, T C::*pm, T1&& t1, Tn&&... tn) noexcept(
+    noexcept((SLB_FORWARD(PT1, t1).*pm)(SLB_FORWARD(Tn, tn)...)))
+    -> decltype((SLB_FORWARD(PT1, t1).*pm)(SLB_FORWARD(Tn, tn)...)) {
+  return (SLB_FORWARD(PT1, t1).*pm)(SLB_FORWARD(Tn, tn)...);
+}
 
-template <typename F, typename T1, typename... Tn>
-struct mem_fun_ptr_result<ref_wrapper_tag,
-                          F(T1, Tn...),
-                          decltype((void)((std::declval<T1>().get().*
-                                           std::declval<F&>())(
-                              std::declval<Tn>()...)))> {
-  using type = decltype(
-      (std::declval<T1>().get().*std::declval<F&>())(std::declval<Tn>()...));
-};
+// `(t1.get().*pm)(t2, ..., tN)` when `pm` is a pointer to a member function
+// of a class `C` and `remove_cvref_t<decltype(t1)>` is a specialization of
+// `reference_wrapper`;
+template <typename T, typename C, typename T1, typename... Tn>
+constexpr auto invoke_mem_ptr(std::true_type,
+                              ref_wrapper_tag,
+                              T C::*pm,
+                              T1&& t1,
+                              Tn&&... tn) noexcept(
+    noexcept((t1.get().*pm)(SLB_FORWARD(Tn, tn)...)))
+    -> decltype((t1.get().*pm)(SLB_FORWARD(Tn, tn)...)) {
+  return (t1.get().*pm)(SLB_FORWARD(Tn, tn)...);
+}
 
-template <typename F, typename T1, typename... Tn>
-struct mem_fun_ptr_result<ptr_tag,
-                          F(T1, Tn...),
-                          decltype((
-                              void)(((*std::declval<T1>()).*std::declval<F&>())(
-                              std::declval<Tn>()...)))> {
-  using type = decltype(
-      ((*std::declval<T1>()).*std::declval<F&>())(std::declval<Tn>()...));
-};
+// `((*t1).*pm)(t2, ..., tN)` when `pm` is a pointer to a member function of a
+// class `C` and `t1` does not satisfy the previous two items;
+template <typename T, typename C, typename T1, typename... Tn>
+constexpr auto
+invoke_mem_ptr(std::true_type, ptr_tag, T C::*pm, T1&& t1, Tn&&... tn) noexcept(
+    noexcept(((*SLB_FORWARD(T1, t1)).*pm)(SLB_FORWARD(Tn, tn)...)))
+    -> decltype(((*SLB_FORWARD(T1, t1)).*pm)(SLB_FORWARD(Tn, tn)...)) {
+  return ((*SLB_FORWARD(T1, t1)).*pm)(SLB_FORWARD(Tn, tn)...);
+}
+
+// `t1.*pm` when `N == 1` and `pm` is a pointer to data member of a class `C`
+// and `is_base_of_v<C, remove_reference_t<decltype(t1)>>` is `true`;
+template <typename T, typename C, typename T1>
+constexpr auto
+invoke_mem_ptr(std::false_type, ref_tag, T C::*pm, T1&& t1) noexcept
+    -> decltype(SLB_FORWARD(T1, t1).*pm) {
+  return SLB_FORWARD(T1, t1).*pm;
+}
+
+// `t1.get().*pm` when `N == 1` and `pm` is a pointer to data member of a
+// class `C` and `remove_cvref_t<decltype(t1)>` is a specialization of
+// `reference_wrapper`;
+template <typename T, typename C, typename T1>
+constexpr auto invoke_mem_ptr(std::false_type,
+                              ref_wrapper_tag,
+                              T C::*pm,
+                              T1&& t1) noexcept -> decltype(t1.get().*pm) {
+  return t1.get().*pm;
+}
+
+// `(*t1).*pm` when `N == 1` and `pm` is a pointer to data member of a class
+// `C` and `t1` does not satisfy the previous two items;
+template <typename T, typename C, typename T1>
+constexpr auto
+invoke_mem_ptr(std::false_type, ptr_tag, T C::*pm, T1&& t1) noexcept(
+    noexcept(*SLB_FORWARD(T1, t1))) -> decltype((*SLB_FORWARD(T1, t1)).*pm) {
+  return (*SLB_FORWARD(T1, t1)).*pm;
+}
+
+} // namespace invoke_impl
+
+// `f(t1, t2, ..., tN)` in all other cases.
+template <typename F, typename... Args>
+constexpr auto invoke(F&& f, Args&&... args) noexcept(
+    noexcept(SLB_FORWARD(F, f)(SLB_FORWARD(Args, args)...)))
+    -> decltype(SLB_FORWARD(F, f)(SLB_FORWARD(Args, args)...)) {
+  return SLB_FORWARD(F, f)(SLB_FORWARD(Args, args)...);
+}
+
+// We don't use `std::is_function<T>` here since some libstdc++ versions fail to
+// classify function types with noexcept specifiers.
+
+template <typename T, typename C, typename T1, typename... Tn>
+constexpr auto invoke(T C::*pm, T1&& t1, Tn&&... tn) noexcept(
+    noexcept(invoke_impl::invoke_mem_ptr(
+        typename detail::lib::is_function<T>::type{},
+        invoke_impl::dispatch_mem_ptr<C, T1>{},
+        pm,
+        SLB_FORWARD(T1, t1),
+        SLB_FORWARD(Tn, tn)...)))
+    -> decltype(invoke_impl::invoke_mem_ptr(
+        typename detail::lib::is_function<T>::type{},
+        invoke_impl::dispatch_mem_ptr<C, T1>{},
+        pm,
+        SLB_FORWARD(T1, t1),
+        SLB_FORWARD(Tn, tn)...)) {
+  return invoke_impl::invoke_mem_ptr(
+      typename detail::lib::is_function<T>::type{},
+      invoke_impl::dispatch_mem_ptr<C, T1>{},
+      pm,
+      SLB_FORWARD(T1, t1),
+      SLB_FORWARD(Tn, tn)...);
+}
 
 ////////////////////////////////////////////////////////////////////////////////
+namespace invoke_impl {
+
 template <typename T>
-class mem_fun_ptr;
+class mem_fn;
 
 template <typename T, typename C>
-class mem_fun_ptr<T C::*> {
+class mem_fn<T C::*> {
   T C::*pm;
 
-private:
-  // `(t1.*pm)(t2, ..., tN)` when `pm` is a pointer to a member function of a
-  // class `C` and `is_base_of_v<C, remove_reference_t<decltype(t1)>>` is
-  // `true`;
-  template <typename R, typename T1, typename... Tn>
-  static constexpr R call(ref_tag, T C::*pm, T1&& t1, Tn&&... tn) noexcept(
-      noexcept((std::forward<T1>(t1).*pm)(std::forward<Tn>(tn)...))) {
-    return (std::forward<T1>(t1).*pm)(std::forward<Tn>(tn)...);
-  }
-
-  // `(t1.get().*pm)(t2, ..., tN)` when `pm` is a pointer to a member function
-  // of a class `C` and `remove_cvref_t<decltype(t1)>` is a specialization of
-  // `reference_wrapper`;
-  template <typename R, typename T1, typename... Tn>
-  static constexpr R
-  call(ref_wrapper_tag,
-       T C::*pm,
-       T1&& t1,
-       Tn&&... tn) noexcept(noexcept((t1.get().*pm)(std::forward<Tn>(tn)...))) {
-    return (t1.get().*pm)(std::forward<Tn>(tn)...);
-  }
-
-  // `((*t1).*pm)(t2, ..., tN)` when `pm` is a pointer to a member function of a
-  // class `C` and `t1` does not satisfy the previous two items;
-  template <typename R, typename T1, typename... Tn>
-  static constexpr R call(ptr_tag, T C::*pm, T1&& t1, Tn&&... tn) noexcept(
-      noexcept(((*std::forward<T1>(t1)).*pm)(std::forward<Tn>(tn)...))) {
-    return ((*std::forward<T1>(t1)).*pm)(std::forward<Tn>(tn)...);
-  }
-
 public:
-  constexpr mem_fun_ptr(T C::*pm) noexcept : pm(pm) {}
-
-  template <typename T1,
-            typename... Tn,
-            typename PT1 = typename p0704<T, T1>::type,
-            typename Tag = typename dispatch_mem_ptr<C, PT1>::type,
-            typename R =
-                typename mem_fun_ptr_result<Tag, T C::*(PT1&&, Tn&&...)>::type,
-            typename = typename apply_clang_workaround<C, T, T1>::type>
-  constexpr R operator()(T1&& t1, Tn&&... tn) const noexcept(noexcept(
-      call<R>(Tag{}, pm, std::forward<PT1>(t1), std::forward<Tn>(tn)...))) {
-    return call<R>(Tag{}, pm, std::forward<PT1>(t1), std::forward<Tn>(tn)...);
+  constexpr mem_fn(T C::*pm) noexcept : pm(pm) {}
+
+  template <typename... Args>
+  constexpr auto operator()(Args&&... args) const noexcept(noexcept(
+      detail::invoke(std::declval<T C::*>(), SLB_FORWARD(Args, args)...)))
+      -> decltype(detail::invoke(std::declval<T C::*>(),
+                                 SLB_FORWARD(Args, args)...)) {
+    return detail::invoke(pm, SLB_FORWARD(Args, args)...);
   }
 };
 
 } // namespace invoke_impl
 
-// We don't use `std::is_function<T>` here since some libstdc++ versions fail to
-// classify function types with noexcept specifiers.
-
 template <typename T>
 struct mem_fn_result {};
 
 template <typename T, typename C>
 struct mem_fn_result<T C::*> {
-  using type =
-      typename std::conditional<detail::lib::is_function<T>::value,
-                                invoke_impl::mem_fun_ptr<T C::*>,
-                                invoke_impl::mem_obj_ptr<T C::*>>::type;
-};
-
-////////////////////////////////////////////////////////////////////////////////
-namespace invoke_impl {
-
-template <typename F, typename FD = typename detail::lib::remove_cvref<F>::type>
-struct dispatch_invoke {
-  using type = F&&;
+  using type = invoke_impl::mem_fn<T C::*>;
 };
 
-template <typename F, typename T, typename C>
-struct dispatch_invoke<F, T C::*> {
-  using type = typename mem_fn_result<T C::*>::type;
-};
-
-} // namespace invoke_impl
-
-template <typename F, typename... Args>
-constexpr auto invoke(F&& f, Args&&... args) noexcept(
-    noexcept(typename invoke_impl::dispatch_invoke<F>::type(std::forward<F>(f))(
-        std::forward<Args>(args)...)))
-    -> decltype(typename invoke_impl::dispatch_invoke<F>::type(
-        std::forward<F>(f))(std::forward<Args>(args)...)) {
-  return typename invoke_impl::dispatch_invoke<F>::type(std::forward<F>(f))(
-      std::forward<Args>(args)...);
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 namespace invoke_impl {
 
@@ -345,11 +269,11 @@ private:
 public:
   template <typename F, typename... Args>
   static constexpr auto call(F&& f, Args&&... args) noexcept(
-      noexcept(conversion(detail::invoke(std::forward<F>(f),
-                                         std::forward<Args>(args)...))))
-      -> decltype(conversion(detail::invoke(std::forward<F>(f),
-                                            std::forward<Args>(args)...))) {
-    return detail::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+      noexcept(conversion(detail::invoke(SLB_FORWARD(F, f),
+                                         SLB_FORWARD(Args, args)...))))
+      -> decltype(conversion(detail::invoke(SLB_FORWARD(F, f),
+                                            SLB_FORWARD(Args, args)...))) {
+    return detail::invoke(SLB_FORWARD(F, f), SLB_FORWARD(Args, args)...);
   }
 };
 
@@ -358,11 +282,11 @@ template <typename R>
 struct invoke_guard<R, void> {
   template <typename F, typename... Args>
   static constexpr auto call(F&& f, Args&&... args) noexcept(
-      noexcept(detail::invoke(std::forward<F>(f), std::forward<Args>(args)...)))
-      -> decltype((void)(detail::invoke(std::forward<F>(f),
-                                        std::forward<Args>(args)...))) {
+      noexcept(detail::invoke(SLB_FORWARD(F, f), SLB_FORWARD(Args, args)...)))
+      -> decltype((void)(detail::invoke(SLB_FORWARD(F, f),
+                                        SLB_FORWARD(Args, args)...))) {
     return static_cast<void>(
-        detail::invoke(std::forward<F>(f), std::forward<Args>(args)...));
+        detail::invoke(SLB_FORWARD(F, f), SLB_FORWARD(Args, args)...));
   }
 };
 
@@ -370,12 +294,12 @@ struct invoke_guard<R, void> {
 
 template <typename R, typename F, typename... Args>
 constexpr auto invoke_r(F&& f, Args&&... args) noexcept(
-    noexcept(invoke_impl::invoke_guard<R>::call(std::forward<F>(f),
-                                                std::forward<Args>(args)...)))
+    noexcept(invoke_impl::invoke_guard<R>::call(SLB_FORWARD(F, f),
+                                                SLB_FORWARD(Args, args)...)))
     -> decltype(invoke_impl::invoke_guard<R>::call(
-        std::forward<F>(f), std::forward<Args>(args)...)) {
-  return invoke_impl::invoke_guard<R>::call(std::forward<F>(f),
-                                            std::forward<Args>(args)...);
+        SLB_FORWARD(F, f), SLB_FORWARD(Args, args)...)) {
+  return invoke_impl::invoke_guard<R>::call(SLB_FORWARD(F, f),
+                                            SLB_FORWARD(Args, args)...);
 }
 
 } // namespace detail
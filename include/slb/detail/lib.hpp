@@ -13,6 +13,8 @@
 
 #include <type_traits>
 
+#include "config.hpp"
+
 namespace slb {
 namespace detail {
 namespace lib {
@@ -20,6 +22,13 @@ namespace lib {
 template <typename>
 struct always_false : std::false_type {};
 
+// gcc did not implement CWG1558: "Unused arguments in alias template
+// specializations" until version 5, so we can't use `void_t` here.
+template <typename>
+struct always_void {
+  using type = void;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -42,6 +51,18 @@ struct remove_cvref {
       typename std::remove_cv<typename std::remove_reference<T>::type>::type;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// Whether the call is part of a constant evaluation, so that constexpr
+// functions can use non-constexpr code at run time. Without compiler support,
+// it is always `false`.
+constexpr bool is_constant_evaluated() noexcept {
+#if SLB_HAS_IS_CONSTANT_EVALUATED
+  return __builtin_is_constant_evaluated();
+#else
+  return false;
+#endif
+}
+
 } // namespace lib
 } // namespace detail
 } // namespace slb
@@ -0,0 +1,799 @@
+/*
+  SLB.Detail.SwissTable
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_DETAIL_SWISS_TABLE_HPP
+#define SLB_DETAIL_SWISS_TABLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../bit.hpp"
+#include "../memory.hpp"
+#include "../type_traits.hpp"
+#include "config.hpp"
+#include "lib.hpp"
+
+#if SLB_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace slb {
+namespace detail {
+
+// An open-addressing hash table in the style of Abseil's SwissTable. Slots are
+// grouped 16 at a time, and each slot has a control byte that is either empty,
+// deleted (a tombstone), or holds the low 7 bits of the hash of the element in
+// it. A lookup probes whole groups at once, comparing all 16 control bytes of a
+// group against the hash in a few instructions, so that the keys themselves
+// are compared only on a likely match.
+//
+// The remaining bits of the hash select the first group to probe; groups are
+// then visited in triangular steps, which covers all of them since their
+// number is a power of two. The table grows when it would be more than 7/8
+// full, counting tombstones.
+
+using ctrl_t = signed char;
+
+enum : int {
+  ctrl_empty = -128, // 0b10000000
+  ctrl_deleted = -2, // 0b11111110
+  ctrl_sentinel = -1 // 0b11111111, marks the end for iteration
+};
+
+// The control bytes of a table with no slots: a sentinel, so that iteration
+// stops immediately, followed by empty bytes, so that a lookup does as well.
+template <typename = void>
+struct swiss_empty_group {
+  static ctrl_t const value[16];
+};
+
+template <typename T>
+ctrl_t const swiss_empty_group<T>::value[16] = {
+    ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty,    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty,    ctrl_empty, ctrl_empty, ctrl_empty};
+
+// The control bytes of a group; the `match` functions return a mask with bit
+// `i` set for each matching byte `i`.
+#if SLB_HAS_SSE2
+class swiss_group {
+public:
+  enum : std::size_t { width = 16 };
+
+  explicit swiss_group(ctrl_t const* ctrl) noexcept
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl))) {}
+
+  unsigned match(ctrl_t h2) const noexcept {
+    return static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+  }
+
+  unsigned match_empty() const noexcept {
+    return match(static_cast<ctrl_t>(ctrl_empty));
+  }
+
+  // Both are less than the sentinel, and full bytes are non-negative.
+  unsigned match_empty_or_deleted() const noexcept {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(
+        _mm_set1_epi8(static_cast<ctrl_t>(ctrl_sentinel)), ctrl_)));
+  }
+
+private:
+  __m128i ctrl_;
+};
+#else
+// Processes the group as two 64-bit words, 8 control bytes at a time.
+class swiss_group {
+public:
+  enum : std::size_t { width = 16 };
+
+  explicit swiss_group(ctrl_t const* ctrl) noexcept
+      : lo_(load(ctrl)), hi_(load(ctrl + 8)) {}
+
+  unsigned match(ctrl_t h2) const noexcept {
+    std::uint64_t const pattern = lsbs * static_cast<unsigned char>(h2);
+    return gather(zero_bytes(lo_ ^ pattern)) |
+           gather(zero_bytes(hi_ ^ pattern)) << 8;
+  }
+
+  // Only an empty byte has its high bit set and the next one clear.
+  unsigned match_empty() const noexcept {
+    return gather(lo_ & ~(lo_ << 1) & msbs) |
+           gather(hi_ & ~(hi_ << 1) & msbs) << 8;
+  }
+
+  // Only the sentinel has both its high bit and its low bit set.
+  unsigned match_empty_or_deleted() const noexcept {
+    return gather(lo_ & ~(lo_ << 7) & msbs) |
+           gather(hi_ & ~(hi_ << 7) & msbs) << 8;
+  }
+
+private:
+  enum : std::uint64_t {
+    lsbs = 0x0101010101010101u,
+    msbs = 0x8080808080808080u
+  };
+
+  // Little-endian regardless of the platform, so that byte `i` of the group
+  // maps to bit `i` of the masks.
+  static std::uint64_t load(ctrl_t const* ctrl) noexcept {
+    std::uint64_t word = 0;
+    for (int i = 0; i < 8; ++i) {
+      word |= std::uint64_t(static_cast<unsigned char>(ctrl[i])) << (8 * i);
+    }
+    return word;
+  }
+
+  // The high bit of each byte of `word` that is zero, and no other bits.
+  static std::uint64_t zero_bytes(std::uint64_t word) noexcept {
+    std::uint64_t const low7 = ~msbs;
+    return ~(((word & low7) + low7) | word | low7);
+  }
+
+  // Packs the high bit of each byte into the low 8 bits.
+  static unsigned gather(std::uint64_t high_bits) noexcept {
+    return static_cast<unsigned>(((high_bits >> 7) * 0x0102040810204080u) >>
+                                 56);
+  }
+
+  std::uint64_t lo_;
+  std::uint64_t hi_;
+};
+#endif
+
+// Hashers that declare `is_avalanching` promise that every bit of their result
+// depends on every bit of the key; others have their results mixed first.
+template <typename Hash, typename = void>
+struct is_avalanching : std::false_type {};
+
+template <typename Hash>
+struct is_avalanching<
+    Hash,
+    typename lib::always_void<typename Hash::is_avalanching>::type>
+    : std::true_type {};
+
+inline std::size_t hash_mix(std::size_t hash) noexcept {
+  std::uint64_t x = hash;
+  x ^= x >> 32;
+  x *= 0xd6e8feb86659fd93u;
+  x ^= x >> 32;
+  x *= 0xd6e8feb86659fd93u;
+  x ^= x >> 32;
+  return static_cast<std::size_t>(x);
+}
+
+template <typename KeyEqual, typename K, typename = void>
+struct is_transparent_for_key_equal : std::false_type {};
+
+template <typename KeyEqual, typename K>
+struct is_transparent_for_key_equal<
+    KeyEqual,
+    K,
+    typename lib::always_void<typename KeyEqual::is_transparent>::type>
+    : std::true_type {};
+
+// Heterogeneous lookup requires both the hasher and the key equality to be
+// transparent. Depends on `K` so that member templates of the containers are
+// SFINAE-constrained on it, rather than rejected as the class is instantiated.
+template <typename Hash, typename KeyEqual, typename K, typename = void>
+struct is_transparent_hash : std::false_type {};
+
+template <typename Hash, typename KeyEqual, typename K>
+struct is_transparent_hash<
+    Hash,
+    KeyEqual,
+    K,
+    typename lib::always_void<typename Hash::is_transparent>::type>
+    : is_transparent_for_key_equal<KeyEqual, K> {};
+
+template <typename Hash, typename KeyEqual, typename K>
+using enable_if_transparent_hash = typename std::enable_if<
+    is_transparent_hash<Hash, KeyEqual, K>::value>::type;
+
+template <typename Policy, typename Hash, typename KeyEqual, typename Allocator>
+class swiss_table;
+
+template <typename Value>
+class swiss_iterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename std::remove_const<Value>::type;
+  using difference_type = std::ptrdiff_t;
+  using reference = Value&;
+  using pointer = Value*;
+
+  swiss_iterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+
+  template <typename Other,
+            typename = typename std::enable_if<
+                !std::is_same<Other, Value>::value &&
+                std::is_convertible<Other*, Value*>::value>::type>
+  swiss_iterator(swiss_iterator<Other> const& other) noexcept
+      : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+  reference operator*() const noexcept { return *slot_; }
+  pointer operator->() const noexcept { return slot_; }
+
+  swiss_iterator& operator++() noexcept {
+    ++ctrl_;
+    ++slot_;
+    skip_empty_or_deleted();
+    return *this;
+  }
+
+  swiss_iterator operator++(int) noexcept {
+    swiss_iterator result = *this;
+    ++*this;
+    return result;
+  }
+
+  friend bool operator==(swiss_iterator const& x,
+                         swiss_iterator const& y) noexcept {
+    return x.ctrl_ == y.ctrl_;
+  }
+
+  friend bool operator!=(swiss_iterator const& x,
+                         swiss_iterator const& y) noexcept {
+    return x.ctrl_ != y.ctrl_;
+  }
+
+private:
+  swiss_iterator(ctrl_t const* ctrl, Value* slot) noexcept
+      : ctrl_(ctrl), slot_(slot) {}
+
+  void skip_empty_or_deleted() noexcept {
+    while (*ctrl_ < ctrl_sentinel) {
+      ++ctrl_;
+      ++slot_;
+    }
+  }
+
+  template <typename>
+  friend class swiss_iterator;
+
+  template <typename, typename, typename, typename>
+  friend class swiss_table;
+
+  ctrl_t const* ctrl_;
+  Value* slot_;
+};
+
+// `Policy` describes the elements: its `value_type`, and how to get the
+// `key_type` of one with `key`.
+template <typename Policy, typename Hash, typename KeyEqual, typename Allocator>
+class swiss_table {
+  using value_alloc = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<typename Policy::value_type>;
+  using value_alloc_traits = std::allocator_traits<value_alloc>;
+  using ctrl_alloc =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<ctrl_t>;
+  using ctrl_alloc_traits = std::allocator_traits<ctrl_alloc>;
+
+public:
+  using key_type = typename Policy::key_type;
+  using value_type = typename Policy::value_type;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = swiss_iterator<value_type>;
+  using const_iterator = swiss_iterator<value_type const>;
+
+  static_assert(
+      std::is_same<typename value_alloc_traits::pointer, value_type*>::value,
+      "`swiss_table` does not support fancy pointers.");
+
+  swiss_table(size_type n,
+              hasher const& hash,
+              key_equal const& eq,
+              allocator_type const& alloc)
+      : hash_(hash), eq_(eq), alloc_(alloc) {
+    reset();
+    if (n > 0) {
+      rehash(n);
+    }
+  }
+
+  swiss_table(swiss_table const& other, allocator_type const& alloc)
+      : hash_(other.hash_), eq_(other.eq_), alloc_(alloc) {
+    reset();
+    copy_from(other);
+  }
+
+  swiss_table(swiss_table const& other)
+      : swiss_table(other,
+                    std::allocator_traits<Allocator>::
+                        select_on_container_copy_construction(other.alloc_)) {}
+
+  swiss_table(swiss_table&& other) noexcept
+      : hash_(std::move(other.hash_)),
+        eq_(std::move(other.eq_)),
+        alloc_(std::move(other.alloc_)) {
+    steal(other);
+  }
+
+  ~swiss_table() { release(); }
+
+  swiss_table& operator=(swiss_table const& other) {
+    if (this != &other) {
+      swiss_table tmp(
+          other,
+          std::allocator_traits<
+              Allocator>::propagate_on_container_copy_assignment::value
+              ? other.alloc_
+              : alloc_);
+      swap_contents(tmp);
+      // `tmp` releases the old elements with the allocator they came from.
+      using std::swap;
+      swap(alloc_, tmp.alloc_);
+      hash_ = other.hash_;
+      eq_ = other.eq_;
+    }
+    return *this;
+  }
+
+  swiss_table& operator=(swiss_table&& other) noexcept(
+      std::allocator_traits<
+          Allocator>::propagate_on_container_move_assignment::value) {
+    if (this != &other) {
+      // Elements moved one at a time are placed with the new hash function.
+      hash_ = std::move(other.hash_);
+      eq_ = std::move(other.eq_);
+      if (std::allocator_traits<
+              Allocator>::propagate_on_container_move_assignment::value ||
+          alloc_ == other.alloc_) {
+        release();
+        if (std::allocator_traits<
+                Allocator>::propagate_on_container_move_assignment::value) {
+          alloc_ = std::move(other.alloc_);
+        }
+        steal(other);
+      } else {
+        clear();
+        reserve(other.size_);
+        for (value_type& x : other) {
+          emplace_unique(Policy::key(x), std::move(x));
+        }
+        other.clear();
+      }
+    }
+    return *this;
+  }
+
+  // iterators
+  iterator begin() noexcept {
+    iterator it(ctrl_, slots_);
+    it.skip_empty_or_deleted();
+    return it;
+  }
+  const_iterator begin() const noexcept {
+    const_iterator it(ctrl_, slots_);
+    it.skip_empty_or_deleted();
+    return it;
+  }
+  iterator end() noexcept {
+    return iterator(ctrl_ + capacity_, slots_ + capacity_);
+  }
+  const_iterator end() const noexcept {
+    return const_iterator(ctrl_ + capacity_, slots_ + capacity_);
+  }
+
+  // capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return (std::min)(value_alloc_traits::max_size(value_alloc(alloc_)),
+                      ctrl_alloc_traits::max_size(ctrl_alloc(alloc_))) /
+           8 * 7;
+  }
+
+  // modifiers
+
+  // Inserts an element constructed from `args` unless there is one with a
+  // key equivalent to `key`.
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace_unique(K const& key, Args&&... args) {
+    std::size_t const hash = hash_key(key);
+    if (value_type* const slot = find_slot(key, hash)) {
+      return {iterator_at(slot), false};
+    }
+    if (growth_left_ == 0) {
+      // The arguments may refer to an element that is about to be moved.
+      typename slb::aligned_storage<sizeof(value_type),
+                                    alignof(value_type)>::type storage;
+      value_type* const tmp = reinterpret_cast<value_type*>(&storage);
+      ::new (detail::voidify_ptr(tmp)) value_type(std::forward<Args>(args)...);
+      struct guard {
+        value_type* p;
+        ~guard() { slb::destroy_at(p); }
+      } g{tmp};
+      grow();
+      return {insert_at(hash, std::move(*tmp)), true};
+    }
+    return {insert_at(hash, std::forward<Args>(args)...), true};
+  }
+
+  iterator erase(const_iterator position) {
+    iterator next(position.ctrl_, const_cast<value_type*>(position.slot_));
+    erase_slot(next.slot_);
+    ++next;
+    return next;
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    while (first != last) {
+      first = erase(first);
+    }
+    return iterator(last.ctrl_, const_cast<value_type*>(last.slot_));
+  }
+
+  template <typename K>
+  size_type erase_key(K const& key) {
+    value_type* const slot = find_slot(key, hash_key(key));
+    if (slot == nullptr) {
+      return 0;
+    }
+    erase_slot(slot);
+    return 1;
+  }
+
+  void clear() noexcept {
+    destroy_elements();
+    if (capacity_ > 0) {
+      std::memset(ctrl_, ctrl_empty, capacity_);
+    }
+    size_ = 0;
+    growth_left_ = max_load(capacity_);
+  }
+
+  void swap(swiss_table& other) noexcept(
+      slb::is_nothrow_swappable<hasher>::value &&
+      slb::is_nothrow_swappable<key_equal>::value) {
+    using std::swap;
+    swap(hash_, other.hash_);
+    swap(eq_, other.eq_);
+    if (std::allocator_traits<
+            Allocator>::propagate_on_container_swap::value) {
+      swap(alloc_, other.alloc_);
+    }
+    swap_contents(other);
+  }
+
+  // observers
+  allocator_type get_allocator() const noexcept { return alloc_; }
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return eq_; }
+
+  // lookup
+  template <typename K>
+  iterator find(K const& key) {
+    value_type* const slot = find_slot(key, hash_key(key));
+    return slot != nullptr ? iterator_at(slot) : end();
+  }
+
+  template <typename K>
+  const_iterator find(K const& key) const {
+    value_type* const slot = find_slot(key, hash_key(key));
+    return slot != nullptr ? const_iterator(iterator_at(slot)) : end();
+  }
+
+  template <typename K>
+  bool contains(K const& key) const {
+    return find_slot(key, hash_key(key)) != nullptr;
+  }
+
+  // bucket interface
+  size_type bucket_count() const noexcept { return capacity_; }
+
+  // hash policy
+  float load_factor() const noexcept {
+    return capacity_ == 0 ? 0.0f
+                          : static_cast<float>(size_) /
+                                static_cast<float>(capacity_);
+  }
+
+  float max_load_factor() const noexcept { return 0.875f; }
+
+  // Ensures room for at least `n` slots, and at least `size()` elements
+  // without growing; `rehash(0)` releases the storage of an empty table.
+  void rehash(size_type n) {
+    n = (std::max)(n, min_capacity(size_));
+    if (n == 0) {
+      release();
+      reset();
+      return;
+    }
+    size_type groups = 1;
+    while (groups * swiss_group::width < n) {
+      groups *= 2;
+    }
+    if (groups * swiss_group::width != capacity_) {
+      resize(groups);
+    }
+  }
+
+  void reserve(size_type n) {
+    if (n > max_load(capacity_)) {
+      rehash(min_capacity(n));
+    }
+  }
+
+private:
+  static size_type max_load(size_type capacity) noexcept {
+    return capacity - capacity / 8;
+  }
+
+  // The smallest capacity for which `n` elements fit under the maximum load.
+  static size_type min_capacity(size_type n) noexcept {
+    return n + (n + 6) / 7;
+  }
+
+  template <typename K>
+  std::size_t hash_key(K const& key) const {
+    std::size_t const hash = hash_(key);
+    return is_avalanching<Hash>::value ? hash : detail::hash_mix(hash);
+  }
+
+  static ctrl_t h2(std::size_t hash) noexcept {
+    return static_cast<ctrl_t>(hash & 0x7f);
+  }
+
+  iterator iterator_at(value_type* slot) const noexcept {
+    return iterator(ctrl_ + (slot - slots_), slot);
+  }
+
+  template <typename K>
+  value_type* find_slot(K const& key, std::size_t hash) const {
+    ctrl_t const h = h2(hash);
+    std::size_t g = (hash >> 7) & group_mask_;
+    for (std::size_t step = 1;; ++step) {
+      std::size_t const first = g * swiss_group::width;
+      swiss_group const group(ctrl_ + first);
+      for (unsigned m = group.match(h); m != 0; m &= m - 1) {
+        value_type* const slot = slots_ + first + slb::countr_zero(m);
+        if (eq_(Policy::key(*slot), key)) {
+          return slot;
+        }
+      }
+      if (group.match_empty() != 0) {
+        return nullptr;
+      }
+      g = (g + step) & group_mask_;
+    }
+  }
+
+  // The first empty or deleted slot along the probe sequence for `hash`.
+  std::size_t find_non_full(std::size_t hash) const noexcept {
+    std::size_t g = (hash >> 7) & group_mask_;
+    for (std::size_t step = 1;; ++step) {
+      unsigned const m =
+          swiss_group(ctrl_ + g * swiss_group::width).match_empty_or_deleted();
+      if (m != 0) {
+        return g * swiss_group::width + slb::countr_zero(m);
+      }
+      g = (g + step) & group_mask_;
+    }
+  }
+
+  template <typename... Args>
+  iterator insert_at(std::size_t hash, Args&&... args) {
+    std::size_t const i = find_non_full(hash);
+    value_type* const slot = slots_ + i;
+    ::new (detail::voidify_ptr(slot)) value_type(std::forward<Args>(args)...);
+    if (ctrl_[i] == ctrl_empty) {
+      --growth_left_;
+    }
+    ctrl_[i] = h2(hash);
+    ++size_;
+    return iterator_at(slot);
+  }
+
+  // A slot becomes a tombstone only if its group has never had an empty byte
+  // since the last rehash, as otherwise no probe sequence goes past it.
+  void erase_slot(value_type* slot) noexcept {
+    std::size_t const i = static_cast<std::size_t>(slot - slots_);
+    slb::destroy_at(slot);
+    --size_;
+    ctrl_t* const group = ctrl_ + (i & ~std::size_t(swiss_group::width - 1));
+    if (swiss_group(group).match_empty() != 0) {
+      ctrl_[i] = ctrl_empty;
+      ++growth_left_;
+    } else {
+      ctrl_[i] = ctrl_deleted;
+    }
+  }
+
+  // Doubles the capacity, or only drops the tombstones if they make up a
+  // large part of the table.
+  void grow() {
+    if (capacity_ == 0) {
+      resize(1);
+    } else if (size_ <= max_load(capacity_) / 2) {
+      resize(group_mask_ + 1);
+    } else {
+      resize(2 * (group_mask_ + 1));
+    }
+  }
+
+  // Moves the elements to a new table with `groups` groups. If an exception
+  // is thrown, the table is left unchanged.
+  void resize(size_type groups) {
+    size_type const capacity = groups * swiss_group::width;
+    // Copying the hasher may throw, so `tmp` is ready to own the arrays
+    // before they are allocated.
+    swiss_table tmp(0, hash_, eq_, alloc_);
+    ctrl_alloc calloc(alloc_);
+    value_alloc valloc(alloc_);
+    ctrl_t* const ctrl = ctrl_alloc_traits::allocate(calloc, capacity + 1);
+    value_type* slots;
+    try {
+      slots = value_alloc_traits::allocate(valloc, capacity);
+    } catch (...) {
+      ctrl_alloc_traits::deallocate(calloc, ctrl, capacity + 1);
+      throw;
+    }
+    std::memset(ctrl, ctrl_empty, capacity);
+    ctrl[capacity] = ctrl_sentinel;
+
+    tmp.ctrl_ = ctrl;
+    tmp.slots_ = slots;
+    tmp.capacity_ = capacity;
+    tmp.group_mask_ = groups - 1;
+    tmp.growth_left_ = max_load(capacity);
+    // If an exception is thrown, `tmp` destroys the moved elements.
+    transfer_to(tmp,
+                slb::bool_constant<
+                    is_memmove_relocatable<value_type*, value_type*>::value>{});
+    swap_contents(tmp);
+  }
+
+  void transfer_to(swiss_table& tmp, std::true_type) {
+    try {
+      for (size_type i = 0; i < capacity_; ++i) {
+        if (ctrl_[i] >= 0) {
+          std::size_t const hash = hash_key(Policy::key(slots_[i]));
+          std::size_t const j = tmp.find_non_full(hash);
+          std::memcpy(detail::voidify_ptr(tmp.slots_ + j),
+                      detail::voidify_ptr(slots_ + i), sizeof(value_type));
+          tmp.ctrl_[j] = h2(hash);
+        }
+      }
+    } catch (...) {
+      // If the hasher throws, the elements still belong to this table, and
+      // `tmp` forgets its copies of them.
+      std::memset(tmp.ctrl_, ctrl_empty, tmp.capacity_);
+      throw;
+    }
+    tmp.size_ = size_;
+    tmp.growth_left_ -= size_;
+    // The elements now belong to `tmp`.
+    size_ = 0;
+    std::memset(ctrl_, ctrl_empty, capacity_);
+  }
+
+  void transfer_to(swiss_table& tmp, std::false_type) {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] >= 0) {
+        std::size_t const hash = hash_key(Policy::key(slots_[i]));
+        tmp.insert_at(hash, std::move_if_noexcept(slots_[i]));
+      }
+    }
+  }
+
+  void copy_from(swiss_table const& other) {
+    if (other.size_ == 0) {
+      return;
+    }
+    // Copies each element to the same position, so that the probe sequences
+    // are kept as they are, tombstones included. This is only called from a
+    // constructor, which would not run the destructor on an exception.
+    resize(other.group_mask_ + 1);
+    try {
+      for (size_type i = 0; i < other.capacity_; ++i) {
+        if (other.ctrl_[i] >= 0) {
+          ::new (detail::voidify_ptr(slots_ + i)) value_type(other.slots_[i]);
+          ctrl_[i] = other.ctrl_[i];
+          ++size_;
+        }
+      }
+    } catch (...) {
+      release();
+      throw;
+    }
+    std::memcpy(ctrl_, other.ctrl_, capacity_);
+    growth_left_ = other.growth_left_;
+  }
+
+  void destroy_elements() noexcept {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] >= 0) {
+        slb::destroy_at(slots_ + i);
+      }
+    }
+  }
+
+  void release() noexcept {
+    if (capacity_ > 0) {
+      destroy_elements();
+      ctrl_alloc calloc(alloc_);
+      value_alloc valloc(alloc_);
+      ctrl_alloc_traits::deallocate(calloc, ctrl_, capacity_ + 1);
+      value_alloc_traits::deallocate(valloc, slots_, capacity_);
+    }
+  }
+
+  void reset() noexcept {
+    ctrl_ = const_cast<ctrl_t*>(swiss_empty_group<>::value);
+    slots_ = nullptr;
+    capacity_ = 0;
+    group_mask_ = 0;
+    size_ = 0;
+    growth_left_ = 0;
+  }
+
+  void steal(swiss_table& other) noexcept {
+    ctrl_ = other.ctrl_;
+    slots_ = other.slots_;
+    capacity_ = other.capacity_;
+    group_mask_ = other.group_mask_;
+    size_ = other.size_;
+    growth_left_ = other.growth_left_;
+    other.reset();
+  }
+
+  void swap_contents(swiss_table& other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(group_mask_, other.group_mask_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+  }
+
+  // The empty table refers to `swiss_empty_group`, which is never written to
+  // as there are no slots to insert into without growing first.
+  ctrl_t* ctrl_;
+  value_type* slots_;
+  size_type capacity_;
+  size_type group_mask_;
+  size_type size_;
+  size_type growth_left_;
+  hasher hash_;
+  key_equal eq_;
+  allocator_type alloc_;
+};
+
+} // namespace detail
+
+// The default hasher of the unordered flat containers: `std::hash` followed by
+// a mixing step, as `std::hash` is often the identity for integers and the
+// tables take both the group and the control byte from its result.
+template <typename Key>
+struct unordered_flat_hash {
+  using is_avalanching = void;
+
+  std::size_t operator()(Key const& key) const
+      noexcept(noexcept(std::hash<Key>()(key))) {
+    return detail::hash_mix(std::hash<Key>()(key));
+  }
+};
+
+} // namespace slb
+
+#endif // SLB_DETAIL_SWISS_TABLE_HPP
@@ -0,0 +1,142 @@
+/*
+  SLB.Detail.WorkDeque
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_DETAIL_WORK_DEQUE_HPP
+#define SLB_DETAIL_WORK_DEQUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "../cache_padded.hpp"
+#include "config.hpp"
+
+namespace slb {
+namespace detail {
+
+// A work-stealing deque of pointers (Chase and Lev, "Dynamic Circular
+// Work-Stealing Deque"). The owning thread pushes and pops at the bottom, in
+// LIFO order; any other thread steals from the top, in FIFO order. Popping
+// the last element and stealing race on `top_`, and the `seq_cst` accesses
+// to `top_` and `bottom_` make sure at most one of them wins.
+//
+// The owner replaces a full ring with one twice its size. The replaced rings
+// are kept until destruction, since a thief may still be reading from one.
+template <typename T>
+class work_deque {
+  static_assert(std::is_pointer<T>::value, "the elements are pointers");
+
+  struct ring {
+    explicit ring(std::int64_t capacity)
+        : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+
+    std::int64_t capacity() const noexcept { return mask + 1; }
+
+    T get(std::int64_t i) const noexcept {
+      return slots[i & mask].load(std::memory_order_relaxed);
+    }
+
+    void put(std::int64_t i, T value) noexcept {
+      slots[i & mask].store(value, std::memory_order_relaxed);
+    }
+
+    std::int64_t mask;
+    std::unique_ptr<std::atomic<T>[]> slots;
+    std::unique_ptr<ring> previous;
+  };
+
+public:
+  explicit work_deque(std::int64_t capacity = 256)
+      : top_(0), bottom_(0), ring_(new ring(capacity)) {}
+
+  work_deque(work_deque const&) = delete;
+  work_deque& operator=(work_deque const&) = delete;
+
+  ~work_deque() { delete ring_.load(std::memory_order_relaxed); }
+
+  // Called by the owner only. The `seq_cst` store of `bottom_` also orders
+  // the push before a later `seq_cst` load by the caller.
+  void push(T value) {
+    std::int64_t const b = bottom_.load(std::memory_order_relaxed);
+    std::int64_t const t = top_.load(std::memory_order_acquire);
+    ring* r = ring_.load(std::memory_order_relaxed);
+    if (b - t >= r->capacity()) {
+      r = grow(r, t, b);
+    }
+    r->put(b, value);
+    bottom_.store(b + 1, std::memory_order_seq_cst);
+  }
+
+  // Called by the owner only; returns `nullptr` when empty.
+  T pop() noexcept {
+    std::int64_t const b = bottom_.load(std::memory_order_relaxed) - 1;
+    ring* const r = ring_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_seq_cst);
+    std::int64_t t = top_.load(std::memory_order_seq_cst);
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T value = r->get(b);
+    if (t == b) {
+      if (!top_.compare_exchange_strong(t,
+                                        t + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        value = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return value;
+  }
+
+  // Called by any thread; returns `nullptr` when empty, or when it loses a
+  // race for the top element.
+  T steal() noexcept {
+    std::int64_t t = top_.load(std::memory_order_seq_cst);
+    std::int64_t const b = bottom_.load(std::memory_order_seq_cst);
+    if (t >= b) {
+      return nullptr;
+    }
+    T const value = ring_.load(std::memory_order_acquire)->get(t);
+    if (!top_.compare_exchange_strong(t,
+                                      t + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return value;
+  }
+
+private:
+  ring* grow(ring* r, std::int64_t t, std::int64_t b) {
+    ring* const bigger = new ring(r->capacity() * 2);
+    for (std::int64_t i = t; i != b; ++i) {
+      bigger->put(i, r->get(i));
+    }
+    bigger->previous.reset(r);
+    ring_.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+  // Thieves write `top_`, and the owner writes `bottom_`, so they are kept
+  // on separate cache lines. Padding, rather than alignment, also keeps them
+  // apart when the deque is allocated with `new` before C++17.
+  std::atomic<std::int64_t> top_;
+  char padding_[cache_padded_alignment - sizeof(std::atomic<std::int64_t>)];
+  std::atomic<std::int64_t> bottom_;
+  std::atomic<ring*> ring_;
+};
+
+} // namespace detail
+} // namespace slb
+
+#endif // SLB_DETAIL_WORK_DEQUE_HPP
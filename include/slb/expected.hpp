@@ -0,0 +1,1664 @@
+/*
+  SLB.Expected
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_EXPECTED_HPP
+#define SLB_EXPECTED_HPP
+
+/*
+
+Header <expected> synopsis [expected.syn]
+
+namespace std {
+  // [expected.unexpected], class template unexpected
+  template<class E> class unexpected;
+
+  // [expected.bad], class template bad_expected_access
+  template<class E> class bad_expected_access;
+
+  // [expected.bad.void], specialization for void
+  template<> class bad_expected_access<void>;
+
+  // in-place construction of unexpected values
+  struct unexpect_t {
+    explicit unexpect_t() = default;
+  };
+  inline constexpr unexpect_t unexpect{};
+
+  // [expected.expected], class template expected
+  template<class T, class E> class expected;
+
+  // [expected.void], partial specialization of expected for void types
+  template<class T, class E> requires is_void_v<T> class expected<T, E>;
+}
+
+*/
+
+#include <exception>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "detail/config.hpp"
+#include "detail/invoke.hpp"
+#include "detail/lib.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+#if __has_include(<expected>)
+#include <expected>
+#endif
+
+namespace slb {
+
+#if __cpp_lib_expected >= 202211L // C++23
+using std::unexpected;
+using std::bad_expected_access;
+using std::unexpect_t;
+using std::unexpect;
+using std::expected;
+#else
+// [expected.unexpected], class template unexpected
+template <typename E>
+class unexpected;
+
+template <typename T, typename E>
+class expected;
+
+namespace detail {
+
+template <typename T>
+struct is_unexpected : std::false_type {};
+
+template <typename E>
+struct is_unexpected<unexpected<E>> : std::true_type {};
+
+template <typename T>
+struct is_expected : std::false_type {};
+
+template <typename T, typename E>
+struct is_expected<expected<T, E>> : std::true_type {};
+
+template <typename E>
+struct is_expected_error
+    : slb::bool_constant<std::is_object<E>::value &&
+                         !std::is_array<E>::value &&
+                         !std::is_const<E>::value &&
+                         !std::is_volatile<E>::value &&
+                         !is_unexpected<E>::value> {};
+
+} // namespace detail
+
+template <typename E>
+class unexpected {
+  static_assert(detail::is_expected_error<E>::value,
+                "`E` shall be a non-array, non-cv object type that is not a "
+                "specialization of `unexpected`.");
+
+public:
+  // [expected.un.cons], constructors
+  constexpr unexpected(unexpected const&) = default;
+  constexpr unexpected(unexpected&&) = default;
+
+  template <
+      typename Err = E,
+      typename std::enable_if<
+          !std::is_same<typename remove_cvref<Err>::type, unexpected>::value &&
+              !std::is_same<typename remove_cvref<Err>::type,
+                            in_place_t>::value &&
+              std::is_constructible<E, Err>::value,
+          int>::type = 0>
+  constexpr explicit unexpected(Err&& e) : unex_(SLB_FORWARD(Err, e)) {}
+
+  template <typename... Args,
+            typename std::enable_if<std::is_constructible<E, Args...>::value,
+                                    int>::type = 0>
+  constexpr explicit unexpected(in_place_t, Args&&... args)
+      : unex_(SLB_FORWARD(Args, args)...) {}
+
+  template <typename U,
+            typename... Args,
+            typename std::enable_if<
+                std::is_constructible<E,
+                                      std::initializer_list<U>&,
+                                      Args...>::value,
+                int>::type = 0>
+  constexpr explicit unexpected(in_place_t,
+                                std::initializer_list<U> il,
+                                Args&&... args)
+      : unex_(il, SLB_FORWARD(Args, args)...) {}
+
+  unexpected& operator=(unexpected const&) = default;
+  unexpected& operator=(unexpected&&) = default;
+
+  // [expected.un.obs], observers
+  SLB_CXX14_CONSTEXPR E& error() & noexcept { return unex_; }
+  constexpr E const& error() const& noexcept { return unex_; }
+  SLB_CXX14_CONSTEXPR E&& error() && noexcept { return SLB_MOVE(unex_); }
+  constexpr E const&& error() const&& noexcept { return SLB_MOVE(unex_); }
+
+  // [expected.un.swap], swap
+  void swap(unexpected& other) noexcept(slb::is_nothrow_swappable<E>::value) {
+    using std::swap;
+    swap(unex_, other.unex_);
+  }
+
+  friend void swap(unexpected& x,
+                   unexpected& y) noexcept(noexcept(x.swap(y))) {
+    x.swap(y);
+  }
+
+  // [expected.un.eq], equality operator
+  template <typename E2>
+  friend constexpr bool operator==(unexpected const& x,
+                                   unexpected<E2> const& y) {
+    return x.error() == y.error();
+  }
+
+  template <typename E2>
+  friend constexpr bool operator!=(unexpected const& x,
+                                   unexpected<E2> const& y) {
+    return !(x.error() == y.error());
+  }
+
+private:
+  E unex_;
+};
+
+#if __cpp_deduction_guides
+template <typename E>
+unexpected(E) -> unexpected<E>;
+#endif
+
+// [expected.bad], class template bad_expected_access
+template <typename E>
+class bad_expected_access;
+
+// [expected.bad.void], specialization for void
+template <>
+class bad_expected_access<void> : public std::exception {
+public:
+  char const* what() const noexcept override {
+    return "bad access to slb::expected without expected value";
+  }
+
+protected:
+  bad_expected_access() noexcept = default;
+  bad_expected_access(bad_expected_access const&) = default;
+  bad_expected_access(bad_expected_access&&) = default;
+  bad_expected_access& operator=(bad_expected_access const&) = default;
+  bad_expected_access& operator=(bad_expected_access&&) = default;
+  ~bad_expected_access() override = default;
+};
+
+template <typename E>
+class bad_expected_access : public bad_expected_access<void> {
+public:
+  explicit bad_expected_access(E e) : unex_(std::move(e)) {}
+
+  E& error() & noexcept { return unex_; }
+  E const& error() const& noexcept { return unex_; }
+  E&& error() && noexcept { return std::move(unex_); }
+  E const&& error() const&& noexcept { return std::move(unex_); }
+
+private:
+  E unex_;
+};
+
+// in-place construction of unexpected values
+struct unexpect_t {
+  explicit unexpect_t() = default;
+};
+
+SLB_CXX17_INLINE_VARIABLE constexpr unexpect_t unexpect{};
+
+namespace detail {
+
+// Stands in for the value of `expected<void, E>`, so that it shares the
+// storage of the other specializations.
+struct expected_void {};
+
+struct expected_from_t {};
+
+// The value or the error, and which of the two is there. Destroying it is
+// trivial if destroying both is.
+template <typename T,
+          typename E,
+          bool = std::is_trivially_destructible<T>::value &&
+                 std::is_trivially_destructible<E>::value>
+class expected_base {
+public:
+  template <typename... Args>
+  constexpr explicit expected_base(in_place_t, Args&&... args)
+      : val_(SLB_FORWARD(Args, args)...), has_val_(true) {}
+
+  template <typename... Args>
+  constexpr explicit expected_base(unexpect_t, Args&&... args)
+      : unex_(SLB_FORWARD(Args, args)...), has_val_(false) {}
+
+  // Copies or moves whichever of the value or the error `other` holds.
+  template <typename Other>
+  expected_base(expected_from_t, Other&& other) : has_val_(other.has_val_) {
+    construct_from(SLB_FORWARD(Other, other));
+  }
+
+  template <typename Other>
+  void construct_from(Other&& other) {
+    if (other.has_val_) {
+      ::new (detail::voidify(val_)) T(SLB_FORWARD(Other, other).val_);
+    } else {
+      ::new (detail::voidify(unex_)) E(SLB_FORWARD(Other, other).unex_);
+    }
+  }
+
+  void destroy() noexcept {}
+
+  union {
+    T val_;
+    E unex_;
+  };
+  bool has_val_;
+};
+
+template <typename T, typename E>
+class expected_base<T, E, false> {
+public:
+  template <typename... Args>
+  constexpr explicit expected_base(in_place_t, Args&&... args)
+      : val_(SLB_FORWARD(Args, args)...), has_val_(true) {}
+
+  template <typename... Args>
+  constexpr explicit expected_base(unexpect_t, Args&&... args)
+      : unex_(SLB_FORWARD(Args, args)...), has_val_(false) {}
+
+  template <typename Other>
+  expected_base(expected_from_t, Other&& other) : has_val_(other.has_val_) {
+    construct_from(SLB_FORWARD(Other, other));
+  }
+
+  ~expected_base() { destroy(); }
+
+  template <typename Other>
+  void construct_from(Other&& other) {
+    if (other.has_val_) {
+      ::new (detail::voidify(val_)) T(SLB_FORWARD(Other, other).val_);
+    } else {
+      ::new (detail::voidify(unex_)) E(SLB_FORWARD(Other, other).unex_);
+    }
+  }
+
+  void destroy() noexcept {
+    if (has_val_) {
+      slb::destroy_at(std::addressof(val_));
+    } else {
+      slb::destroy_at(std::addressof(unex_));
+    }
+  }
+
+  union {
+    T val_;
+    E unex_;
+  };
+  bool has_val_;
+};
+
+// Destroys `oldval` and constructs `newval` in its place, which may be the
+// same storage, such that `oldval` is restored if the construction throws.
+template <typename New, typename Old, typename... Args>
+void expected_reinit(std::integral_constant<int, 0>, // nothrow constructible
+                     New& newval,
+                     Old& oldval,
+                     Args&&... args) {
+  slb::destroy_at(std::addressof(oldval));
+  ::new (detail::voidify(newval)) New(SLB_FORWARD(Args, args)...);
+}
+
+template <typename New, typename Old, typename... Args>
+void expected_reinit(std::integral_constant<int, 1>, // nothrow movable
+                     New& newval,
+                     Old& oldval,
+                     Args&&... args) {
+  New tmp(SLB_FORWARD(Args, args)...);
+  slb::destroy_at(std::addressof(oldval));
+  ::new (detail::voidify(newval)) New(SLB_MOVE(tmp));
+}
+
+template <typename New, typename Old, typename... Args>
+void expected_reinit(std::integral_constant<int, 2>,
+                     New& newval,
+                     Old& oldval,
+                     Args&&... args) {
+  Old tmp(SLB_MOVE(oldval));
+  slb::destroy_at(std::addressof(oldval));
+  try {
+    ::new (detail::voidify(newval)) New(SLB_FORWARD(Args, args)...);
+  } catch (...) {
+    ::new (detail::voidify(oldval)) Old(SLB_MOVE(tmp));
+    throw;
+  }
+}
+
+template <typename New, typename Old, typename... Args>
+void expected_reinit(New& newval, Old& oldval, Args&&... args) {
+  detail::expected_reinit(
+      std::integral_constant<
+          int,
+          std::is_nothrow_constructible<New, Args...>::value
+              ? 0
+              : std::is_nothrow_move_constructible<New>::value ? 1 : 2>{},
+      newval, oldval, SLB_FORWARD(Args, args)...);
+}
+
+template <typename Base, typename U>
+void expected_assign_value(Base& self, U&& v) {
+  if (self.has_val_) {
+    self.val_ = SLB_FORWARD(U, v);
+  } else {
+    detail::expected_reinit(self.val_, self.unex_, SLB_FORWARD(U, v));
+    self.has_val_ = true;
+  }
+}
+
+template <typename Base, typename G>
+void expected_assign_error(Base& self, G&& e) {
+  if (self.has_val_) {
+    detail::expected_reinit(self.unex_, self.val_, SLB_FORWARD(G, e));
+    self.has_val_ = false;
+  } else {
+    self.unex_ = SLB_FORWARD(G, e);
+  }
+}
+
+// Copying and moving is trivial if it is for both the value and the error.
+#if SLB_TRIVIALITY_TRAITS
+template <typename T, typename E>
+struct is_expected_trivial
+    : slb::bool_constant<slb::is_trivially_copyable<T>::value &&
+                         slb::is_trivially_copyable<E>::value> {};
+#else
+template <typename T, typename E>
+struct is_expected_trivial
+    : slb::bool_constant<std::is_trivial<T>::value &&
+                         std::is_trivial<E>::value> {};
+#endif
+
+template <typename T, typename E, bool = is_expected_trivial<T, E>::value>
+class expected_storage : public expected_base<T, E> {
+public:
+  using expected_base<T, E>::expected_base;
+};
+
+template <typename T, typename E>
+class expected_storage<T, E, false> : public expected_base<T, E> {
+  using base = expected_base<T, E>;
+
+public:
+  using base::base;
+
+  expected_storage(expected_storage const& other) noexcept(
+      std::is_nothrow_copy_constructible<T>::value &&
+      std::is_nothrow_copy_constructible<E>::value)
+      : base(expected_from_t{}, other) {}
+
+  expected_storage(expected_storage&& other) noexcept(
+      std::is_nothrow_move_constructible<T>::value &&
+      std::is_nothrow_move_constructible<E>::value)
+      : base(expected_from_t{}, SLB_MOVE(other)) {}
+
+  expected_storage& operator=(expected_storage const& other) {
+    assign_from(other);
+    return *this;
+  }
+
+  expected_storage& operator=(expected_storage&& other) noexcept(
+      std::is_nothrow_move_constructible<T>::value &&
+      std::is_nothrow_move_assignable<T>::value &&
+      std::is_nothrow_move_constructible<E>::value &&
+      std::is_nothrow_move_assignable<E>::value) {
+    assign_from(SLB_MOVE(other));
+    return *this;
+  }
+
+private:
+  template <typename Other>
+  void assign_from(Other&& other) {
+    if (other.has_val_) {
+      detail::expected_assign_value(*this, SLB_FORWARD(Other, other).val_);
+    } else {
+      detail::expected_assign_error(*this, SLB_FORWARD(Other, other).unex_);
+    }
+  }
+};
+
+// Deletes the copy and move constructors of `expected` unless they are
+// supported by both the value and the error.
+template <bool Copy, bool Move>
+struct expected_enable_copy_move {};
+
+template <>
+struct expected_enable_copy_move<false, true> {
+  expected_enable_copy_move() = default;
+  expected_enable_copy_move(expected_enable_copy_move const&) = delete;
+  expected_enable_copy_move(expected_enable_copy_move&&) = default;
+  expected_enable_copy_move& operator=(expected_enable_copy_move const&) =
+      default;
+  expected_enable_copy_move& operator=(expected_enable_copy_move&&) = default;
+};
+
+template <>
+struct expected_enable_copy_move<true, false> {
+  expected_enable_copy_move() = default;
+  expected_enable_copy_move(expected_enable_copy_move const&) = default;
+  expected_enable_copy_move& operator=(expected_enable_copy_move const&) =
+      default;
+};
+
+template <>
+struct expected_enable_copy_move<false, false> {
+  expected_enable_copy_move() = default;
+  expected_enable_copy_move(expected_enable_copy_move const&) = delete;
+  expected_enable_copy_move& operator=(expected_enable_copy_move const&) =
+      default;
+};
+
+template <typename T, typename E>
+using expected_enable_copy_move_for = expected_enable_copy_move<
+    std::is_copy_constructible<T>::value &&
+        std::is_copy_constructible<E>::value,
+    std::is_move_constructible<T>::value &&
+        std::is_move_constructible<E>::value>;
+
+// Deletes the copy and move assignments of `expected` unless both the value
+// and the error support them, and at least one of the two can be moved
+// without throwing (see `is_reinit_safe`).
+template <bool Copy, bool Move>
+struct expected_enable_assign {};
+
+template <>
+struct expected_enable_assign<false, true> {
+  expected_enable_assign() = default;
+  expected_enable_assign(expected_enable_assign const&) = default;
+  expected_enable_assign(expected_enable_assign&&) = default;
+  expected_enable_assign& operator=(expected_enable_assign const&) = delete;
+  expected_enable_assign& operator=(expected_enable_assign&&) = default;
+};
+
+template <>
+struct expected_enable_assign<true, false> {
+  expected_enable_assign() = default;
+  expected_enable_assign(expected_enable_assign const&) = default;
+  expected_enable_assign& operator=(expected_enable_assign const&) = default;
+};
+
+template <>
+struct expected_enable_assign<false, false> {
+  expected_enable_assign() = default;
+  expected_enable_assign(expected_enable_assign const&) = default;
+  expected_enable_assign& operator=(expected_enable_assign const&) = delete;
+};
+
+template <typename T, typename E>
+using expected_enable_assign_for = expected_enable_assign<
+    std::is_copy_constructible<T>::value &&
+        std::is_copy_assignable<T>::value &&
+        std::is_copy_constructible<E>::value &&
+        std::is_copy_assignable<E>::value &&
+        (std::is_nothrow_move_constructible<T>::value ||
+         std::is_nothrow_move_constructible<E>::value),
+    std::is_move_constructible<T>::value &&
+        std::is_move_assignable<T>::value &&
+        std::is_move_constructible<E>::value &&
+        std::is_move_assignable<E>::value &&
+        (std::is_nothrow_move_constructible<T>::value ||
+         std::is_nothrow_move_constructible<E>::value)>;
+
+// Whether `T` can be constructed from, or converted from, some form of `W`.
+template <typename T, typename W>
+struct is_constructible_from_any_cvref
+    : slb::bool_constant<std::is_constructible<T, W&>::value ||
+                         std::is_constructible<T, W>::value ||
+                         std::is_constructible<T, W const&>::value ||
+                         std::is_constructible<T, W const>::value ||
+                         std::is_convertible<W&, T>::value ||
+                         std::is_convertible<W, T>::value ||
+                         std::is_convertible<W const&, T>::value ||
+                         std::is_convertible<W const, T>::value> {};
+
+// The constraints on converting `expected<U, G>` to `expected<T, E>`, where
+// `UF` and `GF` are `U` and `G` as they are forwarded.
+template <typename T, typename E, typename U, typename G, typename UF,
+          typename GF>
+struct is_expected_convertible
+    : slb::bool_constant<
+          std::is_constructible<T, UF>::value &&
+          std::is_constructible<E, GF>::value &&
+          (std::is_same<bool, typename std::remove_cv<T>::type>::value ||
+           !is_constructible_from_any_cvref<T, expected<U, G>>::value) &&
+          !std::is_constructible<unexpected<E>, expected<U, G>&>::value &&
+          !std::is_constructible<unexpected<E>, expected<U, G>>::value &&
+          !std::is_constructible<unexpected<E>,
+                                 expected<U, G> const&>::value &&
+          !std::is_constructible<unexpected<E>,
+                                 expected<U, G> const>::value> {};
+
+template <typename Exp>
+using expected_value_t = typename remove_cvref<Exp>::type::value_type;
+
+template <typename Exp>
+using expected_error_t = typename remove_cvref<Exp>::type::error_type;
+
+// Invokes `f` with the value of `self`, or with no arguments if it is an
+// `expected<void, E>`. There is no `type` if `f` cannot be invoked so, which
+// leaves the monadic operations below out of overload resolution.
+template <typename F,
+          typename Exp,
+          bool = std::is_void<expected_value_t<Exp>>::value,
+          typename = void>
+struct expected_invoke_value {};
+
+template <typename F, typename Exp>
+struct expected_invoke_value<
+    F,
+    Exp,
+    false,
+    typename lib::always_void<typename slb::invoke_result<
+        F,
+        decltype(*std::declval<Exp>())>::type>::type> {
+  using type =
+      typename slb::invoke_result<F, decltype(*std::declval<Exp>())>::type;
+
+  static type call(F&& f, Exp&& self) {
+    return detail::invoke(SLB_FORWARD(F, f), *SLB_FORWARD(Exp, self));
+  }
+};
+
+template <typename F, typename Exp>
+struct expected_invoke_value<
+    F,
+    Exp,
+    true,
+    typename lib::always_void<typename slb::invoke_result<F>::type>::type> {
+  using type = typename slb::invoke_result<F>::type;
+
+  static type call(F&& f, Exp&&) { return detail::invoke(SLB_FORWARD(F, f)); }
+};
+
+template <typename F, typename Exp, typename = void>
+struct expected_invoke_error {};
+
+template <typename F, typename Exp>
+struct expected_invoke_error<
+    F,
+    Exp,
+    typename lib::always_void<typename slb::invoke_result<
+        F,
+        decltype(std::declval<Exp>().error())>::type>::type> {
+  using type = typename slb::invoke_result<
+      F,
+      decltype(std::declval<Exp>().error())>::type;
+
+  static type call(F&& f, Exp&& self) {
+    return detail::invoke(SLB_FORWARD(F, f), SLB_FORWARD(Exp, self).error());
+  }
+};
+
+// An `R` holding the value of `self`.
+template <typename R, typename Exp>
+R expected_with_value(std::false_type, Exp&& self) {
+  return R(in_place, *SLB_FORWARD(Exp, self));
+}
+
+template <typename R, typename Exp>
+R expected_with_value(std::true_type, Exp&&) {
+  return R();
+}
+
+template <typename F, typename Exp, typename = void>
+struct expected_and_then {};
+
+template <typename F, typename Exp>
+struct expected_and_then<
+    F,
+    Exp,
+    typename lib::always_void<
+        typename expected_invoke_value<F, Exp>::type>::type> {
+  using invoke = expected_invoke_value<F, Exp>;
+  using type = typename remove_cvref<typename invoke::type>::type;
+  static_assert(is_expected<type>::value,
+                "`and_then` requires `f` to return an `expected`.");
+  static_assert(std::is_same<typename type::error_type,
+                             expected_error_t<Exp>>::value,
+                "`and_then` requires `f` to return the same `error_type`.");
+
+  static type call(F&& f, Exp&& self) {
+    if (!self.has_value()) {
+      return type(unexpect, SLB_FORWARD(Exp, self).error());
+    }
+    return invoke::call(SLB_FORWARD(F, f), SLB_FORWARD(Exp, self));
+  }
+};
+
+template <typename F, typename Exp, typename = void>
+struct expected_or_else {};
+
+template <typename F, typename Exp>
+struct expected_or_else<
+    F,
+    Exp,
+    typename lib::always_void<
+        typename expected_invoke_error<F, Exp>::type>::type> {
+  using invoke = expected_invoke_error<F, Exp>;
+  using type = typename remove_cvref<typename invoke::type>::type;
+  static_assert(is_expected<type>::value,
+                "`or_else` requires `f` to return an `expected`.");
+  static_assert(std::is_same<typename type::value_type,
+                             expected_value_t<Exp>>::value,
+                "`or_else` requires `f` to return the same `value_type`.");
+
+  static type call(F&& f, Exp&& self) {
+    if (self.has_value()) {
+      return detail::expected_with_value<type>(
+          std::is_void<expected_value_t<Exp>>{}, SLB_FORWARD(Exp, self));
+    }
+    return invoke::call(SLB_FORWARD(F, f), SLB_FORWARD(Exp, self));
+  }
+};
+
+template <typename F, typename Exp, typename = void>
+struct expected_transform {};
+
+template <typename F, typename Exp>
+struct expected_transform<
+    F,
+    Exp,
+    typename lib::always_void<
+        typename expected_invoke_value<F, Exp>::type>::type> {
+  using invoke = expected_invoke_value<F, Exp>;
+  using value_type = typename std::remove_cv<typename invoke::type>::type;
+  using type = expected<value_type, expected_error_t<Exp>>;
+
+  static type call(F&& f, Exp&& self) {
+    if (!self.has_value()) {
+      return type(unexpect, SLB_FORWARD(Exp, self).error());
+    }
+    return make(std::is_void<value_type>{}, f, self);
+  }
+
+private:
+  static type make(std::false_type, F& f, Exp& self) {
+    return type(in_place,
+                invoke::call(SLB_FORWARD(F, f), SLB_FORWARD(Exp, self)));
+  }
+
+  static type make(std::true_type, F& f, Exp& self) {
+    invoke::call(SLB_FORWARD(F, f), SLB_FORWARD(Exp, self));
+    return type();
+  }
+};
+
+template <typename F, typename Exp, typename = void>
+struct expected_transform_error {};
+
+template <typename F, typename Exp>
+struct expected_transform_error<
+    F,
+    Exp,
+    typename lib::always_void<
+        typename expected_invoke_error<F, Exp>::type>::type> {
+  using invoke = expected_invoke_error<F, Exp>;
+  using error_type = typename std::remove_cv<typename invoke::type>::type;
+  using type = expected<expected_value_t<Exp>, error_type>;
+
+  static type call(F&& f, Exp&& self) {
+    if (self.has_value()) {
+      return detail::expected_with_value<type>(
+          std::is_void<expected_value_t<Exp>>{}, SLB_FORWARD(Exp, self));
+    }
+    return type(unexpect,
+                invoke::call(SLB_FORWARD(F, f), SLB_FORWARD(Exp, self)));
+  }
+};
+
+// Exchanges the value of `x` with the error of `y`, such that both are left
+// as they were if an exception is thrown.
+template <typename Base>
+void expected_swap_value_error(std::true_type, // nothrow movable error
+                               Base& x,
+                               Base& y) {
+  using E = decltype(y.unex_);
+  using T = decltype(x.val_);
+  E tmp(SLB_MOVE(y.unex_));
+  slb::destroy_at(std::addressof(y.unex_));
+  try {
+    ::new (detail::voidify(y.val_)) T(SLB_MOVE(x.val_));
+  } catch (...) {
+    ::new (detail::voidify(y.unex_)) E(SLB_MOVE(tmp));
+    throw;
+  }
+  slb::destroy_at(std::addressof(x.val_));
+  ::new (detail::voidify(x.unex_)) E(SLB_MOVE(tmp));
+  x.has_val_ = false;
+  y.has_val_ = true;
+}
+
+template <typename Base>
+void expected_swap_value_error(std::false_type, // nothrow movable value
+                               Base& x,
+                               Base& y) {
+  using E = decltype(y.unex_);
+  using T = decltype(x.val_);
+  T tmp(SLB_MOVE(x.val_));
+  slb::destroy_at(std::addressof(x.val_));
+  try {
+    ::new (detail::voidify(x.unex_)) E(SLB_MOVE(y.unex_));
+  } catch (...) {
+    ::new (detail::voidify(x.val_)) T(SLB_MOVE(tmp));
+    throw;
+  }
+  slb::destroy_at(std::addressof(y.unex_));
+  ::new (detail::voidify(y.val_)) T(SLB_MOVE(tmp));
+  x.has_val_ = false;
+  y.has_val_ = true;
+}
+
+template <typename Base>
+void expected_swap(Base& x, Base& y) {
+  using std::swap;
+  if (x.has_val_ && y.has_val_) {
+    swap(x.val_, y.val_);
+  } else if (!x.has_val_ && !y.has_val_) {
+    swap(x.unex_, y.unex_);
+  } else if (x.has_val_) {
+    detail::expected_swap_value_error(
+        std::is_nothrow_move_constructible<decltype(y.unex_)>{}, x, y);
+  } else {
+    detail::expected_swap_value_error(
+        std::is_nothrow_move_constructible<decltype(x.unex_)>{}, y, x);
+  }
+}
+
+} // namespace detail
+
+// [expected.expected], class template expected
+
+// Holds either a value of type `T` or an error of type `E` within itself; it
+// is trivially copyable if both `T` and `E` are, and trivially destructible
+// if both are, so that returning one costs no more than returning a
+// hand-rolled tagged union.
+template <typename T, typename E>
+class expected : private detail::expected_storage<T, E>,
+                 private detail::expected_enable_copy_move_for<T, E>,
+                 private detail::expected_enable_assign_for<T, E> {
+  static_assert(!std::is_reference<T>::value && !std::is_array<T>::value &&
+                    !std::is_function<T>::value &&
+                    !std::is_same<typename std::remove_cv<T>::type,
+                                  in_place_t>::value &&
+                    !std::is_same<typename std::remove_cv<T>::type,
+                                  unexpect_t>::value &&
+                    !detail::is_unexpected<
+                        typename std::remove_cv<T>::type>::value,
+                "`T` shall be an object type other than an array, `in_place_t`,"
+                " `unexpect_t`, or a specialization of `unexpected`.");
+  static_assert(detail::is_expected_error<E>::value,
+                "`E` shall be a non-array, non-cv object type that is not a "
+                "specialization of `unexpected`.");
+
+  using base = detail::expected_storage<T, E>;
+
+  template <typename, typename>
+  friend class expected;
+
+  template <typename U, typename G, typename UF, typename GF>
+  using is_convertible_from =
+      detail::is_expected_convertible<T, E, U, G, UF, GF>;
+
+  template <typename U>
+  using is_value_convertible = slb::bool_constant<
+      !std::is_same<typename remove_cvref<U>::type, in_place_t>::value &&
+      !std::is_same<typename remove_cvref<U>::type, expected>::value &&
+      !std::is_same<typename remove_cvref<U>::type, unexpect_t>::value &&
+      !detail::is_unexpected<typename remove_cvref<U>::type>::value &&
+      std::is_constructible<T, U>::value &&
+      (!std::is_same<bool, typename std::remove_cv<T>::type>::value ||
+       !detail::is_expected<typename remove_cvref<U>::type>::value)>;
+
+  // Assignments that change between a value and an error offer the strong
+  // guarantee, which needs one of them to be movable without throwing.
+  template <typename New, typename Arg>
+  using is_reinit_safe = slb::bool_constant<
+      std::is_nothrow_constructible<New, Arg>::value ||
+      std::is_nothrow_move_constructible<T>::value ||
+      std::is_nothrow_move_constructible<E>::value>;
+
+public:
+  using value_type = T;
+  using error_type = E;
+  using unexpected_type = unexpected<E>;
+
+  template <typename U>
+  using rebind = expected<U, error_type>;
+
+  // [expected.object.cons], constructors
+  template <typename U = T,
+            typename std::enable_if<std::is_default_constructible<U>::value,
+                                    int>::type = 0>
+  constexpr expected() : base(in_place) {}
+
+  template <typename U,
+            typename G,
+            typename std::enable_if<
+                is_convertible_from<U, G, U const&, G const&>::value &&
+                    std::is_convertible<U const&, T>::value &&
+                    std::is_convertible<G const&, E>::value,
+                int>::type = 0>
+  expected(expected<U, G> const& other)
+      : base(detail::expected_from_t{}, other.storage()) {}
+
+  template <typename U,
+            typename G,
+            typename std::enable_if<
+                is_convertible_from<U, G, U const&, G const&>::value &&
+                    !(std::is_convertible<U const&, T>::value &&
+                      std::is_convertible<G const&, E>::value),
+                int>::type = 0>
+  explicit expected(expected<U, G> const& other)
+      : base(detail::expected_from_t{}, other.storage()) {}
+
+  template <typename U,
+            typename G,
+            typename std::enable_if<is_convertible_from<U, G, U, G>::value &&
+                                        std::is_convertible<U, T>::value &&
+                                        std::is_convertible<G, E>::value,
+                                    int>::type = 0>
+  expected(expected<U, G>&& other)
+      : base(detail::expected_from_t{}, SLB_MOVE(other.storage())) {}
+
+  template <typename U,
+            typename G,
+            typename std::enable_if<is_convertible_from<U, G, U, G>::value &&
+                                        !(std::is_convertible<U, T>::value &&
+                                          std::is_convertible<G, E>::value),
+                                    int>::type = 0>
+  explicit expected(expected<U, G>&& other)
+      : base(detail::expected_from_t{}, SLB_MOVE(other.storage())) {}
+
+  template <typename U = T,
+            typename std::enable_if<is_value_convertible<U>::value &&
+                                        std::is_convertible<U, T>::value,
+                                    int>::type = 0>
+  constexpr expected(U&& v) : base(in_place, SLB_FORWARD(U, v)) {}
+
+  template <typename U = T,
+            typename std::enable_if<is_value_convertible<U>::value &&
+                                        !std::is_convertible<U, T>::value,
+                                    int>::type = 0>
+  constexpr explicit expected(U&& v) : base(in_place, SLB_FORWARD(U, v)) {}
+
+  template <typename G,
+            typename std::enable_if<
+                std::is_constructible<E, G const&>::value &&
+                    std::is_convertible<G const&, E>::value,
+                int>::type = 0>
+  constexpr expected(unexpected<G> const& e) : base(unexpect, e.error()) {}
+
+  template <typename G,
+            typename std::enable_if<
+                std::is_constructible<E, G const&>::value &&
+                    !std::is_convertible<G const&, E>::value,
+                int>::type = 0>
+  constexpr explicit expected(unexpected<G> const& e)
+      : base(unexpect, e.error()) {}
+
+  template <typename G,
+            typename std::enable_if<std::is_constructible<E, G>::value &&
+                                        std::is_convertible<G, E>::value,
+                                    int>::type = 0>
+  constexpr expected(unexpected<G>&& e)
+      : base(unexpect, SLB_MOVE(e).error()) {}
+
+  template <typename G,
+            typename std::enable_if<std::is_constructible<E, G>::value &&
+                                        !std::is_convertible<G, E>::value,
+                                    int>::type = 0>
+  constexpr explicit expected(unexpected<G>&& e)
+      : base(unexpect, SLB_MOVE(e).error()) {}
+
+  template <typename... Args,
+            typename std::enable_if<std::is_constructible<T, Args...>::value,
+                                    int>::type = 0>
+  constexpr explicit expected(in_place_t, Args&&... args)
+      : base(in_place, SLB_FORWARD(Args, args)...) {}
+
+  template <typename U,
+            typename... Args,
+            typename std::enable_if<
+                std::is_constructible<T,
+                                      std::initializer_list<U>&,
+                                      Args...>::value,
+                int>::type = 0>
+  constexpr explicit expected(in_place_t,
+                              std::initializer_list<U> il,
+                              Args&&... args)
+      : base(in_place, il, SLB_FORWARD(Args, args)...) {}
+
+  template <typename... Args,
+            typename std::enable_if<std::is_constructible<E, Args...>::value,
+                                    int>::type = 0>
+  constexpr explicit expected(unexpect_t, Args&&... args)
+      : base(unexpect, SLB_FORWARD(Args, args)...) {}
+
+  template <typename U,
+            typename... Args,
+            typename std::enable_if<
+                std::is_constructible<E,
+                                      std::initializer_list<U>&,
+                                      Args...>::value,
+                int>::type = 0>
+  constexpr explicit expected(unexpect_t,
+                              std::initializer_list<U> il,
+                              Args&&... args)
+      : base(unexpect, il, SLB_FORWARD(Args, args)...) {}
+
+  // [expected.object.assign], assignment
+  template <typename U = T,
+            typename std::enable_if<
+                !std::is_same<typename remove_cvref<U>::type,
+                              expected>::value &&
+                    !detail::is_unexpected<
+                        typename remove_cvref<U>::type>::value &&
+                    std::is_constructible<T, U>::value &&
+                    std::is_assignable<T&, U>::value &&
+                    is_reinit_safe<T, U>::value,
+                int>::type = 0>
+  expected& operator=(U&& v) {
+    detail::expected_assign_value(storage(), SLB_FORWARD(U, v));
+    return *this;
+  }
+
+  template <typename G,
+            typename std::enable_if<
+                std::is_constructible<E, G const&>::value &&
+                    std::is_assignable<E&, G const&>::value &&
+                    is_reinit_safe<E, G const&>::value,
+                int>::type = 0>
+  expected& operator=(unexpected<G> const& e) {
+    detail::expected_assign_error(storage(), e.error());
+    return *this;
+  }
+
+  template <typename G,
+            typename std::enable_if<std::is_constructible<E, G>::value &&
+                                        std::is_assignable<E&, G>::value &&
+                                        is_reinit_safe<E, G>::value,
+                                    int>::type = 0>
+  expected& operator=(unexpected<G>&& e) {
+    detail::expected_assign_error(storage(), SLB_MOVE(e).error());
+    return *this;
+  }
+
+  template <typename... Args,
+            typename std::enable_if<
+                std::is_nothrow_constructible<T, Args...>::value,
+                int>::type = 0>
+  T& emplace(Args&&... args) noexcept {
+    this->destroy();
+    ::new (detail::voidify(this->val_)) T(SLB_FORWARD(Args, args)...);
+    this->has_val_ = true;
+    return this->val_;
+  }
+
+  template <typename U,
+            typename... Args,
+            typename std::enable_if<
+                std::is_nothrow_constructible<T,
+                                              std::initializer_list<U>&,
+                                              Args...>::value,
+                int>::type = 0>
+  T& emplace(std::initializer_list<U> il, Args&&... args) noexcept {
+    this->destroy();
+    ::new (detail::voidify(this->val_)) T(il, SLB_FORWARD(Args, args)...);
+    this->has_val_ = true;
+    return this->val_;
+  }
+
+  // [expected.object.swap], swap
+  void swap(expected& other) noexcept(
+      std::is_nothrow_move_constructible<T>::value &&
+      slb::is_nothrow_swappable<T>::value &&
+      std::is_nothrow_move_constructible<E>::value &&
+      slb::is_nothrow_swappable<E>::value) {
+    detail::expected_swap(storage(), other.storage());
+  }
+
+  friend void swap(expected& x, expected& y) noexcept(noexcept(x.swap(y))) {
+    x.swap(y);
+  }
+
+  // [expected.object.obs], observers
+  T const* operator->() const noexcept { return std::addressof(this->val_); }
+  T* operator->() noexcept { return std::addressof(this->val_); }
+  constexpr T const& operator*() const& noexcept { return this->val_; }
+  SLB_CXX14_CONSTEXPR T& operator*() & noexcept { return this->val_; }
+  constexpr T const&& operator*() const&& noexcept {
+    return SLB_MOVE(this->val_);
+  }
+  SLB_CXX14_CONSTEXPR T&& operator*() && noexcept {
+    return SLB_MOVE(this->val_);
+  }
+
+  constexpr explicit operator bool() const noexcept { return this->has_val_; }
+  constexpr bool has_value() const noexcept { return this->has_val_; }
+
+  SLB_CXX14_CONSTEXPR T const& value() const& {
+    if (!this->has_val_) {
+      throw bad_expected_access<E>(slb::as_const(this->unex_));
+    }
+    return this->val_;
+  }
+
+  SLB_CXX14_CONSTEXPR T& value() & {
+    if (!this->has_val_) {
+      throw bad_expected_access<E>(slb::as_const(this->unex_));
+    }
+    return this->val_;
+  }
+
+  SLB_CXX14_CONSTEXPR T const&& value() const&& {
+    if (!this->has_val_) {
+      throw bad_expected_access<E>(SLB_MOVE(this->unex_));
+    }
+    return SLB_MOVE(this->val_);
+  }
+
+  SLB_CXX14_CONSTEXPR T&& value() && {
+    if (!this->has_val_) {
+      throw bad_expected_access<E>(SLB_MOVE(this->unex_));
+    }
+    return SLB_MOVE(this->val_);
+  }
+
+  constexpr E const& error() const& noexcept { return this->unex_; }
+  SLB_CXX14_CONSTEXPR E& error() & noexcept { return this->unex_; }
+  constexpr E const&& error() const&& noexcept {
+    return SLB_MOVE(this->unex_);
+  }
+  SLB_CXX14_CONSTEXPR E&& error() && noexcept { return SLB_MOVE(this->unex_); }
+
+  template <typename U>
+  constexpr T value_or(U&& v) const& {
+    return this->has_val_ ? this->val_ : static_cast<T>(SLB_FORWARD(U, v));
+  }
+
+  template <typename U>
+  SLB_CXX14_CONSTEXPR T value_or(U&& v) && {
+    return this->has_val_ ? SLB_MOVE(this->val_)
+                          : static_cast<T>(SLB_FORWARD(U, v));
+  }
+
+  template <typename G = E>
+  constexpr E error_or(G&& e) const& {
+    return this->has_val_ ? static_cast<E>(SLB_FORWARD(G, e)) : this->unex_;
+  }
+
+  template <typename G = E>
+  SLB_CXX14_CONSTEXPR E error_or(G&& e) && {
+    return this->has_val_ ? static_cast<E>(SLB_FORWARD(G, e))
+                          : SLB_MOVE(this->unex_);
+  }
+
+  // [expected.object.monadic], monadic operations
+  template <typename F>
+  typename detail::expected_and_then<F, expected&>::type and_then(F&& f) & {
+    return detail::expected_and_then<F, expected&>::call(SLB_FORWARD(F, f),
+                                                         *this);
+  }
+
+  template <typename F>
+  typename detail::expected_and_then<F, expected const&>::type and_then(
+      F&& f) const& {
+    return detail::expected_and_then<F, expected const&>::call(
+        SLB_FORWARD(F, f), *this);
+  }
+
+  template <typename F>
+  typename detail::expected_and_then<F, expected>::type and_then(F&& f) && {
+    return detail::expected_and_then<F, expected>::call(SLB_FORWARD(F, f),
+                                                        SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_and_then<F, expected const>::type and_then(
+      F&& f) const&& {
+    return detail::expected_and_then<F, expected const>::call(
+        SLB_FORWARD(F, f), SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_or_else<F, expected&>::type or_else(F&& f) & {
+    return detail::expected_or_else<F, expected&>::call(SLB_FORWARD(F, f),
+                                                        *this);
+  }
+
+  template <typename F>
+  typename detail::expected_or_else<F, expected const&>::type or_else(
+      F&& f) const& {
+    return detail::expected_or_else<F, expected const&>::call(
+        SLB_FORWARD(F, f), *this);
+  }
+
+  template <typename F>
+  typename detail::expected_or_else<F, expected>::type or_else(F&& f) && {
+    return detail::expected_or_else<F, expected>::call(SLB_FORWARD(F, f),
+                                                       SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_or_else<F, expected const>::type or_else(
+      F&& f) const&& {
+    return detail::expected_or_else<F, expected const>::call(
+        SLB_FORWARD(F, f), SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_transform<F, expected&>::type transform(F&& f) & {
+    return detail::expected_transform<F, expected&>::call(SLB_FORWARD(F, f),
+                                                          *this);
+  }
+
+  template <typename F>
+  typename detail::expected_transform<F, expected const&>::type transform(
+      F&& f) const& {
+    return detail::expected_transform<F, expected const&>::call(
+        SLB_FORWARD(F, f), *this);
+  }
+
+  template <typename F>
+  typename detail::expected_transform<F, expected>::type transform(F&& f) && {
+    return detail::expected_transform<F, expected>::call(SLB_FORWARD(F, f),
+                                                         SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_transform<F, expected const>::type transform(
+      F&& f) const&& {
+    return detail::expected_transform<F, expected const>::call(
+        SLB_FORWARD(F, f), SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_transform_error<F, expected&>::type
+  transform_error(F&& f) & {
+    return detail::expected_transform_error<F, expected&>::call(
+        SLB_FORWARD(F, f), *this);
+  }
+
+  template <typename F>
+  typename detail::expected_transform_error<F, expected const&>::type
+  transform_error(F&& f) const& {
+    return detail::expected_transform_error<F, expected const&>::call(
+        SLB_FORWARD(F, f), *this);
+  }
+
+  template <typename F>
+  typename detail::expected_transform_error<F, expected>::type
+  transform_error(F&& f) && {
+    return detail::expected_transform_error<F, expected>::call(
+        SLB_FORWARD(F, f), SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_transform_error<F, expected const>::type
+  transform_error(F&& f) const&& {
+    return detail::expected_transform_error<F, expected const>::call(
+        SLB_FORWARD(F, f), SLB_MOVE(*this));
+  }
+
+  // [expected.object.eq], equality operators
+  template <typename T2,
+            typename E2,
+            typename std::enable_if<!std::is_void<T2>::value, int>::type = 0>
+  friend constexpr bool operator==(expected const& x,
+                                   expected<T2, E2> const& y) {
+    return x.has_value() != y.has_value()
+               ? false
+               : x.has_value() ? *x == *y : x.error() == y.error();
+  }
+
+  template <typename T2,
+            typename E2,
+            typename std::enable_if<!std::is_void<T2>::value, int>::type = 0>
+  friend constexpr bool operator!=(expected const& x,
+                                   expected<T2, E2> const& y) {
+    return !(x == y);
+  }
+
+  template <typename T2,
+            typename std::enable_if<
+                !detail::is_expected<T2>::value &&
+                    !detail::is_unexpected<T2>::value,
+                int>::type = 0>
+  friend constexpr bool operator==(expected const& x, T2 const& v) {
+    return x.has_value() && static_cast<bool>(*x == v);
+  }
+
+  template <typename T2,
+            typename std::enable_if<
+                !detail::is_expected<T2>::value &&
+                    !detail::is_unexpected<T2>::value,
+                int>::type = 0>
+  friend constexpr bool operator==(T2 const& v, expected const& x) {
+    return x == v;
+  }
+
+  template <typename T2,
+            typename std::enable_if<
+                !detail::is_expected<T2>::value &&
+                    !detail::is_unexpected<T2>::value,
+                int>::type = 0>
+  friend constexpr bool operator!=(expected const& x, T2 const& v) {
+    return !(x == v);
+  }
+
+  template <typename T2,
+            typename std::enable_if<
+                !detail::is_expected<T2>::value &&
+                    !detail::is_unexpected<T2>::value,
+                int>::type = 0>
+  friend constexpr bool operator!=(T2 const& v, expected const& x) {
+    return !(x == v);
+  }
+
+  template <typename E2>
+  friend constexpr bool operator==(expected const& x,
+                                   unexpected<E2> const& e) {
+    return !x.has_value() && static_cast<bool>(x.error() == e.error());
+  }
+
+  template <typename E2>
+  friend constexpr bool operator==(unexpected<E2> const& e,
+                                   expected const& x) {
+    return x == e;
+  }
+
+  template <typename E2>
+  friend constexpr bool operator!=(expected const& x,
+                                   unexpected<E2> const& e) {
+    return !(x == e);
+  }
+
+  template <typename E2>
+  friend constexpr bool operator!=(unexpected<E2> const& e,
+                                   expected const& x) {
+    return !(x == e);
+  }
+
+private:
+  base& storage() noexcept { return *this; }
+  base const& storage() const noexcept { return *this; }
+};
+
+// [expected.void], partial specialization of expected for void types
+template <typename E>
+class expected<void, E>
+    : private detail::expected_storage<detail::expected_void, E>,
+      private detail::expected_enable_copy_move_for<detail::expected_void, E>,
+      private detail::expected_enable_assign_for<detail::expected_void, E> {
+  static_assert(detail::is_expected_error<E>::value,
+                "`E` shall be a non-array, non-cv object type that is not a "
+                "specialization of `unexpected`.");
+
+  using base = detail::expected_storage<detail::expected_void, E>;
+
+  template <typename, typename>
+  friend class expected;
+
+  template <typename U, typename G, typename GF>
+  using is_convertible_from = slb::bool_constant<
+      std::is_void<U>::value && std::is_constructible<E, GF>::value &&
+      !std::is_constructible<unexpected<E>, expected<U, G>&>::value &&
+      !std::is_constructible<unexpected<E>, expected<U, G>>::value &&
+      !std::is_constructible<unexpected<E>, expected<U, G> const&>::value &&
+      !std::is_constructible<unexpected<E>, expected<U, G> const>::value>;
+
+  template <typename Arg>
+  using is_reinit_safe = slb::bool_constant<
+      std::is_nothrow_constructible<E, Arg>::value ||
+      std::is_nothrow_move_constructible<E>::value>;
+
+public:
+  using value_type = void;
+  using error_type = E;
+  using unexpected_type = unexpected<E>;
+
+  template <typename U>
+  using rebind = expected<U, error_type>;
+
+  // [expected.void.cons], constructors
+  constexpr expected() noexcept : base(in_place) {}
+
+  template <typename U,
+            typename G,
+            typename std::enable_if<
+                is_convertible_from<U, G, G const&>::value &&
+                    std::is_convertible<G const&, E>::value,
+                int>::type = 0>
+  expected(expected<U, G> const& other)
+      : base(detail::expected_from_t{}, other.storage()) {}
+
+  template <typename U,
+            typename G,
+            typename std::enable_if<
+                is_convertible_from<U, G, G const&>::value &&
+                    !std::is_convertible<G const&, E>::value,
+                int>::type = 0>
+  explicit expected(expected<U, G> const& other)
+      : base(detail::expected_from_t{}, other.storage()) {}
+
+  template <typename U,
+            typename G,
+            typename std::enable_if<is_convertible_from<U, G, G>::value &&
+                                        std::is_convertible<G, E>::value,
+                                    int>::type = 0>
+  expected(expected<U, G>&& other)
+      : base(detail::expected_from_t{}, SLB_MOVE(other.storage())) {}
+
+  template <typename U,
+            typename G,
+            typename std::enable_if<is_convertible_from<U, G, G>::value &&
+                                        !std::is_convertible<G, E>::value,
+                                    int>::type = 0>
+  explicit expected(expected<U, G>&& other)
+      : base(detail::expected_from_t{}, SLB_MOVE(other.storage())) {}
+
+  template <typename G,
+            typename std::enable_if<
+                std::is_constructible<E, G const&>::value &&
+                    std::is_convertible<G const&, E>::value,
+                int>::type = 0>
+  constexpr expected(unexpected<G> const& e) : base(unexpect, e.error()) {}
+
+  template <typename G,
+            typename std::enable_if<
+                std::is_constructible<E, G const&>::value &&
+                    !std::is_convertible<G const&, E>::value,
+                int>::type = 0>
+  constexpr explicit expected(unexpected<G> const& e)
+      : base(unexpect, e.error()) {}
+
+  template <typename G,
+            typename std::enable_if<std::is_constructible<E, G>::value &&
+                                        std::is_convertible<G, E>::value,
+                                    int>::type = 0>
+  constexpr expected(unexpected<G>&& e)
+      : base(unexpect, SLB_MOVE(e).error()) {}
+
+  template <typename G,
+            typename std::enable_if<std::is_constructible<E, G>::value &&
+                                        !std::is_convertible<G, E>::value,
+                                    int>::type = 0>
+  constexpr explicit expected(unexpected<G>&& e)
+      : base(unexpect, SLB_MOVE(e).error()) {}
+
+  constexpr explicit expected(in_place_t) noexcept : base(in_place) {}
+
+  template <typename... Args,
+            typename std::enable_if<std::is_constructible<E, Args...>::value,
+                                    int>::type = 0>
+  constexpr explicit expected(unexpect_t, Args&&... args)
+      : base(unexpect, SLB_FORWARD(Args, args)...) {}
+
+  template <typename U,
+            typename... Args,
+            typename std::enable_if<
+                std::is_constructible<E,
+                                      std::initializer_list<U>&,
+                                      Args...>::value,
+                int>::type = 0>
+  constexpr explicit expected(unexpect_t,
+                              std::initializer_list<U> il,
+                              Args&&... args)
+      : base(unexpect, il, SLB_FORWARD(Args, args)...) {}
+
+  // [expected.void.assign], assignment
+  template <typename G,
+            typename std::enable_if<
+                std::is_constructible<E, G const&>::value &&
+                    std::is_assignable<E&, G const&>::value &&
+                    is_reinit_safe<G const&>::value,
+                int>::type = 0>
+  expected& operator=(unexpected<G> const& e) {
+    detail::expected_assign_error(storage(), e.error());
+    return *this;
+  }
+
+  template <typename G,
+            typename std::enable_if<std::is_constructible<E, G>::value &&
+                                        std::is_assignable<E&, G>::value &&
+                                        is_reinit_safe<G>::value,
+                                    int>::type = 0>
+  expected& operator=(unexpected<G>&& e) {
+    detail::expected_assign_error(storage(), SLB_MOVE(e).error());
+    return *this;
+  }
+
+  void emplace() noexcept {
+    this->destroy();
+    ::new (detail::voidify(this->val_)) detail::expected_void();
+    this->has_val_ = true;
+  }
+
+  // [expected.void.swap], swap
+  void swap(expected& other) noexcept(
+      std::is_nothrow_move_constructible<E>::value &&
+      slb::is_nothrow_swappable<E>::value) {
+    detail::expected_swap(storage(), other.storage());
+  }
+
+  friend void swap(expected& x, expected& y) noexcept(noexcept(x.swap(y))) {
+    x.swap(y);
+  }
+
+  // [expected.void.obs], observers
+  constexpr explicit operator bool() const noexcept { return this->has_val_; }
+  constexpr bool has_value() const noexcept { return this->has_val_; }
+
+  SLB_CXX14_CONSTEXPR void operator*() const noexcept {}
+
+  SLB_CXX14_CONSTEXPR void value() const& {
+    if (!this->has_val_) {
+      throw bad_expected_access<E>(this->unex_);
+    }
+  }
+
+  SLB_CXX14_CONSTEXPR void value() && {
+    if (!this->has_val_) {
+      throw bad_expected_access<E>(SLB_MOVE(this->unex_));
+    }
+  }
+
+  constexpr E const& error() const& noexcept { return this->unex_; }
+  SLB_CXX14_CONSTEXPR E& error() & noexcept { return this->unex_; }
+  constexpr E const&& error() const&& noexcept {
+    return SLB_MOVE(this->unex_);
+  }
+  SLB_CXX14_CONSTEXPR E&& error() && noexcept { return SLB_MOVE(this->unex_); }
+
+  template <typename G = E>
+  constexpr E error_or(G&& e) const& {
+    return this->has_val_ ? static_cast<E>(SLB_FORWARD(G, e)) : this->unex_;
+  }
+
+  template <typename G = E>
+  SLB_CXX14_CONSTEXPR E error_or(G&& e) && {
+    return this->has_val_ ? static_cast<E>(SLB_FORWARD(G, e))
+                          : SLB_MOVE(this->unex_);
+  }
+
+  // [expected.void.monadic], monadic operations
+  template <typename F>
+  typename detail::expected_and_then<F, expected&>::type and_then(F&& f) & {
+    return detail::expected_and_then<F, expected&>::call(SLB_FORWARD(F, f),
+                                                         *this);
+  }
+
+  template <typename F>
+  typename detail::expected_and_then<F, expected const&>::type and_then(
+      F&& f) const& {
+    return detail::expected_and_then<F, expected const&>::call(
+        SLB_FORWARD(F, f), *this);
+  }
+
+  template <typename F>
+  typename detail::expected_and_then<F, expected>::type and_then(F&& f) && {
+    return detail::expected_and_then<F, expected>::call(SLB_FORWARD(F, f),
+                                                        SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_and_then<F, expected const>::type and_then(
+      F&& f) const&& {
+    return detail::expected_and_then<F, expected const>::call(
+        SLB_FORWARD(F, f), SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_or_else<F, expected&>::type or_else(F&& f) & {
+    return detail::expected_or_else<F, expected&>::call(SLB_FORWARD(F, f),
+                                                        *this);
+  }
+
+  template <typename F>
+  typename detail::expected_or_else<F, expected const&>::type or_else(
+      F&& f) const& {
+    return detail::expected_or_else<F, expected const&>::call(
+        SLB_FORWARD(F, f), *this);
+  }
+
+  template <typename F>
+  typename detail::expected_or_else<F, expected>::type or_else(F&& f) && {
+    return detail::expected_or_else<F, expected>::call(SLB_FORWARD(F, f),
+                                                       SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_or_else<F, expected const>::type or_else(
+      F&& f) const&& {
+    return detail::expected_or_else<F, expected const>::call(
+        SLB_FORWARD(F, f), SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_transform<F, expected&>::type transform(F&& f) & {
+    return detail::expected_transform<F, expected&>::call(SLB_FORWARD(F, f),
+                                                          *this);
+  }
+
+  template <typename F>
+  typename detail::expected_transform<F, expected const&>::type transform(
+      F&& f) const& {
+    return detail::expected_transform<F, expected const&>::call(
+        SLB_FORWARD(F, f), *this);
+  }
+
+  template <typename F>
+  typename detail::expected_transform<F, expected>::type transform(F&& f) && {
+    return detail::expected_transform<F, expected>::call(SLB_FORWARD(F, f),
+                                                         SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_transform<F, expected const>::type transform(
+      F&& f) const&& {
+    return detail::expected_transform<F, expected const>::call(
+        SLB_FORWARD(F, f), SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_transform_error<F, expected&>::type
+  transform_error(F&& f) & {
+    return detail::expected_transform_error<F, expected&>::call(
+        SLB_FORWARD(F, f), *this);
+  }
+
+  template <typename F>
+  typename detail::expected_transform_error<F, expected const&>::type
+  transform_error(F&& f) const& {
+    return detail::expected_transform_error<F, expected const&>::call(
+        SLB_FORWARD(F, f), *this);
+  }
+
+  template <typename F>
+  typename detail::expected_transform_error<F, expected>::type
+  transform_error(F&& f) && {
+    return detail::expected_transform_error<F, expected>::call(
+        SLB_FORWARD(F, f), SLB_MOVE(*this));
+  }
+
+  template <typename F>
+  typename detail::expected_transform_error<F, expected const>::type
+  transform_error(F&& f) const&& {
+    return detail::expected_transform_error<F, expected const>::call(
+        SLB_FORWARD(F, f), SLB_MOVE(*this));
+  }
+
+  // [expected.void.eq], equality operators
+  template <typename T2,
+            typename E2,
+            typename std::enable_if<std::is_void<T2>::value, int>::type = 0>
+  friend constexpr bool operator==(expected const& x,
+                                   expected<T2, E2> const& y) {
+    return x.has_value() != y.has_value()
+               ? false
+               : x.has_value() || static_cast<bool>(x.error() == y.error());
+  }
+
+  template <typename T2,
+            typename E2,
+            typename std::enable_if<std::is_void<T2>::value, int>::type = 0>
+  friend constexpr bool operator!=(expected const& x,
+                                   expected<T2, E2> const& y) {
+    return !(x == y);
+  }
+
+  template <typename E2>
+  friend constexpr bool operator==(expected const& x,
+                                   unexpected<E2> const& e) {
+    return !x.has_value() && static_cast<bool>(x.error() == e.error());
+  }
+
+  template <typename E2>
+  friend constexpr bool operator==(unexpected<E2> const& e,
+                                   expected const& x) {
+    return x == e;
+  }
+
+  template <typename E2>
+  friend constexpr bool operator!=(expected const& x,
+                                   unexpected<E2> const& e) {
+    return !(x == e);
+  }
+
+  template <typename E2>
+  friend constexpr bool operator!=(unexpected<E2> const& e,
+                                   expected const& x) {
+    return !(x == e);
+  }
+
+private:
+  base& storage() noexcept { return *this; }
+  base const& storage() const noexcept { return *this; }
+};
+#endif
+
+} // namespace slb
+
+#endif // SLB_EXPECTED_HPP
@@ -0,0 +1,912 @@
+/*
+  SLB.FlatMap
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_FLAT_MAP_HPP
+#define SLB_FLAT_MAP_HPP
+
+/*
+
+Header <flat_map> synopsis [flat.map.syn]
+
+namespace std {
+  // [flat.map], class template flat_map
+  template<class Key, class T, class Compare = less<Key>,
+           class KeyContainer = vector<Key>,
+           class MappedContainer = vector<T>>
+    class flat_map;
+
+  struct sorted_unique_t { explicit sorted_unique_t() = default; };
+  inline constexpr sorted_unique_t sorted_unique{};
+
+  // [flat.map.erasure], erasure for flat_map
+  template<class Key, class T, class Compare, class KeyContainer,
+           class MappedContainer, class Predicate>
+    typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type
+      erase_if(flat_map<Key, T, Compare, KeyContainer, MappedContainer>& c,
+               Predicate pred);
+}
+
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "detail/config.hpp"
+#include "detail/flat.hpp"
+#include "detail/lib.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+
+#if __has_include(<flat_map>)
+#include <flat_map>
+#endif
+
+namespace slb {
+
+#if __cpp_lib_flat_map // C++23
+using std::flat_map;
+using std::erase_if;
+#else
+template <typename Key,
+          typename T,
+          typename Compare,
+          typename KeyContainer,
+          typename MappedContainer>
+class flat_map;
+
+namespace detail {
+
+// `operator->` of an iterator whose `reference` is not a language reference.
+template <typename Reference>
+class arrow_proxy {
+public:
+  Reference const* operator->() const noexcept {
+    return std::addressof(reference_);
+  }
+
+private:
+  explicit arrow_proxy(Reference reference) : reference_(reference) {}
+
+  template <typename, typename, typename, typename>
+  friend class flat_map_iterator;
+
+  Reference reference_;
+};
+
+// Walks the key and mapped containers in lockstep, yielding pairs of
+// references to a key and its mapped value.
+template <typename Key, typename T, typename KeyIt, typename MappedIt>
+class flat_map_iterator {
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::pair<Key, T>;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::pair<
+      Key const&,
+      typename std::iterator_traits<MappedIt>::reference>;
+  using pointer = arrow_proxy<reference>;
+
+  flat_map_iterator() = default;
+
+  template <typename OtherMappedIt,
+            typename = typename std::enable_if<
+                !std::is_same<OtherMappedIt, MappedIt>::value &&
+                std::is_convertible<OtherMappedIt, MappedIt>::value>::type>
+  flat_map_iterator(
+      flat_map_iterator<Key, T, KeyIt, OtherMappedIt> const& other)
+      : key_it_(other.key_it_), mapped_it_(other.mapped_it_) {}
+
+  reference operator*() const { return reference(*key_it_, *mapped_it_); }
+  pointer operator->() const { return pointer(**this); }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  flat_map_iterator& operator++() {
+    ++key_it_;
+    ++mapped_it_;
+    return *this;
+  }
+
+  flat_map_iterator operator++(int) {
+    flat_map_iterator result = *this;
+    ++*this;
+    return result;
+  }
+
+  flat_map_iterator& operator--() {
+    --key_it_;
+    --mapped_it_;
+    return *this;
+  }
+
+  flat_map_iterator operator--(int) {
+    flat_map_iterator result = *this;
+    --*this;
+    return result;
+  }
+
+  flat_map_iterator& operator+=(difference_type n) {
+    key_it_ += n;
+    mapped_it_ += n;
+    return *this;
+  }
+
+  flat_map_iterator& operator-=(difference_type n) { return *this += -n; }
+
+  friend flat_map_iterator operator+(flat_map_iterator it, difference_type n) {
+    return it += n;
+  }
+
+  friend flat_map_iterator operator+(difference_type n, flat_map_iterator it) {
+    return it += n;
+  }
+
+  friend flat_map_iterator operator-(flat_map_iterator it, difference_type n) {
+    return it -= n;
+  }
+
+  friend difference_type operator-(flat_map_iterator const& x,
+                                   flat_map_iterator const& y) {
+    return x.key_it_ - y.key_it_;
+  }
+
+  friend bool operator==(flat_map_iterator const& x,
+                         flat_map_iterator const& y) {
+    return x.key_it_ == y.key_it_;
+  }
+
+  friend bool operator!=(flat_map_iterator const& x,
+                         flat_map_iterator const& y) {
+    return x.key_it_ != y.key_it_;
+  }
+
+  friend bool operator<(flat_map_iterator const& x,
+                        flat_map_iterator const& y) {
+    return x.key_it_ < y.key_it_;
+  }
+
+  friend bool operator>(flat_map_iterator const& x,
+                        flat_map_iterator const& y) {
+    return y < x;
+  }
+
+  friend bool operator<=(flat_map_iterator const& x,
+                         flat_map_iterator const& y) {
+    return !(y < x);
+  }
+
+  friend bool operator>=(flat_map_iterator const& x,
+                         flat_map_iterator const& y) {
+    return !(x < y);
+  }
+
+private:
+  flat_map_iterator(KeyIt key_it, MappedIt mapped_it)
+      : key_it_(key_it), mapped_it_(mapped_it) {}
+
+  template <typename, typename, typename, typename>
+  friend class flat_map_iterator;
+
+  template <typename, typename, typename, typename, typename>
+  friend class slb::flat_map;
+
+  KeyIt key_it_;
+  MappedIt mapped_it_;
+};
+
+} // namespace detail
+
+// [flat.map], class template flat_map
+template <typename Key,
+          typename T,
+          typename Compare = std::less<Key>,
+          typename KeyContainer = std::vector<Key>,
+          typename MappedContainer = std::vector<T>>
+class flat_map {
+  static_assert(std::is_same<Key, typename KeyContainer::value_type>::value,
+                "`KeyContainer::value_type` shall be `Key`.");
+  static_assert(std::is_same<T, typename MappedContainer::value_type>::value,
+                "`MappedContainer::value_type` shall be `T`.");
+
+public:
+  // types
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = std::pair<key_type const&, mapped_type&>;
+  using const_reference = std::pair<key_type const&, mapped_type const&>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator =
+      detail::flat_map_iterator<Key,
+                                T,
+                                typename KeyContainer::const_iterator,
+                                typename MappedContainer::iterator>;
+  using const_iterator =
+      detail::flat_map_iterator<Key,
+                                T,
+                                typename KeyContainer::const_iterator,
+                                typename MappedContainer::const_iterator>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using key_container_type = KeyContainer;
+  using mapped_container_type = MappedContainer;
+
+  class value_compare {
+  public:
+    bool operator()(const_reference x, const_reference y) const {
+      return comp(x.first, y.first);
+    }
+
+  private:
+    explicit value_compare(key_compare c) : comp(c) {}
+
+    friend class flat_map;
+
+    key_compare comp;
+  };
+
+  struct containers {
+    key_container_type keys;
+    mapped_container_type values;
+  };
+
+  // [flat.map.cons], constructors
+  flat_map() : flat_map(key_compare()) {}
+
+  flat_map(key_container_type key_cont,
+           mapped_container_type mapped_cont,
+           key_compare const& comp = key_compare())
+      : c_{std::move(key_cont), std::move(mapped_cont)}, compare_(comp) {
+    sort_and_unique(0);
+  }
+
+  flat_map(sorted_unique_t,
+           key_container_type key_cont,
+           mapped_container_type mapped_cont,
+           key_compare const& comp = key_compare())
+      : c_{std::move(key_cont), std::move(mapped_cont)}, compare_(comp) {}
+
+  explicit flat_map(key_compare const& comp) : c_(), compare_(comp) {}
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  flat_map(InputIt first,
+           InputIt last,
+           key_compare const& comp = key_compare())
+      : c_(), compare_(comp) {
+    insert(first, last);
+  }
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  flat_map(sorted_unique_t s,
+           InputIt first,
+           InputIt last,
+           key_compare const& comp = key_compare())
+      : c_(), compare_(comp) {
+    insert(s, first, last);
+  }
+
+  flat_map(std::initializer_list<value_type> il,
+           key_compare const& comp = key_compare())
+      : flat_map(il.begin(), il.end(), comp) {}
+
+  flat_map(sorted_unique_t s,
+           std::initializer_list<value_type> il,
+           key_compare const& comp = key_compare())
+      : flat_map(s, il.begin(), il.end(), comp) {}
+
+  flat_map& operator=(std::initializer_list<value_type> il) {
+    clear();
+    insert(il);
+    return *this;
+  }
+
+  // iterators
+  iterator begin() noexcept { return iterator_at(0); }
+  const_iterator begin() const noexcept { return iterator_at(0); }
+  iterator end() noexcept { return iterator_at(size()); }
+  const_iterator end() const noexcept { return iterator_at(size()); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  // [flat.map.capacity], capacity
+  bool empty() const noexcept { return c_.keys.empty(); }
+  size_type size() const noexcept { return c_.keys.size(); }
+  size_type max_size() const noexcept {
+    return (std::min<size_type>)(c_.keys.max_size(), c_.values.max_size());
+  }
+
+  // [flat.map.access], element access
+  mapped_type& operator[](key_type const& x) {
+    return (*try_emplace(x).first).second;
+  }
+
+  mapped_type& operator[](key_type&& x) {
+    return (*try_emplace(std::move(x)).first).second;
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  mapped_type& operator[](K&& x) {
+    return (*try_emplace(std::forward<K>(x)).first).second;
+  }
+
+  mapped_type& at(key_type const& x) { return at_key(x); }
+  mapped_type const& at(key_type const& x) const { return at_key(x); }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  mapped_type& at(K const& x) {
+    return at_key(x);
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  mapped_type const& at(K const& x) const {
+    return at_key(x);
+  }
+
+  // [flat.map.modifiers], modifiers
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type x(std::forward<Args>(args)...);
+    return try_emplace(std::move(x.first), std::move(x.second));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  std::pair<iterator, bool> insert(value_type const& x) {
+    return try_emplace(x.first, x.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& x) {
+    return try_emplace(std::move(x.first), std::move(x.second));
+  }
+
+  template <typename P,
+            typename = typename std::enable_if<
+                std::is_constructible<value_type, P>::value>::type>
+  std::pair<iterator, bool> insert(P&& x) {
+    return emplace(std::forward<P>(x));
+  }
+
+  iterator insert(const_iterator, value_type const& x) {
+    return insert(x).first;
+  }
+
+  iterator insert(const_iterator, value_type&& x) {
+    return insert(std::move(x)).first;
+  }
+
+  // Appends the new elements, sorts them, and merges them into place, keeping
+  // the existing element of any equivalent pair.
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  void insert(InputIt first, InputIt last) {
+    size_type const size = this->size();
+    append(first, last);
+    sort_and_unique(size);
+  }
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  void insert(sorted_unique_t, InputIt first, InputIt last) {
+    size_type const size = this->size();
+    append(first, last);
+    merge_and_unique(size);
+  }
+
+  void insert(std::initializer_list<value_type> il) {
+    insert(il.begin(), il.end());
+  }
+
+  void insert(sorted_unique_t s, std::initializer_list<value_type> il) {
+    insert(s, il.begin(), il.end());
+  }
+
+  containers extract() && {
+    containers c = std::move(c_);
+    clear();
+    return c;
+  }
+
+  // Precondition: `key_cont` is sorted and free of equivalent elements, and
+  // has as many elements as `mapped_cont`.
+  void replace(key_container_type&& key_cont,
+               mapped_container_type&& mapped_cont) {
+    try {
+      c_.keys = std::move(key_cont);
+      c_.values = std::move(mapped_cont);
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type const& k, Args&&... args) {
+    return try_emplace_key(k, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& k, Args&&... args) {
+    return try_emplace_key(std::move(k), std::forward<Args>(args)...);
+  }
+
+  template <typename K,
+            typename... Args,
+            typename = detail::enable_if_transparent<Compare, K>,
+            typename = typename std::enable_if<
+                !std::is_convertible<K, const_iterator>::value &&
+                !std::is_convertible<K, iterator>::value>::type>
+  std::pair<iterator, bool> try_emplace(K&& k, Args&&... args) {
+    return try_emplace_key(std::forward<K>(k), std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  iterator try_emplace(const_iterator, key_type const& k, Args&&... args) {
+    return try_emplace_key(k, std::forward<Args>(args)...).first;
+  }
+
+  template <typename... Args>
+  iterator try_emplace(const_iterator, key_type&& k, Args&&... args) {
+    return try_emplace_key(std::move(k), std::forward<Args>(args)...).first;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(key_type const& k, M&& obj) {
+    return insert_or_assign_key(k, std::forward<M>(obj));
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(key_type&& k, M&& obj) {
+    return insert_or_assign_key(std::move(k), std::forward<M>(obj));
+  }
+
+  template <typename K,
+            typename M,
+            typename = detail::enable_if_transparent<Compare, K>>
+  std::pair<iterator, bool> insert_or_assign(K&& k, M&& obj) {
+    return insert_or_assign_key(std::forward<K>(k), std::forward<M>(obj));
+  }
+
+  template <typename M>
+  iterator insert_or_assign(const_iterator, key_type const& k, M&& obj) {
+    return insert_or_assign_key(k, std::forward<M>(obj)).first;
+  }
+
+  template <typename M>
+  iterator insert_or_assign(const_iterator, key_type&& k, M&& obj) {
+    return insert_or_assign_key(std::move(k), std::forward<M>(obj)).first;
+  }
+
+  iterator erase(iterator position) {
+    return erase(const_iterator(position));
+  }
+
+  iterator erase(const_iterator position) {
+    return erase(position, std::next(position));
+  }
+
+  size_type erase(key_type const& x) { return erase_key(x); }
+
+  template <typename K,
+            typename = detail::enable_if_transparent<Compare, K>,
+            typename = typename std::enable_if<
+                !std::is_convertible<K, const_iterator>::value &&
+                !std::is_convertible<K, iterator>::value>::type>
+  size_type erase(K&& x) {
+    return erase_key(x);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    auto const i = first - cbegin();
+    auto const j = last - cbegin();
+    try {
+      c_.keys.erase(c_.keys.begin() + i, c_.keys.begin() + j);
+      c_.values.erase(c_.values.begin() + i, c_.values.begin() + j);
+    } catch (...) {
+      clear();
+      throw;
+    }
+    return iterator_at(static_cast<size_type>(i));
+  }
+
+  void swap(flat_map& y) noexcept(
+      slb::is_nothrow_swappable<key_container_type>::value &&
+      slb::is_nothrow_swappable<mapped_container_type>::value &&
+      slb::is_nothrow_swappable<key_compare>::value) {
+    using std::swap;
+    swap(c_.keys, y.c_.keys);
+    swap(c_.values, y.c_.values);
+    swap(compare_, y.compare_);
+  }
+
+  void clear() noexcept {
+    c_.keys.clear();
+    c_.values.clear();
+  }
+
+  // observers
+  key_compare key_comp() const { return compare_; }
+  value_compare value_comp() const { return value_compare(compare_); }
+
+  key_container_type const& keys() const noexcept { return c_.keys; }
+  mapped_container_type const& values() const noexcept { return c_.values; }
+
+  // map operations
+  iterator find(key_type const& x) { return iterator_at(find_index(x)); }
+  const_iterator find(key_type const& x) const {
+    return iterator_at(find_index(x));
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  iterator find(K const& x) {
+    return iterator_at(find_index(x));
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  const_iterator find(K const& x) const {
+    return iterator_at(find_index(x));
+  }
+
+  size_type count(key_type const& x) const { return contains(x) ? 1 : 0; }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  size_type count(K const& x) const {
+    return contains(x) ? 1 : 0;
+  }
+
+  bool contains(key_type const& x) const { return find_index(x) != size(); }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  bool contains(K const& x) const {
+    return find_index(x) != size();
+  }
+
+  iterator lower_bound(key_type const& x) {
+    return iterator_at(lower_bound_index(x));
+  }
+
+  const_iterator lower_bound(key_type const& x) const {
+    return iterator_at(lower_bound_index(x));
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  iterator lower_bound(K const& x) {
+    return iterator_at(lower_bound_index(x));
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  const_iterator lower_bound(K const& x) const {
+    return iterator_at(lower_bound_index(x));
+  }
+
+  iterator upper_bound(key_type const& x) {
+    return iterator_at(upper_bound_index(x));
+  }
+
+  const_iterator upper_bound(key_type const& x) const {
+    return iterator_at(upper_bound_index(x));
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  iterator upper_bound(K const& x) {
+    return iterator_at(upper_bound_index(x));
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  const_iterator upper_bound(K const& x) const {
+    return iterator_at(upper_bound_index(x));
+  }
+
+  std::pair<iterator, iterator> equal_range(key_type const& x) {
+    return equal_range_key(x);
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      key_type const& x) const {
+    return equal_range_key(x);
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  std::pair<iterator, iterator> equal_range(K const& x) {
+    return equal_range_key(x);
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  std::pair<const_iterator, const_iterator> equal_range(K const& x) const {
+    return equal_range_key(x);
+  }
+
+  friend bool operator==(flat_map const& x, flat_map const& y) {
+    return x.size() == y.size() &&
+           std::equal(x.c_.keys.begin(), x.c_.keys.end(), y.c_.keys.begin()) &&
+           std::equal(x.c_.values.begin(), x.c_.values.end(),
+                      y.c_.values.begin());
+  }
+
+  friend bool operator!=(flat_map const& x, flat_map const& y) {
+    return !(x == y);
+  }
+
+  friend bool operator<(flat_map const& x, flat_map const& y) {
+    return std::lexicographical_compare(x.begin(), x.end(), y.begin(),
+                                        y.end());
+  }
+
+  friend bool operator>(flat_map const& x, flat_map const& y) { return y < x; }
+
+  friend bool operator<=(flat_map const& x, flat_map const& y) {
+    return !(y < x);
+  }
+
+  friend bool operator>=(flat_map const& x, flat_map const& y) {
+    return !(x < y);
+  }
+
+  friend void swap(flat_map& x, flat_map& y) noexcept(noexcept(x.swap(y))) {
+    x.swap(y);
+  }
+
+private:
+  iterator iterator_at(size_type i) noexcept {
+    auto const n = static_cast<difference_type>(i);
+    return iterator(c_.keys.cbegin() + n, c_.values.begin() + n);
+  }
+
+  const_iterator iterator_at(size_type i) const noexcept {
+    auto const n = static_cast<difference_type>(i);
+    return const_iterator(c_.keys.cbegin() + n, c_.values.cbegin() + n);
+  }
+
+  template <typename K>
+  size_type lower_bound_index(K const& x) const {
+    return static_cast<size_type>(
+        detail::flat_lower_bound(c_.keys.cbegin(), c_.keys.cend(), x,
+                                 compare_) -
+        c_.keys.cbegin());
+  }
+
+  template <typename K>
+  size_type upper_bound_index(K const& x) const {
+    return static_cast<size_type>(
+        detail::flat_upper_bound(c_.keys.cbegin(), c_.keys.cend(), x,
+                                 compare_) -
+        c_.keys.cbegin());
+  }
+
+  // Returns `size()` if there is no element with a key equivalent to `x`.
+  template <typename K>
+  size_type find_index(K const& x) const {
+    size_type const i = lower_bound_index(x);
+    return i != size() && !compare_(x, c_.keys[i]) ? i : size();
+  }
+
+  template <typename K>
+  mapped_type& at_key(K const& x) {
+    size_type const i = find_index(x);
+    if (i == size()) {
+      throw std::out_of_range("slb::flat_map::at");
+    }
+    return c_.values[i];
+  }
+
+  template <typename K>
+  mapped_type const& at_key(K const& x) const {
+    size_type const i = find_index(x);
+    if (i == size()) {
+      throw std::out_of_range("slb::flat_map::at");
+    }
+    return c_.values[i];
+  }
+
+  template <typename K>
+  std::pair<iterator, iterator> equal_range_key(K const& x) {
+    size_type const i = lower_bound_index(x);
+    if (i != size() && !compare_(x, c_.keys[i])) {
+      return {iterator_at(i), iterator_at(i + 1)};
+    }
+    return {iterator_at(i), iterator_at(i)};
+  }
+
+  template <typename K>
+  std::pair<const_iterator, const_iterator> equal_range_key(
+      K const& x) const {
+    size_type const i = lower_bound_index(x);
+    if (i != size() && !compare_(x, c_.keys[i])) {
+      return {iterator_at(i), iterator_at(i + 1)};
+    }
+    return {iterator_at(i), iterator_at(i)};
+  }
+
+  template <typename K>
+  size_type erase_key(K const& x) {
+    size_type const i = find_index(x);
+    if (i == size()) {
+      return 0;
+    }
+    erase(iterator_at(i));
+    return 1;
+  }
+
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> try_emplace_key(K&& k, Args&&... args) {
+    size_type const i = lower_bound_index(k);
+    if (i != size() && !compare_(k, c_.keys[i])) {
+      return {iterator_at(i), false};
+    }
+    return {emplace_at(i, std::forward<K>(k), std::forward<Args>(args)...),
+            true};
+  }
+
+  template <typename K, typename M>
+  std::pair<iterator, bool> insert_or_assign_key(K&& k, M&& obj) {
+    size_type const i = lower_bound_index(k);
+    if (i != size() && !compare_(k, c_.keys[i])) {
+      c_.values[i] = std::forward<M>(obj);
+      return {iterator_at(i), false};
+    }
+    return {emplace_at(i, std::forward<K>(k), std::forward<M>(obj)), true};
+  }
+
+  template <typename K, typename... Args>
+  iterator emplace_at(size_type i, K&& k, Args&&... args) {
+    auto const n = static_cast<difference_type>(i);
+    c_.keys.emplace(c_.keys.begin() + n, std::forward<K>(k));
+    try {
+      c_.values.emplace(c_.values.begin() + n, std::forward<Args>(args)...);
+    } catch (...) {
+      c_.keys.erase(c_.keys.begin() + n);
+      throw;
+    }
+    return iterator_at(i);
+  }
+
+  template <typename InputIt>
+  void append(InputIt first, InputIt last) {
+    try {
+      for (; first != last; ++first) {
+        value_type x(*first);
+        c_.keys.insert(c_.keys.end(), std::move(x.first));
+        c_.values.insert(c_.values.end(), std::move(x.second));
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  // Sorts the elements in `[mid, size())` by key, then merges them with the
+  // sorted elements in `[0, mid)` and removes the duplicates.
+  void sort_and_unique(size_type mid) {
+    Compare& comp = compare_;
+    key_container_type const& keys = c_.keys;
+    if (std::adjacent_find(keys.begin() + static_cast<difference_type>(mid),
+                           keys.end(),
+                           [&comp](key_type const& x, key_type const& y) {
+                             return !comp(x, y);
+                           }) == keys.end()) {
+      // Already sorted and free of duplicates, e.g., a bulk load.
+      merge_and_unique(mid);
+      return;
+    }
+    std::vector<size_type> order(size());
+    std::iota(order.begin(), order.end(), size_type(0));
+    auto const by_key = [&comp, &keys](size_type i, size_type j) {
+      return comp(keys[i], keys[j]);
+    };
+    std::stable_sort(order.begin() + static_cast<difference_type>(mid),
+                     order.end(), by_key);
+    permute(order, mid);
+  }
+
+  // Merges the sorted elements in `[mid, size())` with those in `[0, mid)`,
+  // keeping the existing element of any equivalent pair.
+  void merge_and_unique(size_type mid) {
+    if (mid == 0 || mid == size() ||
+        compare_(c_.keys[mid - 1], c_.keys[mid])) {
+      return;
+    }
+    std::vector<size_type> order(size());
+    std::iota(order.begin(), order.end(), size_type(0));
+    permute(order, mid);
+  }
+
+  // Rebuilds the containers in the order given by `order`, whose subranges
+  // `[0, mid)` and `[mid, size())` are each sorted by key, dropping all but
+  // the first element of any run of equivalent keys.
+  void permute(std::vector<size_type>& order, size_type mid) {
+    Compare& comp = compare_;
+    key_container_type const& keys = c_.keys;
+    std::inplace_merge(order.begin(),
+                       order.begin() + static_cast<difference_type>(mid),
+                       order.end(),
+                       [&comp, &keys](size_type i, size_type j) {
+                         return comp(keys[i], keys[j]);
+                       });
+    try {
+      containers c;
+      for (size_type i : order) {
+        if (!c.keys.empty() && !comp(c.keys.back(), c_.keys[i])) {
+          continue;
+        }
+        c.keys.insert(c.keys.end(), std::move(c_.keys[i]));
+        c.values.insert(c.values.end(), std::move(c_.values[i]));
+      }
+      c_.keys = std::move(c.keys);
+      c_.values = std::move(c.values);
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  containers c_;
+  key_compare compare_;
+};
+
+// [flat.map.erasure], erasure for flat_map
+template <typename Key,
+          typename T,
+          typename Compare,
+          typename KeyContainer,
+          typename MappedContainer,
+          typename Predicate>
+typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type
+erase_if(flat_map<Key, T, Compare, KeyContainer, MappedContainer>& c,
+         Predicate pred) {
+  using map = flat_map<Key, T, Compare, KeyContainer, MappedContainer>;
+  typename map::containers cont = std::move(c).extract();
+  std::size_t const size = cont.keys.size();
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    if (pred(typename map::const_reference(cont.keys[i], cont.values[i]))) {
+      continue;
+    }
+    if (n != i) {
+      cont.keys[n] = std::move(cont.keys[i]);
+      cont.values[n] = std::move(cont.values[i]);
+    }
+    ++n;
+  }
+  auto const end = static_cast<typename KeyContainer::difference_type>(n);
+  cont.keys.erase(cont.keys.begin() + end, cont.keys.end());
+  cont.values.erase(cont.values.begin() + end, cont.values.end());
+  c.replace(std::move(cont.keys), std::move(cont.values));
+  return size - n;
+}
+#endif
+
+} // namespace slb
+
+#endif // SLB_FLAT_MAP_HPP
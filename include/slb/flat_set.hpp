@@ -0,0 +1,444 @@
+/*
+  SLB.FlatSet
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_FLAT_SET_HPP
+#define SLB_FLAT_SET_HPP
+
+/*
+
+Header <flat_set> synopsis [flat.set.syn]
+
+namespace std {
+  // [flat.set], class template flat_set
+  template<class Key, class Compare = less<Key>,
+           class KeyContainer = vector<Key>>
+    class flat_set;
+
+  struct sorted_unique_t { explicit sorted_unique_t() = default; };
+  inline constexpr sorted_unique_t sorted_unique{};
+
+  // [flat.set.erasure], erasure for flat_set
+  template<class Key, class Compare, class KeyContainer, class Predicate>
+    typename flat_set<Key, Compare, KeyContainer>::size_type
+      erase_if(flat_set<Key, Compare, KeyContainer>& c, Predicate pred);
+}
+
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "detail/config.hpp"
+#include "detail/flat.hpp"
+#include "detail/lib.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+
+#if __has_include(<flat_set>)
+#include <flat_set>
+#endif
+
+namespace slb {
+
+#if __cpp_lib_flat_set // C++23
+using std::flat_set;
+using std::erase_if;
+#else
+// [flat.set], class template flat_set
+template <typename Key,
+          typename Compare = std::less<Key>,
+          typename KeyContainer = std::vector<Key>>
+class flat_set {
+  static_assert(std::is_same<Key, typename KeyContainer::value_type>::value,
+                "`KeyContainer::value_type` shall be `Key`.");
+
+public:
+  // types
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using reference = value_type&;
+  using const_reference = value_type const&;
+  using size_type = typename KeyContainer::size_type;
+  using difference_type = typename KeyContainer::difference_type;
+  using iterator = typename KeyContainer::const_iterator;
+  using const_iterator = typename KeyContainer::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using container_type = KeyContainer;
+
+  // [flat.set.cons], constructors
+  flat_set() : flat_set(key_compare()) {}
+
+  explicit flat_set(container_type cont,
+                    key_compare const& comp = key_compare())
+      : c_(std::move(cont)), compare_(comp) {
+    sort_and_unique(c_.begin());
+  }
+
+  flat_set(sorted_unique_t,
+           container_type cont,
+           key_compare const& comp = key_compare())
+      : c_(std::move(cont)), compare_(comp) {}
+
+  explicit flat_set(key_compare const& comp) : c_(), compare_(comp) {}
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  flat_set(InputIt first,
+           InputIt last,
+           key_compare const& comp = key_compare())
+      : c_(), compare_(comp) {
+    insert(first, last);
+  }
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  flat_set(sorted_unique_t,
+           InputIt first,
+           InputIt last,
+           key_compare const& comp = key_compare())
+      : c_(first, last), compare_(comp) {}
+
+  flat_set(std::initializer_list<value_type> il,
+           key_compare const& comp = key_compare())
+      : flat_set(il.begin(), il.end(), comp) {}
+
+  flat_set(sorted_unique_t s,
+           std::initializer_list<value_type> il,
+           key_compare const& comp = key_compare())
+      : flat_set(s, il.begin(), il.end(), comp) {}
+
+  flat_set& operator=(std::initializer_list<value_type> il) {
+    clear();
+    insert(il);
+    return *this;
+  }
+
+  // iterators
+  iterator begin() noexcept { return c_.cbegin(); }
+  const_iterator begin() const noexcept { return c_.cbegin(); }
+  iterator end() noexcept { return c_.cend(); }
+  const_iterator end() const noexcept { return c_.cend(); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  // capacity
+  bool empty() const noexcept { return c_.empty(); }
+  size_type size() const noexcept { return c_.size(); }
+  size_type max_size() const noexcept { return c_.max_size(); }
+
+  // [flat.set.modifiers], modifiers
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert_unique(key_type(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  std::pair<iterator, bool> insert(value_type const& x) {
+    return insert_unique(x);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& x) {
+    return insert_unique(std::move(x));
+  }
+
+  template <typename K,
+            typename = detail::enable_if_transparent<Compare, K>,
+            typename = typename std::enable_if<
+                std::is_constructible<value_type, K>::value>::type>
+  std::pair<iterator, bool> insert(K&& x) {
+    return insert_unique(std::forward<K>(x));
+  }
+
+  iterator insert(const_iterator, value_type const& x) {
+    return insert(x).first;
+  }
+
+  iterator insert(const_iterator, value_type&& x) {
+    return insert(std::move(x)).first;
+  }
+
+  // Appends the new elements, sorts them, and merges them into place, keeping
+  // the existing element of any equivalent pair.
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  void insert(InputIt first, InputIt last) {
+    size_type const size = c_.size();
+    c_.insert(c_.end(), first, last);
+    sort_and_unique(c_.begin() + static_cast<difference_type>(size));
+  }
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  void insert(sorted_unique_t, InputIt first, InputIt last) {
+    size_type const size = c_.size();
+    c_.insert(c_.end(), first, last);
+    merge_and_unique(c_.begin() + static_cast<difference_type>(size));
+  }
+
+  void insert(std::initializer_list<value_type> il) {
+    insert(il.begin(), il.end());
+  }
+
+  void insert(sorted_unique_t s, std::initializer_list<value_type> il) {
+    insert(s, il.begin(), il.end());
+  }
+
+  container_type extract() && {
+    container_type c = std::move(c_);
+    c_.clear();
+    return c;
+  }
+
+  // Precondition: `cont` is sorted and free of equivalent elements.
+  void replace(container_type&& cont) { c_ = std::move(cont); }
+
+  iterator erase(const_iterator position) { return c_.erase(position); }
+
+  size_type erase(key_type const& x) { return erase_key(x); }
+
+  template <typename K,
+            typename = detail::enable_if_transparent<Compare, K>,
+            typename = typename std::enable_if<
+                !std::is_convertible<K, iterator>::value>::type>
+  size_type erase(K&& x) {
+    return erase_key(x);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    return c_.erase(first, last);
+  }
+
+  void swap(flat_set& y) noexcept(
+      slb::is_nothrow_swappable<container_type>::value &&
+      slb::is_nothrow_swappable<key_compare>::value) {
+    using std::swap;
+    swap(c_, y.c_);
+    swap(compare_, y.compare_);
+  }
+
+  void clear() noexcept { c_.clear(); }
+
+  // observers
+  key_compare key_comp() const { return compare_; }
+  value_compare value_comp() const { return compare_; }
+
+  // set operations
+  iterator find(key_type const& x) { return find_key(x); }
+  const_iterator find(key_type const& x) const { return find_key(x); }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  iterator find(K const& x) {
+    return find_key(x);
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  const_iterator find(K const& x) const {
+    return find_key(x);
+  }
+
+  size_type count(key_type const& x) const { return contains(x) ? 1 : 0; }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  size_type count(K const& x) const {
+    return contains(x) ? 1 : 0;
+  }
+
+  bool contains(key_type const& x) const { return find(x) != end(); }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  bool contains(K const& x) const {
+    return find(x) != end();
+  }
+
+  iterator lower_bound(key_type const& x) {
+    return detail::flat_lower_bound(begin(), end(), x, compare_);
+  }
+
+  const_iterator lower_bound(key_type const& x) const {
+    return detail::flat_lower_bound(begin(), end(), x, compare_);
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  iterator lower_bound(K const& x) {
+    return detail::flat_lower_bound(begin(), end(), x, compare_);
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  const_iterator lower_bound(K const& x) const {
+    return detail::flat_lower_bound(begin(), end(), x, compare_);
+  }
+
+  iterator upper_bound(key_type const& x) {
+    return detail::flat_upper_bound(begin(), end(), x, compare_);
+  }
+
+  const_iterator upper_bound(key_type const& x) const {
+    return detail::flat_upper_bound(begin(), end(), x, compare_);
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  iterator upper_bound(K const& x) {
+    return detail::flat_upper_bound(begin(), end(), x, compare_);
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  const_iterator upper_bound(K const& x) const {
+    return detail::flat_upper_bound(begin(), end(), x, compare_);
+  }
+
+  std::pair<iterator, iterator> equal_range(key_type const& x) {
+    return equal_range_key(x);
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      key_type const& x) const {
+    return equal_range_key(x);
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  std::pair<iterator, iterator> equal_range(K const& x) {
+    return equal_range_key(x);
+  }
+
+  template <typename K, typename = detail::enable_if_transparent<Compare, K>>
+  std::pair<const_iterator, const_iterator> equal_range(K const& x) const {
+    return equal_range_key(x);
+  }
+
+  friend bool operator==(flat_set const& x, flat_set const& y) {
+    return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+  }
+
+  friend bool operator!=(flat_set const& x, flat_set const& y) {
+    return !(x == y);
+  }
+
+  friend bool operator<(flat_set const& x, flat_set const& y) {
+    return std::lexicographical_compare(x.begin(), x.end(), y.begin(),
+                                        y.end());
+  }
+
+  friend bool operator>(flat_set const& x, flat_set const& y) { return y < x; }
+
+  friend bool operator<=(flat_set const& x, flat_set const& y) {
+    return !(y < x);
+  }
+
+  friend bool operator>=(flat_set const& x, flat_set const& y) {
+    return !(x < y);
+  }
+
+  friend void swap(flat_set& x, flat_set& y) noexcept(noexcept(x.swap(y))) {
+    x.swap(y);
+  }
+
+private:
+  template <typename K>
+  std::pair<iterator, bool> insert_unique(K&& x) {
+    const_iterator const it = lower_bound(x);
+    if (it != end() && !compare_(x, *it)) {
+      return {it, false};
+    }
+    return {c_.emplace(it, std::forward<K>(x)), true};
+  }
+
+  template <typename K>
+  const_iterator find_key(K const& x) const {
+    const_iterator const it = lower_bound(x);
+    return it != end() && !compare_(x, *it) ? it : end();
+  }
+
+  template <typename K>
+  std::pair<const_iterator, const_iterator> equal_range_key(
+      K const& x) const {
+    const_iterator const it = lower_bound(x);
+    if (it != end() && !compare_(x, *it)) {
+      return {it, std::next(it)};
+    }
+    return {it, it};
+  }
+
+  template <typename K>
+  size_type erase_key(K const& x) {
+    const_iterator const it = find(x);
+    if (it == end()) {
+      return 0;
+    }
+    c_.erase(it);
+    return 1;
+  }
+
+  // Sorts the elements in `[mid, end)`, then merges them with the sorted
+  // elements in `[begin, mid)` and removes the duplicates.
+  void sort_and_unique(typename container_type::iterator mid) {
+    std::stable_sort(mid, c_.end(), compare_);
+    merge_and_unique(mid);
+  }
+
+  void merge_and_unique(typename container_type::iterator mid) {
+    std::inplace_merge(c_.begin(), mid, c_.end(), compare_);
+    // The elements are sorted, so adjacent ones are equivalent unless the
+    // first compares less; `inplace_merge` is stable, so the existing
+    // element of any equivalent pair comes first and is kept.
+    Compare& comp = compare_;
+    c_.erase(std::unique(c_.begin(), c_.end(),
+                         [&comp](key_type const& x, key_type const& y) {
+                           return !comp(x, y);
+                         }),
+             c_.end());
+  }
+
+  container_type c_;
+  key_compare compare_;
+};
+
+// [flat.set.erasure], erasure for flat_set
+template <typename Key,
+          typename Compare,
+          typename KeyContainer,
+          typename Predicate>
+typename flat_set<Key, Compare, KeyContainer>::size_type erase_if(
+    flat_set<Key, Compare, KeyContainer>& c, Predicate pred) {
+  KeyContainer cont = std::move(c).extract();
+  auto const it = std::remove_if(cont.begin(), cont.end(), pred);
+  auto const r = static_cast<typename KeyContainer::size_type>(cont.end() - it);
+  cont.erase(it, cont.end());
+  c.replace(std::move(cont));
+  return r;
+}
+#endif
+
+} // namespace slb
+
+#endif // SLB_FLAT_SET_HPP
@@ -172,7 +172,7 @@ template <typename F, typename... Args>
 typename slb::invoke_result<F, Args...>::type
 invoke(F&& f,
        Args&&... args) noexcept(slb::is_nothrow_invocable<F, Args...>::value) {
-  return detail::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+  return detail::invoke(SLB_FORWARD(F, f), SLB_FORWARD(Args, args)...);
 }
 #endif
 
@@ -196,7 +196,7 @@ class not_fn_result {
 
 public:
   template <typename F>
-  not_fn_result(not_fn_tag, F&& f) : fd(std::forward<F>(f)) {}
+  not_fn_result(not_fn_tag, F&& f) : fd(SLB_FORWARD(F, f)) {}
 
   not_fn_result(not_fn_result&&) = default;
   not_fn_result(not_fn_result const&) = default;
@@ -204,27 +204,27 @@ public:
   template <typename... Args>
       auto operator()(Args&&... args) &
       noexcept(noexcept(!detail::invoke(std::declval<FD&>(),
-                                        std::forward<Args>(args)...)))
+                                        SLB_FORWARD(Args, args)...)))
           -> decltype(!detail::invoke(std::declval<FD&>(),
-                                      std::forward<Args>(args)...)) {
-    return !detail::invoke(fd, std::forward<Args>(args)...);
+                                      SLB_FORWARD(Args, args)...)) {
+    return !detail::invoke(fd, SLB_FORWARD(Args, args)...);
   }
 
   template <typename... Args>
   auto operator()(Args&&... args) const& noexcept(noexcept(
-      !detail::invoke(std::declval<FD const&>(), std::forward<Args>(args)...)))
+      !detail::invoke(std::declval<FD const&>(), SLB_FORWARD(Args, args)...)))
       -> decltype(!detail::invoke(std::declval<FD const&>(),
-                                  std::forward<Args>(args)...)) {
-    return !detail::invoke(fd, std::forward<Args>(args)...);
+                                  SLB_FORWARD(Args, args)...)) {
+    return !detail::invoke(fd, SLB_FORWARD(Args, args)...);
   }
 
   template <typename... Args>
       auto operator()(Args&&... args) &&
       noexcept(noexcept(!detail::invoke(std::declval<FD&&>(),
-                                        std::forward<Args>(args)...)))
+                                        SLB_FORWARD(Args, args)...)))
           -> decltype(!detail::invoke(std::declval<FD&&>(),
-                                      std::forward<Args>(args)...)) {
-    return !detail::invoke(std::move(fd), std::forward<Args>(args)...);
+                                      SLB_FORWARD(Args, args)...)) {
+    return !detail::invoke(SLB_MOVE(fd), SLB_FORWARD(Args, args)...);
   }
 
 // gcc finds calls on const rvalues ambiguous up to version 4.8.
@@ -232,10 +232,10 @@ public:
     ((__GNUC__ == 4) && (__GNUC_MINOR__ > 8))
   template <typename... Args>
   auto operator()(Args&&... args) const&& noexcept(noexcept(
-      !detail::invoke(std::declval<FD const&&>(), std::forward<Args>(args)...)))
+      !detail::invoke(std::declval<FD const&&>(), SLB_FORWARD(Args, args)...)))
       -> decltype(!detail::invoke(std::declval<FD const&&>(),
-                                  std::forward<Args>(args)...)) {
-    return !detail::invoke(std::move(fd), std::forward<Args>(args)...);
+                                  SLB_FORWARD(Args, args)...)) {
+    return !detail::invoke(SLB_MOVE(fd), SLB_FORWARD(Args, args)...);
   }
 #endif
 };
@@ -248,7 +248,7 @@ detail::not_fn_result<FD> not_fn(F&& f) {
                 "FD shall satisfy the requirements of MoveConstructible");
   static_assert(std::is_constructible<FD, F>::value,
                 "is_constructible_v<FD, F> shall be true");
-  return {detail::not_fn_tag{}, std::forward<F>(f)};
+  return {detail::not_fn_tag{}, SLB_FORWARD(F, f)};
 }
 #endif
 
@@ -285,23 +285,23 @@ class bound {
 
 public:
   template <typename F>
-  bound(bind_tag, F&& f) : fd(std::forward<F>(f)) {}
+  bound(bind_tag, F&& f) : fd(SLB_FORWARD(F, f)) {}
 
   template <typename... Args>
   auto operator()(Args&&... args) noexcept(noexcept(
-      detail::invoke(std::declval<FD&>(), std::forward<Args>(args)...)))
+      detail::invoke(std::declval<FD&>(), SLB_FORWARD(Args, args)...)))
       -> decltype(detail::invoke(std::declval<FD&>(),
-                                 std::forward<Args>(args)...)) {
-    return detail::invoke(fd, std::forward<Args>(args)...);
+                                 SLB_FORWARD(Args, args)...)) {
+    return detail::invoke(fd, SLB_FORWARD(Args, args)...);
   }
 
   template <typename... Args>
   auto operator()(Args&&... args) const
       noexcept(noexcept(detail::invoke(std::declval<FD const&>(),
-                                       std::forward<Args>(args)...)))
+                                       SLB_FORWARD(Args, args)...)))
           -> decltype(detail::invoke(std::declval<FD const&>(),
-                                     std::forward<Args>(args)...)) {
-    return detail::invoke(fd, std::forward<Args>(args)...);
+                                     SLB_FORWARD(Args, args)...)) {
+    return detail::invoke(fd, SLB_FORWARD(Args, args)...);
   }
 };
 
@@ -317,23 +317,23 @@ class bound_r {
 
 public:
   template <typename F>
-  bound_r(bind_tag, F&& f) : fd(std::forward<F>(f)) {}
+  bound_r(bind_tag, F&& f) : fd(SLB_FORWARD(F, f)) {}
 
   template <typename... Args>
   auto operator()(Args&&... args) noexcept(noexcept(
-      detail::invoke_r<R>(std::declval<FD&>(), std::forward<Args>(args)...)))
+      detail::invoke_r<R>(std::declval<FD&>(), SLB_FORWARD(Args, args)...)))
       -> decltype(detail::invoke_r<R>(std::declval<FD&>(),
-                                      std::forward<Args>(args)...)) {
-    return detail::invoke_r<R>(fd, std::forward<Args>(args)...);
+                                      SLB_FORWARD(Args, args)...)) {
+    return detail::invoke_r<R>(fd, SLB_FORWARD(Args, args)...);
   }
 
   template <typename... Args>
   auto operator()(Args&&... args) const
       noexcept(noexcept(detail::invoke_r<R>(std::declval<FD const&>(),
-                                            std::forward<Args>(args)...)))
+                                            SLB_FORWARD(Args, args)...)))
           -> decltype(detail::invoke_r<R>(std::declval<FD const&>(),
-                                          std::forward<Args>(args)...)) {
-    return detail::invoke_r<R>(fd, std::forward<Args>(args)...);
+                                          SLB_FORWARD(Args, args)...)) {
+    return detail::invoke_r<R>(fd, SLB_FORWARD(Args, args)...);
   }
 };
 
@@ -349,8 +349,8 @@ template <typename F,
           typename FD = typename std::decay<F>::type>
 typename detail::bind_result<FD, BoundArgs...>::type bind(F&& f,
                                                           BoundArgs&&... args) {
-  return std::bind(detail::bound<FD>{detail::bind_tag{}, std::forward<F>(f)},
-                   std::forward<BoundArgs>(args)...);
+  return std::bind(detail::bound<FD>{detail::bind_tag{}, SLB_FORWARD(F, f)},
+                   SLB_FORWARD(BoundArgs, args)...);
 }
 
 template <typename R,
@@ -360,8 +360,8 @@ template <typename R,
 typename detail::bind_result_r<R, FD, BoundArgs...>::type
 bind(F&& f, BoundArgs&&... args) {
   return std::bind<R>(
-      detail::bound_r<R, FD>{detail::bind_tag{}, std::forward<F>(f)},
-      std::forward<BoundArgs>(args)...);
+      detail::bound_r<R, FD>{detail::bind_tag{}, SLB_FORWARD(F, f)},
+      SLB_FORWARD(BoundArgs, args)...);
 }
 #endif
 
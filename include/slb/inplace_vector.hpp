@@ -0,0 +1,559 @@
+/*
+  SLB.InplaceVector
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_INPLACE_VECTOR_HPP
+#define SLB_INPLACE_VECTOR_HPP
+
+/*
+
+Header <inplace_vector> synopsis [inplace.vector.syn]
+
+namespace std {
+  // [inplace.vector], class template inplace_vector
+  template<class T, size_t N> class inplace_vector;
+
+  // [inplace.vector.erasure], erasure
+  template<class T, size_t N, class U = T>
+    constexpr typename inplace_vector<T, N>::size_type
+      erase(inplace_vector<T, N>& c, const U& value);
+  template<class T, size_t N, class Predicate>
+    constexpr typename inplace_vector<T, N>::size_type
+      erase_if(inplace_vector<T, N>& c, Predicate pred);
+}
+
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "detail/config.hpp"
+#include "detail/lib.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+
+#if __has_include(<inplace_vector>)
+#include <inplace_vector>
+#endif
+
+namespace slb {
+
+#if __cpp_lib_inplace_vector // C++26
+using std::inplace_vector;
+using std::erase;
+using std::erase_if;
+#else
+namespace detail {
+
+// The smallest unsigned integer type that can hold every size in `[0, N]`.
+template <std::size_t N>
+using inplace_vector_size_t = typename std::conditional<
+    N <= std::numeric_limits<unsigned char>::max(),
+    unsigned char,
+    typename std::conditional<
+        N <= std::numeric_limits<unsigned short>::max(),
+        unsigned short,
+        typename std::conditional<N <= std::numeric_limits<unsigned int>::max(),
+                                  unsigned int,
+                                  std::size_t>::type>::type>::type;
+
+// An `inplace_vector` of a trivially copyable type is itself trivially
+// copyable, at the cost of copying the whole buffer rather than just the
+// elements in use.
+#if SLB_TRIVIALITY_TRAITS
+template <typename T>
+struct is_inplace_vector_trivial
+    : slb::bool_constant<slb::is_trivially_copyable<T>::value> {};
+#else
+template <typename T>
+struct is_inplace_vector_trivial
+    : slb::bool_constant<std::is_trivial<T>::value> {};
+#endif
+
+template <typename T, std::size_t N>
+class inplace_vector_buffer {
+public:
+  inplace_vector_buffer() noexcept : size_(0) {}
+
+  T* data() noexcept { return reinterpret_cast<T*>(&buffer_); }
+  T const* data() const noexcept {
+    return reinterpret_cast<T const*>(&buffer_);
+  }
+
+  std::size_t size() const noexcept { return size_; }
+  void set_size(std::size_t n) noexcept {
+    size_ = static_cast<inplace_vector_size_t<N>>(n);
+  }
+
+private:
+  typename slb::aligned_storage<sizeof(T) * N, alignof(T)>::type buffer_;
+  inplace_vector_size_t<N> size_;
+};
+
+template <typename T>
+class inplace_vector_buffer<T, 0> {
+public:
+  T* data() noexcept { return nullptr; }
+  T const* data() const noexcept { return nullptr; }
+
+  std::size_t size() const noexcept { return 0; }
+  void set_size(std::size_t) noexcept {}
+};
+
+template <typename T,
+          std::size_t N,
+          bool = N == 0 || is_inplace_vector_trivial<T>::value>
+class inplace_vector_storage : public inplace_vector_buffer<T, N> {};
+
+template <typename T, std::size_t N>
+class inplace_vector_storage<T, N, false> : public inplace_vector_buffer<T, N> {
+public:
+  inplace_vector_storage() = default;
+
+  inplace_vector_storage(inplace_vector_storage const& other) {
+    slb::uninitialized_copy(other.data(), other.data() + other.size(),
+                            this->data());
+    this->set_size(other.size());
+  }
+
+  inplace_vector_storage(inplace_vector_storage&& other) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    slb::uninitialized_move(other.data(), other.data() + other.size(),
+                            this->data());
+    this->set_size(other.size());
+  }
+
+  inplace_vector_storage& operator=(inplace_vector_storage const& other) {
+    if (this != &other) {
+      assign(other.data(), other.size());
+    }
+    return *this;
+  }
+
+  inplace_vector_storage& operator=(inplace_vector_storage&& other) noexcept(
+      std::is_nothrow_move_assignable<T>::value &&
+      std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+      assign(std::make_move_iterator(other.data()), other.size());
+    }
+    return *this;
+  }
+
+  ~inplace_vector_storage() {
+    slb::destroy(this->data(), this->data() + this->size());
+  }
+
+private:
+  template <typename InputIt>
+  void assign(InputIt first, std::size_t n) {
+    T* const data = this->data();
+    std::size_t const size = this->size();
+    if (n <= size) {
+      std::copy(first, first + n, data);
+      slb::destroy(data + n, data + size);
+    } else {
+      std::copy(first, first + size, data);
+      slb::uninitialized_copy(first + size, first + n, data + size);
+    }
+    this->set_size(n);
+  }
+};
+
+} // namespace detail
+
+// [inplace.vector], class template inplace_vector
+template <typename T, std::size_t N>
+class inplace_vector {
+public:
+  // types
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = T const*;
+  using reference = value_type&;
+  using const_reference = value_type const&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = T*;
+  using const_iterator = T const*;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // [inplace.vector.cons], construct/copy/destroy
+  inplace_vector() = default;
+
+  explicit inplace_vector(size_type n) {
+    check_capacity(n);
+    slb::uninitialized_value_construct_n(data(), n);
+    storage_.set_size(n);
+  }
+
+  inplace_vector(size_type n, T const& value) {
+    check_capacity(n);
+    std::uninitialized_fill_n(data(), n, value);
+    storage_.set_size(n);
+  }
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  inplace_vector(InputIt first, InputIt last) {
+    append(first, last, detail::is_forward_iterator<InputIt>{});
+  }
+
+  inplace_vector(std::initializer_list<T> il)
+      : inplace_vector(il.begin(), il.end()) {}
+
+  inplace_vector& operator=(std::initializer_list<T> il) {
+    assign(il.begin(), il.end());
+    return *this;
+  }
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  void assign(InputIt first, InputIt last) {
+    assign(first, last, detail::is_forward_iterator<InputIt>{});
+  }
+
+  void assign(size_type n, T const& value) {
+    check_capacity(n);
+    size_type const size = this->size();
+    if (n <= size) {
+      std::fill_n(data(), n, value);
+      slb::destroy(data() + n, data() + size);
+    } else {
+      std::fill_n(data(), size, value);
+      std::uninitialized_fill_n(data() + size, n - size, value);
+    }
+    storage_.set_size(n);
+  }
+
+  void assign(std::initializer_list<T> il) { assign(il.begin(), il.end()); }
+
+  // iterators
+  iterator begin() noexcept { return data(); }
+  const_iterator begin() const noexcept { return data(); }
+  iterator end() noexcept { return data() + size(); }
+  const_iterator end() const noexcept { return data() + size(); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  // [inplace.vector.capacity], size/capacity
+  bool empty() const noexcept { return size() == 0; }
+  size_type size() const noexcept { return storage_.size(); }
+  static constexpr size_type max_size() noexcept { return N; }
+  static constexpr size_type capacity() noexcept { return N; }
+
+  void resize(size_type n) {
+    size_type const size = this->size();
+    if (n <= size) {
+      slb::destroy(data() + n, data() + size);
+    } else {
+      check_capacity(n);
+      slb::uninitialized_value_construct_n(data() + size, n - size);
+    }
+    storage_.set_size(n);
+  }
+
+  void resize(size_type n, T const& value) {
+    size_type const size = this->size();
+    if (n <= size) {
+      slb::destroy(data() + n, data() + size);
+    } else {
+      check_capacity(n);
+      std::uninitialized_fill_n(data() + size, n - size, value);
+    }
+    storage_.set_size(n);
+  }
+
+  static void reserve(size_type n) { check_capacity(n); }
+  static void shrink_to_fit() noexcept {}
+
+  // element access
+  reference operator[](size_type n) { return data()[n]; }
+  const_reference operator[](size_type n) const { return data()[n]; }
+
+  reference at(size_type n) {
+    if (n >= size()) {
+      throw std::out_of_range("slb::inplace_vector::at");
+    }
+    return data()[n];
+  }
+
+  const_reference at(size_type n) const {
+    if (n >= size()) {
+      throw std::out_of_range("slb::inplace_vector::at");
+    }
+    return data()[n];
+  }
+
+  reference front() { return data()[0]; }
+  const_reference front() const { return data()[0]; }
+  reference back() { return data()[size() - 1]; }
+  const_reference back() const { return data()[size() - 1]; }
+
+  // [inplace.vector.data], data access
+  T* data() noexcept { return storage_.data(); }
+  T const* data() const noexcept { return storage_.data(); }
+
+  // [inplace.vector.modifiers], modifiers
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    check_capacity(size() + 1);
+    return unchecked_emplace_back(std::forward<Args>(args)...);
+  }
+
+  reference push_back(T const& value) { return emplace_back(value); }
+  reference push_back(T&& value) { return emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  pointer try_emplace_back(Args&&... args) {
+    if (size() == N) {
+      return nullptr;
+    }
+    return std::addressof(
+        unchecked_emplace_back(std::forward<Args>(args)...));
+  }
+
+  pointer try_push_back(T const& value) { return try_emplace_back(value); }
+  pointer try_push_back(T&& value) {
+    return try_emplace_back(std::move(value));
+  }
+
+  // Precondition: `size() < capacity()`.
+  template <typename... Args>
+  reference unchecked_emplace_back(Args&&... args) {
+    T* const p = data() + size();
+    ::new (detail::voidify_ptr(p)) T(std::forward<Args>(args)...);
+    storage_.set_size(size() + 1);
+    return *p;
+  }
+
+  reference unchecked_push_back(T const& value) {
+    return unchecked_emplace_back(value);
+  }
+  reference unchecked_push_back(T&& value) {
+    return unchecked_emplace_back(std::move(value));
+  }
+
+  void pop_back() {
+    slb::destroy_at(data() + size() - 1);
+    storage_.set_size(size() - 1);
+  }
+
+  // Elements are never reallocated, so arguments referring to elements of the
+  // vector stay valid while the new elements are appended and rotated into
+  // place.
+  template <typename... Args>
+  iterator emplace(const_iterator position, Args&&... args) {
+    iterator const p = begin() + (position - cbegin());
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(p, end() - 1, end());
+    return p;
+  }
+
+  iterator insert(const_iterator position, T const& value) {
+    return emplace(position, value);
+  }
+
+  iterator insert(const_iterator position, T&& value) {
+    return emplace(position, std::move(value));
+  }
+
+  iterator insert(const_iterator position, size_type n, T const& value) {
+    iterator const p = begin() + (position - cbegin());
+    size_type const size = this->size();
+    check_capacity(size + n);
+    std::uninitialized_fill_n(end(), n, value);
+    storage_.set_size(size + n);
+    std::rotate(p, begin() + size, end());
+    return p;
+  }
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  iterator insert(const_iterator position, InputIt first, InputIt last) {
+    iterator const p = begin() + (position - cbegin());
+    size_type const size = this->size();
+    append(first, last, detail::is_forward_iterator<InputIt>{});
+    std::rotate(p, begin() + size, end());
+    return p;
+  }
+
+  iterator insert(const_iterator position, std::initializer_list<T> il) {
+    return insert(position, il.begin(), il.end());
+  }
+
+  iterator erase(const_iterator position) {
+    return erase(position, position + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    iterator const p = begin() + (first - cbegin());
+    if (first != last) {
+      iterator const new_end = std::move(begin() + (last - cbegin()), end(), p);
+      slb::destroy(new_end, end());
+      storage_.set_size(static_cast<size_type>(new_end - begin()));
+    }
+    return p;
+  }
+
+  void clear() noexcept {
+    slb::destroy(begin(), end());
+    storage_.set_size(0);
+  }
+
+  void swap(inplace_vector& other) noexcept(
+      N == 0 || (std::is_nothrow_move_constructible<T>::value &&
+                 slb::is_nothrow_swappable<T>::value)) {
+    inplace_vector* shorter = this;
+    inplace_vector* longer = &other;
+    if (shorter->size() > longer->size()) {
+      std::swap(shorter, longer);
+    }
+    size_type const shorter_size = shorter->size();
+    size_type const longer_size = longer->size();
+    iterator const mid = longer->begin() + shorter_size;
+    std::swap_ranges(shorter->begin(), shorter->end(), longer->begin());
+    slb::uninitialized_move(mid, longer->end(), shorter->end());
+    slb::destroy(mid, longer->end());
+    shorter->storage_.set_size(longer_size);
+    longer->storage_.set_size(shorter_size);
+  }
+
+private:
+  static void check_capacity(size_type n) {
+    if (n > N) {
+      throw std::bad_alloc();
+    }
+  }
+
+  template <typename InputIt>
+  void append(InputIt first, InputIt last, std::false_type) {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+
+  template <typename ForwardIt>
+  void append(ForwardIt first, ForwardIt last, std::true_type) {
+    size_type const size = this->size();
+    size_type const n = static_cast<size_type>(std::distance(first, last));
+    check_capacity(size + n);
+    slb::uninitialized_copy(first, last, data() + size);
+    storage_.set_size(size + n);
+  }
+
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last, std::false_type) {
+    clear();
+    append(first, last, std::false_type{});
+  }
+
+  template <typename ForwardIt>
+  void assign(ForwardIt first, ForwardIt last, std::true_type) {
+    size_type const n = static_cast<size_type>(std::distance(first, last));
+    check_capacity(n);
+    size_type const size = this->size();
+    if (n <= size) {
+      slb::destroy(std::copy(first, last, data()), data() + size);
+    } else {
+      ForwardIt mid = std::next(first, static_cast<difference_type>(size));
+      std::copy(first, mid, data());
+      slb::uninitialized_copy(mid, last, data() + size);
+    }
+    storage_.set_size(n);
+  }
+
+  detail::inplace_vector_storage<T, N> storage_;
+};
+
+template <typename T, std::size_t N>
+bool operator==(inplace_vector<T, N> const& lhs,
+                inplace_vector<T, N> const& rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, std::size_t N>
+bool operator!=(inplace_vector<T, N> const& lhs,
+                inplace_vector<T, N> const& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T, std::size_t N>
+bool operator<(inplace_vector<T, N> const& lhs,
+               inplace_vector<T, N> const& rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                      rhs.end());
+}
+
+template <typename T, std::size_t N>
+bool operator>(inplace_vector<T, N> const& lhs,
+               inplace_vector<T, N> const& rhs) {
+  return rhs < lhs;
+}
+
+template <typename T, std::size_t N>
+bool operator<=(inplace_vector<T, N> const& lhs,
+                inplace_vector<T, N> const& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename T, std::size_t N>
+bool operator>=(inplace_vector<T, N> const& lhs,
+                inplace_vector<T, N> const& rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename T, std::size_t N>
+void swap(inplace_vector<T, N>& lhs,
+          inplace_vector<T, N>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+// [inplace.vector.erasure], erasure
+template <typename T, std::size_t N, typename U>
+typename inplace_vector<T, N>::size_type erase(inplace_vector<T, N>& c,
+                                               U const& value) {
+  auto const it = std::remove(c.begin(), c.end(), value);
+  auto const r = static_cast<std::size_t>(c.end() - it);
+  c.erase(it, c.end());
+  return r;
+}
+
+template <typename T, std::size_t N, typename Predicate>
+typename inplace_vector<T, N>::size_type erase_if(inplace_vector<T, N>& c,
+                                                  Predicate pred) {
+  auto const it = std::remove_if(c.begin(), c.end(), pred);
+  auto const r = static_cast<std::size_t>(c.end() - it);
+  c.erase(it, c.end());
+  return r;
+}
+#endif
+
+} // namespace slb
+
+#endif // SLB_INPLACE_VECTOR_HPP
@@ -0,0 +1,99 @@
+/*
+  SLB.Latch
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_LATCH_HPP
+#define SLB_LATCH_HPP
+
+/*
+
+Header <latch> synopsis
+
+namespace std {
+  // [thread.latch.class], class latch
+  class latch {
+  public:
+    static constexpr ptrdiff_t max() noexcept;
+
+    constexpr explicit latch(ptrdiff_t expected);
+    ~latch();
+
+    latch(const latch&) = delete;
+    latch& operator=(const latch&) = delete;
+
+    void count_down(ptrdiff_t update = 1);
+    bool try_wait() const noexcept;
+    void wait() const;
+    void arrive_and_wait(ptrdiff_t update = 1);
+  };
+}
+
+*/
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+
+#include "detail/atomic_wait.hpp"
+#include "detail/config.hpp"
+
+#if __has_include(<latch>)
+#include <latch>
+#endif
+
+namespace slb {
+
+// [thread.latch.class], class latch
+
+#if __cpp_lib_latch // C++20
+using std::latch;
+#else
+class latch {
+public:
+  static constexpr std::ptrdiff_t max() noexcept { return INT_MAX; }
+
+  constexpr explicit latch(std::ptrdiff_t expected)
+      : counter_(static_cast<int>(expected)) {}
+
+  latch(latch const&) = delete;
+  latch& operator=(latch const&) = delete;
+
+  void count_down(std::ptrdiff_t update = 1) {
+    int const n = static_cast<int>(update);
+    if (counter_.fetch_sub(n, std::memory_order_release) == n) {
+      detail::platform_notify(counter_, INT_MAX);
+    }
+  }
+
+  bool try_wait() const noexcept {
+    return counter_.load(std::memory_order_acquire) == 0;
+  }
+
+  void wait() const {
+    if (detail::atomic_spin([this] { return try_wait(); })) {
+      return;
+    }
+    for (int old; (old = counter_.load(std::memory_order_acquire)) != 0;) {
+      detail::platform_wait(counter_, old);
+    }
+  }
+
+  void arrive_and_wait(std::ptrdiff_t update = 1) {
+    count_down(update);
+    wait();
+  }
+
+private:
+  std::atomic<int> counter_;
+};
+#endif
+
+} // namespace slb
+
+#endif // SLB_LATCH_HPP
@@ -0,0 +1,1454 @@
+/*
+  SLB.MDSpan
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_MDSPAN_HPP
+#define SLB_MDSPAN_HPP
+
+/*
+
+Header <mdspan> synopsis [mdspan.syn]
+
+namespace std {
+  // [mdspan.extents], class template extents
+  template<class IndexType, size_t... Extents>
+    class extents;
+
+  // [mdspan.extents.dextents], alias template dextents
+  template<class IndexType, size_t Rank>
+    using dextents = see below;
+
+  // [mdspan.layout], layout mapping
+  struct layout_left;
+  struct layout_right;
+  struct layout_stride;
+
+  // [mdspan.accessor.default], class template default_accessor
+  template<class ElementType>
+    class default_accessor;
+
+  // [mdspan.mdspan], class template mdspan
+  template<class ElementType, class Extents, class LayoutPolicy = layout_right,
+           class AccessorPolicy = default_accessor<ElementType>>
+    class mdspan;
+
+  // [mdspan.sub], submdspan creation
+  template<class OffsetType, class LengthType, class StrideType>
+    struct strided_slice;
+
+  struct full_extent_t { explicit full_extent_t() = default; };
+  inline constexpr full_extent_t full_extent{};
+
+  // [mdspan.sub.sub], submdspan function template
+  template<class ElementType, class Extents, class LayoutPolicy,
+           class AccessorPolicy, class... SliceSpecifiers>
+    constexpr auto submdspan(
+      const mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>& src,
+      SliceSpecifiers... slices) -> see below;
+}
+
+*/
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "detail/config.hpp"
+#include "detail/lib.hpp"
+#include "span.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
+
+namespace slb {
+
+#if __cpp_lib_mdspan >= 202207L && __cpp_lib_submdspan >= 202306L // C++26
+using std::extents;
+using std::dextents;
+using std::layout_left;
+using std::layout_right;
+using std::layout_stride;
+using std::default_accessor;
+using std::mdspan;
+using std::strided_slice;
+using std::full_extent_t;
+using std::full_extent;
+using std::submdspan;
+#else
+namespace detail {
+
+// Compile-time queries over the static extents, written as single return
+// statements so that they are constant expressions in C++11 as well. Given a
+// constant rank index, an optimizer folds them away entirely.
+constexpr std::size_t mdspan_pick(std::size_t) { return 0; }
+
+template <typename... Ts>
+constexpr std::size_t mdspan_pick(std::size_t r, std::size_t x, Ts... xs) {
+  return r == 0 ? x : detail::mdspan_pick(r - 1, xs...);
+}
+
+// The number of dynamic extents before rank index `r`.
+constexpr std::size_t mdspan_count_dynamic(std::size_t) { return 0; }
+
+template <typename... Ts>
+constexpr std::size_t mdspan_count_dynamic(std::size_t r,
+                                           std::size_t x,
+                                           Ts... xs) {
+  return r == 0 ? 0
+                : (x == dynamic_extent ? 1 : 0) +
+                      detail::mdspan_count_dynamic(r - 1, xs...);
+}
+
+// The rank index of the `d`-th dynamic extent.
+constexpr std::size_t mdspan_dynamic_position(std::size_t, std::size_t pos) {
+  return pos;
+}
+
+template <typename... Ts>
+constexpr std::size_t mdspan_dynamic_position(std::size_t d,
+                                              std::size_t pos,
+                                              std::size_t x,
+                                              Ts... xs) {
+  return x != dynamic_extent
+             ? detail::mdspan_dynamic_position(d, pos + 1, xs...)
+             : d == 0 ? pos
+                      : detail::mdspan_dynamic_position(d - 1, pos + 1, xs...);
+}
+
+template <std::size_t... Es>
+struct mdspan_rank_dynamic
+    : std::integral_constant<std::size_t,
+                             detail::mdspan_count_dynamic(sizeof...(Es),
+                                                          Es...)> {};
+
+// A fixed-size array that is empty when there is nothing to store, so that
+// fully static extents take no space beyond that of an empty object.
+template <typename T, std::size_t N>
+class mdspan_array {
+public:
+  constexpr mdspan_array() : elems_{} {}
+
+  template <typename... Ts>
+  constexpr explicit mdspan_array(T x, Ts... xs) : elems_{x, xs...} {}
+
+  constexpr T operator[](std::size_t i) const { return elems_[i]; }
+  SLB_CXX14_CONSTEXPR T& operator[](std::size_t i) { return elems_[i]; }
+
+private:
+  T elems_[N];
+};
+
+template <typename T>
+class mdspan_array<T, 0> {
+public:
+  constexpr T operator[](std::size_t) const { return T(); }
+};
+
+struct mdspan_from_all_t {};
+struct mdspan_from_mapping_t {};
+
+} // namespace detail
+
+// [mdspan.extents], class template extents
+
+// The static extents are part of the type; only the dynamic extents are
+// stored, in rank order.
+template <typename IndexType, std::size_t... Extents>
+class extents
+    : private detail::mdspan_array<
+          IndexType,
+          detail::mdspan_rank_dynamic<Extents...>::value> {
+  static_assert(std::is_integral<IndexType>::value &&
+                    !std::is_same<IndexType, bool>::value,
+                "`IndexType` shall be a signed or unsigned integer type.");
+
+  using dynamic_storage =
+      detail::mdspan_array<IndexType,
+                           detail::mdspan_rank_dynamic<Extents...>::value>;
+
+  template <typename... OtherIndexTypes>
+  using if_convertible = typename std::enable_if<
+      slb::conjunction<
+          std::is_convertible<OtherIndexTypes, IndexType>...>::value,
+      int>::type;
+
+  // Whether the static extents of `Other` agree with these where both are
+  // static.
+  template <typename Other>
+  static constexpr bool is_compatible(std::size_t r = 0) {
+    return r == sizeof...(Extents) ||
+           ((static_extent(r) == dynamic_extent ||
+             Other::static_extent(r) == dynamic_extent ||
+             static_extent(r) == Other::static_extent(r)) &&
+            is_compatible<Other>(r + 1));
+  }
+
+  // Whether converting from `Other` needs checking at runtime, either of a
+  // dynamic extent against a static one or of a narrowing conversion.
+  template <typename Other>
+  static constexpr bool is_narrowing(std::size_t r = 0) {
+    return r == sizeof...(Extents)
+               ? static_cast<unsigned long long>(
+                     std::numeric_limits<IndexType>::max()) <
+                     static_cast<unsigned long long>(std::numeric_limits<
+                         typename Other::index_type>::max())
+               : (static_extent(r) != dynamic_extent &&
+                  Other::static_extent(r) == dynamic_extent) ||
+                     is_narrowing<Other>(r + 1);
+  }
+
+public:
+  using index_type = IndexType;
+  using size_type = typename std::make_unsigned<IndexType>::type;
+  using rank_type = std::size_t;
+
+  // [mdspan.extents.obs], observers of the multidimensional index space
+  static constexpr rank_type rank() noexcept { return sizeof...(Extents); }
+  static constexpr rank_type rank_dynamic() noexcept {
+    return detail::mdspan_rank_dynamic<Extents...>::value;
+  }
+  static constexpr std::size_t static_extent(rank_type r) noexcept {
+    return detail::mdspan_pick(r, Extents...);
+  }
+  constexpr index_type extent(rank_type r) const noexcept {
+    return static_extent(r) == dynamic_extent
+               ? dynamic_storage::operator[](
+                     detail::mdspan_count_dynamic(r, Extents...))
+               : static_cast<index_type>(static_extent(r));
+  }
+
+  // [mdspan.extents.cons], constructors
+  constexpr extents() noexcept : dynamic_storage() {}
+
+  template <typename OtherIndexType,
+            std::size_t... OtherExtents,
+            typename std::enable_if<
+                sizeof...(OtherExtents) == sizeof...(Extents) &&
+                    is_compatible<extents<OtherIndexType,
+                                          OtherExtents...>>() &&
+                    !is_narrowing<extents<OtherIndexType,
+                                          OtherExtents...>>(),
+                int>::type = 0>
+  constexpr extents(
+      extents<OtherIndexType, OtherExtents...> const& other) noexcept
+      : extents(other,
+                slb::make_index_sequence<
+                    detail::mdspan_rank_dynamic<Extents...>::value>{}) {}
+
+  template <typename OtherIndexType,
+            std::size_t... OtherExtents,
+            typename std::enable_if<
+                sizeof...(OtherExtents) == sizeof...(Extents) &&
+                    is_compatible<extents<OtherIndexType,
+                                          OtherExtents...>>() &&
+                    is_narrowing<extents<OtherIndexType,
+                                         OtherExtents...>>(),
+                int>::type = 0>
+  constexpr explicit extents(
+      extents<OtherIndexType, OtherExtents...> const& other) noexcept
+      : extents(other,
+                slb::make_index_sequence<
+                    detail::mdspan_rank_dynamic<Extents...>::value>{}) {}
+
+  template <typename... OtherIndexTypes,
+            if_convertible<OtherIndexTypes...> = 0,
+            typename std::enable_if<
+                sizeof...(OtherIndexTypes) ==
+                    detail::mdspan_rank_dynamic<Extents...>::value,
+                int>::type = 0>
+  constexpr explicit extents(OtherIndexTypes... exts) noexcept
+      : dynamic_storage(static_cast<index_type>(exts)...) {}
+
+  template <typename... OtherIndexTypes,
+            if_convertible<OtherIndexTypes...> = 0,
+            typename std::enable_if<
+                sizeof...(OtherIndexTypes) == sizeof...(Extents) &&
+                    sizeof...(OtherIndexTypes) !=
+                        detail::mdspan_rank_dynamic<Extents...>::value,
+                int>::type = 0>
+  constexpr explicit extents(OtherIndexTypes... exts) noexcept
+      : extents(detail::mdspan_from_all_t{},
+                slb::make_index_sequence<
+                    detail::mdspan_rank_dynamic<Extents...>::value>{},
+                detail::mdspan_array<index_type, sizeof...(Extents)>(
+                    static_cast<index_type>(exts)...)) {}
+
+  template <typename OtherIndexType,
+            std::size_t N,
+            typename std::enable_if<
+                std::is_convertible<OtherIndexType const&,
+                                    index_type>::value &&
+                    N == detail::mdspan_rank_dynamic<Extents...>::value,
+                int>::type = 0>
+  constexpr extents(std::array<OtherIndexType, N> const& exts) noexcept
+      : extents(exts, slb::make_index_sequence<N>{}) {}
+
+  template <typename OtherIndexType,
+            std::size_t N,
+            typename std::enable_if<
+                std::is_convertible<OtherIndexType const&,
+                                    index_type>::value &&
+                    N == sizeof...(Extents) &&
+                    N != detail::mdspan_rank_dynamic<Extents...>::value,
+                int>::type = 0>
+  constexpr explicit extents(std::array<OtherIndexType, N> const& exts) noexcept
+      : extents(exts, slb::make_index_sequence<N>{}) {}
+
+  // [mdspan.extents.cmp], comparison operators
+  template <typename OtherIndexType, std::size_t... OtherExtents>
+  friend constexpr bool operator==(
+      extents const& x,
+      extents<OtherIndexType, OtherExtents...> const& y) noexcept {
+    return sizeof...(Extents) == sizeof...(OtherExtents) && x.equal(y, 0);
+  }
+
+  template <typename OtherIndexType, std::size_t... OtherExtents>
+  friend constexpr bool operator!=(
+      extents const& x,
+      extents<OtherIndexType, OtherExtents...> const& y) noexcept {
+    return !(x == y);
+  }
+
+private:
+  template <typename, std::size_t...>
+  friend class extents;
+
+  template <typename Other, std::size_t... D>
+  constexpr extents(Other const& other, slb::index_sequence<D...>) noexcept
+      : dynamic_storage(static_cast<index_type>(other.extent(
+            detail::mdspan_dynamic_position(D, 0, Extents...)))...) {}
+
+  template <typename OtherIndexType, std::size_t N, std::size_t... I>
+  constexpr extents(std::array<OtherIndexType, N> const& exts,
+                    slb::index_sequence<I...>) noexcept
+      : extents(static_cast<index_type>(exts[I])...) {}
+
+  template <std::size_t... D>
+  constexpr extents(
+      detail::mdspan_from_all_t,
+      slb::index_sequence<D...>,
+      detail::mdspan_array<index_type, sizeof...(Extents)> const& all) noexcept
+      : dynamic_storage(
+            all[detail::mdspan_dynamic_position(D, 0, Extents...)]...) {}
+
+  template <typename Other>
+  constexpr bool equal(Other const& other, rank_type r) const noexcept {
+    return r == sizeof...(Extents) ||
+           (extent(r) == other.extent(r) && equal(other, r + 1));
+  }
+};
+
+namespace detail {
+
+template <std::size_t>
+struct mdspan_dynamic_extent
+    : std::integral_constant<std::size_t, dynamic_extent> {};
+
+template <typename IndexType, typename Is>
+struct make_dextents;
+
+template <typename IndexType, std::size_t... Is>
+struct make_dextents<IndexType, slb::index_sequence<Is...>> {
+  using type = extents<IndexType, mdspan_dynamic_extent<Is>::value...>;
+};
+
+// The product of the extents in `[first, last)`.
+template <typename Extents>
+constexpr typename Extents::index_type mdspan_product(
+    Extents const& exts, std::size_t first, std::size_t last) noexcept {
+  return first == last ? 1
+                       : exts.extent(first) *
+                             detail::mdspan_product(exts, first + 1, last);
+}
+
+template <typename IndexType, typename... Indices>
+using enable_if_mdspan_indices = typename std::enable_if<
+    slb::conjunction<std::is_convertible<Indices, IndexType>...>::value,
+    int>::type;
+
+} // namespace detail
+
+// [mdspan.extents.dextents], alias template dextents
+template <typename IndexType, std::size_t Rank>
+using dextents =
+    typename detail::make_dextents<IndexType,
+                                   slb::make_index_sequence<Rank>>::type;
+
+// [mdspan.layout], layout mapping
+
+// The rightmost index is the fastest varying, as for nested C arrays.
+struct layout_right {
+  template <typename Extents>
+  class mapping;
+};
+
+// The leftmost index is the fastest varying, as in Fortran.
+struct layout_left {
+  template <typename Extents>
+  class mapping;
+};
+
+// Each index has a stride of its own.
+struct layout_stride {
+  template <typename Extents>
+  class mapping;
+};
+
+namespace detail {
+
+template <typename Mapping>
+struct is_mdspan_mapping : std::false_type {};
+
+template <typename Extents>
+struct is_mdspan_mapping<layout_right::mapping<Extents>> : std::true_type {};
+
+template <typename Extents>
+struct is_mdspan_mapping<layout_left::mapping<Extents>> : std::true_type {};
+
+template <typename Extents>
+struct is_mdspan_mapping<layout_stride::mapping<Extents>> : std::true_type {
+};
+
+} // namespace detail
+
+// [mdspan.layout.right], class template layout_right::mapping
+template <typename Extents>
+class layout_right::mapping {
+public:
+  using extents_type = Extents;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using layout_type = layout_right;
+
+  // [mdspan.layout.right.cons], constructors
+  constexpr mapping() noexcept = default;
+  constexpr mapping(extents_type const& exts) noexcept : extents_(exts) {}
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                std::is_constructible<extents_type, OtherExtents>::value &&
+                    std::is_convertible<OtherExtents, extents_type>::value,
+                int>::type = 0>
+  constexpr mapping(mapping<OtherExtents> const& other) noexcept
+      : extents_(other.extents()) {}
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                std::is_constructible<extents_type, OtherExtents>::value &&
+                    !std::is_convertible<OtherExtents, extents_type>::value,
+                int>::type = 0>
+  constexpr explicit mapping(mapping<OtherExtents> const& other) noexcept
+      : extents_(other.extents()) {}
+
+  // With a rank of at most one, the layouts coincide.
+  template <typename OtherExtents,
+            typename std::enable_if<
+                extents_type::rank() <= 1 &&
+                    std::is_constructible<extents_type, OtherExtents>::value,
+                int>::type = 0>
+  constexpr explicit mapping(
+      layout_left::mapping<OtherExtents> const& other) noexcept
+      : extents_(other.extents()) {}
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                std::is_constructible<extents_type, OtherExtents>::value,
+                int>::type = 0>
+  constexpr explicit mapping(
+      layout_stride::mapping<OtherExtents> const& other) noexcept
+      : extents_(other.extents()) {}
+
+  // [mdspan.layout.right.obs], observers
+  constexpr extents_type const& extents() const noexcept { return extents_; }
+
+  constexpr index_type required_span_size() const noexcept {
+    return detail::mdspan_product(extents_, 0, extents_type::rank());
+  }
+
+  template <typename... Indices,
+            typename std::enable_if<sizeof...(Indices) == extents_type::rank(),
+                                    int>::type = 0,
+            detail::enable_if_mdspan_indices<index_type, Indices...> = 0>
+  constexpr index_type operator()(Indices... is) const noexcept {
+    return offset<0>(index_type(0), static_cast<index_type>(is)...);
+  }
+
+  static constexpr bool is_always_unique() noexcept { return true; }
+  static constexpr bool is_always_exhaustive() noexcept { return true; }
+  static constexpr bool is_always_strided() noexcept { return true; }
+
+  static constexpr bool is_unique() noexcept { return true; }
+  static constexpr bool is_exhaustive() noexcept { return true; }
+  static constexpr bool is_strided() noexcept { return true; }
+
+  constexpr index_type stride(rank_type r) const noexcept {
+    return detail::mdspan_product(extents_, r + 1, extents_type::rank());
+  }
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                OtherExtents::rank() == extents_type::rank(), int>::type = 0>
+  friend constexpr bool operator==(
+      mapping const& x, mapping<OtherExtents> const& y) noexcept {
+    return x.extents() == y.extents();
+  }
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                OtherExtents::rank() == extents_type::rank(), int>::type = 0>
+  friend constexpr bool operator!=(
+      mapping const& x, mapping<OtherExtents> const& y) noexcept {
+    return !(x == y);
+  }
+
+private:
+  // `((i0 * e1 + i1) * e2 + i2) ...`
+  template <std::size_t R>
+  constexpr index_type offset(index_type acc) const noexcept {
+    return acc;
+  }
+
+  template <std::size_t R, typename... Is>
+  constexpr index_type offset(index_type acc,
+                              index_type i,
+                              Is... is) const noexcept {
+    return offset<R + 1>(acc * extents_.extent(R) + i, is...);
+  }
+
+  extents_type extents_;
+};
+
+// [mdspan.layout.left], class template layout_left::mapping
+template <typename Extents>
+class layout_left::mapping {
+public:
+  using extents_type = Extents;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using layout_type = layout_left;
+
+  // [mdspan.layout.left.cons], constructors
+  constexpr mapping() noexcept = default;
+  constexpr mapping(extents_type const& exts) noexcept : extents_(exts) {}
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                std::is_constructible<extents_type, OtherExtents>::value &&
+                    std::is_convertible<OtherExtents, extents_type>::value,
+                int>::type = 0>
+  constexpr mapping(mapping<OtherExtents> const& other) noexcept
+      : extents_(other.extents()) {}
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                std::is_constructible<extents_type, OtherExtents>::value &&
+                    !std::is_convertible<OtherExtents, extents_type>::value,
+                int>::type = 0>
+  constexpr explicit mapping(mapping<OtherExtents> const& other) noexcept
+      : extents_(other.extents()) {}
+
+  // With a rank of at most one, the layouts coincide.
+  template <typename OtherExtents,
+            typename std::enable_if<
+                extents_type::rank() <= 1 &&
+                    std::is_constructible<extents_type, OtherExtents>::value,
+                int>::type = 0>
+  constexpr explicit mapping(
+      layout_right::mapping<OtherExtents> const& other) noexcept
+      : extents_(other.extents()) {}
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                std::is_constructible<extents_type, OtherExtents>::value,
+                int>::type = 0>
+  constexpr explicit mapping(
+      layout_stride::mapping<OtherExtents> const& other) noexcept
+      : extents_(other.extents()) {}
+
+  // [mdspan.layout.left.obs], observers
+  constexpr extents_type const& extents() const noexcept { return extents_; }
+
+  constexpr index_type required_span_size() const noexcept {
+    return detail::mdspan_product(extents_, 0, extents_type::rank());
+  }
+
+  template <typename... Indices,
+            typename std::enable_if<sizeof...(Indices) == extents_type::rank(),
+                                    int>::type = 0,
+            detail::enable_if_mdspan_indices<index_type, Indices...> = 0>
+  constexpr index_type operator()(Indices... is) const noexcept {
+    return offset<0>(static_cast<index_type>(is)...);
+  }
+
+  static constexpr bool is_always_unique() noexcept { return true; }
+  static constexpr bool is_always_exhaustive() noexcept { return true; }
+  static constexpr bool is_always_strided() noexcept { return true; }
+
+  static constexpr bool is_unique() noexcept { return true; }
+  static constexpr bool is_exhaustive() noexcept { return true; }
+  static constexpr bool is_strided() noexcept { return true; }
+
+  constexpr index_type stride(rank_type r) const noexcept {
+    return detail::mdspan_product(extents_, 0, r);
+  }
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                OtherExtents::rank() == extents_type::rank(), int>::type = 0>
+  friend constexpr bool operator==(
+      mapping const& x, mapping<OtherExtents> const& y) noexcept {
+    return x.extents() == y.extents();
+  }
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                OtherExtents::rank() == extents_type::rank(), int>::type = 0>
+  friend constexpr bool operator!=(
+      mapping const& x, mapping<OtherExtents> const& y) noexcept {
+    return !(x == y);
+  }
+
+private:
+  // `i0 + e0 * (i1 + e1 * (i2 + ...))`
+  template <std::size_t R>
+  constexpr index_type offset() const noexcept {
+    return 0;
+  }
+
+  template <std::size_t R, typename... Is>
+  constexpr index_type offset(index_type i, Is... is) const noexcept {
+    return i + extents_.extent(R) * offset<R + 1>(is...);
+  }
+
+  extents_type extents_;
+};
+
+// [mdspan.layout.stride], class template layout_stride::mapping
+template <typename Extents>
+class layout_stride::mapping {
+  using stride_storage =
+      detail::mdspan_array<typename Extents::index_type, Extents::rank()>;
+
+public:
+  using extents_type = Extents;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using layout_type = layout_stride;
+
+  // [mdspan.layout.stride.cons], constructors
+  constexpr mapping() noexcept
+      : mapping(layout_right::mapping<extents_type>()) {}
+
+  template <typename OtherIndexType,
+            typename std::enable_if<
+                std::is_convertible<OtherIndexType const&,
+                                    index_type>::value,
+                int>::type = 0>
+  constexpr mapping(
+      extents_type const& exts,
+      std::array<OtherIndexType, extents_type::rank()> const& s) noexcept
+      : mapping(exts, s, slb::make_index_sequence<extents_type::rank()>{}) {}
+
+  template <typename OtherIndexType,
+            typename std::enable_if<
+                std::is_convertible<OtherIndexType const&,
+                                    index_type>::value,
+                int>::type = 0>
+  constexpr mapping(
+      extents_type const& exts,
+      span<OtherIndexType, extents_type::rank()> s) noexcept
+      : mapping(exts, s, slb::make_index_sequence<extents_type::rank()>{}) {}
+
+  // Any of the standard layouts is strided.
+  template <typename StridedMapping,
+            typename std::enable_if<
+                detail::is_mdspan_mapping<StridedMapping>::value &&
+                    std::is_constructible<
+                        extents_type,
+                        typename StridedMapping::extents_type>::value &&
+                    std::is_convertible<typename StridedMapping::extents_type,
+                                        extents_type>::value,
+                int>::type = 0>
+  constexpr mapping(StridedMapping const& other) noexcept
+      : mapping(detail::mdspan_from_mapping_t{},
+                extents_type(other.extents()),
+                other,
+                slb::make_index_sequence<extents_type::rank()>{}) {}
+
+  template <typename StridedMapping,
+            typename std::enable_if<
+                detail::is_mdspan_mapping<StridedMapping>::value &&
+                    std::is_constructible<
+                        extents_type,
+                        typename StridedMapping::extents_type>::value &&
+                    !std::is_convertible<typename StridedMapping::extents_type,
+                                         extents_type>::value,
+                int>::type = 0>
+  constexpr explicit mapping(StridedMapping const& other) noexcept
+      : mapping(detail::mdspan_from_mapping_t{},
+                extents_type(other.extents()),
+                other,
+                slb::make_index_sequence<extents_type::rank()>{}) {}
+
+  // [mdspan.layout.stride.obs], observers
+  constexpr extents_type const& extents() const noexcept { return extents_; }
+
+  std::array<index_type, extents_type::rank()> strides() const noexcept {
+    return strides(slb::make_index_sequence<extents_type::rank()>{});
+  }
+
+  constexpr index_type required_span_size() const noexcept {
+    return detail::mdspan_product(extents_, 0, extents_type::rank()) == 0
+               ? 0
+               : 1 + span_size(0);
+  }
+
+  template <typename... Indices,
+            typename std::enable_if<sizeof...(Indices) == extents_type::rank(),
+                                    int>::type = 0,
+            detail::enable_if_mdspan_indices<index_type, Indices...> = 0>
+  constexpr index_type operator()(Indices... is) const noexcept {
+    return offset<0>(static_cast<index_type>(is)...);
+  }
+
+  static constexpr bool is_always_unique() noexcept { return true; }
+  static constexpr bool is_always_exhaustive() noexcept { return false; }
+  static constexpr bool is_always_strided() noexcept { return true; }
+
+  static constexpr bool is_unique() noexcept { return true; }
+  static constexpr bool is_strided() noexcept { return true; }
+
+  // Whether some ordering of the ranks, from the smallest stride up, lays
+  // them out one after another with no gaps.
+  SLB_CXX14_CONSTEXPR bool is_exhaustive() const noexcept {
+    bool used[extents_type::rank() + 1] = {};
+    index_type expected = 1;
+    for (rank_type n = 0; n < extents_type::rank(); ++n) {
+      rank_type next = extents_type::rank();
+      for (rank_type r = 0; r < extents_type::rank(); ++r) {
+        if (!used[r] && strides_[r] == expected &&
+            (next == extents_type::rank() ||
+             extents_.extent(r) < extents_.extent(next))) {
+          next = r;
+        }
+      }
+      if (next == extents_type::rank()) {
+        return false;
+      }
+      used[next] = true;
+      expected *= extents_.extent(next);
+    }
+    return true;
+  }
+
+  constexpr index_type stride(rank_type r) const noexcept {
+    return strides_[r];
+  }
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                OtherExtents::rank() == extents_type::rank(), int>::type = 0>
+  friend constexpr bool operator==(
+      mapping const& x, mapping<OtherExtents> const& y) noexcept {
+    return x.extents() == y.extents() && x.equal_strides(y, 0);
+  }
+
+  template <typename OtherExtents,
+            typename std::enable_if<
+                OtherExtents::rank() == extents_type::rank(), int>::type = 0>
+  friend constexpr bool operator!=(
+      mapping const& x, mapping<OtherExtents> const& y) noexcept {
+    return !(x == y);
+  }
+
+private:
+  template <typename>
+  friend class mapping;
+
+  template <typename Strides, std::size_t... R>
+  constexpr mapping(extents_type const& exts,
+                    Strides const& s,
+                    slb::index_sequence<R...>) noexcept
+      : extents_(exts), strides_(static_cast<index_type>(s[R])...) {}
+
+  template <typename StridedMapping, std::size_t... R>
+  constexpr mapping(detail::mdspan_from_mapping_t,
+                    extents_type const& exts,
+                    StridedMapping const& other,
+                    slb::index_sequence<R...>) noexcept
+      : extents_(exts), strides_(static_cast<index_type>(other.stride(R))...) {
+  }
+
+  template <std::size_t... R>
+  std::array<index_type, extents_type::rank()> strides(
+      slb::index_sequence<R...>) const noexcept {
+    return {{strides_[R]...}};
+  }
+
+  constexpr index_type span_size(rank_type r) const noexcept {
+    return r == extents_type::rank()
+               ? 0
+               : (extents_.extent(r) - 1) * strides_[r] + span_size(r + 1);
+  }
+
+  template <typename Other>
+  constexpr bool equal_strides(Other const& other,
+                               rank_type r) const noexcept {
+    return r == extents_type::rank() ||
+           (strides_[r] == other.stride(r) && equal_strides(other, r + 1));
+  }
+
+  // `i0 * s0 + i1 * s1 + i2 * s2 ...`
+  template <std::size_t R>
+  constexpr index_type offset() const noexcept {
+    return 0;
+  }
+
+  template <std::size_t R, typename... Is>
+  constexpr index_type offset(index_type i, Is... is) const noexcept {
+    return i * strides_[R] + offset<R + 1>(is...);
+  }
+
+  extents_type extents_;
+  stride_storage strides_;
+};
+
+// [mdspan.accessor.default], class template default_accessor
+template <typename ElementType>
+class default_accessor {
+public:
+  using offset_policy = default_accessor;
+  using element_type = ElementType;
+  using reference = ElementType&;
+  using data_handle_type = ElementType*;
+
+  constexpr default_accessor() noexcept = default;
+
+  template <typename OtherElementType,
+            typename std::enable_if<
+                std::is_convertible<OtherElementType (*)[],
+                                    element_type (*)[]>::value,
+                int>::type = 0>
+  constexpr default_accessor(default_accessor<OtherElementType>) noexcept {}
+
+  constexpr reference access(data_handle_type p, std::size_t i) const
+      noexcept {
+    return p[i];
+  }
+
+  constexpr data_handle_type offset(data_handle_type p, std::size_t i) const
+      noexcept {
+    return p + i;
+  }
+};
+
+// [mdspan.mdspan], class template mdspan
+
+// A multidimensional view over a pointer. Indexing is a call to the layout
+// mapping, which for static extents reduces to the same arithmetic as a
+// hand-written offset.
+//
+// Without multidimensional `operator[]` (C++23), elements are accessed with
+// `operator()`, or with `operator[]` given an array of indices.
+template <typename ElementType,
+          typename Extents,
+          typename LayoutPolicy = layout_right,
+          typename AccessorPolicy = default_accessor<ElementType>>
+class mdspan {
+  using mapping_of = typename LayoutPolicy::template mapping<Extents>;
+
+public:
+  using extents_type = Extents;
+  using layout_type = LayoutPolicy;
+  using accessor_type = AccessorPolicy;
+  using mapping_type = mapping_of;
+  using element_type = ElementType;
+  using value_type = typename std::remove_cv<ElementType>::type;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using data_handle_type = typename accessor_type::data_handle_type;
+  using reference = typename accessor_type::reference;
+
+  static constexpr rank_type rank() noexcept { return extents_type::rank(); }
+  static constexpr rank_type rank_dynamic() noexcept {
+    return extents_type::rank_dynamic();
+  }
+  static constexpr std::size_t static_extent(rank_type r) noexcept {
+    return extents_type::static_extent(r);
+  }
+  constexpr index_type extent(rank_type r) const noexcept {
+    return extents().extent(r);
+  }
+
+  // [mdspan.mdspan.cons], constructors
+  template <typename E = Extents,
+            typename std::enable_if<(E::rank_dynamic() > 0), int>::type = 0>
+  constexpr mdspan() : ptr_(), map_(), acc_() {}
+
+  constexpr mdspan(mdspan const&) = default;
+  constexpr mdspan(mdspan&&) = default;
+
+  template <typename... OtherIndexTypes,
+            detail::enable_if_mdspan_indices<index_type, OtherIndexTypes...> =
+                0,
+            typename std::enable_if<
+                std::is_constructible<extents_type,
+                                      OtherIndexTypes...>::value,
+                int>::type = 0>
+  constexpr explicit mdspan(data_handle_type p, OtherIndexTypes... exts)
+      : ptr_(SLB_MOVE(p)),
+        map_(extents_type(static_cast<index_type>(exts)...)),
+        acc_() {}
+
+  template <typename OtherIndexType,
+            std::size_t N,
+            typename std::enable_if<
+                std::is_convertible<std::array<OtherIndexType, N> const&,
+                                    extents_type>::value,
+                int>::type = 0>
+  constexpr mdspan(data_handle_type p,
+                   std::array<OtherIndexType, N> const& exts)
+      : ptr_(SLB_MOVE(p)), map_(extents_type(exts)), acc_() {}
+
+  template <typename OtherIndexType,
+            std::size_t N,
+            typename std::enable_if<
+                std::is_constructible<extents_type,
+                                      std::array<OtherIndexType, N> const&>::
+                        value &&
+                    !std::is_convertible<std::array<OtherIndexType, N> const&,
+                                         extents_type>::value,
+                int>::type = 0>
+  constexpr explicit mdspan(data_handle_type p,
+                            std::array<OtherIndexType, N> const& exts)
+      : ptr_(SLB_MOVE(p)), map_(extents_type(exts)), acc_() {}
+
+  constexpr mdspan(data_handle_type p, extents_type const& exts)
+      : ptr_(SLB_MOVE(p)), map_(exts), acc_() {}
+
+  constexpr mdspan(data_handle_type p, mapping_type const& m)
+      : ptr_(SLB_MOVE(p)), map_(m), acc_() {}
+
+  constexpr mdspan(data_handle_type p,
+                   mapping_type const& m,
+                   accessor_type const& a)
+      : ptr_(SLB_MOVE(p)), map_(m), acc_(a) {}
+
+  template <typename OtherElementType,
+            typename OtherExtents,
+            typename OtherLayoutPolicy,
+            typename OtherAccessor,
+            typename OtherMapping =
+                typename OtherLayoutPolicy::template mapping<OtherExtents>,
+            typename std::enable_if<
+                std::is_constructible<mapping_type,
+                                      OtherMapping const&>::value &&
+                    std::is_constructible<accessor_type,
+                                          OtherAccessor const&>::value &&
+                    std::is_convertible<OtherMapping const&,
+                                        mapping_type>::value &&
+                    std::is_convertible<OtherAccessor const&,
+                                        accessor_type>::value,
+                int>::type = 0>
+  constexpr mdspan(mdspan<OtherElementType,
+                          OtherExtents,
+                          OtherLayoutPolicy,
+                          OtherAccessor> const& other)
+      : ptr_(other.data_handle()),
+        map_(other.mapping()),
+        acc_(other.accessor()) {}
+
+  template <typename OtherElementType,
+            typename OtherExtents,
+            typename OtherLayoutPolicy,
+            typename OtherAccessor,
+            typename OtherMapping =
+                typename OtherLayoutPolicy::template mapping<OtherExtents>,
+            typename std::enable_if<
+                std::is_constructible<mapping_type,
+                                      OtherMapping const&>::value &&
+                    std::is_constructible<accessor_type,
+                                          OtherAccessor const&>::value &&
+                    !(std::is_convertible<OtherMapping const&,
+                                          mapping_type>::value &&
+                      std::is_convertible<OtherAccessor const&,
+                                          accessor_type>::value),
+                int>::type = 0>
+  constexpr explicit mdspan(mdspan<OtherElementType,
+                                   OtherExtents,
+                                   OtherLayoutPolicy,
+                                   OtherAccessor> const& other)
+      : ptr_(other.data_handle()),
+        map_(other.mapping()),
+        acc_(other.accessor()) {}
+
+  SLB_CXX14_CONSTEXPR mdspan& operator=(mdspan const&) = default;
+  SLB_CXX14_CONSTEXPR mdspan& operator=(mdspan&&) = default;
+
+  // [mdspan.mdspan.members], members
+  template <typename... Indices,
+            typename std::enable_if<sizeof...(Indices) == Extents::rank(),
+                                    int>::type = 0,
+            detail::enable_if_mdspan_indices<index_type, Indices...> = 0>
+  constexpr reference operator()(Indices... is) const {
+    return acc_.access(ptr_, static_cast<std::size_t>(
+                                 map_(static_cast<index_type>(is)...)));
+  }
+
+#if __cpp_multidimensional_subscript >= 202110L // C++23
+  template <typename... Indices,
+            typename std::enable_if<sizeof...(Indices) == Extents::rank(),
+                                    int>::type = 0,
+            detail::enable_if_mdspan_indices<index_type, Indices...> = 0>
+  constexpr reference operator[](Indices... is) const {
+    return (*this)(is...);
+  }
+#endif
+
+  template <typename OtherIndexType,
+            typename std::enable_if<
+                std::is_convertible<OtherIndexType const&,
+                                    index_type>::value,
+                int>::type = 0>
+  constexpr reference operator[](
+      std::array<OtherIndexType, Extents::rank()> const& indices) const {
+    return access(indices, slb::make_index_sequence<Extents::rank()>{});
+  }
+
+  template <typename OtherIndexType,
+            typename std::enable_if<
+                std::is_convertible<OtherIndexType const&,
+                                    index_type>::value,
+                int>::type = 0>
+  constexpr reference operator[](
+      span<OtherIndexType, Extents::rank()> indices) const {
+    return access(indices, slb::make_index_sequence<Extents::rank()>{});
+  }
+
+  constexpr size_type size() const noexcept {
+    return static_cast<size_type>(
+        detail::mdspan_product(extents(), 0, rank()));
+  }
+  constexpr bool empty() const noexcept { return size() == 0; }
+
+  friend void swap(mdspan& x, mdspan& y) noexcept {
+    using std::swap;
+    swap(x.ptr_, y.ptr_);
+    swap(x.map_, y.map_);
+    swap(x.acc_, y.acc_);
+  }
+
+  constexpr extents_type const& extents() const noexcept {
+    return map_.extents();
+  }
+  constexpr data_handle_type const& data_handle() const noexcept {
+    return ptr_;
+  }
+  constexpr mapping_type const& mapping() const noexcept { return map_; }
+  constexpr accessor_type const& accessor() const noexcept { return acc_; }
+
+  static constexpr bool is_always_unique() {
+    return mapping_type::is_always_unique();
+  }
+  static constexpr bool is_always_exhaustive() {
+    return mapping_type::is_always_exhaustive();
+  }
+  static constexpr bool is_always_strided() {
+    return mapping_type::is_always_strided();
+  }
+
+  constexpr bool is_unique() const { return map_.is_unique(); }
+  constexpr bool is_exhaustive() const { return map_.is_exhaustive(); }
+  constexpr bool is_strided() const { return map_.is_strided(); }
+  constexpr index_type stride(rank_type r) const { return map_.stride(r); }
+
+private:
+  template <typename Indices, std::size_t... R>
+  constexpr reference access(Indices const& indices,
+                             slb::index_sequence<R...>) const {
+    return (*this)(static_cast<index_type>(indices[R])...);
+  }
+
+  data_handle_type ptr_;
+  mapping_type map_;
+  accessor_type acc_;
+};
+
+#if __cpp_deduction_guides
+template <typename ElementType,
+          typename... Integrals,
+          typename std::enable_if<
+              slb::conjunction<
+                  std::is_convertible<Integrals, std::size_t>...>::value &&
+                  (sizeof...(Integrals) > 0),
+              int>::type = 0>
+explicit mdspan(ElementType*, Integrals...)
+    -> mdspan<ElementType, dextents<std::size_t, sizeof...(Integrals)>>;
+
+template <typename ElementType, typename OtherIndexType, std::size_t N>
+mdspan(ElementType*, std::array<OtherIndexType, N> const&)
+    -> mdspan<ElementType, dextents<std::size_t, N>>;
+
+template <typename ElementType, typename IndexType, std::size_t... Extents>
+mdspan(ElementType*, extents<IndexType, Extents...> const&)
+    -> mdspan<ElementType, extents<IndexType, Extents...>>;
+
+template <typename ElementType, typename Mapping>
+mdspan(ElementType*, Mapping const&)
+    -> mdspan<ElementType,
+              typename Mapping::extents_type,
+              typename Mapping::layout_type>;
+#endif
+
+// [mdspan.sub], submdspan creation
+
+// A slice of `extent` indices, `stride` apart, starting at `offset`.
+template <typename OffsetType, typename ExtentType, typename StrideType>
+struct strided_slice {
+  using offset_type = OffsetType;
+  using extent_type = ExtentType;
+  using stride_type = StrideType;
+
+  OffsetType offset;
+  ExtentType extent;
+  StrideType stride;
+};
+
+struct full_extent_t {
+  explicit full_extent_t() = default;
+};
+
+SLB_CXX17_INLINE_VARIABLE constexpr full_extent_t full_extent{};
+
+namespace detail {
+
+enum mdspan_slice_kind {
+  mdspan_slice_index,   // a single index, which removes the rank
+  mdspan_slice_full,    // `full_extent`
+  mdspan_slice_range,   // a pair-like `{first, last}`
+  mdspan_slice_strided, // `strided_slice`
+  mdspan_slice_invalid
+};
+
+template <typename T>
+struct is_mdspan_pair_like : std::false_type {};
+
+template <typename T, typename U>
+struct is_mdspan_pair_like<std::pair<T, U>> : std::true_type {};
+
+template <typename T, typename U>
+struct is_mdspan_pair_like<std::tuple<T, U>> : std::true_type {};
+
+template <typename T>
+struct is_mdspan_pair_like<std::array<T, 2>> : std::true_type {};
+
+template <typename T>
+struct is_strided_slice : std::false_type {};
+
+template <typename OffsetType, typename ExtentType, typename StrideType>
+struct is_strided_slice<strided_slice<OffsetType, ExtentType, StrideType>>
+    : std::true_type {};
+
+template <typename IndexType, typename S>
+struct mdspan_slice_kind_of
+    : std::integral_constant<
+          int,
+          std::is_convertible<S, IndexType>::value
+              ? mdspan_slice_index
+              : std::is_same<S, full_extent_t>::value
+                    ? mdspan_slice_full
+                    : is_mdspan_pair_like<S>::value
+                          ? mdspan_slice_range
+                          : is_strided_slice<S>::value
+                                ? mdspan_slice_strided
+                                : mdspan_slice_invalid> {};
+
+// The first index of a slice, and the extent and stride of the rank it
+// leaves in the result.
+template <typename IndexType,
+          typename S,
+          int = mdspan_slice_kind_of<IndexType, S>::value>
+struct mdspan_slice;
+
+template <typename IndexType, typename S>
+struct mdspan_slice<IndexType, S, mdspan_slice_index> {
+  static IndexType first(S const& s) { return static_cast<IndexType>(s); }
+  static IndexType extent(S const&, IndexType) { return 0; }
+  static IndexType stride(S const&, IndexType) { return 0; }
+};
+
+template <typename IndexType, typename S>
+struct mdspan_slice<IndexType, S, mdspan_slice_full> {
+  static IndexType first(S const&) { return 0; }
+  static IndexType extent(S const&, IndexType ext) { return ext; }
+  static IndexType stride(S const&, IndexType str) { return str; }
+};
+
+template <typename IndexType, typename S>
+struct mdspan_slice<IndexType, S, mdspan_slice_range> {
+  static IndexType first(S const& s) {
+    return static_cast<IndexType>(std::get<0>(s));
+  }
+  static IndexType extent(S const& s, IndexType) {
+    return static_cast<IndexType>(std::get<1>(s)) -
+           static_cast<IndexType>(std::get<0>(s));
+  }
+  static IndexType stride(S const&, IndexType str) { return str; }
+};
+
+template <typename IndexType, typename S>
+struct mdspan_slice<IndexType, S, mdspan_slice_strided> {
+  static IndexType first(S const& s) {
+    return static_cast<IndexType>(s.offset);
+  }
+  static IndexType extent(S const& s, IndexType) {
+    return static_cast<IndexType>(s.extent) == 0
+               ? 0
+               : 1 + (static_cast<IndexType>(s.extent) - 1) /
+                         static_cast<IndexType>(s.stride);
+  }
+  static IndexType stride(S const& s, IndexType str) {
+    return static_cast<IndexType>(s.extent) == 0
+               ? str
+               : str * static_cast<IndexType>(s.stride);
+  }
+};
+
+// The extents of the result drop the ranks sliced by a single index; only
+// the ranks taken whole keep their static extent.
+template <typename Result,
+          std::size_t R,
+          typename Extents,
+          typename... Slices>
+struct submdspan_extents_impl {
+  using type = Result;
+};
+
+template <typename IndexType,
+          std::size_t... Es,
+          std::size_t R,
+          typename Extents,
+          typename S,
+          typename... Slices>
+struct submdspan_extents_impl<extents<IndexType, Es...>,
+                              R,
+                              Extents,
+                              S,
+                              Slices...>
+    : std::conditional<
+          mdspan_slice_kind_of<IndexType, S>::value == mdspan_slice_index,
+          submdspan_extents_impl<extents<IndexType, Es...>,
+                                 R + 1,
+                                 Extents,
+                                 Slices...>,
+          submdspan_extents_impl<
+              extents<IndexType,
+                      Es...,
+                      mdspan_slice_kind_of<IndexType, S>::value ==
+                              mdspan_slice_full
+                          ? Extents::static_extent(R)
+                          : dynamic_extent>,
+              R + 1,
+              Extents,
+              Slices...>>::type {};
+
+template <typename Extents, typename... Slices>
+using submdspan_extents_t = typename submdspan_extents_impl<
+    extents<typename Extents::index_type>,
+    0,
+    Extents,
+    Slices...>::type;
+
+// Whether the ranks that remain, taken in order from `first`, are a unit
+// stride range followed by whole ranks.
+constexpr bool submdspan_is_right(std::size_t, std::size_t) { return true; }
+
+template <typename... Ks>
+constexpr bool submdspan_is_right(std::size_t r,
+                                  std::size_t first,
+                                  int kind,
+                                  Ks... kinds) {
+  return (r < first ||
+          (r == first ? kind == mdspan_slice_full ||
+                            kind == mdspan_slice_range
+                      : kind == mdspan_slice_full)) &&
+         detail::submdspan_is_right(r + 1, first, kinds...);
+}
+
+// Whether the ranks that remain, up to `last`, are whole ranks followed by a
+// unit stride range.
+constexpr bool submdspan_is_left(std::size_t, std::size_t) { return true; }
+
+template <typename... Ks>
+constexpr bool submdspan_is_left(std::size_t r,
+                                 std::size_t last,
+                                 int kind,
+                                 Ks... kinds) {
+  return (r > last ||
+          (r == last ? kind == mdspan_slice_full ||
+                           kind == mdspan_slice_range
+                     : kind == mdspan_slice_full)) &&
+         detail::submdspan_is_left(r + 1, last, kinds...);
+}
+
+// Slicing keeps `layout_right` and `layout_left` where the elements that
+// remain are still contiguous in their ranks, and `layout_stride` otherwise.
+template <typename Layout, typename SubExtents, typename... Slices>
+struct submdspan_layout {
+  using type = layout_stride;
+};
+
+template <typename SubExtents, typename... Slices>
+struct submdspan_layout<layout_right, SubExtents, Slices...> {
+  using type = typename std::conditional<
+      SubExtents::rank() == 0 ||
+          detail::submdspan_is_right(
+              0,
+              sizeof...(Slices) - SubExtents::rank(),
+              mdspan_slice_kind_of<typename SubExtents::index_type,
+                                   Slices>::value...),
+      layout_right,
+      layout_stride>::type;
+};
+
+template <typename SubExtents, typename... Slices>
+struct submdspan_layout<layout_left, SubExtents, Slices...> {
+  using type = typename std::conditional<
+      SubExtents::rank() == 0 ||
+          detail::submdspan_is_left(
+              0,
+              SubExtents::rank() - 1,
+              mdspan_slice_kind_of<typename SubExtents::index_type,
+                                   Slices>::value...),
+      layout_left,
+      layout_stride>::type;
+};
+
+template <typename Mapping, typename SubExtents, typename Strides>
+Mapping submdspan_mapping(layout_right,
+                          SubExtents const& exts,
+                          Strides const&) {
+  return Mapping(exts);
+}
+
+template <typename Mapping, typename SubExtents, typename Strides>
+Mapping submdspan_mapping(layout_left,
+                          SubExtents const& exts,
+                          Strides const&) {
+  return Mapping(exts);
+}
+
+template <typename Mapping, typename SubExtents, typename Strides>
+Mapping submdspan_mapping(layout_stride,
+                          SubExtents const& exts,
+                          Strides const& strides) {
+  return Mapping(exts, strides);
+}
+
+template <typename T,
+          typename Extents,
+          typename Layout,
+          typename Accessor,
+          std::size_t... R,
+          typename... Slices>
+mdspan<T,
+       submdspan_extents_t<Extents, Slices...>,
+       typename submdspan_layout<Layout,
+                                 submdspan_extents_t<Extents, Slices...>,
+                                 Slices...>::type,
+       typename Accessor::offset_policy>
+submdspan(mdspan<T, Extents, Layout, Accessor> const& src,
+          slb::index_sequence<R...>,
+          Slices const&... slices) {
+  using index_type = typename Extents::index_type;
+  using sub_extents_type = submdspan_extents_t<Extents, Slices...>;
+  using sub_layout_type =
+      typename submdspan_layout<Layout, sub_extents_type, Slices...>::type;
+  using sub_mapping_type =
+      typename sub_layout_type::template mapping<sub_extents_type>;
+
+  // Trailing zeros keep the arrays from being empty at rank 0.
+  int const kinds[] = {mdspan_slice_kind_of<index_type, Slices>::value...,
+                       0};
+  index_type const firsts[] = {
+      mdspan_slice<index_type, Slices>::first(slices)..., 0};
+  index_type const exts[] = {
+      mdspan_slice<index_type, Slices>::extent(slices, src.extent(R))..., 0};
+  index_type const strides[] = {
+      mdspan_slice<index_type, Slices>::stride(slices, src.stride(R))..., 0};
+
+  index_type offset = 0;
+  std::array<index_type, sub_extents_type::rank()> sub_exts = {};
+  std::array<index_type, sub_extents_type::rank()> sub_strides = {};
+  std::size_t n = 0;
+  for (std::size_t r = 0; r < Extents::rank(); ++r) {
+    offset += firsts[r] * src.stride(r);
+    if (kinds[r] != mdspan_slice_index) {
+      sub_exts[n] = exts[r];
+      sub_strides[n] = strides[r];
+      ++n;
+    }
+  }
+
+  return mdspan<T, sub_extents_type, sub_layout_type,
+                typename Accessor::offset_policy>(
+      src.accessor().offset(src.data_handle(),
+                            static_cast<std::size_t>(offset)),
+      detail::submdspan_mapping<sub_mapping_type>(
+          sub_layout_type(), sub_extents_type(sub_exts), sub_strides),
+      typename Accessor::offset_policy(src.accessor()));
+}
+
+} // namespace detail
+
+// [mdspan.sub.sub], submdspan function template
+
+// Each slice is a single index, which removes its rank from the result,
+// `full_extent`, a pair-like `{first, last}`, or a `strided_slice`. Only
+// ranks taken with `full_extent` keep a static extent.
+template <typename T,
+          typename Extents,
+          typename Layout,
+          typename Accessor,
+          typename... Slices>
+mdspan<T,
+       detail::submdspan_extents_t<Extents, Slices...>,
+       typename detail::submdspan_layout<
+           Layout,
+           detail::submdspan_extents_t<Extents, Slices...>,
+           Slices...>::type,
+       typename Accessor::offset_policy>
+submdspan(mdspan<T, Extents, Layout, Accessor> const& src, Slices... slices) {
+  static_assert(sizeof...(Slices) == Extents::rank(),
+                "There shall be a slice for each rank.");
+  static_assert(
+      !slb::disjunction<slb::bool_constant<
+          detail::mdspan_slice_kind_of<typename Extents::index_type,
+                                       Slices>::value ==
+          detail::mdspan_slice_invalid>...>::value,
+      "Each slice shall be an index, `full_extent`, a pair-like range, or a "
+      "`strided_slice`.");
+  return detail::submdspan(src, slb::make_index_sequence<Extents::rank()>{},
+                           slices...);
+}
+#endif
+
+} // namespace slb
+
+#endif // SLB_MDSPAN_HPP
@@ -0,0 +1,650 @@
+/*
+  SLB.Memory
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_MEMORY_HPP
+#define SLB_MEMORY_HPP
+
+/*
+
+Header <memory> synopsis [memory.syn]
+
+namespace std {
+  // [specialized.algorithms], specialized algorithms
+  template<class T>
+    constexpr T* addressof(T& r) noexcept;
+  template<class T>
+    const T* addressof(const T&&) = delete;
+
+  template<class InputIterator, class NoThrowForwardIterator>
+    NoThrowForwardIterator uninitialized_copy(InputIterator first,
+                                              InputIterator last,
+                                              NoThrowForwardIterator result);
+  template<class InputIterator, class Size, class NoThrowForwardIterator>
+    NoThrowForwardIterator uninitialized_copy_n(InputIterator first, Size n,
+                                                NoThrowForwardIterator result);
+
+  template<class InputIterator, class NoThrowForwardIterator>
+    NoThrowForwardIterator uninitialized_move(InputIterator first,
+                                              InputIterator last,
+                                              NoThrowForwardIterator result);
+  template<class InputIterator, class Size, class NoThrowForwardIterator>
+    pair<InputIterator, NoThrowForwardIterator>
+      uninitialized_move_n(InputIterator first, Size n,
+                           NoThrowForwardIterator result);
+
+  template<class NoThrowForwardIterator>
+    void uninitialized_default_construct(NoThrowForwardIterator first,
+                                         NoThrowForwardIterator last);
+  template<class NoThrowForwardIterator, class Size>
+    NoThrowForwardIterator
+      uninitialized_default_construct_n(NoThrowForwardIterator first, Size n);
+
+  template<class NoThrowForwardIterator>
+    void uninitialized_value_construct(NoThrowForwardIterator first,
+                                       NoThrowForwardIterator last);
+  template<class NoThrowForwardIterator, class Size>
+    NoThrowForwardIterator
+      uninitialized_value_construct_n(NoThrowForwardIterator first, Size n);
+
+  template<class T>
+    void destroy_at(T* location);
+  template<class NoThrowForwardIterator>
+    void destroy(NoThrowForwardIterator first, NoThrowForwardIterator last);
+  template<class NoThrowForwardIterator, class Size>
+    NoThrowForwardIterator destroy_n(NoThrowForwardIterator first, Size n);
+
+  // P1144: "Object relocation in terms of move plus destroy"
+  template<class T>
+    T* relocate_at(T* source, T* dest);
+  template<class InputIterator, class NoThrowForwardIterator>
+    NoThrowForwardIterator uninitialized_relocate(InputIterator first,
+                                                  InputIterator last,
+                                                  NoThrowForwardIterator result);
+  template<class InputIterator, class Size, class NoThrowForwardIterator>
+    pair<InputIterator, NoThrowForwardIterator>
+      uninitialized_relocate_n(InputIterator first, Size n,
+                               NoThrowForwardIterator result);
+}
+
+*/
+
+#include <memory>
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "detail/config.hpp"
+#include "detail/lib.hpp"
+#include "type_traits.hpp"
+
+namespace slb {
+
+// [specialized.algorithms], specialized algorithms
+
+using std::addressof;
+
+namespace detail {
+
+template <typename T>
+void* voidify(T& obj) noexcept {
+  return const_cast<void*>(
+      static_cast<void const volatile*>(std::addressof(obj)));
+}
+
+template <typename T>
+void* voidify_ptr(T* p) noexcept {
+  return const_cast<void*>(static_cast<void const*>(p));
+}
+
+template <typename It>
+using iter_value_t = typename std::iterator_traits<It>::value_type;
+
+template <typename It>
+using iter_category_t = typename std::iterator_traits<It>::iterator_category;
+
+template <typename It>
+using is_forward_iterator =
+    std::is_base_of<std::forward_iterator_tag, iter_category_t<It>>;
+
+template <typename It>
+using enable_if_input_iterator = typename std::enable_if<
+    std::is_base_of<std::input_iterator_tag, iter_category_t<It>>::value>::type;
+
+} // namespace detail
+
+// [specialized.destroy], destroy
+
+#if __cpp_lib_raw_memory_algorithms // C++17
+using std::destroy_at;
+#else
+template <typename T>
+void destroy_at(T* location) {
+  location->~T();
+}
+#endif
+
+// We don't defer to the C++17 `destroy`/`destroy_n` or the `uninitialized_*`
+// algorithms, since not all implementations reduce them to no-ops, `memcpy`
+// or `memset` for trivial element types.
+
+namespace detail {
+
+template <typename ForwardIt, typename Size>
+ForwardIt destroy_n(std::true_type, ForwardIt first, Size n) {
+  std::advance(first, n > 0 ? n : 0);
+  return first;
+}
+
+template <typename ForwardIt, typename Size>
+ForwardIt destroy_n(std::false_type, ForwardIt first, Size n) {
+  for (; n > 0; ++first, (void)--n) {
+    slb::destroy_at(std::addressof(*first));
+  }
+  return first;
+}
+
+template <typename ForwardIt>
+void destroy(std::true_type, ForwardIt, ForwardIt) {}
+
+template <typename ForwardIt>
+void destroy(std::false_type, ForwardIt first, ForwardIt last) {
+  for (; first != last; ++first) {
+    slb::destroy_at(std::addressof(*first));
+  }
+}
+
+// Destroys the objects in `[first, last)` unless released.
+template <typename ForwardIt>
+struct destroy_guard {
+  ForwardIt first;
+  ForwardIt& last;
+  bool released;
+
+  ~destroy_guard() {
+    if (!released) {
+      detail::destroy(
+          slb::bool_constant<slb::is_trivially_destructible<
+              detail::iter_value_t<ForwardIt>>::value>{},
+          first,
+          last);
+    }
+  }
+};
+
+} // namespace detail
+
+template <typename ForwardIt>
+void destroy(ForwardIt first, ForwardIt last) {
+  detail::destroy(slb::bool_constant<slb::is_trivially_destructible<
+                      detail::iter_value_t<ForwardIt>>::value>{},
+                  first,
+                  last);
+}
+
+template <typename ForwardIt, typename Size>
+ForwardIt destroy_n(ForwardIt first, Size n) {
+  return detail::destroy_n(slb::bool_constant<slb::is_trivially_destructible<
+                               detail::iter_value_t<ForwardIt>>::value>{},
+                           first,
+                           n);
+}
+
+// [uninitialized.copy], uninitialized_copy
+// [uninitialized.move], uninitialized_move
+
+namespace detail {
+
+// Whether constructing `ForwardIt`'s elements from `InputIt`'s elements can be
+// done by copying the object representations, i.e., both are pointers to the
+// same type and `Trait` (a triviality trait) holds for it.
+template <template <typename> class Trait,
+          typename InputIt,
+          typename ForwardIt>
+struct is_memcpy_constructible : std::false_type {};
+
+template <template <typename> class Trait, typename T, typename U>
+struct is_memcpy_constructible<Trait, T*, U*>
+    : slb::bool_constant<
+          std::is_same<typename std::remove_const<T>::type, U>::value &&
+          !std::is_volatile<U>::value && Trait<U>::value &&
+          slb::is_trivially_destructible<U>::value> {};
+
+template <typename T, typename U, typename Size>
+std::pair<T*, U*> uninitialized_memcpy_n(T* first, Size n, U* d_first) {
+  if (n <= 0) {
+    return {first, d_first};
+  }
+  std::memcpy(detail::voidify_ptr(d_first), detail::voidify_ptr(first),
+              static_cast<std::size_t>(n) * sizeof(U));
+  return {first + n, d_first + n};
+}
+
+template <typename T, typename U>
+U* uninitialized_copy(std::true_type, T* first, T* last, U* d_first) {
+  return detail::uninitialized_memcpy_n(first, last - first, d_first).second;
+}
+
+template <typename InputIt, typename ForwardIt>
+ForwardIt uninitialized_copy(std::false_type,
+                             InputIt first,
+                             InputIt last,
+                             ForwardIt d_first) {
+  using T = detail::iter_value_t<ForwardIt>;
+  ForwardIt current = d_first;
+  destroy_guard<ForwardIt> guard{d_first, current, false};
+  for (; first != last; ++first, (void)++current) {
+    ::new (detail::voidify(*current)) T(*first);
+  }
+  guard.released = true;
+  return current;
+}
+
+template <typename T, typename Size, typename U>
+U* uninitialized_copy_n(std::true_type, T* first, Size n, U* d_first) {
+  return detail::uninitialized_memcpy_n(first, n, d_first).second;
+}
+
+template <typename InputIt, typename Size, typename ForwardIt>
+ForwardIt uninitialized_copy_n(std::false_type,
+                               InputIt first,
+                               Size n,
+                               ForwardIt d_first) {
+  using T = detail::iter_value_t<ForwardIt>;
+  ForwardIt current = d_first;
+  destroy_guard<ForwardIt> guard{d_first, current, false};
+  for (; n > 0; ++first, (void)++current, --n) {
+    ::new (detail::voidify(*current)) T(*first);
+  }
+  guard.released = true;
+  return current;
+}
+
+template <typename T, typename U>
+U* uninitialized_move(std::true_type, T* first, T* last, U* d_first) {
+  return detail::uninitialized_memcpy_n(first, last - first, d_first).second;
+}
+
+template <typename InputIt, typename ForwardIt>
+ForwardIt uninitialized_move(std::false_type,
+                             InputIt first,
+                             InputIt last,
+                             ForwardIt d_first) {
+  using T = detail::iter_value_t<ForwardIt>;
+  ForwardIt current = d_first;
+  destroy_guard<ForwardIt> guard{d_first, current, false};
+  for (; first != last; ++first, (void)++current) {
+    ::new (detail::voidify(*current)) T(std::move(*first));
+  }
+  guard.released = true;
+  return current;
+}
+
+template <typename T, typename Size, typename U>
+std::pair<T*, U*> uninitialized_move_n(std::true_type,
+                                       T* first,
+                                       Size n,
+                                       U* d_first) {
+  return detail::uninitialized_memcpy_n(first, n, d_first);
+}
+
+template <typename InputIt, typename Size, typename ForwardIt>
+std::pair<InputIt, ForwardIt> uninitialized_move_n(std::false_type,
+                                                   InputIt first,
+                                                   Size n,
+                                                   ForwardIt d_first) {
+  using T = detail::iter_value_t<ForwardIt>;
+  ForwardIt current = d_first;
+  destroy_guard<ForwardIt> guard{d_first, current, false};
+  for (; n > 0; ++first, (void)++current, --n) {
+    ::new (detail::voidify(*current)) T(std::move(*first));
+  }
+  guard.released = true;
+  return {first, current};
+}
+
+} // namespace detail
+
+template <typename InputIt, typename ForwardIt>
+ForwardIt uninitialized_copy(InputIt first, InputIt last, ForwardIt d_first) {
+  return detail::uninitialized_copy(
+      slb::bool_constant<
+          detail::is_memcpy_constructible<slb::is_trivially_copy_constructible,
+                                          InputIt,
+                                          ForwardIt>::value>{},
+      first,
+      last,
+      d_first);
+}
+
+template <typename InputIt, typename Size, typename ForwardIt>
+ForwardIt uninitialized_copy_n(InputIt first, Size n, ForwardIt d_first) {
+  return detail::uninitialized_copy_n(
+      slb::bool_constant<
+          detail::is_memcpy_constructible<slb::is_trivially_copy_constructible,
+                                          InputIt,
+                                          ForwardIt>::value>{},
+      first,
+      n,
+      d_first);
+}
+
+template <typename InputIt, typename ForwardIt>
+ForwardIt uninitialized_move(InputIt first, InputIt last, ForwardIt d_first) {
+  return detail::uninitialized_move(
+      slb::bool_constant<
+          detail::is_memcpy_constructible<slb::is_trivially_move_constructible,
+                                          InputIt,
+                                          ForwardIt>::value>{},
+      first,
+      last,
+      d_first);
+}
+
+template <typename InputIt, typename Size, typename ForwardIt>
+std::pair<InputIt, ForwardIt> uninitialized_move_n(InputIt first,
+                                                   Size n,
+                                                   ForwardIt d_first) {
+  return detail::uninitialized_move_n(
+      slb::bool_constant<
+          detail::is_memcpy_constructible<slb::is_trivially_move_constructible,
+                                          InputIt,
+                                          ForwardIt>::value>{},
+      first,
+      n,
+      d_first);
+}
+
+// [uninitialized.construct.default], uninitialized_default_construct
+
+namespace detail {
+
+template <typename ForwardIt, typename Size>
+ForwardIt uninitialized_default_construct_n(std::true_type,
+                                            ForwardIt first,
+                                            Size n) {
+  std::advance(first, n > 0 ? n : 0);
+  return first;
+}
+
+template <typename ForwardIt, typename Size>
+ForwardIt uninitialized_default_construct_n(std::false_type,
+                                            ForwardIt first,
+                                            Size n) {
+  using T = detail::iter_value_t<ForwardIt>;
+  ForwardIt current = first;
+  destroy_guard<ForwardIt> guard{first, current, false};
+  for (; n > 0; ++current, (void)--n) {
+    ::new (detail::voidify(*current)) T;
+  }
+  guard.released = true;
+  return current;
+}
+
+template <typename ForwardIt>
+void uninitialized_default_construct(std::true_type, ForwardIt, ForwardIt) {}
+
+template <typename ForwardIt>
+void uninitialized_default_construct(std::false_type,
+                                     ForwardIt first,
+                                     ForwardIt last) {
+  using T = detail::iter_value_t<ForwardIt>;
+  ForwardIt current = first;
+  destroy_guard<ForwardIt> guard{first, current, false};
+  for (; current != last; ++current) {
+    ::new (detail::voidify(*current)) T;
+  }
+  guard.released = true;
+}
+
+} // namespace detail
+
+template <typename ForwardIt>
+void uninitialized_default_construct(ForwardIt first, ForwardIt last) {
+  detail::uninitialized_default_construct(
+      slb::bool_constant<slb::is_trivially_default_constructible<
+          detail::iter_value_t<ForwardIt>>::value>{},
+      first,
+      last);
+}
+
+template <typename ForwardIt, typename Size>
+ForwardIt uninitialized_default_construct_n(ForwardIt first, Size n) {
+  return detail::uninitialized_default_construct_n(
+      slb::bool_constant<slb::is_trivially_default_constructible<
+          detail::iter_value_t<ForwardIt>>::value>{},
+      first,
+      n);
+}
+
+// [uninitialized.construct.value], uninitialized_value_construct
+
+namespace detail {
+
+// Value-initialization can be done with `memset` only if the zero value is
+// represented by all-bits-zero, which does not hold for pointers to data
+// members on the Itanium ABI, nor in general for class types that may contain
+// them.
+template <typename ForwardIt>
+struct is_memset_constructible : std::false_type {};
+
+template <typename T>
+struct is_memset_constructible<T*>
+    : slb::bool_constant<std::is_scalar<T>::value &&
+                         !std::is_member_pointer<T>::value &&
+                         !std::is_volatile<T>::value> {};
+
+template <typename T, typename Size>
+T* uninitialized_value_construct_n(std::true_type, T* first, Size n) {
+  if (n <= 0) {
+    return first;
+  }
+  std::memset(detail::voidify_ptr(first), 0,
+              static_cast<std::size_t>(n) * sizeof(T));
+  return first + n;
+}
+
+template <typename ForwardIt, typename Size>
+ForwardIt uninitialized_value_construct_n(std::false_type,
+                                          ForwardIt first,
+                                          Size n) {
+  using T = detail::iter_value_t<ForwardIt>;
+  ForwardIt current = first;
+  destroy_guard<ForwardIt> guard{first, current, false};
+  for (; n > 0; ++current, (void)--n) {
+    ::new (detail::voidify(*current)) T();
+  }
+  guard.released = true;
+  return current;
+}
+
+template <typename T>
+void uninitialized_value_construct(std::true_type, T* first, T* last) {
+  detail::uninitialized_value_construct_n(std::true_type{}, first,
+                                          last - first);
+}
+
+template <typename ForwardIt>
+void uninitialized_value_construct(std::false_type,
+                                   ForwardIt first,
+                                   ForwardIt last) {
+  using T = detail::iter_value_t<ForwardIt>;
+  ForwardIt current = first;
+  destroy_guard<ForwardIt> guard{first, current, false};
+  for (; current != last; ++current) {
+    ::new (detail::voidify(*current)) T();
+  }
+  guard.released = true;
+}
+
+} // namespace detail
+
+template <typename ForwardIt>
+void uninitialized_value_construct(ForwardIt first, ForwardIt last) {
+  detail::uninitialized_value_construct(
+      slb::bool_constant<detail::is_memset_constructible<ForwardIt>::value>{},
+      first,
+      last);
+}
+
+template <typename ForwardIt, typename Size>
+ForwardIt uninitialized_value_construct_n(ForwardIt first, Size n) {
+  return detail::uninitialized_value_construct_n(
+      slb::bool_constant<detail::is_memset_constructible<ForwardIt>::value>{},
+      first,
+      n);
+}
+
+// P1144: "Object relocation in terms of move plus destroy"
+
+namespace detail {
+
+// Whether relocating from `InputIt` to `ForwardIt` can be done by copying the
+// object representations, i.e., both are pointers to the same trivially
+// relocatable type.
+template <typename InputIt, typename ForwardIt>
+struct is_memmove_relocatable : std::false_type {};
+
+template <typename T>
+struct is_memmove_relocatable<T*, T*>
+    : slb::bool_constant<slb::is_trivially_relocatable<T>::value &&
+                         !std::is_volatile<T>::value> {};
+
+template <typename T>
+T* relocate_at(std::true_type, T* source, T* dest) noexcept {
+  std::memmove(detail::voidify_ptr(dest), detail::voidify_ptr(source),
+               sizeof(T));
+  return dest;
+}
+
+template <typename T>
+T* relocate_at(std::false_type, T* source, T* dest) {
+  struct guard {
+    T* t;
+    ~guard() { slb::destroy_at(t); }
+  } g{source};
+  return ::new (detail::voidify(*dest)) T(std::move(*source));
+}
+
+template <typename T, typename Size>
+std::pair<T*, T*> uninitialized_relocate_n(std::true_type,
+                                           T* first,
+                                           Size n,
+                                           T* d_first) noexcept {
+  if (n <= 0) {
+    return {first, d_first};
+  }
+  std::memmove(detail::voidify_ptr(d_first), detail::voidify_ptr(first),
+               static_cast<std::size_t>(n) * sizeof(T));
+  return {first + n, d_first + n};
+}
+
+// If an exception is thrown, all objects in both the source and the
+// destination ranges are destroyed.
+template <typename InputIt, typename Size, typename ForwardIt>
+std::pair<InputIt, ForwardIt> uninitialized_relocate_n(std::false_type,
+                                                       InputIt first,
+                                                       Size n,
+                                                       ForwardIt d_first) {
+  using T = detail::iter_value_t<ForwardIt>;
+  struct source_guard {
+    InputIt& first;
+    Size& n;
+    ~source_guard() {
+      for (; n > 0; ++first, (void)--n) {
+        slb::destroy_at(std::addressof(*first));
+      }
+    }
+  } sources{first, n};
+  ForwardIt current = d_first;
+  destroy_guard<ForwardIt> destinations{d_first, current, false};
+  for (; n > 0; ++first, (void)++current, --n) {
+    ::new (detail::voidify(*current)) T(std::move(*first));
+    slb::destroy_at(std::addressof(*first));
+  }
+  destinations.released = true;
+  return {first, current};
+}
+
+template <typename T>
+T* uninitialized_relocate(std::true_type, T* first, T* last, T* d_first) {
+  return detail::uninitialized_relocate_n(
+             std::true_type{}, first, last - first, d_first)
+      .second;
+}
+
+template <typename InputIt, typename ForwardIt>
+ForwardIt uninitialized_relocate(std::false_type,
+                                 InputIt first,
+                                 InputIt last,
+                                 ForwardIt d_first) {
+  using T = detail::iter_value_t<ForwardIt>;
+  struct source_guard {
+    InputIt& first;
+    InputIt& last;
+    ~source_guard() {
+      for (; first != last; ++first) {
+        slb::destroy_at(std::addressof(*first));
+      }
+    }
+  } sources{first, last};
+  ForwardIt current = d_first;
+  destroy_guard<ForwardIt> destinations{d_first, current, false};
+  for (; first != last; ++first, (void)++current) {
+    ::new (detail::voidify(*current)) T(std::move(*first));
+    slb::destroy_at(std::addressof(*first));
+  }
+  destinations.released = true;
+  return current;
+}
+
+} // namespace detail
+
+template <typename T>
+T* relocate_at(T* source, T* dest) noexcept(
+    slb::is_trivially_relocatable<T>::value ||
+    std::is_nothrow_move_constructible<T>::value) {
+  static_assert(!std::is_const<T>::value, "`T` shall not be const-qualified.");
+  return detail::relocate_at(
+      slb::bool_constant<detail::is_memmove_relocatable<T*, T*>::value>{},
+      source,
+      dest);
+}
+
+template <typename InputIt, typename ForwardIt>
+ForwardIt uninitialized_relocate(InputIt first,
+                                 InputIt last,
+                                 ForwardIt d_first) {
+  return detail::uninitialized_relocate(
+      slb::bool_constant<
+          detail::is_memmove_relocatable<InputIt, ForwardIt>::value>{},
+      first,
+      last,
+      d_first);
+}
+
+template <typename InputIt, typename Size, typename ForwardIt>
+std::pair<InputIt, ForwardIt> uninitialized_relocate_n(InputIt first,
+                                                       Size n,
+                                                       ForwardIt d_first) {
+  return detail::uninitialized_relocate_n(
+      slb::bool_constant<
+          detail::is_memmove_relocatable<InputIt, ForwardIt>::value>{},
+      first,
+      n,
+      d_first);
+}
+
+} // namespace slb
+
+#endif // SLB_MEMORY_HPP
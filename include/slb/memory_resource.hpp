@@ -0,0 +1,1211 @@
+/*
+  SLB.MemoryResource
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_MEMORY_RESOURCE_HPP
+#define SLB_MEMORY_RESOURCE_HPP
+
+/*
+
+Header <memory_resource> synopsis [mem.res.syn]
+
+namespace std::pmr {
+  // [mem.res.class], class memory_resource
+  class memory_resource;
+
+  bool operator==(const memory_resource& a, const memory_resource& b) noexcept;
+  bool operator!=(const memory_resource& a, const memory_resource& b) noexcept;
+
+  // [mem.poly.allocator.class], class template polymorphic_allocator
+  template<class Tp> class polymorphic_allocator;
+
+  template<class T1, class T2>
+    bool operator==(const polymorphic_allocator<T1>& a,
+                    const polymorphic_allocator<T2>& b) noexcept;
+  template<class T1, class T2>
+    bool operator!=(const polymorphic_allocator<T1>& a,
+                    const polymorphic_allocator<T2>& b) noexcept;
+
+  // [mem.res.global], global memory resources
+  memory_resource* new_delete_resource() noexcept;
+  memory_resource* null_memory_resource() noexcept;
+  memory_resource* set_default_resource(memory_resource* r) noexcept;
+  memory_resource* get_default_resource() noexcept;
+
+  // [mem.res.pool], pool resource classes
+  struct pool_options;
+  class synchronized_pool_resource;
+  class unsynchronized_pool_resource;
+  class monotonic_buffer_resource;
+}
+
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "bit.hpp"
+#include "detail/config.hpp"
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+namespace slb {
+namespace pmr {
+
+#if __cpp_lib_memory_resource // C++17
+using std::pmr::memory_resource;
+using std::pmr::polymorphic_allocator;
+using std::pmr::new_delete_resource;
+using std::pmr::null_memory_resource;
+using std::pmr::set_default_resource;
+using std::pmr::get_default_resource;
+using std::pmr::pool_options;
+using std::pmr::synchronized_pool_resource;
+using std::pmr::unsynchronized_pool_resource;
+using std::pmr::monotonic_buffer_resource;
+#else
+
+// [mem.res.class], class memory_resource
+
+class memory_resource {
+public:
+  memory_resource() = default;
+  memory_resource(memory_resource const&) = default;
+  virtual ~memory_resource() = default;
+
+  memory_resource& operator=(memory_resource const&) = default;
+
+  void* allocate(std::size_t bytes,
+                 std::size_t alignment = alignof(std::max_align_t)) {
+    return do_allocate(bytes, alignment);
+  }
+
+  void deallocate(void* p,
+                  std::size_t bytes,
+                  std::size_t alignment = alignof(std::max_align_t)) {
+    do_deallocate(p, bytes, alignment);
+  }
+
+  bool is_equal(memory_resource const& other) const noexcept {
+    return do_is_equal(other);
+  }
+
+private:
+  virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+  virtual void do_deallocate(void* p,
+                             std::size_t bytes,
+                             std::size_t alignment) = 0;
+  virtual bool do_is_equal(memory_resource const& other) const noexcept = 0;
+};
+
+inline bool operator==(memory_resource const& a,
+                       memory_resource const& b) noexcept {
+  return &a == &b || a.is_equal(b);
+}
+
+inline bool operator!=(memory_resource const& a,
+                       memory_resource const& b) noexcept {
+  return !(a == b);
+}
+
+} // namespace pmr
+
+namespace detail {
+
+// Without aligned `operator new`, over-aligned blocks are carved from a
+// larger allocation, and the pointer to it is stored right before the block.
+inline void* aligned_new(std::size_t bytes, std::size_t alignment) {
+#if __cpp_aligned_new
+  return alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+             ? ::operator new(bytes, std::align_val_t(alignment))
+             : ::operator new(bytes);
+#else
+  if (alignment <= alignof(std::max_align_t)) {
+    return ::operator new(bytes);
+  }
+  if (bytes > std::numeric_limits<std::size_t>::max() - alignment) {
+    throw std::bad_alloc();
+  }
+  void* const p = ::operator new(bytes + alignment);
+  void* const block = reinterpret_cast<void*>(
+      (reinterpret_cast<std::uintptr_t>(p) + alignment) & ~(alignment - 1));
+  static_cast<void**>(block)[-1] = p;
+  return block;
+#endif
+}
+
+inline void aligned_delete(void* p, std::size_t alignment) noexcept {
+#if __cpp_aligned_new
+  if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    ::operator delete(p, std::align_val_t(alignment));
+  } else {
+    ::operator delete(p);
+  }
+#else
+  ::operator delete(alignment <= alignof(std::max_align_t)
+                        ? p
+                        : static_cast<void**>(p)[-1]);
+#endif
+}
+
+class new_delete_resource_impl final : public pmr::memory_resource {
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    return detail::aligned_new(bytes, alignment);
+  }
+
+  void do_deallocate(void* p,
+                     std::size_t /*bytes*/,
+                     std::size_t alignment) override {
+    detail::aligned_delete(p, alignment);
+  }
+
+  bool do_is_equal(
+      pmr::memory_resource const& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+class null_memory_resource_impl final : public pmr::memory_resource {
+  void* do_allocate(std::size_t, std::size_t) override {
+    throw std::bad_alloc();
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(
+      pmr::memory_resource const& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+// The global memory resources are never destroyed, so that they can be used
+// during the destruction of objects with static storage duration.
+template <typename T>
+T* immortal() noexcept {
+  alignas(T) static unsigned char storage[sizeof(T)];
+  static T* const p = ::new (static_cast<void*>(storage)) T();
+  return p;
+}
+
+} // namespace detail
+
+namespace pmr {
+
+// [mem.res.global], global memory resources
+
+inline memory_resource* new_delete_resource() noexcept {
+  return detail::immortal<detail::new_delete_resource_impl>();
+}
+
+inline memory_resource* null_memory_resource() noexcept {
+  return detail::immortal<detail::null_memory_resource_impl>();
+}
+
+} // namespace pmr
+
+namespace detail {
+
+inline std::atomic<pmr::memory_resource*>& default_resource() noexcept {
+  static std::atomic<pmr::memory_resource*> resource(
+      pmr::new_delete_resource());
+  return resource;
+}
+
+} // namespace detail
+
+namespace pmr {
+
+inline memory_resource* set_default_resource(memory_resource* r) noexcept {
+  return detail::default_resource().exchange(r != nullptr
+                                                 ? r
+                                                 : pmr::new_delete_resource());
+}
+
+inline memory_resource* get_default_resource() noexcept {
+  return detail::default_resource().load();
+}
+
+} // namespace pmr
+
+namespace detail {
+
+// [allocator.uses.construction], uses-allocator construction
+template <typename T, typename Alloc, typename... Args>
+struct uses_allocator_kind
+    : std::integral_constant<
+          int,
+          !std::uses_allocator<T, Alloc>::value
+              ? 0
+              : std::is_constructible<T,
+                                      std::allocator_arg_t,
+                                      Alloc const&,
+                                      Args...>::value
+                    ? 1
+                    : 2> {};
+
+template <typename Alloc, typename... Args>
+std::tuple<Args...> uses_allocator_args(std::integral_constant<int, 0>,
+                                        Alloc const&,
+                                        std::tuple<Args...>&& args) {
+  return std::move(args);
+}
+
+template <typename Alloc, typename... Args>
+std::tuple<std::allocator_arg_t, Alloc const&, Args...> uses_allocator_args(
+    std::integral_constant<int, 1>,
+    Alloc const& alloc,
+    std::tuple<Args...>&& args) {
+  return std::tuple_cat(
+      std::tuple<std::allocator_arg_t, Alloc const&>(std::allocator_arg,
+                                                     alloc),
+      std::move(args));
+}
+
+template <typename Alloc, typename... Args>
+std::tuple<Args..., Alloc const&> uses_allocator_args(
+    std::integral_constant<int, 2>,
+    Alloc const& alloc,
+    std::tuple<Args...>&& args) {
+  return std::tuple_cat(std::move(args), std::tuple<Alloc const&>(alloc));
+}
+
+template <typename T, typename Alloc, typename... Args>
+void uses_allocator_construct(std::integral_constant<int, 0>,
+                              T* p,
+                              Alloc const&,
+                              Args&&... args) {
+  ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+}
+
+template <typename T, typename Alloc, typename... Args>
+void uses_allocator_construct(std::integral_constant<int, 1>,
+                              T* p,
+                              Alloc const& alloc,
+                              Args&&... args) {
+  ::new (static_cast<void*>(p))
+      T(std::allocator_arg, alloc, std::forward<Args>(args)...);
+}
+
+template <typename T, typename Alloc, typename... Args>
+void uses_allocator_construct(std::integral_constant<int, 2>,
+                              T* p,
+                              Alloc const& alloc,
+                              Args&&... args) {
+  ::new (static_cast<void*>(p)) T(std::forward<Args>(args)..., alloc);
+}
+
+template <typename T>
+struct is_pair : std::false_type {};
+
+template <typename T1, typename T2>
+struct is_pair<std::pair<T1, T2>> : std::true_type {};
+
+} // namespace detail
+
+namespace pmr {
+
+// [mem.poly.allocator.class], class template polymorphic_allocator
+
+template <typename T>
+class polymorphic_allocator {
+public:
+  using value_type = T;
+
+  // [mem.poly.allocator.ctor], constructors
+  polymorphic_allocator() noexcept : resource_(pmr::get_default_resource()) {}
+  polymorphic_allocator(memory_resource* r) : resource_(r) {}
+
+  polymorphic_allocator(polymorphic_allocator const& other) = default;
+
+  template <typename U>
+  polymorphic_allocator(polymorphic_allocator<U> const& other) noexcept
+      : resource_(other.resource()) {}
+
+  polymorphic_allocator& operator=(polymorphic_allocator const&) = delete;
+
+  // [mem.poly.allocator.mem], member functions
+  T* allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) {
+    resource_->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  template <typename U,
+            typename... Args,
+            typename std::enable_if<!detail::is_pair<U>::value, int>::type = 0>
+  void construct(U* p, Args&&... args) {
+    detail::uses_allocator_construct(
+        detail::uses_allocator_kind<U, polymorphic_allocator, Args...>{},
+        p,
+        *this,
+        std::forward<Args>(args)...);
+  }
+
+  template <typename T1, typename T2, typename... Args1, typename... Args2>
+  void construct(std::pair<T1, T2>* p,
+                 std::piecewise_construct_t,
+                 std::tuple<Args1...> x,
+                 std::tuple<Args2...> y) {
+    ::new (static_cast<void*>(p)) std::pair<T1, T2>(
+        std::piecewise_construct,
+        detail::uses_allocator_args(
+            detail::uses_allocator_kind<T1, polymorphic_allocator, Args1...>{},
+            *this,
+            std::move(x)),
+        detail::uses_allocator_args(
+            detail::uses_allocator_kind<T2, polymorphic_allocator, Args2...>{},
+            *this,
+            std::move(y)));
+  }
+
+  template <typename T1, typename T2>
+  void construct(std::pair<T1, T2>* p) {
+    construct(p, std::piecewise_construct, std::tuple<>(), std::tuple<>());
+  }
+
+  template <typename T1, typename T2, typename U, typename V>
+  void construct(std::pair<T1, T2>* p, U&& x, V&& y) {
+    construct(p,
+              std::piecewise_construct,
+              std::forward_as_tuple(std::forward<U>(x)),
+              std::forward_as_tuple(std::forward<V>(y)));
+  }
+
+  template <typename T1, typename T2, typename U, typename V>
+  void construct(std::pair<T1, T2>* p, std::pair<U, V> const& pr) {
+    construct(p,
+              std::piecewise_construct,
+              std::forward_as_tuple(pr.first),
+              std::forward_as_tuple(pr.second));
+  }
+
+  template <typename T1, typename T2, typename U, typename V>
+  void construct(std::pair<T1, T2>* p, std::pair<U, V>&& pr) {
+    construct(p,
+              std::piecewise_construct,
+              std::forward_as_tuple(std::forward<U>(pr.first)),
+              std::forward_as_tuple(std::forward<V>(pr.second)));
+  }
+
+  template <typename U>
+  void destroy(U* p) {
+    p->~U();
+  }
+
+  polymorphic_allocator select_on_container_copy_construction() const {
+    return polymorphic_allocator();
+  }
+
+  memory_resource* resource() const { return resource_; }
+
+private:
+  memory_resource* resource_;
+};
+
+// [mem.poly.allocator.eq], equality
+template <typename T1, typename T2>
+bool operator==(polymorphic_allocator<T1> const& a,
+                polymorphic_allocator<T2> const& b) noexcept {
+  return *a.resource() == *b.resource();
+}
+
+template <typename T1, typename T2>
+bool operator!=(polymorphic_allocator<T1> const& a,
+                polymorphic_allocator<T2> const& b) noexcept {
+  return !(a == b);
+}
+
+// [mem.res.pool.options], pool_options data members
+struct pool_options {
+  std::size_t max_blocks_per_chunk = 0;
+  std::size_t largest_required_pool_block = 0;
+};
+
+} // namespace pmr
+
+namespace detail {
+
+struct free_block {
+  free_block* next;
+};
+
+// Blocks of each pool are carved from chunks obtained from the upstream
+// resource. The bookkeeping for a chunk is placed after its blocks.
+struct pool_chunk {
+  pool_chunk* next;
+  std::size_t blocks;
+};
+
+// Allocations too large for any pool go directly to the upstream resource,
+// prefixed with a header that links them together so they can be released.
+struct oversized_block {
+  oversized_block* prev;
+  oversized_block* next;
+  std::size_t bytes;
+  std::size_t alignment;
+};
+
+// The pools of a pool resource, which serve power-of-two block sizes from
+// `min_block_size` up to `largest_required_pool_block`. Each pool hands out
+// freed blocks first, then carves new ones from its current chunk. Chunks
+// grow geometrically up to `max_blocks_per_chunk` or `max_chunk_size` bytes,
+// whichever is smaller, but always hold at least one block.
+class pool_set {
+public:
+  enum : std::size_t {
+    min_block_size = sizeof(free_block) < 8 ? 8 : sizeof(free_block),
+    max_block_size = std::size_t(1) << 20,
+    max_pools = 18,
+    max_chunk_size = std::size_t(1) << 20
+  };
+
+  pool_set(pmr::pool_options const& options,
+           pmr::memory_resource* upstream) noexcept
+      : options_(normalize(options)),
+        upstream_(upstream),
+        npools_(static_cast<std::size_t>(slb::bit_width(
+                    options_.largest_required_pool_block - 1)) -
+                static_cast<std::size_t>(slb::bit_width(min_block_size - 1)) +
+                1),
+        oversized_(nullptr) {}
+
+  pool_set(pool_set const&) = delete;
+  pool_set& operator=(pool_set const&) = delete;
+
+  ~pool_set() { release(); }
+
+  pmr::pool_options options() const noexcept { return options_; }
+  pmr::memory_resource* upstream() const noexcept { return upstream_; }
+  std::size_t pool_count() const noexcept { return npools_; }
+
+  std::size_t block_size(std::size_t index) const noexcept {
+    return min_block_size << index;
+  }
+
+  // The index of the pool serving the request, or `pool_count()` if the
+  // request is oversized.
+  std::size_t pool_index(std::size_t bytes,
+                         std::size_t alignment) const noexcept {
+    std::size_t const size = bytes > alignment ? bytes : alignment;
+    if (size > options_.largest_required_pool_block) {
+      return npools_;
+    }
+    return size <= min_block_size
+               ? 0
+               : static_cast<std::size_t>(slb::bit_width(size - 1) -
+                                          slb::bit_width(min_block_size - 1));
+  }
+
+  void* allocate_block(std::size_t index) {
+    pool& p = pools_[index];
+    if (p.free != nullptr) {
+      free_block* const block = p.free;
+      p.free = block->next;
+      return block;
+    }
+    if (p.next == p.end) {
+      allocate_chunk(index);
+    }
+    void* const block = p.next;
+    p.next += block_size(index);
+    return block;
+  }
+
+  void deallocate_block(std::size_t index, void* block) noexcept {
+    pool& p = pools_[index];
+    p.free = ::new (block) free_block{p.free};
+  }
+
+  void* allocate_oversized(std::size_t bytes, std::size_t alignment) {
+    std::size_t const align = oversized_alignment(alignment);
+    std::size_t const offset = oversized_offset(align);
+    if (bytes > std::numeric_limits<std::size_t>::max() - offset) {
+      throw std::bad_alloc();
+    }
+    char* const base =
+        static_cast<char*>(upstream_->allocate(bytes + offset, align));
+    oversized_block* const header =
+        ::new (base + offset - sizeof(oversized_block))
+            oversized_block{nullptr, oversized_, bytes, align};
+    if (oversized_ != nullptr) {
+      oversized_->prev = header;
+    }
+    oversized_ = header;
+    return base + offset;
+  }
+
+  void deallocate_oversized(void* p) noexcept {
+    oversized_block* const header = static_cast<oversized_block*>(p) - 1;
+    (header->prev != nullptr ? header->prev->next : oversized_) = header->next;
+    if (header->next != nullptr) {
+      header->next->prev = header->prev;
+    }
+    deallocate_oversized(header);
+  }
+
+  void release() noexcept {
+    for (std::size_t i = 0; i < npools_; ++i) {
+      std::size_t const size = block_size(i);
+      for (pool_chunk* chunk = pools_[i].chunks; chunk != nullptr;) {
+        pool_chunk* const next = chunk->next;
+        std::size_t const bytes = chunk->blocks * size;
+        upstream_->deallocate(reinterpret_cast<char*>(chunk) - bytes,
+                              bytes + sizeof(pool_chunk),
+                              size);
+        chunk = next;
+      }
+      pools_[i] = pool();
+    }
+    while (oversized_ != nullptr) {
+      oversized_block* const next = oversized_->next;
+      deallocate_oversized(oversized_);
+      oversized_ = next;
+    }
+  }
+
+private:
+  struct pool {
+    free_block* free = nullptr;
+    char* next = nullptr;
+    char* end = nullptr;
+    pool_chunk* chunks = nullptr;
+    std::size_t next_blocks = 0;
+  };
+
+  static pmr::pool_options normalize(pmr::pool_options options) noexcept {
+    std::size_t& largest = options.largest_required_pool_block;
+    largest = largest == 0 ? 4096
+                           : largest < min_block_size
+                                 ? min_block_size
+                                 : largest > max_block_size ? max_block_size
+                                                            : largest;
+    largest = std::size_t(1) << slb::bit_width(largest - 1);
+    std::size_t& blocks = options.max_blocks_per_chunk;
+    blocks = blocks == 0 || blocks > max_chunk_size ? max_chunk_size : blocks;
+    return options;
+  }
+
+  static std::size_t oversized_alignment(std::size_t alignment) noexcept {
+    return alignment > alignof(oversized_block) ? alignment
+                                                : alignof(oversized_block);
+  }
+
+  static std::size_t oversized_offset(std::size_t alignment) noexcept {
+    return (sizeof(oversized_block) + alignment - 1) & ~(alignment - 1);
+  }
+
+  void deallocate_oversized(oversized_block* header) noexcept {
+    std::size_t const offset = oversized_offset(header->alignment);
+    upstream_->deallocate(reinterpret_cast<char*>(header + 1) - offset,
+                          header->bytes + offset,
+                          header->alignment);
+  }
+
+  void allocate_chunk(std::size_t index) {
+    pool& p = pools_[index];
+    std::size_t const size = block_size(index);
+    std::size_t const limit =
+        max_chunk_size / size < options_.max_blocks_per_chunk
+            ? max_chunk_size / size
+            : options_.max_blocks_per_chunk;
+    std::size_t blocks = p.next_blocks != 0 ? p.next_blocks : 4096 / size;
+    if (blocks > limit) {
+      blocks = limit;
+    }
+    if (blocks == 0) {
+      blocks = 1;
+    }
+
+    // The chunk is aligned to the block size, and so is every block in it.
+    char* const base = static_cast<char*>(
+        upstream_->allocate(blocks * size + sizeof(pool_chunk), size));
+    p.chunks = ::new (base + blocks * size) pool_chunk{p.chunks, blocks};
+    p.next = base;
+    p.end = base + blocks * size;
+    p.next_blocks = blocks * 2;
+  }
+
+  pmr::pool_options options_;
+  pmr::memory_resource* upstream_;
+  std::size_t npools_;
+  pool pools_[max_pools];
+  oversized_block* oversized_;
+};
+
+} // namespace detail
+
+namespace pmr {
+
+// [mem.res.pool], pool resource classes
+
+class unsynchronized_pool_resource : public memory_resource {
+public:
+  unsynchronized_pool_resource(pool_options const& opts,
+                               memory_resource* upstream)
+      : pools_(opts, upstream) {}
+  unsynchronized_pool_resource()
+      : unsynchronized_pool_resource(pool_options(),
+                                     pmr::get_default_resource()) {}
+  explicit unsynchronized_pool_resource(memory_resource* upstream)
+      : unsynchronized_pool_resource(pool_options(), upstream) {}
+  explicit unsynchronized_pool_resource(pool_options const& opts)
+      : unsynchronized_pool_resource(opts, pmr::get_default_resource()) {}
+
+  unsynchronized_pool_resource(unsynchronized_pool_resource const&) = delete;
+  unsynchronized_pool_resource& operator=(
+      unsynchronized_pool_resource const&) = delete;
+
+  ~unsynchronized_pool_resource() override = default;
+
+  void release() { pools_.release(); }
+
+  memory_resource* upstream_resource() const { return pools_.upstream(); }
+
+  pool_options options() const { return pools_.options(); }
+
+protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    std::size_t const index = pools_.pool_index(bytes, alignment);
+    return index < pools_.pool_count()
+               ? pools_.allocate_block(index)
+               : pools_.allocate_oversized(bytes, alignment);
+  }
+
+  void do_deallocate(void* p,
+                     std::size_t bytes,
+                     std::size_t alignment) override {
+    std::size_t const index = pools_.pool_index(bytes, alignment);
+    if (index < pools_.pool_count()) {
+      pools_.deallocate_block(index, p);
+    } else {
+      pools_.deallocate_oversized(p);
+    }
+  }
+
+  bool do_is_equal(memory_resource const& other) const noexcept override {
+    return this == &other;
+  }
+
+private:
+  detail::pool_set pools_;
+};
+
+} // namespace pmr
+
+namespace detail {
+
+class synchronized_pools;
+
+// A thread's cache of free blocks for one `synchronized_pool_resource`.
+// Its mutex is only contended by `release` and by the owning thread's exit,
+// so the common path does not touch shared state. The blocks in the cache
+// belong to the resource's pools as of `generation`; a `release` clears the
+// cache and bumps the generation, after which stale blocks are dropped.
+struct pool_cache {
+  struct list {
+    free_block* head = nullptr;
+    std::size_t count = 0;
+  };
+
+  explicit pool_cache(std::uint64_t id) noexcept : id(id) {}
+
+  void push(std::size_t index, void* block) noexcept {
+    list& l = lists[index];
+    l.head = ::new (block) free_block{l.head};
+    ++l.count;
+  }
+
+  void* pop(std::size_t index) noexcept {
+    list& l = lists[index];
+    free_block* const block = l.head;
+    if (block != nullptr) {
+      l.head = block->next;
+      --l.count;
+    }
+    return block;
+  }
+
+  // Detaches the first `count` blocks of a list.
+  free_block* take(std::size_t index, std::size_t count) noexcept {
+    list& l = lists[index];
+    free_block* const head = l.head;
+    free_block* last = head;
+    for (std::size_t i = 1; i < count && last->next != nullptr; ++i) {
+      last = last->next;
+    }
+    l.head = last->next;
+    last->next = nullptr;
+    l.count = count < l.count ? l.count - count : 0;
+    return head;
+  }
+
+  void clear(std::uint64_t new_generation) noexcept {
+    for (list& l : lists) {
+      l = list();
+    }
+    generation = new_generation;
+  }
+
+  std::uint64_t const id;
+  synchronized_pools* owner = nullptr; // guarded by the registry mutex
+  std::mutex mutex;
+  std::uint64_t generation = 0; // guarded by `mutex`
+  list lists[pool_set::max_pools];
+  pool_cache* next_in_thread = nullptr;
+  pool_cache* prev_in_owner = nullptr; // guarded by the registry mutex
+  pool_cache* next_in_owner = nullptr; // guarded by the registry mutex
+};
+
+// Guards the association between caches and resources, which only changes
+// when a thread first uses a resource, a thread exits, or a resource is
+// released or destroyed. It is always acquired first.
+inline std::mutex& pool_cache_registry() noexcept {
+  static std::mutex mutex;
+  return mutex;
+}
+
+class thread_pool_caches {
+public:
+  thread_pool_caches() noexcept : head_(nullptr) {}
+  thread_pool_caches(thread_pool_caches const&) = delete;
+  thread_pool_caches& operator=(thread_pool_caches const&) = delete;
+  inline ~thread_pool_caches();
+
+  // Most threads use few resources; the most recently found is moved first.
+  pool_cache* find(std::uint64_t id) noexcept {
+    for (pool_cache *cache = head_, *prev = nullptr; cache != nullptr;
+         prev = cache, cache = cache->next_in_thread) {
+      if (cache->id == id) {
+        if (prev != nullptr) {
+          prev->next_in_thread = cache->next_in_thread;
+          cache->next_in_thread = head_;
+          head_ = cache;
+        }
+        return cache;
+      }
+    }
+    return nullptr;
+  }
+
+  // Requires the registry mutex. Caches of destroyed resources are pruned.
+  void insert(pool_cache* cache) noexcept {
+    for (pool_cache** it = &head_; *it != nullptr;) {
+      pool_cache* const dead = *it;
+      if (dead->owner == nullptr) {
+        *it = dead->next_in_thread;
+        delete dead;
+      } else {
+        it = &dead->next_in_thread;
+      }
+    }
+    cache->next_in_thread = head_;
+    head_ = cache;
+  }
+
+private:
+  pool_cache* head_;
+};
+
+inline thread_pool_caches& this_thread_pool_caches() noexcept {
+  static thread_local thread_pool_caches caches;
+  return caches;
+}
+
+// The state of a `synchronized_pool_resource`. The pools are shared and
+// guarded by `mutex_`; each thread allocates from and deallocates to its own
+// cache, and moves blocks between its cache and the pools in batches.
+class synchronized_pools {
+public:
+  synchronized_pools(pmr::pool_options const& options,
+                     pmr::memory_resource* upstream) noexcept
+      : id_(next_id()),
+        pools_(options, upstream),
+        generation_(0),
+        caches_(nullptr) {}
+
+  synchronized_pools(synchronized_pools const&) = delete;
+  synchronized_pools& operator=(synchronized_pools const&) = delete;
+
+  ~synchronized_pools() {
+    std::lock_guard<std::mutex> registry(pool_cache_registry());
+    for (pool_cache* cache = caches_; cache != nullptr;
+         cache = cache->next_in_owner) {
+      cache->owner = nullptr;
+    }
+  }
+
+  pmr::pool_options options() const noexcept { return pools_.options(); }
+  pmr::memory_resource* upstream() const noexcept { return pools_.upstream(); }
+
+  void* allocate(std::size_t bytes, std::size_t alignment) {
+    std::size_t const index = pools_.pool_index(bytes, alignment);
+    if (index == pools_.pool_count()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return pools_.allocate_oversized(bytes, alignment);
+    }
+
+    pool_cache* const cache = this_thread_cache();
+    if (cache == nullptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return pools_.allocate_block(index);
+    }
+    {
+      std::lock_guard<std::mutex> lock(cache->mutex);
+      if (void* const block = cache->pop(index)) {
+        return block;
+      }
+    }
+
+    // Refill the cache with a batch from the pools, keeping one block.
+    void* block;
+    free_block* batch = nullptr;
+    std::uint64_t generation;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      block = pools_.allocate_block(index);
+      generation = generation_;
+      try {
+        for (std::size_t i = 1; i < batch_size(index); ++i) {
+          batch = ::new (pools_.allocate_block(index)) free_block{batch};
+        }
+      } catch (...) {
+      }
+    }
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    if (cache->generation == generation) {
+      while (batch != nullptr) {
+        free_block* const next = batch->next;
+        cache->push(index, batch);
+        batch = next;
+      }
+    }
+    return block;
+  }
+
+  void deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    std::size_t const index = pools_.pool_index(bytes, alignment);
+    if (index == pools_.pool_count()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pools_.deallocate_oversized(p);
+      return;
+    }
+
+    pool_cache* const cache = this_thread_cache();
+    if (cache == nullptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pools_.deallocate_block(index, p);
+      return;
+    }
+
+    // Return half of the cache to the pools once it is full.
+    free_block* batch = nullptr;
+    std::uint64_t generation;
+    {
+      std::lock_guard<std::mutex> lock(cache->mutex);
+      cache->push(index, p);
+      if (cache->lists[index].count <= 2 * batch_size(index)) {
+        return;
+      }
+      batch = cache->take(index, batch_size(index));
+      generation = cache->generation;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation_ == generation) {
+      give_back(index, batch);
+    }
+  }
+
+  void release() {
+    std::lock_guard<std::mutex> registry(pool_cache_registry());
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    for (pool_cache* cache = caches_; cache != nullptr;
+         cache = cache->next_in_owner) {
+      std::lock_guard<std::mutex> cache_lock(cache->mutex);
+      cache->clear(generation_);
+    }
+    pools_.release();
+  }
+
+  // Requires the registry mutex; called when the cache's thread exits.
+  void detach(pool_cache* cache) noexcept {
+    std::uint64_t generation;
+    pool_cache::list lists[pool_set::max_pools];
+    {
+      std::lock_guard<std::mutex> cache_lock(cache->mutex);
+      generation = cache->generation;
+      for (std::size_t i = 0; i < pools_.pool_count(); ++i) {
+        lists[i] = cache->lists[i];
+      }
+      cache->clear(generation);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (generation_ == generation) {
+        for (std::size_t i = 0; i < pools_.pool_count(); ++i) {
+          give_back(i, lists[i].head);
+        }
+      }
+    }
+    (cache->prev_in_owner != nullptr ? cache->prev_in_owner->next_in_owner
+                                     : caches_) = cache->next_in_owner;
+    if (cache->next_in_owner != nullptr) {
+      cache->next_in_owner->prev_in_owner = cache->prev_in_owner;
+    }
+    cache->owner = nullptr;
+  }
+
+private:
+  static std::uint64_t next_id() noexcept {
+    static std::atomic<std::uint64_t> id(0);
+    return ++id;
+  }
+
+  // About 16KiB worth of blocks, between 2 and 32 of them.
+  std::size_t batch_size(std::size_t index) const noexcept {
+    std::size_t const blocks =
+        (std::size_t(16) << 10) / pools_.block_size(index);
+    return blocks < 2 ? 2 : blocks > 32 ? 32 : blocks;
+  }
+
+  // Requires `mutex_`.
+  void give_back(std::size_t index, free_block* blocks) noexcept {
+    while (blocks != nullptr) {
+      free_block* const next = blocks->next;
+      pools_.deallocate_block(index, blocks);
+      blocks = next;
+    }
+  }
+
+  // Returns null if the cache could not be allocated, in which case the pools
+  // are used directly.
+  pool_cache* this_thread_cache() noexcept {
+    thread_pool_caches& caches = this_thread_pool_caches();
+    if (pool_cache* const cache = caches.find(id_)) {
+      return cache;
+    }
+    pool_cache* const cache = new (std::nothrow) pool_cache(id_);
+    if (cache == nullptr) {
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> registry(pool_cache_registry());
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cache->generation = generation_;
+    }
+    cache->owner = this;
+    cache->next_in_owner = caches_;
+    if (caches_ != nullptr) {
+      caches_->prev_in_owner = cache;
+    }
+    caches_ = cache;
+    caches.insert(cache);
+    return cache;
+  }
+
+  std::uint64_t const id_;
+  std::mutex mutex_;
+  pool_set pools_;           // guarded by `mutex_`
+  std::uint64_t generation_; // guarded by `mutex_`
+  pool_cache* caches_;       // guarded by the registry mutex
+};
+
+inline thread_pool_caches::~thread_pool_caches() {
+  while (head_ != nullptr) {
+    pool_cache* const cache = head_;
+    head_ = cache->next_in_thread;
+    {
+      std::lock_guard<std::mutex> registry(pool_cache_registry());
+      if (cache->owner != nullptr) {
+        cache->owner->detach(cache);
+      }
+    }
+    delete cache;
+  }
+}
+
+} // namespace detail
+
+namespace pmr {
+
+class synchronized_pool_resource : public memory_resource {
+public:
+  synchronized_pool_resource(pool_options const& opts,
+                             memory_resource* upstream)
+      : pools_(opts, upstream) {}
+  synchronized_pool_resource()
+      : synchronized_pool_resource(pool_options(),
+                                   pmr::get_default_resource()) {}
+  explicit synchronized_pool_resource(memory_resource* upstream)
+      : synchronized_pool_resource(pool_options(), upstream) {}
+  explicit synchronized_pool_resource(pool_options const& opts)
+      : synchronized_pool_resource(opts, pmr::get_default_resource()) {}
+
+  synchronized_pool_resource(synchronized_pool_resource const&) = delete;
+  synchronized_pool_resource& operator=(synchronized_pool_resource const&) =
+      delete;
+
+  ~synchronized_pool_resource() override = default;
+
+  void release() { pools_.release(); }
+
+  memory_resource* upstream_resource() const { return pools_.upstream(); }
+
+  pool_options options() const { return pools_.options(); }
+
+protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    return pools_.allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p,
+                     std::size_t bytes,
+                     std::size_t alignment) override {
+    pools_.deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(memory_resource const& other) const noexcept override {
+    return this == &other;
+  }
+
+private:
+  detail::synchronized_pools pools_;
+};
+
+// [mem.res.monotonic.buffer], class monotonic_buffer_resource
+
+class monotonic_buffer_resource : public memory_resource {
+  struct chunk {
+    chunk* next;
+    std::size_t size;
+  };
+
+public:
+  explicit monotonic_buffer_resource(memory_resource* upstream)
+      : monotonic_buffer_resource(nullptr, 0, upstream) {}
+  monotonic_buffer_resource(std::size_t initial_size,
+                            memory_resource* upstream)
+      : upstream_(upstream),
+        buffer_(nullptr),
+        buffer_size_(0),
+        initial_next_size_(initial_size),
+        current_(nullptr),
+        space_(0),
+        next_size_(initial_size),
+        chunks_(nullptr) {}
+  monotonic_buffer_resource(void* buffer,
+                            std::size_t buffer_size,
+                            memory_resource* upstream)
+      : upstream_(upstream),
+        buffer_(buffer),
+        buffer_size_(buffer_size),
+        initial_next_size_(buffer_size > 512 ? buffer_size * 2 : 1024),
+        current_(buffer),
+        space_(buffer_size),
+        next_size_(initial_next_size_),
+        chunks_(nullptr) {}
+
+  monotonic_buffer_resource()
+      : monotonic_buffer_resource(pmr::get_default_resource()) {}
+  explicit monotonic_buffer_resource(std::size_t initial_size)
+      : monotonic_buffer_resource(initial_size, pmr::get_default_resource()) {}
+  monotonic_buffer_resource(void* buffer, std::size_t buffer_size)
+      : monotonic_buffer_resource(
+            buffer, buffer_size, pmr::get_default_resource()) {}
+
+  monotonic_buffer_resource(monotonic_buffer_resource const&) = delete;
+  monotonic_buffer_resource& operator=(monotonic_buffer_resource const&) =
+      delete;
+
+  ~monotonic_buffer_resource() override { release(); }
+
+  void release() {
+    while (chunks_ != nullptr) {
+      chunk* const next = chunks_->next;
+      upstream_->deallocate(
+          chunks_, sizeof(chunk) + chunks_->size, alignof(std::max_align_t));
+      chunks_ = next;
+    }
+    current_ = buffer_;
+    space_ = buffer_size_;
+    next_size_ = initial_next_size_;
+  }
+
+  memory_resource* upstream_resource() const { return upstream_; }
+
+protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void* p = current_;
+    if (p == nullptr || std::align(alignment, bytes, p, space_) == nullptr) {
+      allocate_chunk(bytes, alignment);
+      p = current_;
+      std::align(alignment, bytes, p, space_);
+    }
+    current_ = static_cast<char*>(p) + bytes;
+    space_ -= bytes;
+    return p;
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(memory_resource const& other) const noexcept override {
+    return this == &other;
+  }
+
+private:
+  // Buffers grow geometrically, and are large enough for the request at
+  // any alignment.
+  void allocate_chunk(std::size_t bytes, std::size_t alignment) {
+    std::size_t const max_size =
+        std::numeric_limits<std::size_t>::max() / 2 - sizeof(chunk);
+    if (bytes > max_size - alignment) {
+      throw std::bad_alloc();
+    }
+    std::size_t size = next_size_ != 0 ? next_size_ : 1024;
+    while (size < bytes + alignment) {
+      size *= 2;
+    }
+    void* const p =
+        upstream_->allocate(sizeof(chunk) + size, alignof(std::max_align_t));
+    chunks_ = ::new (p) chunk{chunks_, size};
+    current_ = chunks_ + 1;
+    space_ = size;
+    next_size_ = size < max_size / 2 ? size * 2 : max_size;
+  }
+
+  memory_resource* upstream_;
+  void* buffer_;
+  std::size_t buffer_size_;
+  std::size_t initial_next_size_;
+  void* current_;
+  std::size_t space_;
+  std::size_t next_size_;
+  chunk* chunks_;
+};
+#endif
+
+} // namespace pmr
+} // namespace slb
+
+#endif // SLB_MEMORY_RESOURCE_HPP
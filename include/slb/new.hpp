@@ -0,0 +1,58 @@
+/*
+  SLB.New
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_NEW_HPP
+#define SLB_NEW_HPP
+
+/*
+
+Header <new> synopsis
+
+namespace std {
+  // [hardware.interference], hardware interference size
+  inline constexpr size_t hardware_destructive_interference_size =
+    implementation-defined;
+  inline constexpr size_t hardware_constructive_interference_size =
+    implementation-defined;
+}
+
+*/
+
+#include <cstddef>
+#include <new>
+
+#include "detail/config.hpp"
+
+namespace slb {
+
+// [hardware.interference], hardware interference size
+
+#if __cpp_lib_hardware_interference_size // C++17
+using std::hardware_destructive_interference_size;
+using std::hardware_constructive_interference_size;
+#else
+// GCC describes the target it tunes for; otherwise, a cache line of 64 bytes
+// is by far the most common.
+#if defined(__GCC_DESTRUCTIVE_SIZE) && defined(__GCC_CONSTRUCTIVE_SIZE)
+SLB_CXX17_INLINE_VARIABLE constexpr std::size_t
+    hardware_destructive_interference_size = __GCC_DESTRUCTIVE_SIZE;
+SLB_CXX17_INLINE_VARIABLE constexpr std::size_t
+    hardware_constructive_interference_size = __GCC_CONSTRUCTIVE_SIZE;
+#else
+SLB_CXX17_INLINE_VARIABLE constexpr std::size_t
+    hardware_destructive_interference_size = 64;
+SLB_CXX17_INLINE_VARIABLE constexpr std::size_t
+    hardware_constructive_interference_size = 64;
+#endif
+#endif
+
+} // namespace slb
+
+#endif // SLB_NEW_HPP
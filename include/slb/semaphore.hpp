@@ -0,0 +1,172 @@
+/*
+  SLB.Semaphore
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_SEMAPHORE_HPP
+#define SLB_SEMAPHORE_HPP
+
+/*
+
+Header <semaphore> synopsis
+
+namespace std {
+  // [thread.sema.cnt], class template counting_semaphore
+  template<ptrdiff_t LeastMaxValue = implementation-defined>
+    class counting_semaphore {
+    public:
+      static constexpr ptrdiff_t max() noexcept;
+
+      constexpr explicit counting_semaphore(ptrdiff_t desired);
+      ~counting_semaphore();
+
+      counting_semaphore(const counting_semaphore&) = delete;
+      counting_semaphore& operator=(const counting_semaphore&) = delete;
+
+      void release(ptrdiff_t update = 1);
+      void acquire();
+      bool try_acquire() noexcept;
+      template<class Rep, class Period>
+        bool try_acquire_for(const chrono::duration<Rep, Period>& rel_time);
+      template<class Clock, class Duration>
+        bool try_acquire_until(
+          const chrono::time_point<Clock, Duration>& abs_time);
+    };
+
+  using binary_semaphore = counting_semaphore<1>;
+}
+
+*/
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+
+#include "detail/atomic_wait.hpp"
+#include "detail/config.hpp"
+
+#if __has_include(<semaphore>)
+#include <semaphore>
+#endif
+
+namespace slb {
+
+// [thread.sema.cnt], class template counting_semaphore
+
+#if __cpp_lib_semaphore // C++20
+using std::counting_semaphore;
+using std::binary_semaphore;
+#else
+// The counter is a 32-bit word that waiters block on directly. Acquiring
+// spins briefly before blocking, and releasing only makes a system call when
+// some thread is blocked.
+template <std::ptrdiff_t LeastMaxValue = INT_MAX>
+class counting_semaphore {
+  static_assert(LeastMaxValue >= 0 && LeastMaxValue <= INT_MAX,
+                "the counter is an int");
+
+public:
+  static constexpr std::ptrdiff_t max() noexcept { return LeastMaxValue; }
+
+  constexpr explicit counting_semaphore(std::ptrdiff_t desired)
+      : counter_(static_cast<int>(desired)), waiters_(0) {}
+
+  counting_semaphore(counting_semaphore const&) = delete;
+  counting_semaphore& operator=(counting_semaphore const&) = delete;
+
+  void release(std::ptrdiff_t update = 1) {
+    // Together with the increment of `waiters_` in `acquire_slow`, at least
+    // one side sees the other's write.
+    counter_.fetch_add(static_cast<int>(update), std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) != 0) {
+      detail::platform_notify(counter_, static_cast<int>(update));
+    }
+  }
+
+  void acquire() {
+    if (!detail::atomic_spin([this] { return try_acquire(); })) {
+      acquire_slow([this] {
+        detail::platform_wait(counter_, 0);
+        return true;
+      });
+    }
+  }
+
+  bool try_acquire() noexcept {
+    int old = counter_.load(std::memory_order_relaxed);
+    while (old > 0) {
+      if (counter_.compare_exchange_weak(old,
+                                         old - 1,
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename Rep, typename Period>
+  bool try_acquire_for(std::chrono::duration<Rep, Period> const& rel_time) {
+    return try_acquire_until(std::chrono::steady_clock::now() + rel_time);
+  }
+
+  template <typename Clock, typename Duration>
+  bool try_acquire_until(
+      std::chrono::time_point<Clock, Duration> const& abs_time) {
+    if (detail::atomic_spin([this] { return try_acquire(); })) {
+      return true;
+    }
+    return acquire_slow([this, &abs_time] {
+      auto const now = Clock::now();
+      if (now >= abs_time) {
+        return false;
+      }
+      detail::platform_wait_for(
+          counter_,
+          0,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(abs_time -
+                                                               now));
+      return true;
+    });
+  }
+
+private:
+  // Blocks with `wait` until the counter can be decremented, or until `wait`
+  // returns `false`.
+  template <typename Wait>
+  bool acquire_slow(Wait wait) {
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    bool acquired = false;
+    while (!acquired) {
+      int old = counter_.load(std::memory_order_seq_cst);
+      if (old == 0) {
+        if (!wait()) {
+          break;
+        }
+      } else {
+        acquired = counter_.compare_exchange_weak(old,
+                                                  old - 1,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed);
+      }
+    }
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+    return acquired;
+  }
+
+  std::atomic<int> counter_;
+  std::atomic<int> waiters_;
+};
+
+using binary_semaphore = counting_semaphore<1>;
+#endif
+
+} // namespace slb
+
+#endif // SLB_SEMAPHORE_HPP
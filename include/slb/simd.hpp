@@ -0,0 +1,1427 @@
+/*
+  SLB.Simd
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_SIMD_HPP
+#define SLB_SIMD_HPP
+
+/*
+
+Header <slb/simd.hpp> synopsis
+
+namespace slb {
+  namespace simd_abi {
+    struct scalar {};
+    template<int N> struct fixed_size {};
+    inline constexpr int max_fixed_size = 64;
+    template<class T> using compatible = fixed_size<16 / sizeof(T)>;
+    template<class T> using native = see below;
+  }
+
+  struct element_aligned_tag {};
+  struct vector_aligned_tag {};
+  template<size_t> struct overaligned_tag {};
+  inline constexpr element_aligned_tag element_aligned{};
+  inline constexpr vector_aligned_tag vector_aligned{};
+  template<size_t N> inline constexpr overaligned_tag<N> overaligned{};
+
+  // traits
+  template<class T> struct is_abi_tag;
+  template<class T> struct is_simd;
+  template<class T> struct is_simd_mask;
+  template<class T> struct is_simd_flag_type;
+  template<class T, class Abi = simd_abi::compatible<T>> struct simd_size;
+  template<class T, class U = typename T::value_type> struct memory_alignment;
+
+  // class template simd
+  template<class T, class Abi = simd_abi::compatible<T>> class simd;
+  template<class T> using native_simd = simd<T, simd_abi::native<T>>;
+  template<class T, int N>
+    using fixed_size_simd = simd<T, simd_abi::fixed_size<N>>;
+
+  // class template simd_mask
+  template<class T, class Abi = simd_abi::compatible<T>> class simd_mask;
+  template<class T> using native_simd_mask = simd_mask<T, simd_abi::native<T>>;
+  template<class T, int N>
+    using fixed_size_simd_mask = simd_mask<T, simd_abi::fixed_size<N>>;
+
+  // where expressions
+  template<class M, class T> class const_where_expression;
+  template<class M, class T> class where_expression;
+
+  template<class T, class Abi>
+    where_expression<simd_mask<T, Abi>, simd<T, Abi>>
+      where(const typename simd<T, Abi>::mask_type&, simd<T, Abi>&) noexcept;
+  template<class T, class Abi>
+    const_where_expression<simd_mask<T, Abi>, simd<T, Abi>>
+      where(const typename simd<T, Abi>::mask_type&,
+            const simd<T, Abi>&) noexcept;
+
+  // reductions
+  template<class T, class Abi, class BinaryOperation = plus<>>
+    T reduce(const simd<T, Abi>&, BinaryOperation = {});
+  template<class M, class V, class BinaryOperation>
+    typename V::value_type reduce(const const_where_expression<M, V>& x,
+                                  typename V::value_type identity_element,
+                                  BinaryOperation binary_op);
+  template<class T, class Abi> T hmin(const simd<T, Abi>&);
+  template<class T, class Abi> T hmax(const simd<T, Abi>&);
+
+  // algorithms
+  template<class T, class Abi>
+    simd<T, Abi> min(const simd<T, Abi>&, const simd<T, Abi>&) noexcept;
+  template<class T, class Abi>
+    simd<T, Abi> max(const simd<T, Abi>&, const simd<T, Abi>&) noexcept;
+  template<class T, class Abi>
+    pair<simd<T, Abi>, simd<T, Abi>>
+      minmax(const simd<T, Abi>&, const simd<T, Abi>&) noexcept;
+  template<class T, class Abi>
+    simd<T, Abi> clamp(const simd<T, Abi>& v, const simd<T, Abi>& lo,
+                       const simd<T, Abi>& hi);
+
+  // mask reductions
+  template<class T, class Abi> bool all_of(const simd_mask<T, Abi>&) noexcept;
+  template<class T, class Abi> bool any_of(const simd_mask<T, Abi>&) noexcept;
+  template<class T, class Abi> bool none_of(const simd_mask<T, Abi>&) noexcept;
+  template<class T, class Abi> bool some_of(const simd_mask<T, Abi>&) noexcept;
+  template<class T, class Abi> int popcount(const simd_mask<T, Abi>&) noexcept;
+  template<class T, class Abi> int find_first_set(const simd_mask<T, Abi>&);
+  template<class T, class Abi> int find_last_set(const simd_mask<T, Abi>&);
+}
+
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "bit.hpp"
+#include "detail/config.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+#if SLB_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace slb {
+
+namespace detail {
+
+// The vectorizable types are the arithmetic types other than `bool`.
+template <typename T>
+struct is_simd_vectorizable
+    : bool_constant<std::is_arithmetic<T>::value &&
+                    !std::is_const<T>::value && !std::is_volatile<T>::value &&
+                    !std::is_same<T, bool>::value> {};
+
+// The width, in bytes, of the widest vector registers the target enables.
+enum : std::size_t {
+#if defined(__AVX512F__)
+  simd_native_bytes = 64
+#elif defined(__AVX__)
+  simd_native_bytes = 32
+#else
+  simd_native_bytes = 16
+#endif
+};
+
+template <typename T, std::size_t Bytes>
+struct simd_size_for
+    : std::integral_constant<int,
+                             (sizeof(T) < Bytes ? Bytes / sizeof(T) : 1)> {};
+
+// The ABI tag of `simd_abi::native`, which names the register width so that
+// the layout of each type is the same in every translation unit, whatever
+// instruction sets it enables.
+template <std::size_t Bytes>
+struct simd_native_abi {};
+
+} // namespace detail
+
+// [simd.abi], ABI tags
+
+namespace simd_abi {
+
+struct scalar {};
+
+template <int N>
+struct fixed_size {};
+
+SLB_CXX17_INLINE_VARIABLE constexpr int max_fixed_size = 64;
+
+template <typename T>
+using compatible = fixed_size<detail::simd_size_for<T, 16>::value>;
+
+template <typename T>
+using native = detail::simd_native_abi<detail::simd_native_bytes>;
+
+} // namespace simd_abi
+
+// [simd.flags], load/store flags
+
+struct element_aligned_tag {};
+
+struct vector_aligned_tag {};
+
+template <std::size_t N>
+struct overaligned_tag {};
+
+SLB_CXX17_INLINE_VARIABLE constexpr element_aligned_tag element_aligned{};
+
+SLB_CXX17_INLINE_VARIABLE constexpr vector_aligned_tag vector_aligned{};
+
+#if SLB_HAS_CXX14_VARIABLE_TEMPLATES // C++14
+template <std::size_t N>
+SLB_CXX17_INLINE_VARIABLE constexpr overaligned_tag<N> overaligned{};
+#endif
+
+template <typename T, typename Abi = simd_abi::compatible<T>>
+class simd;
+
+template <typename T, typename Abi = simd_abi::compatible<T>>
+class simd_mask;
+
+// [simd.traits], traits
+
+template <typename T>
+struct is_abi_tag : std::false_type {};
+
+template <>
+struct is_abi_tag<simd_abi::scalar> : std::true_type {};
+
+template <int N>
+struct is_abi_tag<simd_abi::fixed_size<N>> : std::true_type {};
+
+template <std::size_t Bytes>
+struct is_abi_tag<detail::simd_native_abi<Bytes>> : std::true_type {};
+
+template <typename T>
+struct is_simd : std::false_type {};
+
+template <typename T, typename Abi>
+struct is_simd<simd<T, Abi>> : std::true_type {};
+
+template <typename T>
+struct is_simd_mask : std::false_type {};
+
+template <typename T, typename Abi>
+struct is_simd_mask<simd_mask<T, Abi>> : std::true_type {};
+
+template <typename T>
+struct is_simd_flag_type : std::false_type {};
+
+template <>
+struct is_simd_flag_type<element_aligned_tag> : std::true_type {};
+
+template <>
+struct is_simd_flag_type<vector_aligned_tag> : std::true_type {};
+
+template <std::size_t N>
+struct is_simd_flag_type<overaligned_tag<N>> : std::true_type {};
+
+template <typename T, typename Abi = simd_abi::compatible<T>>
+struct simd_size {};
+
+template <typename T>
+struct simd_size<T, simd_abi::scalar> : std::integral_constant<std::size_t, 1> {
+};
+
+template <typename T, int N>
+struct simd_size<T, simd_abi::fixed_size<N>>
+    : std::integral_constant<std::size_t, N> {};
+
+template <typename T, std::size_t Bytes>
+struct simd_size<T, detail::simd_native_abi<Bytes>>
+    : std::integral_constant<std::size_t,
+                             detail::simd_size_for<T, Bytes>::value> {};
+
+template <typename T, typename U = typename T::value_type>
+struct memory_alignment {};
+
+template <typename T, typename Abi, typename U>
+struct memory_alignment<simd<T, Abi>, U>
+    : std::integral_constant<std::size_t,
+                             std::is_same<T, U>::value ? alignof(simd<T, Abi>)
+                                                       : alignof(U)> {};
+
+template <typename T, typename Abi>
+struct memory_alignment<simd_mask<T, Abi>, bool>
+    : std::integral_constant<std::size_t, alignof(bool)> {};
+
+#if SLB_HAS_CXX14_VARIABLE_TEMPLATES // C++14
+template <typename T>
+SLB_CXX17_INLINE_VARIABLE constexpr bool is_abi_tag_v = is_abi_tag<T>::value;
+
+template <typename T>
+SLB_CXX17_INLINE_VARIABLE constexpr bool is_simd_v = is_simd<T>::value;
+
+template <typename T>
+SLB_CXX17_INLINE_VARIABLE constexpr bool is_simd_mask_v =
+    is_simd_mask<T>::value;
+
+template <typename T>
+SLB_CXX17_INLINE_VARIABLE constexpr bool is_simd_flag_type_v =
+    is_simd_flag_type<T>::value;
+
+template <typename T, typename Abi = simd_abi::compatible<T>>
+SLB_CXX17_INLINE_VARIABLE constexpr std::size_t simd_size_v =
+    simd_size<T, Abi>::value;
+
+template <typename T, typename U = typename T::value_type>
+SLB_CXX17_INLINE_VARIABLE constexpr std::size_t memory_alignment_v =
+    memory_alignment<T, U>::value;
+#endif
+
+namespace detail {
+
+// A conversion from `From` to `To` is value-preserving if every value of
+// `From` can be represented in `To`.
+template <typename From, typename To>
+struct is_simd_value_preserving
+    : bool_constant<(std::numeric_limits<From>::digits <=
+                     std::numeric_limits<To>::digits) &&
+                    (std::numeric_limits<From>::max_exponent <=
+                     std::numeric_limits<To>::max_exponent) &&
+                    (std::is_floating_point<To>::value ||
+                     !std::is_floating_point<From>::value) &&
+                    (std::is_signed<To>::value ||
+                     !std::is_signed<From>::value)> {};
+
+// A value is broadcast implicitly only if the conversion is value-preserving,
+// except that `int` and (for unsigned elements) `unsigned int` are always
+// accepted so that literals can be mixed with `simd` operands.
+template <typename U, typename T>
+struct is_simd_broadcastable
+    : bool_constant<is_simd_vectorizable<U>::value &&
+                    (std::is_same<U, int>::value ||
+                     (std::is_same<U, unsigned int>::value &&
+                      std::is_unsigned<T>::value) ||
+                     is_simd_value_preserving<U, T>::value)> {};
+
+template <typename G, typename T, typename = void>
+struct is_simd_generator : std::false_type {};
+
+template <typename G, typename T>
+struct is_simd_generator<
+    G,
+    T,
+    typename lib::always_void<decltype(std::declval<G&>()(
+        std::integral_constant<std::size_t, 0>()))>::type>
+    : std::is_convertible<decltype(std::declval<G&>()(
+                              std::integral_constant<std::size_t, 0>())),
+                          T> {};
+
+// The alignment a load/store flag promises for a pointer to `U`.
+template <typename Flags, typename V, typename U>
+struct simd_flag_alignment;
+
+template <typename V, typename U>
+struct simd_flag_alignment<element_aligned_tag, V, U>
+    : std::integral_constant<std::size_t, alignof(U)> {};
+
+template <typename V, typename U>
+struct simd_flag_alignment<vector_aligned_tag, V, U>
+    : memory_alignment<V, U> {};
+
+template <std::size_t N, typename V, typename U>
+struct simd_flag_alignment<overaligned_tag<N>, V, U>
+    : std::integral_constant<std::size_t, N> {};
+
+template <std::size_t Align, typename U>
+U* simd_assume_aligned(U* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<U*>(__builtin_assume_aligned(p, Align));
+#else
+  return p;
+#endif
+}
+
+// The signed integer type with the size of `T`, used for mask elements; all
+// bits are set for `true` and cleared for `false`.
+template <std::size_t Size>
+struct simd_mask_int {
+  using type = long long;
+};
+
+template <>
+struct simd_mask_int<1> {
+  using type = std::int8_t;
+};
+
+template <>
+struct simd_mask_int<2> {
+  using type = std::int16_t;
+};
+
+template <>
+struct simd_mask_int<4> {
+  using type = std::int32_t;
+};
+
+template <>
+struct simd_mask_int<8> {
+  using type = std::int64_t;
+};
+
+// The element-wise operations are applied to single elements and to whole
+// vectors alike; results are converted back to the operand type, so that
+// narrow integer elements wrap rather than promote.
+struct simd_plus {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return static_cast<T>(a + b);
+  }
+};
+
+struct simd_minus {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return static_cast<T>(a - b);
+  }
+};
+
+struct simd_multiplies {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return static_cast<T>(a * b);
+  }
+};
+
+struct simd_divides {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return static_cast<T>(a / b);
+  }
+};
+
+struct simd_modulus {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return static_cast<T>(a % b);
+  }
+};
+
+struct simd_bit_and {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return static_cast<T>(a & b);
+  }
+};
+
+struct simd_bit_or {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return static_cast<T>(a | b);
+  }
+};
+
+struct simd_bit_xor {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return static_cast<T>(a ^ b);
+  }
+};
+
+struct simd_shift_left {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return static_cast<T>(a << b);
+  }
+};
+
+struct simd_shift_right {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return static_cast<T>(a >> b);
+  }
+};
+
+struct simd_negate {
+  template <typename T>
+  T operator()(T const& a) const noexcept {
+    return static_cast<T>(-a);
+  }
+};
+
+struct simd_bit_not {
+  template <typename T>
+  T operator()(T const& a) const noexcept {
+    return static_cast<T>(~a);
+  }
+};
+
+struct simd_equal_to {
+  template <typename T>
+  auto operator()(T const& a, T const& b) const noexcept -> decltype(a == b) {
+    return a == b;
+  }
+};
+
+struct simd_not_equal_to {
+  template <typename T>
+  auto operator()(T const& a, T const& b) const noexcept -> decltype(a != b) {
+    return a != b;
+  }
+};
+
+struct simd_less {
+  template <typename T>
+  auto operator()(T const& a, T const& b) const noexcept -> decltype(a < b) {
+    return a < b;
+  }
+};
+
+struct simd_less_equal {
+  template <typename T>
+  auto operator()(T const& a, T const& b) const noexcept -> decltype(a <= b) {
+    return a <= b;
+  }
+};
+
+struct simd_min {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return b < a ? b : a;
+  }
+};
+
+struct simd_max {
+  template <typename T>
+  T operator()(T const& a, T const& b) const noexcept {
+    return a < b ? b : a;
+  }
+};
+
+// Collects one bit per lane, lane `i` in bit `i`.
+template <typename M>
+std::uint64_t simd_lane_bits(M const& m, std::size_t n) noexcept {
+  std::uint64_t bits = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    bits |= static_cast<std::uint64_t>(m[i] != 0) << i;
+  }
+  return bits;
+}
+
+#if SLB_HAS_SSE2
+// Collects the sign bit of each lane of a 128-bit chunk.
+inline unsigned simd_movemask(__m128i x,
+                              std::integral_constant<std::size_t, 1>) noexcept {
+  return static_cast<unsigned>(_mm_movemask_epi8(x));
+}
+
+inline unsigned simd_movemask(__m128i x,
+                              std::integral_constant<std::size_t, 2>) noexcept {
+  return static_cast<unsigned>(
+      _mm_movemask_epi8(_mm_packs_epi16(x, _mm_setzero_si128())));
+}
+
+inline unsigned simd_movemask(__m128i x,
+                              std::integral_constant<std::size_t, 4>) noexcept {
+  return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(x)));
+}
+
+inline unsigned simd_movemask(__m128i x,
+                              std::integral_constant<std::size_t, 8>) noexcept {
+  return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(x)));
+}
+
+template <std::size_t Size, typename M>
+std::uint64_t simd_chunk_bits(M const& m) noexcept {
+  std::uint64_t bits = 0;
+  for (std::size_t i = 0; i < sizeof(M) / 16; ++i) {
+    __m128i chunk;
+    std::memcpy(&chunk, reinterpret_cast<char const*>(&m) + 16 * i, 16);
+    bits |= static_cast<std::uint64_t>(simd_movemask(
+                chunk, std::integral_constant<std::size_t, Size>()))
+            << (i * (16 / Size));
+  }
+  return bits;
+}
+#endif
+
+template <typename T, std::size_t N>
+struct simd_array {
+  T& operator[](std::size_t i) noexcept { return data[i]; }
+  T const& operator[](std::size_t i) const noexcept { return data[i]; }
+
+  T data[N];
+};
+
+// Power-of-two lane counts that fit in `Bytes` map onto a vector type, whose
+// operators the compiler lowers to the target's vector instructions;
+// everything else is an array processed by plain loops, which leaves the
+// vectorization to the optimizer. Only `simd_abi::native` uses vectors wider
+// than 16 bytes, whose alignment and calling convention depend on the
+// enabled instruction sets.
+template <typename T, std::size_t N, std::size_t Bytes = 16>
+struct simd_use_vector
+    : bool_constant<(SLB_HAS_VECTOR_EXTENSIONS && N > 1 &&
+                     (N & (N - 1)) == 0 && sizeof(T) <= 8 &&
+                     N * sizeof(T) <= Bytes &&
+                     !std::is_same<T, long double>::value)> {};
+
+template <typename Abi>
+struct simd_vector_bytes : std::integral_constant<std::size_t, 16> {};
+
+template <std::size_t Bytes>
+struct simd_vector_bytes<simd_native_abi<Bytes>>
+    : std::integral_constant<std::size_t, Bytes> {};
+
+template <typename T, std::size_t N, bool = simd_use_vector<T, N>::value>
+struct simd_impl {
+  using value_type = T;
+  using mask_value = typename simd_mask_int<sizeof(T)>::type;
+  using storage = simd_array<T, N>;
+  using mask_storage = simd_array<mask_value, N>;
+  using mask_impl = simd_impl<mask_value, N, false>;
+
+  static storage broadcast(T x) noexcept {
+    storage r;
+    for (std::size_t i = 0; i < N; ++i) {
+      r[i] = x;
+    }
+    return r;
+  }
+
+  template <typename Op>
+  static storage apply(Op op, storage const& a) noexcept {
+    storage r;
+    for (std::size_t i = 0; i < N; ++i) {
+      r[i] = op(a[i]);
+    }
+    return r;
+  }
+
+  template <typename Op>
+  static storage apply(Op op, storage const& a, storage const& b) noexcept {
+    storage r;
+    for (std::size_t i = 0; i < N; ++i) {
+      r[i] = op(a[i], b[i]);
+    }
+    return r;
+  }
+
+  template <typename Op>
+  static mask_storage compare(Op op,
+                              storage const& a,
+                              storage const& b) noexcept {
+    mask_storage r;
+    for (std::size_t i = 0; i < N; ++i) {
+      r[i] = static_cast<mask_value>(op(a[i], b[i]) ? -1 : 0);
+    }
+    return r;
+  }
+
+  static storage select(mask_storage const& m,
+                        storage const& a,
+                        storage const& b) noexcept {
+    storage r;
+    for (std::size_t i = 0; i < N; ++i) {
+      r[i] = m[i] ? a[i] : b[i];
+    }
+    return r;
+  }
+
+  static std::uint64_t mask_bits(mask_storage const& m) noexcept {
+    return detail::simd_lane_bits(m, N);
+  }
+};
+
+#if SLB_HAS_VECTOR_EXTENSIONS
+// Reinterprets the bits of a vector as another vector type of the same size.
+template <typename To, typename From>
+To simd_vector_cast(From const& x) noexcept {
+  return (To)x;
+}
+
+template <typename T, std::size_t N>
+struct simd_impl<T, N, true> {
+  using value_type = T;
+  using mask_value = typename simd_mask_int<sizeof(T)>::type;
+  typedef T storage __attribute__((__vector_size__(N * sizeof(T))));
+  typedef mask_value mask_storage
+      __attribute__((__vector_size__(N * sizeof(T))));
+  using mask_impl = simd_impl<mask_value, N, true>;
+
+  static storage broadcast(T x) noexcept { return storage() + x; }
+
+  template <typename Op>
+  static storage apply(Op op, storage const& a) noexcept {
+    return op(a);
+  }
+
+  template <typename Op>
+  static storage apply(Op op, storage const& a, storage const& b) noexcept {
+    return op(a, b);
+  }
+
+  // Vector comparisons yield a signed integer vector with all bits set in
+  // each lane that compares true.
+  template <typename Op>
+  static mask_storage compare(Op op,
+                              storage const& a,
+                              storage const& b) noexcept {
+    return detail::simd_vector_cast<mask_storage>(op(a, b));
+  }
+
+  static storage select(mask_storage const& m,
+                        storage const& a,
+                        storage const& b) noexcept {
+    return detail::simd_vector_cast<storage>(
+        (detail::simd_vector_cast<mask_storage>(a) & m) |
+        (detail::simd_vector_cast<mask_storage>(b) & ~m));
+  }
+
+  static std::uint64_t mask_bits(mask_storage const& m) noexcept {
+    return mask_bits(m, bool_constant<SLB_HAS_SSE2 && sizeof(m) % 16 == 0>());
+  }
+
+private:
+  static std::uint64_t mask_bits(mask_storage const& m,
+                                 std::false_type) noexcept {
+    return detail::simd_lane_bits(m, N);
+  }
+
+#if SLB_HAS_SSE2
+  static std::uint64_t mask_bits(mask_storage const& m,
+                                 std::true_type) noexcept {
+    return detail::simd_chunk_bits<sizeof(T)>(m);
+  }
+#endif
+};
+#endif
+
+template <typename T, typename Abi>
+using simd_impl_for =
+    simd_impl<T,
+              simd_size<T, Abi>::value,
+              simd_use_vector<T,
+                              simd_size<T, Abi>::value,
+                              simd_vector_bytes<Abi>::value>::value>;
+
+// Copies `n` elements between a `simd` representation and memory, converting
+// each element unless the types match.
+template <typename T, typename S, typename U>
+void simd_load(S& data, U const* mem, std::size_t n, std::false_type) noexcept {
+  for (std::size_t i = 0; i < n; ++i) {
+    data[i] = static_cast<T>(mem[i]);
+  }
+}
+
+template <typename T, typename S, typename U>
+void simd_load(S& data, U const* mem, std::size_t, std::true_type) noexcept {
+  std::memcpy(&data, mem, sizeof(data));
+}
+
+template <typename S, typename U>
+void simd_store(S const& data,
+                U* mem,
+                std::size_t n,
+                std::false_type) noexcept {
+  for (std::size_t i = 0; i < n; ++i) {
+    mem[i] = static_cast<U>(data[i]);
+  }
+}
+
+template <typename S, typename U>
+void simd_store(S const& data, U* mem, std::size_t, std::true_type) noexcept {
+  std::memcpy(mem, &data, sizeof(data));
+}
+
+struct simd_storage_tag {};
+
+// Grants the where-expressions and the non-member functions access to the
+// representation of `simd` and `simd_mask`.
+struct simd_access {
+  template <typename S>
+  static auto data(S& s) noexcept -> decltype((s.data_)) {
+    return s.data_;
+  }
+
+  template <typename S, typename D>
+  static S make(D const& data) noexcept {
+    return S(simd_storage_tag(), data);
+  }
+};
+
+} // namespace detail
+
+// [simd.class], class template simd
+
+template <typename T, typename Abi>
+class simd {
+  static_assert(detail::is_simd_vectorizable<T>::value,
+                "simd requires an arithmetic element type other than bool");
+  static_assert(is_abi_tag<Abi>::value, "simd requires an ABI tag");
+
+  using impl = detail::simd_impl_for<T, Abi>;
+
+public:
+  using value_type = T;
+  using mask_type = simd_mask<T, Abi>;
+  using abi_type = Abi;
+
+  static constexpr std::size_t size() noexcept {
+    return simd_size<T, Abi>::value;
+  }
+
+  static_assert(simd_size<T, Abi>::value >= 1 &&
+                    simd_size<T, Abi>::value <= simd_abi::max_fixed_size,
+                "simd supports between 1 and max_fixed_size elements");
+
+  simd() = default;
+
+  template <typename U,
+            typename std::enable_if<
+                detail::is_simd_broadcastable<remove_cvref_t<U>, T>::value,
+                int>::type = 0>
+  simd(U&& value) noexcept
+      : data_(impl::broadcast(static_cast<T>(value))) {}
+
+  template <typename G,
+            typename std::enable_if<
+                !detail::is_simd_vectorizable<remove_cvref_t<G>>::value &&
+                    detail::is_simd_generator<G, T>::value,
+                int>::type = 0>
+  explicit simd(G&& gen) : simd(gen, make_index_sequence<size()>()) {}
+
+  template <typename U,
+            typename Flags,
+            typename std::enable_if<detail::is_simd_vectorizable<U>::value &&
+                                        is_simd_flag_type<Flags>::value,
+                                    int>::type = 0>
+  simd(U const* mem, Flags f) noexcept {
+    copy_from(mem, f);
+  }
+
+  template <typename U,
+            typename Flags,
+            typename std::enable_if<detail::is_simd_vectorizable<U>::value &&
+                                        is_simd_flag_type<Flags>::value,
+                                    int>::type = 0>
+  void copy_from(U const* mem, Flags) noexcept {
+    detail::simd_load<T>(
+        data_,
+        detail::simd_assume_aligned<
+            detail::simd_flag_alignment<Flags, simd, U>::value>(mem),
+        size(),
+        std::is_same<T, U>());
+  }
+
+  template <typename U,
+            typename Flags,
+            typename std::enable_if<detail::is_simd_vectorizable<U>::value &&
+                                        is_simd_flag_type<Flags>::value,
+                                    int>::type = 0>
+  void copy_to(U* mem, Flags) const noexcept {
+    detail::simd_store(
+        data_,
+        detail::simd_assume_aligned<
+            detail::simd_flag_alignment<Flags, simd, U>::value>(mem),
+        size(),
+        std::is_same<T, U>());
+  }
+
+  value_type operator[](std::size_t i) const noexcept { return data_[i]; }
+
+  simd& operator++() noexcept { return *this += simd(1); }
+
+  simd operator++(int) noexcept {
+    simd result = *this;
+    *this += simd(1);
+    return result;
+  }
+
+  simd& operator--() noexcept { return *this -= simd(1); }
+
+  simd operator--(int) noexcept {
+    simd result = *this;
+    *this -= simd(1);
+    return result;
+  }
+
+  mask_type operator!() const noexcept { return *this == simd(0); }
+
+  simd operator~() const noexcept {
+    return simd::apply(detail::simd_bit_not(), *this);
+  }
+
+  simd operator+() const noexcept { return *this; }
+
+  simd operator-() const noexcept {
+    return simd::apply(detail::simd_negate(), *this);
+  }
+
+  friend simd operator+(simd const& a, simd const& b) noexcept {
+    return simd::apply(detail::simd_plus(), a, b);
+  }
+
+  friend simd operator-(simd const& a, simd const& b) noexcept {
+    return simd::apply(detail::simd_minus(), a, b);
+  }
+
+  friend simd operator*(simd const& a, simd const& b) noexcept {
+    return simd::apply(detail::simd_multiplies(), a, b);
+  }
+
+  friend simd operator/(simd const& a, simd const& b) noexcept {
+    return simd::apply(detail::simd_divides(), a, b);
+  }
+
+  friend simd operator%(simd const& a, simd const& b) noexcept {
+    return simd::apply(detail::simd_modulus(), a, b);
+  }
+
+  friend simd operator&(simd const& a, simd const& b) noexcept {
+    return simd::apply(detail::simd_bit_and(), a, b);
+  }
+
+  friend simd operator|(simd const& a, simd const& b) noexcept {
+    return simd::apply(detail::simd_bit_or(), a, b);
+  }
+
+  friend simd operator^(simd const& a, simd const& b) noexcept {
+    return simd::apply(detail::simd_bit_xor(), a, b);
+  }
+
+  friend simd operator<<(simd const& a, simd const& b) noexcept {
+    return simd::apply(detail::simd_shift_left(), a, b);
+  }
+
+  friend simd operator>>(simd const& a, simd const& b) noexcept {
+    return simd::apply(detail::simd_shift_right(), a, b);
+  }
+
+  friend simd& operator+=(simd& a, simd const& b) noexcept {
+    return a = a + b;
+  }
+
+  friend simd& operator-=(simd& a, simd const& b) noexcept {
+    return a = a - b;
+  }
+
+  friend simd& operator*=(simd& a, simd const& b) noexcept {
+    return a = a * b;
+  }
+
+  friend simd& operator/=(simd& a, simd const& b) noexcept {
+    return a = a / b;
+  }
+
+  friend simd& operator%=(simd& a, simd const& b) noexcept {
+    return a = a % b;
+  }
+
+  friend simd& operator&=(simd& a, simd const& b) noexcept {
+    return a = a & b;
+  }
+
+  friend simd& operator|=(simd& a, simd const& b) noexcept {
+    return a = a | b;
+  }
+
+  friend simd& operator^=(simd& a, simd const& b) noexcept {
+    return a = a ^ b;
+  }
+
+  friend simd& operator<<=(simd& a, simd const& b) noexcept {
+    return a = a << b;
+  }
+
+  friend simd& operator>>=(simd& a, simd const& b) noexcept {
+    return a = a >> b;
+  }
+
+  friend mask_type operator==(simd const& a, simd const& b) noexcept {
+    return simd::compare(detail::simd_equal_to(), a, b);
+  }
+
+  friend mask_type operator!=(simd const& a, simd const& b) noexcept {
+    return simd::compare(detail::simd_not_equal_to(), a, b);
+  }
+
+  friend mask_type operator<(simd const& a, simd const& b) noexcept {
+    return simd::compare(detail::simd_less(), a, b);
+  }
+
+  friend mask_type operator<=(simd const& a, simd const& b) noexcept {
+    return simd::compare(detail::simd_less_equal(), a, b);
+  }
+
+  friend mask_type operator>(simd const& a, simd const& b) noexcept {
+    return simd::compare(detail::simd_less(), b, a);
+  }
+
+  friend mask_type operator>=(simd const& a, simd const& b) noexcept {
+    return simd::compare(detail::simd_less_equal(), b, a);
+  }
+
+private:
+  friend struct detail::simd_access;
+
+  simd(detail::simd_storage_tag, typename impl::storage const& data) noexcept
+      : data_(data) {}
+
+  template <typename G, std::size_t... Is>
+  simd(G& gen, index_sequence<Is...>) {
+    T const values[] = {
+        static_cast<T>(gen(std::integral_constant<std::size_t, Is>()))...};
+    detail::simd_load<T>(data_, values, size(), std::true_type());
+  }
+
+  template <typename Op>
+  static simd apply(Op op, simd const& a) noexcept {
+    return simd(detail::simd_storage_tag(), impl::apply(op, a.data_));
+  }
+
+  template <typename Op>
+  static simd apply(Op op, simd const& a, simd const& b) noexcept {
+    return simd(detail::simd_storage_tag(), impl::apply(op, a.data_, b.data_));
+  }
+
+  template <typename Op>
+  static mask_type compare(Op op, simd const& a, simd const& b) noexcept {
+    return detail::simd_access::make<mask_type>(
+        impl::compare(op, a.data_, b.data_));
+  }
+
+  typename impl::storage data_;
+};
+
+template <typename T>
+using native_simd = simd<T, simd_abi::native<T>>;
+
+template <typename T, int N>
+using fixed_size_simd = simd<T, simd_abi::fixed_size<N>>;
+
+// [simd.mask.class], class template simd_mask
+
+template <typename T, typename Abi>
+class simd_mask {
+  static_assert(
+      detail::is_simd_vectorizable<T>::value,
+      "simd_mask requires an arithmetic element type other than bool");
+  static_assert(is_abi_tag<Abi>::value, "simd_mask requires an ABI tag");
+
+  using impl = typename detail::simd_impl_for<T, Abi>::mask_impl;
+  using mask_value = typename impl::value_type;
+
+public:
+  using value_type = bool;
+  using simd_type = simd<T, Abi>;
+  using abi_type = Abi;
+
+  static constexpr std::size_t size() noexcept {
+    return simd_size<T, Abi>::value;
+  }
+
+  simd_mask() = default;
+
+  explicit simd_mask(value_type x) noexcept
+      : data_(impl::broadcast(static_cast<mask_value>(x ? -1 : 0))) {}
+
+  template <typename Flags,
+            typename std::enable_if<is_simd_flag_type<Flags>::value,
+                                    int>::type = 0>
+  simd_mask(value_type const* mem, Flags f) noexcept {
+    copy_from(mem, f);
+  }
+
+  template <typename Flags,
+            typename std::enable_if<is_simd_flag_type<Flags>::value,
+                                    int>::type = 0>
+  void copy_from(value_type const* mem, Flags) noexcept {
+    for (std::size_t i = 0; i < size(); ++i) {
+      data_[i] = static_cast<mask_value>(mem[i] ? -1 : 0);
+    }
+  }
+
+  template <typename Flags,
+            typename std::enable_if<is_simd_flag_type<Flags>::value,
+                                    int>::type = 0>
+  void copy_to(value_type* mem, Flags) const noexcept {
+    for (std::size_t i = 0; i < size(); ++i) {
+      mem[i] = data_[i] != 0;
+    }
+  }
+
+  value_type operator[](std::size_t i) const noexcept { return data_[i] != 0; }
+
+  simd_mask operator!() const noexcept {
+    return simd_mask(detail::simd_storage_tag(),
+                     impl::apply(detail::simd_bit_not(), data_));
+  }
+
+  friend simd_mask operator&&(simd_mask const& a, simd_mask const& b) noexcept {
+    return a & b;
+  }
+
+  friend simd_mask operator||(simd_mask const& a, simd_mask const& b) noexcept {
+    return a | b;
+  }
+
+  friend simd_mask operator&(simd_mask const& a, simd_mask const& b) noexcept {
+    return simd_mask::apply(detail::simd_bit_and(), a, b);
+  }
+
+  friend simd_mask operator|(simd_mask const& a, simd_mask const& b) noexcept {
+    return simd_mask::apply(detail::simd_bit_or(), a, b);
+  }
+
+  friend simd_mask operator^(simd_mask const& a, simd_mask const& b) noexcept {
+    return simd_mask::apply(detail::simd_bit_xor(), a, b);
+  }
+
+  friend simd_mask& operator&=(simd_mask& a, simd_mask const& b) noexcept {
+    return a = a & b;
+  }
+
+  friend simd_mask& operator|=(simd_mask& a, simd_mask const& b) noexcept {
+    return a = a | b;
+  }
+
+  friend simd_mask& operator^=(simd_mask& a, simd_mask const& b) noexcept {
+    return a = a ^ b;
+  }
+
+  friend simd_mask operator==(simd_mask const& a, simd_mask const& b) noexcept {
+    return !(a ^ b);
+  }
+
+  friend simd_mask operator!=(simd_mask const& a, simd_mask const& b) noexcept {
+    return a ^ b;
+  }
+
+private:
+  friend struct detail::simd_access;
+
+  simd_mask(detail::simd_storage_tag,
+            typename impl::storage const& data) noexcept
+      : data_(data) {}
+
+  template <typename Op>
+  static simd_mask apply(Op op, simd_mask const& a, simd_mask const& b) {
+    return simd_mask(detail::simd_storage_tag(),
+                     impl::apply(op, a.data_, b.data_));
+  }
+
+  typename impl::storage data_;
+};
+
+template <typename T>
+using native_simd_mask = simd_mask<T, simd_abi::native<T>>;
+
+template <typename T, int N>
+using fixed_size_simd_mask = simd_mask<T, simd_abi::fixed_size<N>>;
+
+namespace detail {
+
+template <typename T, typename Abi>
+simd<T, Abi> simd_select(simd_mask<T, Abi> const& m,
+                         simd<T, Abi> const& a,
+                         simd<T, Abi> const& b) noexcept {
+  return simd_access::make<simd<T, Abi>>(simd_impl_for<T, Abi>::select(
+      simd_access::data(m), simd_access::data(a), simd_access::data(b)));
+}
+
+template <typename T, typename Abi>
+std::uint64_t simd_mask_bits(simd_mask<T, Abi> const& m) noexcept {
+  return simd_impl_for<T, Abi>::mask_bits(simd_access::data(m));
+}
+
+} // namespace detail
+
+// [simd.whereexpr], where expression class templates
+
+template <typename M, typename V>
+class const_where_expression {
+public:
+  const_where_expression(M const& mask, V const& value) noexcept
+      : mask_(mask), value_(value) {}
+
+  V operator-() const&& noexcept {
+    return detail::simd_select(mask_, -value_, value_);
+  }
+
+  template <typename U,
+            typename Flags,
+            typename std::enable_if<detail::is_simd_vectorizable<U>::value &&
+                                        is_simd_flag_type<Flags>::value,
+                                    int>::type = 0>
+  void copy_to(U* mem, Flags) const&& noexcept {
+    for (std::size_t i = 0; i < V::size(); ++i) {
+      if (mask_[i]) {
+        mem[i] = static_cast<U>(value_[i]);
+      }
+    }
+  }
+
+  template <typename M2, typename V2, typename BinaryOperation>
+  friend typename V2::value_type reduce(
+      const_where_expression<M2, V2> const& x,
+      typename V2::value_type identity_element,
+      BinaryOperation binary_op);
+
+protected:
+  M mask_;
+  V const& value_;
+};
+
+template <typename M, typename V>
+class where_expression : public const_where_expression<M, V> {
+public:
+  where_expression(M const& mask, V& value) noexcept
+      : const_where_expression<M, V>(mask, value), target_(value) {}
+
+  template <typename U>
+  void operator=(U&& x) && noexcept {
+    target_ = detail::simd_select(this->mask_, V(SLB_FORWARD(U, x)), target_);
+  }
+
+  template <typename U>
+  void operator+=(U&& x) && noexcept {
+    assign(detail::simd_plus(), V(SLB_FORWARD(U, x)));
+  }
+
+  template <typename U>
+  void operator-=(U&& x) && noexcept {
+    assign(detail::simd_minus(), V(SLB_FORWARD(U, x)));
+  }
+
+  template <typename U>
+  void operator*=(U&& x) && noexcept {
+    assign(detail::simd_multiplies(), V(SLB_FORWARD(U, x)));
+  }
+
+  // The unselected lanes divide by one, so that they cannot trap.
+  template <typename U>
+  void operator/=(U&& x) && noexcept {
+    assign(detail::simd_divides(),
+           detail::simd_select(this->mask_, V(SLB_FORWARD(U, x)), V(1)));
+  }
+
+  template <typename U>
+  void operator%=(U&& x) && noexcept {
+    assign(detail::simd_modulus(),
+           detail::simd_select(this->mask_, V(SLB_FORWARD(U, x)), V(1)));
+  }
+
+  template <typename U>
+  void operator&=(U&& x) && noexcept {
+    assign(detail::simd_bit_and(), V(SLB_FORWARD(U, x)));
+  }
+
+  template <typename U>
+  void operator|=(U&& x) && noexcept {
+    assign(detail::simd_bit_or(), V(SLB_FORWARD(U, x)));
+  }
+
+  template <typename U>
+  void operator^=(U&& x) && noexcept {
+    assign(detail::simd_bit_xor(), V(SLB_FORWARD(U, x)));
+  }
+
+  template <typename U>
+  void operator<<=(U&& x) && noexcept {
+    assign(detail::simd_shift_left(), V(SLB_FORWARD(U, x)));
+  }
+
+  template <typename U>
+  void operator>>=(U&& x) && noexcept {
+    assign(detail::simd_shift_right(), V(SLB_FORWARD(U, x)));
+  }
+
+  void operator++() && noexcept { assign(detail::simd_plus(), V(1)); }
+
+  void operator++(int) && noexcept { assign(detail::simd_plus(), V(1)); }
+
+  void operator--() && noexcept { assign(detail::simd_minus(), V(1)); }
+
+  void operator--(int) && noexcept { assign(detail::simd_minus(), V(1)); }
+
+  // Only the selected elements are read, so the unselected part of `mem` may
+  // lie outside of any object.
+  template <typename U,
+            typename Flags,
+            typename std::enable_if<detail::is_simd_vectorizable<U>::value &&
+                                        is_simd_flag_type<Flags>::value,
+                                    int>::type = 0>
+  void copy_from(U const* mem, Flags) && noexcept {
+    auto& data = detail::simd_access::data(target_);
+    for (std::size_t i = 0; i < V::size(); ++i) {
+      if (this->mask_[i]) {
+        data[i] = static_cast<typename V::value_type>(mem[i]);
+      }
+    }
+  }
+
+private:
+  template <typename Op>
+  void assign(Op op, V const& x) noexcept {
+    target_ = detail::simd_select(this->mask_, op(target_, x), target_);
+  }
+
+  V& target_;
+};
+
+template <typename T, typename Abi>
+where_expression<simd_mask<T, Abi>, simd<T, Abi>> where(
+    typename simd<T, Abi>::mask_type const& mask,
+    simd<T, Abi>& value) noexcept {
+  return {mask, value};
+}
+
+template <typename T, typename Abi>
+const_where_expression<simd_mask<T, Abi>, simd<T, Abi>> where(
+    typename simd<T, Abi>::mask_type const& mask,
+    simd<T, Abi> const& value) noexcept {
+  return {mask, value};
+}
+
+// [simd.reductions], reductions
+
+namespace detail {
+
+// The elements are combined as a balanced tree, so that the partial results
+// are independent of each other. The recursion is resolved at compile time,
+// which keeps every element at a constant index and thus in registers.
+template <typename T, typename BinaryOperation>
+T simd_reduce(T const* values,
+              BinaryOperation&,
+              std::integral_constant<std::size_t, 1>) {
+  return values[0];
+}
+
+template <typename T, typename BinaryOperation, std::size_t N>
+T simd_reduce(T const* values,
+              BinaryOperation& binary_op,
+              std::integral_constant<std::size_t, N>) {
+  return binary_op(
+      detail::simd_reduce(
+          values, binary_op, std::integral_constant<std::size_t, N / 2>()),
+      detail::simd_reduce(values + N / 2,
+                          binary_op,
+                          std::integral_constant<std::size_t, N - N / 2>()));
+}
+
+template <typename T,
+          typename Abi,
+          typename BinaryOperation,
+          std::size_t... Is>
+T simd_reduce(simd<T, Abi> const& x,
+              BinaryOperation& binary_op,
+              index_sequence<Is...>) {
+  T const values[] = {x[Is]...};
+  return detail::simd_reduce(
+      values,
+      binary_op,
+      std::integral_constant<std::size_t, sizeof...(Is)>());
+}
+
+} // namespace detail
+
+// `binary_op` must be associative and commutative.
+template <typename T, typename Abi, typename BinaryOperation = std::plus<T>>
+T reduce(simd<T, Abi> const& x, BinaryOperation binary_op = {}) {
+  return detail::simd_reduce(
+      x, binary_op, make_index_sequence<simd<T, Abi>::size()>());
+}
+
+template <typename M, typename V, typename BinaryOperation>
+typename V::value_type reduce(const_where_expression<M, V> const& x,
+                              typename V::value_type identity_element,
+                              BinaryOperation binary_op) {
+  return slb::reduce(
+      detail::simd_select(x.mask_, x.value_, V(identity_element)), binary_op);
+}
+
+template <typename T, typename Abi>
+T hmin(simd<T, Abi> const& x) {
+  return slb::reduce(x, detail::simd_min());
+}
+
+template <typename T, typename Abi>
+T hmax(simd<T, Abi> const& x) {
+  return slb::reduce(x, detail::simd_max());
+}
+
+// [simd.alg], algorithms
+
+template <typename T, typename Abi>
+simd<T, Abi> min(simd<T, Abi> const& a, simd<T, Abi> const& b) noexcept {
+  return detail::simd_select(b < a, b, a);
+}
+
+template <typename T, typename Abi>
+simd<T, Abi> max(simd<T, Abi> const& a, simd<T, Abi> const& b) noexcept {
+  return detail::simd_select(a < b, b, a);
+}
+
+template <typename T, typename Abi>
+std::pair<simd<T, Abi>, simd<T, Abi>> minmax(simd<T, Abi> const& a,
+                                             simd<T, Abi> const& b) noexcept {
+  return {slb::min(a, b), slb::max(a, b)};
+}
+
+template <typename T, typename Abi>
+simd<T, Abi> clamp(simd<T, Abi> const& v,
+                   simd<T, Abi> const& lo,
+                   simd<T, Abi> const& hi) {
+  return detail::simd_select(
+      v < lo, lo, detail::simd_select(hi < v, hi, v));
+}
+
+// [simd.mask.reductions], reductions
+
+template <typename T, typename Abi>
+bool all_of(simd_mask<T, Abi> const& m) noexcept {
+  return detail::simd_mask_bits(m) ==
+         (~std::uint64_t(0) >> (64 - simd_mask<T, Abi>::size()));
+}
+
+template <typename T, typename Abi>
+bool any_of(simd_mask<T, Abi> const& m) noexcept {
+  return detail::simd_mask_bits(m) != 0;
+}
+
+template <typename T, typename Abi>
+bool none_of(simd_mask<T, Abi> const& m) noexcept {
+  return detail::simd_mask_bits(m) == 0;
+}
+
+template <typename T, typename Abi>
+bool some_of(simd_mask<T, Abi> const& m) noexcept {
+  return slb::any_of(m) && !slb::all_of(m);
+}
+
+template <typename T, typename Abi>
+int popcount(simd_mask<T, Abi> const& m) noexcept {
+  return slb::popcount(detail::simd_mask_bits(m));
+}
+
+// Requires `any_of(m)`.
+template <typename T, typename Abi>
+int find_first_set(simd_mask<T, Abi> const& m) {
+  return slb::countr_zero(detail::simd_mask_bits(m));
+}
+
+// Requires `any_of(m)`.
+template <typename T, typename Abi>
+int find_last_set(simd_mask<T, Abi> const& m) {
+  return 63 - slb::countl_zero(detail::simd_mask_bits(m));
+}
+
+} // namespace slb
+
+#endif // SLB_SIMD_HPP
@@ -0,0 +1,755 @@
+/*
+  SLB.SmallVector
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_SMALL_VECTOR_HPP
+#define SLB_SMALL_VECTOR_HPP
+
+/*
+
+Header <slb/small_vector.hpp> synopsis
+
+namespace slb {
+  // class template small_vector
+  template<class T, size_t N, class Allocator = allocator<T>>
+    class small_vector;
+
+  template<class T, size_t N, class Allocator>
+    bool operator==(const small_vector<T, N, Allocator>& x,
+                    const small_vector<T, N, Allocator>& y);
+  template<class T, size_t N, class Allocator>
+    bool operator!=(const small_vector<T, N, Allocator>& x,
+                    const small_vector<T, N, Allocator>& y);
+  template<class T, size_t N, class Allocator>
+    bool operator< (const small_vector<T, N, Allocator>& x,
+                    const small_vector<T, N, Allocator>& y);
+  template<class T, size_t N, class Allocator>
+    bool operator> (const small_vector<T, N, Allocator>& x,
+                    const small_vector<T, N, Allocator>& y);
+  template<class T, size_t N, class Allocator>
+    bool operator<=(const small_vector<T, N, Allocator>& x,
+                    const small_vector<T, N, Allocator>& y);
+  template<class T, size_t N, class Allocator>
+    bool operator>=(const small_vector<T, N, Allocator>& x,
+                    const small_vector<T, N, Allocator>& y);
+
+  template<class T, size_t N, class Allocator>
+    void swap(small_vector<T, N, Allocator>& x,
+              small_vector<T, N, Allocator>& y)
+      noexcept(noexcept(x.swap(y)));
+
+  // erasure
+  template<class T, size_t N, class Allocator, class U>
+    typename small_vector<T, N, Allocator>::size_type
+      erase(small_vector<T, N, Allocator>& c, const U& value);
+  template<class T, size_t N, class Allocator, class Predicate>
+    typename small_vector<T, N, Allocator>::size_type
+      erase_if(small_vector<T, N, Allocator>& c, Predicate pred);
+}
+
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "detail/config.hpp"
+#include "detail/lib.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+
+namespace slb {
+
+namespace detail {
+
+// Up to `N` elements are stored within the object itself.
+template <typename T, std::size_t N>
+class small_vector_buffer {
+public:
+  T* inline_data() noexcept { return reinterpret_cast<T*>(&buffer_); }
+
+private:
+  typename slb::aligned_storage<sizeof(T) * N, alignof(T)>::type buffer_;
+};
+
+template <typename T>
+class small_vector_buffer<T, 0> {
+public:
+  T* inline_data() noexcept { return nullptr; }
+};
+
+// Empty allocators take no space.
+template <typename Allocator, bool = std::is_empty<Allocator>::value>
+class small_vector_allocator {
+public:
+  explicit small_vector_allocator(Allocator const& alloc) : alloc_(alloc) {}
+
+  Allocator& allocator() noexcept { return alloc_; }
+  Allocator const& allocator() const noexcept { return alloc_; }
+
+private:
+  Allocator alloc_;
+};
+
+template <typename Allocator>
+class small_vector_allocator<Allocator, true> : private Allocator {
+public:
+  explicit small_vector_allocator(Allocator const& alloc) : Allocator(alloc) {}
+
+  Allocator& allocator() noexcept { return *this; }
+  Allocator const& allocator() const noexcept { return *this; }
+};
+
+// When growing, elements are moved to the new buffer only if that cannot
+// throw, or if they cannot be copied; otherwise they are copied so that the
+// strong exception guarantee holds.
+template <typename T>
+using small_vector_move_if_noexcept_iterator = typename std::conditional<
+    !std::is_nothrow_move_constructible<T>::value &&
+        std::is_copy_constructible<T>::value,
+    T const*,
+    std::move_iterator<T*>>::type;
+
+} // namespace detail
+
+// A vector with inline storage for up to `N` elements, spilling to storage
+// obtained from `Allocator` when it grows beyond that. Elements are
+// constructed directly rather than through `allocator_traits::construct`.
+//
+// Growth relocates elements with `memcpy` when `T` is trivially relocatable
+// (in particular, when it is trivially copyable); see
+// `slb::is_trivially_relocatable`.
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+class small_vector : private detail::small_vector_allocator<Allocator>,
+                     private detail::small_vector_buffer<T, N> {
+  using alloc_base = detail::small_vector_allocator<Allocator>;
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  static_assert(std::is_same<typename alloc_traits::pointer, T*>::value,
+                "`small_vector` does not support fancy pointers.");
+
+public:
+  // types
+  using value_type = T;
+  using allocator_type = Allocator;
+  using pointer = T*;
+  using const_pointer = T const*;
+  using reference = value_type&;
+  using const_reference = value_type const&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = T*;
+  using const_iterator = T const*;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // construct/copy/destroy
+  small_vector() noexcept(noexcept(Allocator()))
+      : small_vector(Allocator()) {}
+
+  explicit small_vector(Allocator const& alloc) noexcept : alloc_base(alloc) {
+    reset();
+  }
+
+  explicit small_vector(size_type n, Allocator const& alloc = Allocator())
+      : small_vector(alloc) {
+    resize(n);
+  }
+
+  small_vector(size_type n,
+               T const& value,
+               Allocator const& alloc = Allocator())
+      : small_vector(alloc) {
+    assign(n, value);
+  }
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  small_vector(InputIt first,
+               InputIt last,
+               Allocator const& alloc = Allocator())
+      : small_vector(alloc) {
+    assign(first, last);
+  }
+
+  small_vector(small_vector const& other)
+      : small_vector(alloc_traits::select_on_container_copy_construction(
+            other.get_allocator())) {
+    assign(other.begin(), other.end());
+  }
+
+  small_vector(small_vector const& other, Allocator const& alloc)
+      : small_vector(alloc) {
+    assign(other.begin(), other.end());
+  }
+
+  small_vector(small_vector&& other) noexcept(
+      slb::is_trivially_relocatable<T>::value ||
+      std::is_nothrow_move_constructible<T>::value)
+      : small_vector(std::move(other.allocator())) {
+    steal(other);
+  }
+
+  small_vector(std::initializer_list<T> il,
+               Allocator const& alloc = Allocator())
+      : small_vector(il.begin(), il.end(), alloc) {}
+
+  ~small_vector() {
+    slb::destroy(begin(), end());
+    deallocate();
+  }
+
+  small_vector& operator=(small_vector const& other) {
+    if (this != &other) {
+      if (alloc_traits::propagate_on_container_copy_assignment::value) {
+        if (this->allocator() != other.allocator()) {
+          clear();
+          deallocate();
+          reset();
+        }
+        this->allocator() = other.allocator();
+      }
+      assign(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  small_vector& operator=(small_vector&& other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value &&
+      (slb::is_trivially_relocatable<T>::value ||
+       std::is_nothrow_move_constructible<T>::value)) {
+    if (this != &other) {
+      bool const equal = this->allocator() == other.allocator();
+      if (alloc_traits::propagate_on_container_move_assignment::value ||
+          equal) {
+        clear();
+        // Inline elements can be relocated into the storage we already have.
+        if (!other.is_inline() || !equal) {
+          deallocate();
+          reset();
+        }
+        if (alloc_traits::propagate_on_container_move_assignment::value) {
+          this->allocator() = std::move(other.allocator());
+        }
+        steal(other);
+      } else {
+        assign(std::make_move_iterator(other.begin()),
+               std::make_move_iterator(other.end()));
+        other.clear();
+      }
+    }
+    return *this;
+  }
+
+  small_vector& operator=(std::initializer_list<T> il) {
+    assign(il.begin(), il.end());
+    return *this;
+  }
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  void assign(InputIt first, InputIt last) {
+    assign(first, last, detail::is_forward_iterator<InputIt>{});
+  }
+
+  void assign(size_type n, T const& value) {
+    if (n > capacity_) {
+      clear();
+      reallocate(grow_capacity(n));
+    }
+    if (n <= size_) {
+      std::fill_n(data_, n, value);
+      slb::destroy(data_ + n, data_ + size_);
+    } else {
+      std::fill_n(data_, size_, value);
+      std::uninitialized_fill_n(data_ + size_, n - size_, value);
+    }
+    size_ = n;
+  }
+
+  void assign(std::initializer_list<T> il) { assign(il.begin(), il.end()); }
+
+  allocator_type get_allocator() const noexcept { return this->allocator(); }
+
+  // iterators
+  iterator begin() noexcept { return data_; }
+  const_iterator begin() const noexcept { return data_; }
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  // capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return (std::min)(alloc_traits::max_size(this->allocator()),
+                      static_cast<size_type>(
+                          std::numeric_limits<difference_type>::max()));
+  }
+  size_type capacity() const noexcept { return capacity_; }
+
+  // Whether the elements are stored within the object itself. Allocated
+  // storage always has room for more than `N` elements.
+  bool is_inline() const noexcept { return capacity_ == N; }
+
+  void resize(size_type n) {
+    if (n <= size_) {
+      erase(begin() + n, end());
+    } else {
+      if (n > capacity_) {
+        reallocate(grow_capacity(n));
+      }
+      slb::uninitialized_value_construct_n(end(), n - size_);
+      size_ = n;
+    }
+  }
+
+  void resize(size_type n, T const& value) {
+    if (n <= size_) {
+      erase(begin() + n, end());
+    } else {
+      insert(end(), n - size_, value);
+    }
+  }
+
+  void reserve(size_type n) {
+    if (n > capacity_) {
+      reallocate(checked_capacity(n));
+    }
+  }
+
+  void shrink_to_fit() {
+    if (!is_inline() && size_ < capacity_) {
+      reallocate((std::max)(size_, N));
+    }
+  }
+
+  // element access
+  reference operator[](size_type n) { return data_[n]; }
+  const_reference operator[](size_type n) const { return data_[n]; }
+
+  reference at(size_type n) {
+    if (n >= size_) {
+      throw std::out_of_range("slb::small_vector::at");
+    }
+    return data_[n];
+  }
+
+  const_reference at(size_type n) const {
+    if (n >= size_) {
+      throw std::out_of_range("slb::small_vector::at");
+    }
+    return data_[n];
+  }
+
+  reference front() { return data_[0]; }
+  const_reference front() const { return data_[0]; }
+  reference back() { return data_[size_ - 1]; }
+  const_reference back() const { return data_[size_ - 1]; }
+
+  // data access
+  T* data() noexcept { return data_; }
+  T const* data() const noexcept { return data_; }
+
+  // modifiers
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      return *realloc_insert(size_, 1, [&](T* p) {
+        ::new (detail::voidify_ptr(p)) T(std::forward<Args>(args)...);
+      });
+    }
+    T* const p = data_ + size_;
+    ::new (detail::voidify_ptr(p)) T(std::forward<Args>(args)...);
+    ++size_;
+    return *p;
+  }
+
+  void push_back(T const& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void pop_back() {
+    --size_;
+    slb::destroy_at(data_ + size_);
+  }
+
+  template <typename... Args>
+  iterator emplace(const_iterator position, Args&&... args) {
+    size_type const index = static_cast<size_type>(position - cbegin());
+    if (size_ == capacity_) {
+      return realloc_insert(index, 1, [&](T* p) {
+        ::new (detail::voidify_ptr(p)) T(std::forward<Args>(args)...);
+      });
+    }
+    if (index == size_) {
+      return std::addressof(emplace_back(std::forward<Args>(args)...));
+    }
+    // The arguments may refer to an element that is about to be shifted.
+    T value(std::forward<Args>(args)...);
+    T* const p = data_ + index;
+    ::new (detail::voidify_ptr(end())) T(std::move(back()));
+    ++size_;
+    std::move_backward(p, end() - 2, end() - 1);
+    *p = std::move(value);
+    return p;
+  }
+
+  iterator insert(const_iterator position, T const& value) {
+    return emplace(position, value);
+  }
+
+  iterator insert(const_iterator position, T&& value) {
+    return emplace(position, std::move(value));
+  }
+
+  iterator insert(const_iterator position, size_type n, T const& value) {
+    size_type const index = static_cast<size_type>(position - cbegin());
+    if (n > capacity_ - size_) {
+      return realloc_insert(index, n, [&](T* p) {
+        std::uninitialized_fill_n(p, n, value);
+      });
+    }
+    size_type const size = size_;
+    std::uninitialized_fill_n(end(), n, value);
+    size_ += n;
+    std::rotate(begin() + index, begin() + size, end());
+    return begin() + index;
+  }
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  iterator insert(const_iterator position, InputIt first, InputIt last) {
+    return insert(position, first, last,
+                  detail::is_forward_iterator<InputIt>{});
+  }
+
+  iterator insert(const_iterator position, std::initializer_list<T> il) {
+    return insert(position, il.begin(), il.end());
+  }
+
+  iterator erase(const_iterator position) {
+    return erase(position, position + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    iterator const p = begin() + (first - cbegin());
+    if (first != last) {
+      iterator const new_end = std::move(begin() + (last - cbegin()), end(), p);
+      slb::destroy(new_end, end());
+      size_ = static_cast<size_type>(new_end - begin());
+    }
+    return p;
+  }
+
+  void clear() noexcept {
+    slb::destroy(begin(), end());
+    size_ = 0;
+  }
+
+  void swap(small_vector& other) noexcept(
+      slb::is_trivially_relocatable<T>::value ||
+      std::is_nothrow_move_constructible<T>::value) {
+    if (this == &other) {
+      return;
+    }
+    if (alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(this->allocator(), other.allocator());
+    }
+    if (!is_inline() && !other.is_inline()) {
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+      return;
+    }
+    small_vector* const a = is_inline() ? this : &other;
+    small_vector* const b = is_inline() ? &other : this;
+    // `a` stores its elements inline; park them while `b`'s move over.
+    small_vector tmp(a->allocator());
+    tmp.steal(*a);
+    a->steal(*b);
+    b->steal(tmp);
+  }
+
+private:
+  // Takes over the elements of `other`, leaving it empty. This vector must be
+  // empty and the allocators must compare equal.
+  void steal(small_vector& other) {
+    if (other.is_inline()) {
+      size_type const n = other.size_;
+      other.size_ = 0;
+      slb::uninitialized_relocate(other.data_, other.data_ + n, data_);
+      size_ = n;
+    } else {
+      data_ = other.data_;
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+      other.reset();
+    }
+  }
+
+  // Returns to the inline buffer; the elements must have been destroyed or
+  // relocated, and any allocated storage released.
+  void reset() noexcept {
+    data_ = this->inline_data();
+    size_ = 0;
+    capacity_ = N;
+  }
+
+  void deallocate() noexcept {
+    if (!is_inline()) {
+      alloc_traits::deallocate(this->allocator(), data_, capacity_);
+    }
+  }
+
+  size_type checked_capacity(size_type n) const {
+    if (n > max_size()) {
+      throw std::length_error("slb::small_vector");
+    }
+    return n;
+  }
+
+  // Geometric growth, to at least `n`.
+  size_type grow_capacity(size_type n) const {
+    checked_capacity(n);
+    size_type const max = max_size();
+    if (capacity_ > max / 2) {
+      return max;
+    }
+    return (std::max)(capacity_ * 2, n);
+  }
+
+  // Moves the elements in `[first, last)` into uninitialized storage at
+  // `d_first`, leaving the sources to be disposed of by `release`.
+  static void transfer(std::true_type, T* first, T* last, T* d_first) noexcept {
+    slb::uninitialized_relocate(first, last, d_first);
+  }
+
+  static void transfer(std::false_type, T* first, T* last, T* d_first) {
+    using It = detail::small_vector_move_if_noexcept_iterator<T>;
+    slb::uninitialized_copy(It(first), It(last), d_first);
+  }
+
+  static void release(std::true_type, T*, T*) noexcept {}
+
+  static void release(std::false_type, T* first, T* last) noexcept {
+    slb::destroy(first, last);
+  }
+
+  using relocatable =
+      slb::bool_constant<detail::is_memmove_relocatable<T*, T*>::value>;
+
+  // Moves the elements to storage for `new_capacity` elements, which is the
+  // inline buffer if it fits.
+  void reallocate(size_type new_capacity) {
+    T* const new_data = new_capacity <= N
+                            ? this->inline_data()
+                            : alloc_traits::allocate(this->allocator(),
+                                                     new_capacity);
+    if (new_data == data_) {
+      return;
+    }
+    try {
+      transfer(relocatable{}, begin(), end(), new_data);
+    } catch (...) {
+      if (new_capacity > N) {
+        alloc_traits::deallocate(this->allocator(), new_data, new_capacity);
+      }
+      throw;
+    }
+    release(relocatable{}, begin(), end());
+    deallocate();
+    data_ = new_data;
+    capacity_ = (std::max)(new_capacity, N);
+  }
+
+  // Grows the storage to make room for `n` new elements at `index`, which are
+  // constructed by `construct(p)` before the existing elements are moved so
+  // that its arguments may still refer to them.
+  template <typename Construct>
+  T* realloc_insert(size_type index, size_type n, Construct construct) {
+    size_type const new_capacity = grow_capacity(size_ + n);
+    T* const new_data =
+        alloc_traits::allocate(this->allocator(), new_capacity);
+    T* const gap = new_data + index;
+    T* const mid = data_ + index;
+    try {
+      construct(gap);
+      try {
+        transfer(relocatable{}, data_, mid, new_data);
+        try {
+          transfer(relocatable{}, mid, end(), gap + n);
+        } catch (...) {
+          slb::destroy(new_data, gap);
+          throw;
+        }
+      } catch (...) {
+        slb::destroy(gap, gap + n);
+        throw;
+      }
+    } catch (...) {
+      alloc_traits::deallocate(this->allocator(), new_data, new_capacity);
+      throw;
+    }
+    release(relocatable{}, begin(), end());
+    deallocate();
+    data_ = new_data;
+    size_ += n;
+    capacity_ = new_capacity;
+    return gap;
+  }
+
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last, std::false_type) {
+    clear();
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+
+  template <typename ForwardIt>
+  void assign(ForwardIt first, ForwardIt last, std::true_type) {
+    size_type const n = static_cast<size_type>(std::distance(first, last));
+    if (n > capacity_) {
+      clear();
+      reallocate(grow_capacity(n));
+    }
+    if (n <= size_) {
+      slb::destroy(std::copy(first, last, data_), end());
+    } else {
+      ForwardIt mid = std::next(first, static_cast<difference_type>(size_));
+      std::copy(first, mid, data_);
+      slb::uninitialized_copy(mid, last, end());
+    }
+    size_ = n;
+  }
+
+  template <typename InputIt>
+  iterator insert(const_iterator position,
+                  InputIt first,
+                  InputIt last,
+                  std::false_type) {
+    size_type const index = static_cast<size_type>(position - cbegin());
+    size_type const size = size_;
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+    std::rotate(begin() + index, begin() + size, end());
+    return begin() + index;
+  }
+
+  template <typename ForwardIt>
+  iterator insert(const_iterator position,
+                  ForwardIt first,
+                  ForwardIt last,
+                  std::true_type) {
+    size_type const index = static_cast<size_type>(position - cbegin());
+    size_type const n = static_cast<size_type>(std::distance(first, last));
+    if (n > capacity_ - size_) {
+      return realloc_insert(index, n, [&](T* p) {
+        slb::uninitialized_copy(first, last, p);
+      });
+    }
+    size_type const size = size_;
+    slb::uninitialized_copy(first, last, end());
+    size_ += n;
+    std::rotate(begin() + index, begin() + size, end());
+    return begin() + index;
+  }
+
+  T* data_;
+  size_type size_;
+  size_type capacity_;
+};
+
+template <typename T, std::size_t N, typename Allocator>
+bool operator==(small_vector<T, N, Allocator> const& lhs,
+                small_vector<T, N, Allocator> const& rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, std::size_t N, typename Allocator>
+bool operator!=(small_vector<T, N, Allocator> const& lhs,
+                small_vector<T, N, Allocator> const& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T, std::size_t N, typename Allocator>
+bool operator<(small_vector<T, N, Allocator> const& lhs,
+               small_vector<T, N, Allocator> const& rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                      rhs.end());
+}
+
+template <typename T, std::size_t N, typename Allocator>
+bool operator>(small_vector<T, N, Allocator> const& lhs,
+               small_vector<T, N, Allocator> const& rhs) {
+  return rhs < lhs;
+}
+
+template <typename T, std::size_t N, typename Allocator>
+bool operator<=(small_vector<T, N, Allocator> const& lhs,
+                small_vector<T, N, Allocator> const& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename T, std::size_t N, typename Allocator>
+bool operator>=(small_vector<T, N, Allocator> const& lhs,
+                small_vector<T, N, Allocator> const& rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename T, std::size_t N, typename Allocator>
+void swap(small_vector<T, N, Allocator>& lhs,
+          small_vector<T, N, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+// erasure
+template <typename T, std::size_t N, typename Allocator, typename U>
+typename small_vector<T, N, Allocator>::size_type erase(
+    small_vector<T, N, Allocator>& c, U const& value) {
+  auto const it = std::remove(c.begin(), c.end(), value);
+  auto const r = static_cast<std::size_t>(c.end() - it);
+  c.erase(it, c.end());
+  return r;
+}
+
+template <typename T, std::size_t N, typename Allocator, typename Predicate>
+typename small_vector<T, N, Allocator>::size_type erase_if(
+    small_vector<T, N, Allocator>& c, Predicate pred) {
+  auto const it = std::remove_if(c.begin(), c.end(), pred);
+  auto const r = static_cast<std::size_t>(c.end() - it);
+  c.erase(it, c.end());
+  return r;
+}
+
+} // namespace slb
+
+#endif // SLB_SMALL_VECTOR_HPP
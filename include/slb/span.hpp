@@ -0,0 +1,402 @@
+/*
+  SLB.Span
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_SPAN_HPP
+#define SLB_SPAN_HPP
+
+/*
+
+Header <span> synopsis [span.syn]
+
+namespace std {
+  // constants
+  inline constexpr size_t dynamic_extent = numeric_limits<size_t>::max();
+
+  // [views.span], class template span
+  template<class ElementType, size_t Extent = dynamic_extent>
+    class span;
+
+  // [span.objectrep], views of object representation
+  template<class ElementType, size_t Extent>
+    span<const byte, Extent == dynamic_extent ? dynamic_extent
+                                              : sizeof(ElementType) * Extent>
+      as_bytes(span<ElementType, Extent> s) noexcept;
+
+  template<class ElementType, size_t Extent>
+    span<byte, Extent == dynamic_extent ? dynamic_extent
+                                        : sizeof(ElementType) * Extent>
+      as_writable_bytes(span<ElementType, Extent> s) noexcept;
+}
+
+*/
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "detail/config.hpp"
+#include "detail/lib.hpp"
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+namespace slb {
+
+#if __cpp_lib_span >= 202002L // C++20
+using std::dynamic_extent;
+using std::span;
+using std::as_bytes;
+using std::as_writable_bytes;
+#else
+SLB_CXX17_INLINE_VARIABLE constexpr std::size_t dynamic_extent =
+    std::numeric_limits<std::size_t>::max();
+
+template <typename T, std::size_t Extent = dynamic_extent>
+class span;
+
+namespace detail {
+
+// The size of a span with a static extent is part of its type, so only the
+// pointer is stored.
+template <typename T, std::size_t Extent>
+class span_storage {
+public:
+  constexpr span_storage(T* data, std::size_t) noexcept : data_(data) {}
+
+  constexpr T* data() const noexcept { return data_; }
+  constexpr std::size_t size() const noexcept { return Extent; }
+
+private:
+  T* data_;
+};
+
+template <typename T>
+class span_storage<T, dynamic_extent> {
+public:
+  constexpr span_storage(T* data, std::size_t size) noexcept
+      : data_(data), size_(size) {}
+
+  constexpr T* data() const noexcept { return data_; }
+  constexpr std::size_t size() const noexcept { return size_; }
+
+private:
+  T* data_;
+  std::size_t size_;
+};
+
+template <typename T>
+struct is_span : std::false_type {};
+
+template <typename T, std::size_t Extent>
+struct is_span<span<T, Extent>> : std::true_type {};
+
+template <typename T>
+struct is_std_array : std::false_type {};
+
+template <typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+// Only qualification conversions are allowed between element types.
+template <typename From, typename To>
+struct is_span_convertible
+    : std::is_convertible<From (*)[], To (*)[]> {};
+
+template <typename R>
+using range_data_t = decltype(std::declval<R&>().data());
+
+// A contiguous sized range is approximated by the presence of `data()` and
+// `size()` members.
+template <typename R, typename T, typename = void>
+struct is_span_compatible_range : std::false_type {};
+
+template <typename R, typename T>
+struct is_span_compatible_range<
+    R,
+    T,
+    typename lib::always_void<decltype(
+        (void)std::declval<R&>().data(), std::declval<R&>().size())>::type>
+    : std::integral_constant<
+          bool,
+          !is_span<typename lib::remove_cvref<R>::type>::value &&
+              !is_std_array<typename lib::remove_cvref<R>::type>::value &&
+              !std::is_array<typename lib::remove_cvref<R>::type>::value &&
+              std::is_pointer<range_data_t<R>>::value &&
+              is_span_convertible<
+                  typename std::remove_pointer<range_data_t<R>>::type,
+                  T>::value &&
+              (std::is_lvalue_reference<R>::value || std::is_const<T>::value)> {
+};
+
+template <std::size_t Extent, std::size_t Offset, std::size_t Count>
+struct subspan_extent
+    : std::integral_constant<std::size_t,
+                             Count != dynamic_extent
+                                 ? Count
+                                 : Extent != dynamic_extent ? Extent - Offset
+                                                            : dynamic_extent> {
+};
+
+} // namespace detail
+
+// [views.span], class template span
+
+template <typename T, std::size_t Extent>
+class span {
+  template <std::size_t E>
+  using if_dynamic =
+      typename std::enable_if<E == dynamic_extent, int>::type;
+
+  template <std::size_t E>
+  using if_static =
+      typename std::enable_if<E != dynamic_extent, int>::type;
+
+public:
+  // constants and types
+  using element_type = T;
+  using value_type = typename std::remove_cv<T>::type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = pointer;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  static constexpr size_type extent = Extent;
+
+  // [span.cons], constructors, copy, and assignment
+  template <std::size_t E = Extent,
+            typename std::enable_if<E == 0 || E == dynamic_extent, int>::type =
+                0>
+  constexpr span() noexcept : storage_(nullptr, 0) {}
+
+  template <typename U,
+            typename std::enable_if<
+                detail::is_span_convertible<U, T>::value, int>::type = 0,
+            std::size_t E = Extent,
+            if_dynamic<E> = 0>
+  constexpr span(U* first, size_type count) : storage_(first, count) {}
+
+  template <typename U,
+            typename std::enable_if<
+                detail::is_span_convertible<U, T>::value, int>::type = 0,
+            std::size_t E = Extent,
+            if_static<E> = 0>
+  constexpr explicit span(U* first, size_type count)
+      : storage_(first, count) {}
+
+  template <typename U,
+            typename std::enable_if<
+                detail::is_span_convertible<U, T>::value, int>::type = 0,
+            std::size_t E = Extent,
+            if_dynamic<E> = 0>
+  constexpr span(U* first, U* last)
+      : storage_(first, static_cast<size_type>(last - first)) {}
+
+  template <typename U,
+            typename std::enable_if<
+                detail::is_span_convertible<U, T>::value, int>::type = 0,
+            std::size_t E = Extent,
+            if_static<E> = 0>
+  constexpr explicit span(U* first, U* last)
+      : storage_(first, static_cast<size_type>(last - first)) {}
+
+  template <std::size_t N,
+            typename std::enable_if<Extent == dynamic_extent || N == Extent,
+                                    int>::type = 0>
+  constexpr span(element_type (&arr)[N]) noexcept : storage_(arr, N) {}
+
+  template <typename U,
+            std::size_t N,
+            typename std::enable_if<
+                (Extent == dynamic_extent || N == Extent) &&
+                    detail::is_span_convertible<U, T>::value,
+                int>::type = 0>
+  constexpr span(std::array<U, N>& arr) noexcept
+      : storage_(arr.data(), N) {}
+
+  template <typename U,
+            std::size_t N,
+            typename std::enable_if<
+                (Extent == dynamic_extent || N == Extent) &&
+                    detail::is_span_convertible<const U, T>::value,
+                int>::type = 0>
+  constexpr span(std::array<U, N> const& arr) noexcept
+      : storage_(arr.data(), N) {}
+
+  template <typename R,
+            typename std::enable_if<
+                detail::is_span_compatible_range<R, T>::value, int>::type = 0,
+            std::size_t E = Extent,
+            if_dynamic<E> = 0>
+  constexpr span(R&& r) : storage_(r.data(), r.size()) {}
+
+  template <typename R,
+            typename std::enable_if<
+                detail::is_span_compatible_range<R, T>::value, int>::type = 0,
+            std::size_t E = Extent,
+            if_static<E> = 0>
+  constexpr explicit span(R&& r) : storage_(r.data(), r.size()) {}
+
+  constexpr span(span const& other) noexcept = default;
+
+  template <typename U,
+            std::size_t N,
+            typename std::enable_if<
+                (Extent == dynamic_extent || N == Extent) &&
+                    detail::is_span_convertible<U, T>::value,
+                int>::type = 0>
+  constexpr span(span<U, N> const& s) noexcept
+      : storage_(s.data(), s.size()) {}
+
+  template <typename U,
+            std::size_t N,
+            typename std::enable_if<
+                Extent != dynamic_extent && N == dynamic_extent &&
+                    detail::is_span_convertible<U, T>::value,
+                int>::type = 0>
+  constexpr explicit span(span<U, N> const& s) noexcept
+      : storage_(s.data(), s.size()) {}
+
+  span& operator=(span const& other) noexcept = default;
+
+  // [span.sub], subviews
+  template <std::size_t Count>
+  constexpr span<element_type, Count> first() const {
+    static_assert(Extent == dynamic_extent || Count <= Extent,
+                  "`Count` shall not exceed `Extent`.");
+    return span<element_type, Count>(data(), Count);
+  }
+
+  template <std::size_t Count>
+  constexpr span<element_type, Count> last() const {
+    static_assert(Extent == dynamic_extent || Count <= Extent,
+                  "`Count` shall not exceed `Extent`.");
+    return span<element_type, Count>(data() + (size() - Count), Count);
+  }
+
+  template <std::size_t Offset, std::size_t Count = dynamic_extent>
+  constexpr span<element_type,
+                 detail::subspan_extent<Extent, Offset, Count>::value>
+  subspan() const {
+    static_assert(Extent == dynamic_extent || Offset <= Extent,
+                  "`Offset` shall not exceed `Extent`.");
+    static_assert(Extent == dynamic_extent || Count == dynamic_extent ||
+                      Count <= Extent - Offset,
+                  "`Count` shall not exceed `Extent - Offset`.");
+    return span<element_type,
+                detail::subspan_extent<Extent, Offset, Count>::value>(
+        data() + Offset, Count != dynamic_extent ? Count : size() - Offset);
+  }
+
+  constexpr span<element_type, dynamic_extent> first(size_type count) const {
+    return span<element_type, dynamic_extent>(data(), count);
+  }
+
+  constexpr span<element_type, dynamic_extent> last(size_type count) const {
+    return span<element_type, dynamic_extent>(data() + (size() - count),
+                                              count);
+  }
+
+  constexpr span<element_type, dynamic_extent> subspan(
+      size_type offset, size_type count = dynamic_extent) const {
+    return span<element_type, dynamic_extent>(
+        data() + offset, count != dynamic_extent ? count : size() - offset);
+  }
+
+  // [span.obs], observers
+  constexpr size_type size() const noexcept { return storage_.size(); }
+  constexpr size_type size_bytes() const noexcept {
+    return size() * sizeof(element_type);
+  }
+  constexpr bool empty() const noexcept { return size() == 0; }
+
+  // [span.elem], element access
+  constexpr reference operator[](size_type idx) const { return data()[idx]; }
+  constexpr reference front() const { return data()[0]; }
+  constexpr reference back() const { return data()[size() - 1]; }
+  constexpr pointer data() const noexcept { return storage_.data(); }
+
+  // [span.iterators], iterator support
+  constexpr iterator begin() const noexcept { return data(); }
+  constexpr iterator end() const noexcept { return data() + size(); }
+  reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+private:
+  detail::span_storage<T, Extent> storage_;
+};
+
+template <typename T, std::size_t Extent>
+constexpr typename span<T, Extent>::size_type span<T, Extent>::extent;
+
+#if __cpp_deduction_guides
+template <typename T, typename EndOrSize>
+span(T*, EndOrSize) -> span<T>;
+
+template <typename T, std::size_t N>
+span(T (&)[N]) -> span<T, N>;
+
+template <typename T, std::size_t N>
+span(std::array<T, N>&) -> span<T, N>;
+
+template <typename T, std::size_t N>
+span(std::array<T, N> const&) -> span<const T, N>;
+
+template <typename R>
+span(R&&) -> span<typename std::remove_pointer<
+    decltype(std::declval<R&>().data())>::type>;
+#endif
+
+// [span.objectrep], views of object representation
+
+namespace detail {
+
+#if __cpp_lib_byte // C++17
+using span_byte = std::byte;
+#else
+using span_byte = unsigned char;
+#endif
+
+template <typename T, std::size_t Extent>
+struct bytes_extent
+    : std::integral_constant<std::size_t,
+                             Extent == dynamic_extent ? dynamic_extent
+                                                      : sizeof(T) * Extent> {
+};
+
+} // namespace detail
+
+// Without `std::byte`, the object representation is viewed as a span of
+// `unsigned char`.
+template <typename T, std::size_t Extent>
+span<const detail::span_byte, detail::bytes_extent<T, Extent>::value> as_bytes(
+    span<T, Extent> s) noexcept {
+  return span<const detail::span_byte, detail::bytes_extent<T, Extent>::value>(
+      reinterpret_cast<const detail::span_byte*>(s.data()), s.size_bytes());
+}
+
+template <typename T, std::size_t Extent>
+typename std::enable_if<
+    !std::is_const<T>::value,
+    span<detail::span_byte, detail::bytes_extent<T, Extent>::value>>::type
+as_writable_bytes(span<T, Extent> s) noexcept {
+  return span<detail::span_byte, detail::bytes_extent<T, Extent>::value>(
+      reinterpret_cast<detail::span_byte*>(s.data()), s.size_bytes());
+}
+#endif
+
+} // namespace slb
+
+#endif // SLB_SPAN_HPP
@@ -0,0 +1,861 @@
+/*
+  SLB.StringView
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_STRING_VIEW_HPP
+#define SLB_STRING_VIEW_HPP
+
+/*
+
+Header <string_view> synopsis [string.view.synop]
+
+namespace std {
+  // [string.view.template], class template basic_string_view
+  template<class charT, class traits = char_traits<charT>>
+  class basic_string_view;
+
+  // [string.view.comparison], non-member comparison functions
+  template<class charT, class traits>
+    constexpr bool operator==(basic_string_view<charT, traits> x,
+                              basic_string_view<charT, traits> y) noexcept;
+  template<class charT, class traits>
+    constexpr bool operator!=(basic_string_view<charT, traits> x,
+                              basic_string_view<charT, traits> y) noexcept;
+  template<class charT, class traits>
+    constexpr bool operator< (basic_string_view<charT, traits> x,
+                              basic_string_view<charT, traits> y) noexcept;
+  template<class charT, class traits>
+    constexpr bool operator> (basic_string_view<charT, traits> x,
+                              basic_string_view<charT, traits> y) noexcept;
+  template<class charT, class traits>
+    constexpr bool operator<=(basic_string_view<charT, traits> x,
+                              basic_string_view<charT, traits> y) noexcept;
+  template<class charT, class traits>
+    constexpr bool operator>=(basic_string_view<charT, traits> x,
+                              basic_string_view<charT, traits> y) noexcept;
+  // see [string.view.comparison], sufficient additional overloads of
+  // comparison functions
+
+  // [string.view.io], inserters and extractors
+  template<class charT, class traits>
+    basic_ostream<charT, traits>&
+      operator<<(basic_ostream<charT, traits>& os,
+                 basic_string_view<charT, traits> str);
+
+  // basic_string_view typedef names
+  using string_view    = basic_string_view<char>;
+  using u16string_view = basic_string_view<char16_t>;
+  using u32string_view = basic_string_view<char32_t>;
+  using wstring_view   = basic_string_view<wchar_t>;
+
+  // [string.view.hash], hash support
+  template<class T> struct hash;
+  template<> struct hash<string_view>;
+  template<> struct hash<u16string_view>;
+  template<> struct hash<u32string_view>;
+  template<> struct hash<wstring_view>;
+}
+
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "detail/config.hpp"
+#include "detail/lib.hpp"
+
+#if __has_include(<string_view>)
+#include <string_view>
+#endif
+
+namespace slb {
+
+#if __cpp_lib_string_view // C++17
+using std::basic_string_view;
+using std::string_view;
+using std::u16string_view;
+using std::u32string_view;
+using std::wstring_view;
+#else
+namespace detail {
+namespace sv {
+
+// The `char_traits` operations other than `eq`, `lt` and `assign` are only
+// constexpr since C++17. They are replaced by plain loops in constant
+// evaluations, and used otherwise, since for the standard character types they
+// are `strlen`, `memcmp` and `memchr`, which the C library vectorizes.
+
+template <typename Traits, typename CharT>
+constexpr std::size_t constant_length(const CharT* s,
+                                      std::size_t n = 0) noexcept {
+  return Traits::eq(s[n], CharT()) ? n
+                                   : sv::constant_length<Traits>(s, n + 1);
+}
+
+template <typename Traits, typename CharT>
+constexpr std::size_t length(const CharT* s) noexcept {
+  return lib::is_constant_evaluated() ? sv::constant_length<Traits>(s)
+                                      : Traits::length(s);
+}
+
+template <typename Traits, typename CharT>
+SLB_CXX14_CONSTEXPR int compare(const CharT* s1,
+                                const CharT* s2,
+                                std::size_t n) noexcept {
+  if (lib::is_constant_evaluated()) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (Traits::lt(s1[i], s2[i])) {
+        return -1;
+      }
+      if (Traits::lt(s2[i], s1[i])) {
+        return 1;
+      }
+    }
+    return 0;
+  }
+  return n == 0 ? 0 : Traits::compare(s1, s2, n);
+}
+
+template <typename Traits, typename CharT>
+SLB_CXX14_CONSTEXPR const CharT* find(const CharT* s,
+                                      std::size_t n,
+                                      CharT c) noexcept {
+  if (lib::is_constant_evaluated()) {
+    for (; n != 0; --n, ++s) {
+      if (Traits::eq(*s, c)) {
+        return s;
+      }
+    }
+    return nullptr;
+  }
+  return n == 0 ? nullptr : Traits::find(s, n, c);
+}
+
+// A set of characters for the `find_*_of` family, searched linearly.
+template <typename Traits, typename CharT>
+class char_list {
+public:
+  constexpr char_list(const CharT* s, std::size_t n) noexcept : s_(s), n_(n) {}
+
+  SLB_CXX14_CONSTEXPR bool contains(CharT c) const noexcept {
+    return sv::find<Traits>(s_, n_, c) != nullptr;
+  }
+
+private:
+  const CharT* s_;
+  std::size_t n_;
+};
+
+// With `std::char_traits<char>`, characters are compared as `unsigned char`,
+// so the set fits in a 256-bit table.
+class char_bitmap {
+public:
+  SLB_CXX14_CONSTEXPR char_bitmap(const char* s, std::size_t n) noexcept
+      : words_{} {
+    for (std::size_t i = 0; i < n; ++i) {
+      unsigned char const u = static_cast<unsigned char>(s[i]);
+      words_[u / 64] |= std::uint64_t(1) << (u % 64);
+    }
+  }
+
+  SLB_CXX14_CONSTEXPR bool contains(char c) const noexcept {
+    return ((words_[static_cast<unsigned char>(c) / 64] >>
+             (static_cast<unsigned char>(c) % 64)) &
+            1) != 0;
+  }
+
+private:
+  std::uint64_t words_[4];
+};
+
+template <typename Traits, typename CharT>
+using char_set = typename std::conditional<
+    std::is_same<Traits, std::char_traits<char>>::value,
+    char_bitmap,
+    char_list<Traits, CharT>>::type;
+
+template <typename Set, typename CharT>
+SLB_CXX14_CONSTEXPR std::size_t find_first(const CharT* s,
+                                           std::size_t n,
+                                           Set const& set,
+                                           bool in_set,
+                                           std::size_t pos) noexcept {
+  for (; pos < n; ++pos) {
+    if (set.contains(s[pos]) == in_set) {
+      return pos;
+    }
+  }
+  return std::size_t(-1);
+}
+
+template <typename Set, typename CharT>
+SLB_CXX14_CONSTEXPR std::size_t find_last(const CharT* s,
+                                          std::size_t n,
+                                          Set const& set,
+                                          bool in_set,
+                                          std::size_t pos) noexcept {
+  if (n == 0) {
+    return std::size_t(-1);
+  }
+  if (pos >= n) {
+    pos = n - 1;
+  }
+  do {
+    if (set.contains(s[pos]) == in_set) {
+      return pos;
+    }
+  } while (pos-- != 0);
+  return std::size_t(-1);
+}
+
+} // namespace sv
+} // namespace detail
+
+// [string.view.template], class template basic_string_view
+
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_string_view {
+public:
+  // types
+  using traits_type = Traits;
+  using value_type = CharT;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using const_iterator = const value_type*;
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  static constexpr size_type npos = size_type(-1);
+
+  // [string.view.cons], construction and assignment
+  constexpr basic_string_view() noexcept : data_(nullptr), size_(0) {}
+  constexpr basic_string_view(basic_string_view const&) noexcept = default;
+  basic_string_view& operator=(basic_string_view const&) noexcept = default;
+  constexpr basic_string_view(const CharT* str)
+      : data_(str), size_(detail::sv::length<Traits>(str)) {}
+  constexpr basic_string_view(const CharT* str, size_type len)
+      : data_(str), size_(len) {}
+
+  // `std::basic_string` can't be given a conversion to `basic_string_view`,
+  // so the conversions in both directions are provided here.
+  template <typename Allocator>
+  basic_string_view(
+      std::basic_string<CharT, Traits, Allocator> const& str) noexcept
+      : data_(str.data()), size_(str.size()) {}
+
+  template <typename Allocator>
+  explicit operator std::basic_string<CharT, Traits, Allocator>() const {
+    return std::basic_string<CharT, Traits, Allocator>(data_, size_);
+  }
+
+  // [string.view.iterators], iterator support
+  constexpr const_iterator begin() const noexcept { return data_; }
+  constexpr const_iterator end() const noexcept { return data_ + size_; }
+  constexpr const_iterator cbegin() const noexcept { return data_; }
+  constexpr const_iterator cend() const noexcept { return data_ + size_; }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator crend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  // [string.view.capacity], capacity
+  constexpr size_type size() const noexcept { return size_; }
+  constexpr size_type length() const noexcept { return size_; }
+  constexpr size_type max_size() const noexcept {
+    return static_cast<size_type>(
+               std::numeric_limits<difference_type>::max()) /
+           sizeof(CharT);
+  }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  // [string.view.access], element access
+  constexpr const_reference operator[](size_type pos) const {
+    return data_[pos];
+  }
+  constexpr const_reference at(size_type pos) const {
+    return pos < size_ ? data_[pos]
+                       : (throw std::out_of_range("slb::basic_string_view::at"),
+                          data_[0]);
+  }
+  constexpr const_reference front() const { return data_[0]; }
+  constexpr const_reference back() const { return data_[size_ - 1]; }
+  constexpr const_pointer data() const noexcept { return data_; }
+
+  // [string.view.modifiers], modifiers
+  SLB_CXX14_CONSTEXPR void remove_prefix(size_type n) {
+    data_ += n;
+    size_ -= n;
+  }
+  SLB_CXX14_CONSTEXPR void remove_suffix(size_type n) { size_ -= n; }
+  SLB_CXX14_CONSTEXPR void swap(basic_string_view& s) noexcept {
+    const_pointer const data = data_;
+    data_ = s.data_;
+    s.data_ = data;
+    size_type const size = size_;
+    size_ = s.size_;
+    s.size_ = size;
+  }
+
+  // [string.view.ops], string operations
+  size_type copy(CharT* s, size_type n, size_type pos = 0) const {
+    if (pos > size_) {
+      throw std::out_of_range("slb::basic_string_view::copy");
+    }
+    size_type const rlen = n < size_ - pos ? n : size_ - pos;
+    if (rlen != 0) {
+      Traits::copy(s, data_ + pos, rlen);
+    }
+    return rlen;
+  }
+
+  constexpr basic_string_view substr(size_type pos = 0,
+                                     size_type n = npos) const {
+    return pos > size_
+               ? (throw std::out_of_range("slb::basic_string_view::substr"),
+                  basic_string_view())
+               : basic_string_view(data_ + pos,
+                                   n < size_ - pos ? n : size_ - pos);
+  }
+
+  SLB_CXX14_CONSTEXPR int compare(basic_string_view s) const noexcept {
+    int const r = detail::sv::compare<Traits>(
+        data_, s.data_, size_ < s.size_ ? size_ : s.size_);
+    return r != 0 ? r : size_ == s.size_ ? 0 : size_ < s.size_ ? -1 : 1;
+  }
+  SLB_CXX14_CONSTEXPR int compare(size_type pos1,
+                                  size_type n1,
+                                  basic_string_view s) const {
+    return substr(pos1, n1).compare(s);
+  }
+  SLB_CXX14_CONSTEXPR int compare(size_type pos1,
+                                  size_type n1,
+                                  basic_string_view s,
+                                  size_type pos2,
+                                  size_type n2) const {
+    return substr(pos1, n1).compare(s.substr(pos2, n2));
+  }
+  SLB_CXX14_CONSTEXPR int compare(const CharT* s) const {
+    return compare(basic_string_view(s));
+  }
+  SLB_CXX14_CONSTEXPR int compare(size_type pos1,
+                                  size_type n1,
+                                  const CharT* s) const {
+    return substr(pos1, n1).compare(basic_string_view(s));
+  }
+  SLB_CXX14_CONSTEXPR int compare(size_type pos1,
+                                  size_type n1,
+                                  const CharT* s,
+                                  size_type n2) const {
+    return substr(pos1, n1).compare(basic_string_view(s, n2));
+  }
+
+  SLB_CXX14_CONSTEXPR bool starts_with(basic_string_view x) const noexcept {
+    return size_ >= x.size_ &&
+           detail::sv::compare<Traits>(data_, x.data_, x.size_) == 0;
+  }
+  constexpr bool starts_with(CharT x) const noexcept {
+    return !empty() && Traits::eq(front(), x);
+  }
+  SLB_CXX14_CONSTEXPR bool starts_with(const CharT* x) const {
+    return starts_with(basic_string_view(x));
+  }
+  SLB_CXX14_CONSTEXPR bool ends_with(basic_string_view x) const noexcept {
+    return size_ >= x.size_ &&
+           detail::sv::compare<Traits>(
+               data_ + (size_ - x.size_), x.data_, x.size_) == 0;
+  }
+  constexpr bool ends_with(CharT x) const noexcept {
+    return !empty() && Traits::eq(back(), x);
+  }
+  SLB_CXX14_CONSTEXPR bool ends_with(const CharT* x) const {
+    return ends_with(basic_string_view(x));
+  }
+
+  SLB_CXX14_CONSTEXPR bool contains(basic_string_view x) const noexcept {
+    return find(x) != npos;
+  }
+  SLB_CXX14_CONSTEXPR bool contains(CharT x) const noexcept {
+    return find(x) != npos;
+  }
+  SLB_CXX14_CONSTEXPR bool contains(const CharT* x) const {
+    return find(x) != npos;
+  }
+
+  // [string.view.find], searching
+
+  // Candidate positions for the first character are found with
+  // `Traits::find`, and only those are compared in full.
+  SLB_CXX14_CONSTEXPR size_type find(basic_string_view s,
+                                     size_type pos = 0) const noexcept {
+    if (s.size_ == 0) {
+      return pos <= size_ ? pos : npos;
+    }
+    if (pos >= size_ || size_ - pos < s.size_) {
+      return npos;
+    }
+    const_pointer first = data_ + pos;
+    const_pointer const last = data_ + (size_ - s.size_ + 1);
+    for (;;) {
+      first = detail::sv::find<Traits>(
+          first, static_cast<size_type>(last - first), s.data_[0]);
+      if (first == nullptr) {
+        return npos;
+      }
+      if (detail::sv::compare<Traits>(
+              first + 1, s.data_ + 1, s.size_ - 1) == 0) {
+        return static_cast<size_type>(first - data_);
+      }
+      if (++first == last) {
+        return npos;
+      }
+    }
+  }
+  SLB_CXX14_CONSTEXPR size_type find(CharT c,
+                                     size_type pos = 0) const noexcept {
+    if (pos >= size_) {
+      return npos;
+    }
+    const_pointer const p =
+        detail::sv::find<Traits>(data_ + pos, size_ - pos, c);
+    return p != nullptr ? static_cast<size_type>(p - data_) : npos;
+  }
+  SLB_CXX14_CONSTEXPR size_type find(const CharT* s,
+                                     size_type pos,
+                                     size_type n) const {
+    return find(basic_string_view(s, n), pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find(const CharT* s,
+                                     size_type pos = 0) const {
+    return find(basic_string_view(s), pos);
+  }
+
+  SLB_CXX14_CONSTEXPR size_type rfind(basic_string_view s,
+                                      size_type pos = npos) const noexcept {
+    if (s.size_ > size_) {
+      return npos;
+    }
+    if (pos > size_ - s.size_) {
+      pos = size_ - s.size_;
+    }
+    do {
+      if (detail::sv::compare<Traits>(data_ + pos, s.data_, s.size_) == 0) {
+        return pos;
+      }
+    } while (pos-- != 0);
+    return npos;
+  }
+  SLB_CXX14_CONSTEXPR size_type rfind(CharT c,
+                                      size_type pos = npos) const noexcept {
+    if (size_ == 0) {
+      return npos;
+    }
+    if (pos >= size_) {
+      pos = size_ - 1;
+    }
+    do {
+      if (Traits::eq(data_[pos], c)) {
+        return pos;
+      }
+    } while (pos-- != 0);
+    return npos;
+  }
+  SLB_CXX14_CONSTEXPR size_type rfind(const CharT* s,
+                                      size_type pos,
+                                      size_type n) const {
+    return rfind(basic_string_view(s, n), pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type rfind(const CharT* s,
+                                      size_type pos = npos) const {
+    return rfind(basic_string_view(s), pos);
+  }
+
+  SLB_CXX14_CONSTEXPR size_type find_first_of(basic_string_view s,
+                                              size_type pos = 0) const
+      noexcept {
+    return s.size_ == 1
+               ? find(s.data_[0], pos)
+               : detail::sv::find_first(
+                     data_,
+                     size_,
+                     detail::sv::char_set<Traits, CharT>(s.data_, s.size_),
+                     true,
+                     pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_first_of(CharT c,
+                                              size_type pos = 0) const
+      noexcept {
+    return find(c, pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_first_of(const CharT* s,
+                                              size_type pos,
+                                              size_type n) const {
+    return find_first_of(basic_string_view(s, n), pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_first_of(const CharT* s,
+                                              size_type pos = 0) const {
+    return find_first_of(basic_string_view(s), pos);
+  }
+
+  SLB_CXX14_CONSTEXPR size_type find_last_of(basic_string_view s,
+                                             size_type pos = npos) const
+      noexcept {
+    return s.size_ == 1
+               ? rfind(s.data_[0], pos)
+               : detail::sv::find_last(
+                     data_,
+                     size_,
+                     detail::sv::char_set<Traits, CharT>(s.data_, s.size_),
+                     true,
+                     pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_last_of(CharT c,
+                                             size_type pos = npos) const
+      noexcept {
+    return rfind(c, pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_last_of(const CharT* s,
+                                             size_type pos,
+                                             size_type n) const {
+    return find_last_of(basic_string_view(s, n), pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_last_of(const CharT* s,
+                                             size_type pos = npos) const {
+    return find_last_of(basic_string_view(s), pos);
+  }
+
+  SLB_CXX14_CONSTEXPR size_type find_first_not_of(basic_string_view s,
+                                                  size_type pos = 0) const
+      noexcept {
+    return detail::sv::find_first(
+        data_,
+        size_,
+        detail::sv::char_set<Traits, CharT>(s.data_, s.size_),
+        false,
+        pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_first_not_of(CharT c,
+                                                  size_type pos = 0) const
+      noexcept {
+    return find_first_not_of(basic_string_view(&c, 1), pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_first_not_of(const CharT* s,
+                                                  size_type pos,
+                                                  size_type n) const {
+    return find_first_not_of(basic_string_view(s, n), pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_first_not_of(const CharT* s,
+                                                  size_type pos = 0) const {
+    return find_first_not_of(basic_string_view(s), pos);
+  }
+
+  SLB_CXX14_CONSTEXPR size_type find_last_not_of(basic_string_view s,
+                                                 size_type pos = npos) const
+      noexcept {
+    return detail::sv::find_last(
+        data_,
+        size_,
+        detail::sv::char_set<Traits, CharT>(s.data_, s.size_),
+        false,
+        pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_last_not_of(CharT c,
+                                                 size_type pos = npos) const
+      noexcept {
+    return find_last_not_of(basic_string_view(&c, 1), pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_last_not_of(const CharT* s,
+                                                 size_type pos,
+                                                 size_type n) const {
+    return find_last_not_of(basic_string_view(s, n), pos);
+  }
+  SLB_CXX14_CONSTEXPR size_type find_last_not_of(const CharT* s,
+                                                 size_type pos = npos) const {
+    return find_last_not_of(basic_string_view(s), pos);
+  }
+
+private:
+  const_pointer data_;
+  size_type size_;
+};
+
+template <typename CharT, typename Traits>
+constexpr typename basic_string_view<CharT, Traits>::size_type
+    basic_string_view<CharT, Traits>::npos;
+
+// [string.view.comparison], non-member comparison functions
+
+namespace detail {
+
+// Comparisons against a `basic_string_view` in a non-deduced context accept
+// anything convertible to it, such as string literals and `std::string`.
+template <typename T>
+struct sv_identity {
+  using type = T;
+};
+
+template <typename CharT, typename Traits>
+using nondeduced_string_view =
+    typename sv_identity<basic_string_view<CharT, Traits>>::type;
+
+} // namespace detail
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator==(
+    basic_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.size() == y.size() && x.compare(y) == 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator==(
+    basic_string_view<CharT, Traits> x,
+    detail::nondeduced_string_view<CharT, Traits> y) noexcept {
+  return x.size() == y.size() && x.compare(y) == 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator==(
+    detail::nondeduced_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.size() == y.size() && x.compare(y) == 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator!=(
+    basic_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.size() != y.size() || x.compare(y) != 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator!=(
+    basic_string_view<CharT, Traits> x,
+    detail::nondeduced_string_view<CharT, Traits> y) noexcept {
+  return x.size() != y.size() || x.compare(y) != 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator!=(
+    detail::nondeduced_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.size() != y.size() || x.compare(y) != 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator<(
+    basic_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) < 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator<(
+    basic_string_view<CharT, Traits> x,
+    detail::nondeduced_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) < 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator<(
+    detail::nondeduced_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) < 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator>(
+    basic_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) > 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator>(
+    basic_string_view<CharT, Traits> x,
+    detail::nondeduced_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) > 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator>(
+    detail::nondeduced_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) > 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator<=(
+    basic_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) <= 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator<=(
+    basic_string_view<CharT, Traits> x,
+    detail::nondeduced_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) <= 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator<=(
+    detail::nondeduced_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) <= 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator>=(
+    basic_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) >= 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator>=(
+    basic_string_view<CharT, Traits> x,
+    detail::nondeduced_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) >= 0;
+}
+
+template <typename CharT, typename Traits>
+SLB_CXX14_CONSTEXPR bool operator>=(
+    detail::nondeduced_string_view<CharT, Traits> x,
+    basic_string_view<CharT, Traits> y) noexcept {
+  return x.compare(y) >= 0;
+}
+
+// [string.view.io], inserters and extractors
+
+template <typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>& operator<<(
+    std::basic_ostream<CharT, Traits>& os,
+    basic_string_view<CharT, Traits> str) {
+  typename std::basic_ostream<CharT, Traits>::sentry sentry(os);
+  if (sentry) {
+    using size_type = typename basic_string_view<CharT, Traits>::size_type;
+    size_type const width =
+        os.width() > 0 ? static_cast<size_type>(os.width()) : 0;
+    size_type const padding = width > str.size() ? width - str.size() : 0;
+    bool const left =
+        (os.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+    bool ok = true;
+    for (size_type i = 0; ok && !left && i < padding; ++i) {
+      ok = !Traits::eq_int_type(os.rdbuf()->sputc(os.fill()), Traits::eof());
+    }
+    ok = ok && os.rdbuf()->sputn(str.data(),
+                                 static_cast<std::streamsize>(str.size())) ==
+                   static_cast<std::streamsize>(str.size());
+    for (size_type i = 0; ok && left && i < padding; ++i) {
+      ok = !Traits::eq_int_type(os.rdbuf()->sputc(os.fill()), Traits::eof());
+    }
+    if (!ok) {
+      os.setstate(std::ios_base::badbit);
+    }
+    os.width(0);
+  }
+  return os;
+}
+
+// basic_string_view typedef names
+
+using string_view = basic_string_view<char>;
+using u16string_view = basic_string_view<char16_t>;
+using u32string_view = basic_string_view<char32_t>;
+using wstring_view = basic_string_view<wchar_t>;
+
+// [string.view.hash], hash support
+
+namespace detail {
+
+// MurmurHash64A, reading the trailing bytes as a little-endian word.
+inline std::size_t hash_bytes(const void* p, std::size_t n) noexcept {
+  std::uint64_t const m = 0xC6A4A7935BD1E995ull;
+  int const r = 47;
+  std::uint64_t h = 0xC70F6907ull ^ (static_cast<std::uint64_t>(n) * m);
+  const unsigned char* s = static_cast<const unsigned char*>(p);
+  for (; n >= 8; s += 8, n -= 8) {
+    std::uint64_t k;
+    std::memcpy(&k, s, 8);
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+    h ^= k;
+    h *= m;
+  }
+  if (n != 0) {
+    std::uint64_t k = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      k |= static_cast<std::uint64_t>(s[i]) << (8 * i);
+    }
+    h ^= k;
+    h *= m;
+  }
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+  return static_cast<std::size_t>(h);
+}
+
+template <typename StringView>
+struct string_view_hash {
+  std::size_t operator()(StringView s) const noexcept {
+    return detail::hash_bytes(
+        s.data(), s.size() * sizeof(typename StringView::value_type));
+  }
+};
+
+} // namespace detail
+#endif
+
+} // namespace slb
+
+#if !__cpp_lib_string_view
+namespace std {
+
+template <>
+struct hash<slb::string_view>
+    : slb::detail::string_view_hash<slb::string_view> {};
+
+template <>
+struct hash<slb::u16string_view>
+    : slb::detail::string_view_hash<slb::u16string_view> {};
+
+template <>
+struct hash<slb::u32string_view>
+    : slb::detail::string_view_hash<slb::u32string_view> {};
+
+template <>
+struct hash<slb::wstring_view>
+    : slb::detail::string_view_hash<slb::wstring_view> {};
+
+} // namespace std
+#endif
+
+#endif // SLB_STRING_VIEW_HPP
@@ -0,0 +1,474 @@
+/*
+  SLB.ThreadPool
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_THREAD_POOL_HPP
+#define SLB_THREAD_POOL_HPP
+
+/*
+
+Header <slb/thread_pool.hpp> synopsis
+
+namespace slb {
+  class thread_pool {
+  public:
+    explicit thread_pool(size_t threads = thread::hardware_concurrency());
+    ~thread_pool();
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    size_t size() const noexcept;
+
+    template<class F, class... Args>
+      future<invoke_result_t<decay_t<F>, decay_t<Args>...>>
+        submit(F&& f, Args&&... args);
+    template<class F, class... Args>
+      void post(F&& f, Args&&... args);
+
+    template<class Index, class F>
+      void parallel_for(Index first, Index last, Index grain, F&& f);
+  };
+}
+
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "atomic.hpp"
+#include "detail/atomic_wait.hpp"
+#include "detail/config.hpp"
+#include "detail/invoke.hpp"
+#include "detail/work_deque.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+namespace slb {
+
+namespace detail {
+
+// A unit of work, allocated together with the callable it runs, so that
+// submitting costs a single allocation. The deques hold pointers to tasks,
+// which a thief can read atomically.
+class pool_task {
+public:
+  // Runs the task, then destroys it.
+  void run() noexcept { run_(this, true); }
+
+  // Destroys the task without running it.
+  void discard() noexcept { run_(this, false); }
+
+protected:
+  using run_type = void (*)(pool_task*, bool);
+
+  explicit pool_task(run_type run) noexcept : run_(run) {}
+
+  ~pool_task() = default;
+
+private:
+  run_type run_;
+};
+
+// Owns a task until it is queued; the derived type is only known to `run_`.
+struct pool_task_deleter {
+  void operator()(pool_task* task) const noexcept { task->discard(); }
+};
+
+using pool_task_ptr = std::unique_ptr<pool_task, pool_task_deleter>;
+
+template <typename Fn>
+class pool_task_for final : public pool_task {
+public:
+  template <typename... Args>
+  explicit pool_task_for(in_place_t, Args&&... args)
+      : pool_task(&pool_task_for::run_and_destroy),
+        fn_(SLB_FORWARD(Args, args)...) {}
+
+private:
+  static void run_and_destroy(pool_task* task, bool run) {
+    std::unique_ptr<pool_task_for> self(static_cast<pool_task_for*>(task));
+    if (run) {
+      self->fn_();
+    }
+  }
+
+  Fn fn_;
+};
+
+// A callable and the decayed copies of its arguments, which it is invoked
+// with as rvalues.
+template <typename F, typename... Args>
+class pool_call {
+public:
+  using result_type = typename slb::invoke_result<F, Args...>::type;
+
+  template <typename G, typename... As>
+  explicit pool_call(G&& g, As&&... as)
+      : bound_(SLB_FORWARD(G, g), SLB_FORWARD(As, as)...) {}
+
+  result_type operator()() { return call(index_sequence_for<Args...>{}); }
+
+private:
+  template <std::size_t... Is>
+  result_type call(index_sequence<Is...>) {
+    return detail::invoke(std::get<0>(SLB_MOVE(bound_)),
+                          std::get<Is + 1>(SLB_MOVE(bound_))...);
+  }
+
+  std::tuple<F, Args...> bound_;
+};
+
+template <typename R>
+struct pool_promise {
+  template <typename Call>
+  static void set(std::promise<R>& promise, Call& call) {
+    promise.set_value(call());
+  }
+};
+
+template <>
+struct pool_promise<void> {
+  template <typename Call>
+  static void set(std::promise<void>& promise, Call& call) {
+    call();
+    promise.set_value();
+  }
+};
+
+// Runs a call, and reports its result or exception to a promise.
+template <typename Call>
+class pool_packaged_call {
+public:
+  using result_type = typename Call::result_type;
+
+  pool_packaged_call(std::promise<result_type>&& promise, Call&& call)
+      : promise_(SLB_MOVE(promise)), call_(SLB_MOVE(call)) {}
+
+  void operator()() {
+    try {
+      pool_promise<result_type>::set(promise_, call_);
+    } catch (...) {
+      promise_.set_exception(std::current_exception());
+    }
+  }
+
+private:
+  std::promise<result_type> promise_;
+  Call call_;
+};
+
+template <typename Index, typename F>
+struct parallel_for_state {
+  parallel_for_state(F& f, std::size_t count, Index grain)
+      : f(f), grain(grain), remaining(count), failed(false) {}
+
+  // Calls `f` for each index in `[lo, hi)`, unless an earlier call threw.
+  void run(Index lo, Index hi) noexcept {
+    if (!failed.load(std::memory_order_relaxed)) {
+      try {
+        for (Index i = lo; i != hi; ++i) {
+          detail::invoke(f, i);
+        }
+      } catch (...) {
+        if (!failed.exchange(true, std::memory_order_relaxed)) {
+          error = std::current_exception();
+        }
+      }
+    }
+    // Once `remaining` drops to zero, the caller may return and destroy this
+    // state. The notification goes through slb's own implementation, rather
+    // than `std::atomic_notify_all`, since it only uses the address as a key
+    // and never touches the object.
+    std::size_t const count = static_cast<std::size_t>(hi - lo);
+    if (remaining.fetch_sub(count, std::memory_order_acq_rel) == count) {
+      detail::atomic_notify_address<std::size_t>(&remaining, true);
+    }
+  }
+
+  F& f;
+  Index grain;
+  std::atomic<std::size_t> remaining;
+  std::atomic<bool> failed;
+  std::exception_ptr error;
+};
+
+struct pool_context {
+  void const* pool;
+  std::size_t index;
+  std::uint32_t seed;
+};
+
+// The pool and worker index of the calling thread, if it is a worker, and
+// the state of the random choice of victims to steal from.
+inline pool_context& current_pool_context() noexcept {
+  static thread_local pool_context context = {nullptr, 0, 0};
+  return context;
+}
+
+} // namespace detail
+
+// A fixed set of worker threads, each with a work-stealing deque. Tasks
+// submitted by a worker go to the bottom of its own deque, which it runs in
+// LIFO order for locality, and which idle workers steal from the top; tasks
+// submitted by any other thread go to a shared queue. Idle workers spin
+// briefly, then sleep until new work arrives, which costs a submitting
+// worker no system call unless some worker is asleep.
+//
+// The destructor runs all submitted tasks before joining the workers. If a
+// task passed to `post` throws, `std::terminate` is called.
+class thread_pool {
+public:
+  explicit thread_pool(std::size_t threads = thread_pool::default_size())
+      : injected_(0), epoch_(0), sleepers_(0), stopping_(false) {
+    if (threads == 0) {
+      threads = 1;
+    }
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back(new worker);
+    }
+    try {
+      for (std::size_t i = 0; i < threads; ++i) {
+        workers_[i]->thread = std::thread([this, i] { work(i); });
+      }
+    } catch (...) {
+      // The workers already started may be looking at the others' deques, so
+      // they are stopped before any of them is destroyed.
+      stopping_.store(true, std::memory_order_release);
+      wake(true);
+      for (std::unique_ptr<worker>& w : workers_) {
+        if (w->thread.joinable()) {
+          w->thread.join();
+        }
+      }
+      throw;
+    }
+  }
+
+  thread_pool(thread_pool const&) = delete;
+  thread_pool& operator=(thread_pool const&) = delete;
+
+  ~thread_pool() {
+    stopping_.store(true, std::memory_order_release);
+    wake(true);
+    for (std::unique_ptr<worker>& w : workers_) {
+      w->thread.join();
+    }
+  }
+
+  std::size_t size() const noexcept { return workers_.size(); }
+
+  template <typename F, typename... Args>
+  std::future<typename slb::invoke_result<typename std::decay<F>::type,
+                                          typename std::decay<Args>::type...>::
+                  type>
+  submit(F&& f, Args&&... args) {
+    using call = detail::pool_call<typename std::decay<F>::type,
+                                   typename std::decay<Args>::type...>;
+    using packaged_call = detail::pool_packaged_call<call>;
+    std::promise<typename call::result_type> promise;
+    auto future = promise.get_future();
+    push(detail::pool_task_ptr(new detail::pool_task_for<packaged_call>(
+        in_place,
+        SLB_MOVE(promise),
+        call(SLB_FORWARD(F, f), SLB_FORWARD(Args, args)...))));
+    return future;
+  }
+
+  template <typename F, typename... Args>
+  void post(F&& f, Args&&... args) {
+    using call = detail::pool_call<typename std::decay<F>::type,
+                                   typename std::decay<Args>::type...>;
+    push(detail::pool_task_ptr(new detail::pool_task_for<call>(
+        in_place, SLB_FORWARD(F, f), SLB_FORWARD(Args, args)...)));
+  }
+
+  // Calls `f(i)` for each `i` in `[first, last)`, and returns once all calls
+  // did. The range is split in halves, down to chunks of at most `grain`
+  // indices, which idle workers steal; the calling thread runs tasks until
+  // all chunks are done. If a call throws, the remaining chunks are skipped,
+  // and the first exception is rethrown.
+  template <typename Index, typename F>
+  void parallel_for(Index first, Index last, Index grain, F&& f) {
+    static_assert(std::is_integral<Index>::value, "Index is an integer");
+    if (!(first < last)) {
+      return;
+    }
+    using state_type =
+        detail::parallel_for_state<Index,
+                                   typename std::remove_reference<F>::type>;
+    state_type state(f,
+                     static_cast<std::size_t>(last - first),
+                     grain < Index(1) ? Index(1) : grain);
+    run_range(state, first, last);
+    for (std::size_t left;
+         (left = state.remaining.load(std::memory_order_acquire)) != 0;) {
+      if (detail::pool_task* task = find_task()) {
+        task->run();
+      } else {
+        detail::atomic_wait_address(&state.remaining, left, [&state] {
+          return state.remaining.load(std::memory_order_acquire);
+        });
+      }
+    }
+    if (state.error) {
+      std::rethrow_exception(state.error);
+    }
+  }
+
+private:
+  struct worker {
+    detail::work_deque<detail::pool_task*> deque;
+    std::thread thread;
+  };
+
+  static std::size_t default_size() noexcept {
+    return std::thread::hardware_concurrency();
+  }
+
+  void push(detail::pool_task_ptr task) {
+    detail::pool_context const& context = detail::current_pool_context();
+    if (context.pool == this) {
+      workers_[context.index]->deque.push(task.get());
+      task.release();
+      // Together with the increment of `sleepers_` by a worker about to
+      // sleep, and the `seq_cst` push, either side sees the other's write.
+      if (sleepers_.load(std::memory_order_seq_cst) != 0) {
+        wake(false);
+      }
+    } else {
+      {
+        std::lock_guard<std::mutex> lock(injection_mutex_);
+        injection_.push_back(task.get());
+        task.release();
+        injected_.store(injection_.size(), std::memory_order_relaxed);
+      }
+      wake(false);
+    }
+  }
+
+  void wake(bool all) {
+    epoch_.fetch_add(1, std::memory_order_release);
+    if (all) {
+      slb::atomic_notify_all(&epoch_);
+    } else {
+      slb::atomic_notify_one(&epoch_);
+    }
+  }
+
+  // Takes a task from the calling worker's own deque, then from the shared
+  // queue, then from the other workers, starting from a random one.
+  detail::pool_task* find_task() {
+    detail::pool_context& context = detail::current_pool_context();
+    bool const is_worker = context.pool == this;
+    if (is_worker) {
+      if (detail::pool_task* task = workers_[context.index]->deque.pop()) {
+        return task;
+      }
+    }
+
+    if (injected_.load(std::memory_order_relaxed) != 0) {
+      std::lock_guard<std::mutex> lock(injection_mutex_);
+      if (!injection_.empty()) {
+        detail::pool_task* const task = injection_.front();
+        injection_.pop_front();
+        injected_.store(injection_.size(), std::memory_order_relaxed);
+        return task;
+      }
+    }
+
+    // xorshift32
+    std::uint32_t seed = context.seed != 0 ? context.seed : 0x9E3779B9u;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    context.seed = seed;
+
+    std::size_t const n = workers_.size();
+    for (std::size_t i = 0, victim = seed % n; i < n; ++i) {
+      if (!is_worker || victim != context.index) {
+        if (detail::pool_task* task = workers_[victim]->deque.steal()) {
+          return task;
+        }
+      }
+      victim = victim + 1 == n ? 0 : victim + 1;
+    }
+    return nullptr;
+  }
+
+  void work(std::size_t index) noexcept {
+    detail::pool_context& context = detail::current_pool_context();
+    context.pool = this;
+    context.index = index;
+    context.seed = static_cast<std::uint32_t>(index + 1) * 0x9E3779B9u;
+
+    for (;;) {
+      detail::pool_task* task = find_task();
+      if (!task) {
+        // Look once more after announcing the intent to sleep, so that work
+        // pushed in between is either seen here, or followed by a wake-up.
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        std::uint32_t const epoch = epoch_.load(std::memory_order_acquire);
+        task = find_task();
+        if (!task) {
+          if (stopping_.load(std::memory_order_acquire)) {
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            return;
+          }
+          slb::atomic_wait(&epoch_, epoch);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+      }
+      if (task) {
+        task->run();
+      }
+    }
+  }
+
+  template <typename State, typename Index>
+  void run_range(State& state, Index lo, Index hi) {
+    while (hi - lo > state.grain) {
+      Index const mid = lo + (hi - lo) / 2;
+      try {
+        post([this, &state, mid, hi] { run_range(state, mid, hi); });
+      } catch (...) {
+        // The chunks already posted refer to `state`, so the caller can't
+        // leave before they are done; the rest of the range runs here.
+        break;
+      }
+      hi = mid;
+    }
+    state.run(lo, hi);
+  }
+
+  std::vector<std::unique_ptr<worker>> workers_;
+
+  std::mutex injection_mutex_;
+  std::deque<detail::pool_task*> injection_;
+  std::atomic<std::size_t> injected_;
+
+  std::atomic<std::uint32_t> epoch_;
+  std::atomic<int> sleepers_;
+  std::atomic<bool> stopping_;
+};
+
+} // namespace slb
+
+#endif // SLB_THREAD_POOL_HPP
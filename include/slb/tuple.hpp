@@ -0,0 +1,132 @@
+/*
+  SLB.Tuple
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_TUPLE_HPP
+#define SLB_TUPLE_HPP
+
+/*
+
+Header <tuple> synopsis [tuple.syn]
+
+namespace std {
+  // [tuple.apply], calling a function with a tuple of arguments
+  template<class F, class Tuple>
+    constexpr decltype(auto) apply(F&& f, Tuple&& t);
+
+  template<class T, class Tuple>
+    constexpr T make_from_tuple(Tuple&& t);
+}
+
+*/
+
+#include <tuple>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "detail/config.hpp"
+#include "detail/invoke.hpp"
+#include "detail/lib.hpp"
+#include "utility.hpp"
+
+namespace slb {
+
+// [tuple.apply], calling a function with a tuple of arguments
+
+// We don't defer to the C++17 `apply`/`make_from_tuple`, since those are
+// specified in terms of `std::get` and thus reject user-defined tuple-like
+// types. Elements are accessed with an unqualified call to `get<I>`, which
+// finds `std::get` as well as `get` overloads found via argument-dependent
+// lookup.
+
+namespace detail {
+namespace tuple_like {
+using std::get;
+
+template <std::size_t I, typename Tuple>
+constexpr auto get_element(Tuple&& t) noexcept(
+    noexcept(get<I>(std::forward<Tuple>(t))))
+    -> decltype(get<I>(std::forward<Tuple>(t))) {
+  return get<I>(std::forward<Tuple>(t));
+}
+} // namespace tuple_like
+
+template <typename Tuple>
+using tuple_indices = slb::make_index_sequence<
+    std::tuple_size<typename lib::remove_cvref<Tuple>::type>::value>;
+
+template <typename F, typename Tuple, std::size_t... Is>
+constexpr auto apply(F&& f, Tuple&& t, slb::index_sequence<Is...>) noexcept(
+    noexcept(detail::invoke(
+        std::forward<F>(f),
+        tuple_like::get_element<Is>(std::forward<Tuple>(t))...)))
+    -> decltype(detail::invoke(
+        std::forward<F>(f),
+        tuple_like::get_element<Is>(std::forward<Tuple>(t))...)) {
+  return detail::invoke(std::forward<F>(f),
+                        tuple_like::get_element<Is>(std::forward<Tuple>(t))...);
+}
+
+// Direct-initializes a `T` from `args...`. With a single argument, `T(arg)`
+// is a C-style cast, so `static_cast` is used instead; given that `T` is
+// constructible from `arg`, it performs the same initialization (LWG3528).
+template <typename T, typename... Args>
+constexpr T construct_from(Args&&... args) noexcept(
+    noexcept(T(std::forward<Args>(args)...))) {
+  return T(std::forward<Args>(args)...);
+}
+
+template <typename T, typename Arg>
+constexpr T construct_from(Arg&& arg) noexcept(
+    noexcept(static_cast<T>(std::forward<Arg>(arg)))) {
+  return static_cast<T>(std::forward<Arg>(arg));
+}
+
+template <typename T, typename Tuple, std::size_t... Is>
+constexpr T make_from_tuple(Tuple&& t, slb::index_sequence<Is...>) noexcept(
+    noexcept(detail::construct_from<T>(
+        tuple_like::get_element<Is>(std::forward<Tuple>(t))...))) {
+  static_assert(
+      std::is_constructible<T,
+                            decltype(tuple_like::get_element<Is>(
+                                std::declval<Tuple>()))...>::value,
+      "T is constructible from the elements of the tuple");
+  return detail::construct_from<T>(
+      tuple_like::get_element<Is>(std::forward<Tuple>(t))...);
+}
+
+} // namespace detail
+
+template <typename F, typename Tuple>
+constexpr auto apply(F&& f, Tuple&& t) noexcept(
+    noexcept(detail::apply(std::forward<F>(f),
+                           std::forward<Tuple>(t),
+                           detail::tuple_indices<Tuple>{})))
+    -> decltype(detail::apply(std::forward<F>(f),
+                              std::forward<Tuple>(t),
+                              detail::tuple_indices<Tuple>{})) {
+  return detail::apply(std::forward<F>(f),
+                       std::forward<Tuple>(t),
+                       detail::tuple_indices<Tuple>{});
+}
+
+template <typename T, typename Tuple>
+constexpr T make_from_tuple(Tuple&& t) noexcept(
+    noexcept(detail::make_from_tuple<T>(std::forward<Tuple>(t),
+                                        detail::tuple_indices<Tuple>{}))) {
+  return detail::make_from_tuple<T>(std::forward<Tuple>(t),
+                                    detail::tuple_indices<Tuple>{});
+}
+
+} // namespace slb
+
+#endif // SLB_TUPLE_HPP
@@ -54,6 +54,7 @@ namespace std {
   template<class T> struct is_volatile;
   template<class T> struct is_trivial;
   template<class T> struct is_trivially_copyable;
+  template<class T> struct is_trivially_relocatable;  // P1144
   template<class T> struct is_standard_layout;
   template<class T> struct is_empty;
   template<class T> struct is_polymorphic;
@@ -193,6 +194,10 @@ namespace std {
   template<bool, class T = void> struct enable_if;
   template<bool, class T, class F> struct conditional;
   template<class... T> struct common_type;
+  template<class T, class U, template<class> class TQual,
+           template<class> class UQual>
+    struct basic_common_reference { };
+  template<class... T> struct common_reference;
   template<class T> struct underlying_type;
   template<class Fn, class... ArgTypes> struct invoke_result;
 
@@ -213,6 +218,8 @@ namespace std {
     using conditional_t     = typename conditional<b, T, F>::type;
   template<class... T>
     using common_type_t     = typename common_type<T...>::type;
+  template<class... T>
+    using common_reference_t = typename common_reference<T...>::type;
   template<class T>
     using underlying_type_t = typename underlying_type<T>::type;
   template<class Fn, class... ArgTypes>
@@ -290,6 +297,9 @@ namespace std {
   template<class T>
     inline constexpr bool is_trivially_copyable_v
       = is_trivially_copyable<T>::value;
+  template<class T>
+    inline constexpr bool is_trivially_relocatable_v  // P1144
+      = is_trivially_relocatable<T>::value;
   template<class T>
     inline constexpr bool is_standard_layout_v = is_standard_layout<T>::value;
   template<class T>
@@ -432,6 +442,7 @@ namespace std {
 #include <type_traits>
 
 #include <cstddef>
+#include <utility>
 
 #include "detail/config.hpp"
 #include "detail/invoke.hpp"
@@ -669,6 +680,24 @@ struct is_trivially_copyable {
 };
 #endif
 
+// P1144: "Object relocation in terms of move plus destroy"
+// Users may specialize `is_trivially_relocatable` for types whose move
+// construction followed by destruction of the source is equivalent to copying
+// the bytes of the object representation (e.g., most owning handles).
+#if __has_builtin(__is_trivially_relocatable)
+template <typename T>
+struct is_trivially_relocatable
+    : slb::bool_constant<__is_trivially_relocatable(T)> {};
+#elif SLB_TRIVIALITY_TRAITS
+template <typename T>
+struct is_trivially_relocatable
+    : slb::bool_constant<slb::is_trivially_copyable<T>::value> {};
+#else
+template <typename T>
+struct is_trivially_relocatable : slb::bool_constant<std::is_trivial<T>::value> {
+};
+#endif
+
 #if __cpp_lib_is_final // C++14
 #if SLB_INTEGRAL_CONSTANT == 2
 using std::is_final;
@@ -1009,13 +1038,13 @@ struct is_trivially_move_constructible
 #endif
           > {
 };
-#endif
 
 template <typename T>
 struct is_trivially_move_constructible<T&> : slb::true_type {};
 
 template <typename T>
 struct is_trivially_move_constructible<T&&> : slb::true_type {};
+#endif
 
 #if SLB_TRIVIALITY_TRAITS == 2
 using std::is_trivially_assignable;
@@ -1121,11 +1150,57 @@ struct is_nothrow_swappable
     : slb::bool_constant<std::is_nothrow_swappable<T>::value> {};
 #endif
 #else
-// TODO
-// template <typename T, typename U> struct is_swappable_with;
-// template <typename T> struct is_swappable;
-// template <typename T, typename U> struct is_nothrow_swappable_with;
-// template <typename T> struct is_nothrow_swappable;
+namespace detail {
+// Swappability is checked in a context where `std::swap` is visible and
+// user-provided overloads are found via argument-dependent lookup.
+namespace swappable {
+using std::swap;
+
+template <typename T, typename U, typename Enable = void>
+struct is_swappable_with : std::false_type {};
+
+template <typename T, typename U>
+struct is_swappable_with<
+    T,
+    U,
+    typename lib::always_void<decltype(
+        (void)swap(std::declval<T>(), std::declval<U>()),
+        (void)swap(std::declval<U>(), std::declval<T>()))>::type>
+    : std::true_type {};
+
+template <typename T,
+          typename U,
+          bool IsSwappable = is_swappable_with<T, U>::value>
+struct is_nothrow_swappable_with : std::false_type {};
+
+template <typename T, typename U>
+struct is_nothrow_swappable_with<T, U, true>
+    : slb::bool_constant<noexcept(swap(std::declval<T>(),
+                                       std::declval<U>())) &&
+                         noexcept(swap(std::declval<U>(),
+                                       std::declval<T>()))> {};
+} // namespace swappable
+} // namespace detail
+
+template <typename T, typename U>
+struct is_swappable_with
+    : slb::bool_constant<detail::swappable::is_swappable_with<T, U>::value> {};
+
+template <typename T>
+struct is_swappable
+    : slb::is_swappable_with<typename std::add_lvalue_reference<T>::type,
+                             typename std::add_lvalue_reference<T>::type> {};
+
+template <typename T, typename U>
+struct is_nothrow_swappable_with
+    : slb::bool_constant<
+          detail::swappable::is_nothrow_swappable_with<T, U>::value> {};
+
+template <typename T>
+struct is_nothrow_swappable
+    : slb::is_nothrow_swappable_with<
+          typename std::add_lvalue_reference<T>::type,
+          typename std::add_lvalue_reference<T>::type> {};
 #endif
 
 #if SLB_INTEGRAL_CONSTANT == 2 // C++14
@@ -1254,12 +1329,38 @@ struct is_invocable_r_impl<R,
       noexcept(detail::invoke_r<R>(std::declval<F>(), std::declval<Args>()...));
 };
 
+// gcc 14 provides `__is_invocable` and `__is_nothrow_invocable`, which spare
+// us from instantiating `detail::invoke` for every query. Pointers to members
+// still go through `detail::invoke`, since before C++2a the builtins don't
+// account for P0704.
+#if __has_builtin(__is_invocable) && __has_builtin(__is_nothrow_invocable)
+#define SLB_INVOCABLE_BUILTINS 1
+#else
+#define SLB_INVOCABLE_BUILTINS 0
+#endif
+
+#if SLB_INVOCABLE_BUILTINS
+template <typename F, typename... Args>
+struct is_invocable_builtin {
+  static constexpr bool value = __is_invocable(F, Args...);
+  static constexpr bool nothrow = __is_nothrow_invocable(F, Args...);
+};
+
+template <typename F, typename... Args>
+using is_invocable_dispatch = typename std::conditional<
+    std::is_member_pointer<typename lib::remove_cvref<F>::type>::value,
+    detail::is_invocable_impl<F && (Args && ...)>,
+    detail::is_invocable_builtin<F, Args...>>::type;
+#else
+template <typename F, typename... Args>
+using is_invocable_dispatch = detail::is_invocable_impl<F && (Args && ...)>;
+#endif
+
 } // namespace detail
 
 template <typename F, typename... Args>
 struct is_invocable
-    : slb::bool_constant<detail::is_invocable_impl<F && (Args && ...)>::value> {
-};
+    : slb::bool_constant<detail::is_invocable_dispatch<F, Args...>::value> {};
 
 template <typename R, typename F, typename... Args>
 struct is_invocable_r
@@ -1268,8 +1369,8 @@ struct is_invocable_r
 
 template <typename F, typename... Args>
 struct is_nothrow_invocable
-    : slb::bool_constant<
-          detail::is_invocable_impl<F && (Args && ...)>::nothrow> {};
+    : slb::bool_constant<detail::is_invocable_dispatch<F, Args...>::nothrow> {
+};
 
 template <typename R, typename F, typename... Args>
 struct is_nothrow_invocable_r
@@ -1423,8 +1524,324 @@ using std::decay;
 using std::enable_if;
 using std::conditional;
 
-// TODO: C++14 (SFINAE) / C++17 (recursive commutative `std::decay_t`)
-using std::common_type;
+namespace detail {
+
+// `COND-RES(X, Y)` is `decltype(false ? declval<X(&)()>()() :
+// declval<Y(&)()>()())`.
+template <typename X, typename Y, typename Enable = void>
+struct cond_res {};
+
+template <typename X, typename Y>
+struct cond_res<X,
+                Y,
+                typename lib::always_void<decltype(
+                    false ? std::declval<X (&)()>()()
+                          : std::declval<Y (&)()>()())>::type> {
+  using type = decltype(false ? std::declval<X (&)()>()()
+                              : std::declval<Y (&)()>()());
+};
+
+// Left fold of a binary type trait `F` over `Ts...`. With fold expressions,
+// this is computed without recursive instantiations, so the cost is linear in
+// `sizeof...(Ts)` and the instantiation depth is constant.
+#if defined(__cpp_fold_expressions) && __cpp_fold_expressions >= 201603
+template <template <typename...> class F, typename T>
+struct type_fold_box {
+  using type = T;
+};
+
+template <template <typename...> class F, typename T, typename U>
+auto operator+(type_fold_box<F, T>, type_fold_box<F, U>)
+    -> type_fold_box<F, typename F<T, U>::type>;
+
+template <template <typename...> class F, typename Enable, typename... Ts>
+struct type_fold {};
+
+template <template <typename...> class F, typename... Ts>
+struct type_fold<F,
+                 typename lib::always_void<decltype(
+                     (... + type_fold_box<F, Ts>{}))>::type,
+                 Ts...> : decltype((... + type_fold_box<F, Ts>{})) {};
+#else
+template <template <typename...> class F, typename Enable, typename... Ts>
+struct type_fold {};
+
+template <template <typename...> class F, typename T>
+struct type_fold<F, void, T> {
+  using type = T;
+};
+
+template <template <typename...> class F,
+          typename T1,
+          typename T2,
+          typename... Ts>
+struct type_fold<F,
+                 typename lib::always_void<typename F<T1, T2>::type>::type,
+                 T1,
+                 T2,
+                 Ts...> : type_fold<F, void, typename F<T1, T2>::type, Ts...> {
+};
+#endif
+
+} // namespace detail
+
+// libstdc++ did not implement LWG2408: "SFINAE-friendly `common_type`" until
+// version 5.
+#if !defined(__GLIBCXX__) || __has_include(<codecvt>) // >= libstdc++-5
+#define SLB_COMMON_TYPE_SFINAE 1
+#else
+#define SLB_COMMON_TYPE_SFINAE 0
+#endif
+
+template <typename... Ts>
+struct common_type;
+
+namespace detail {
+
+// Specializations of `std::common_type` (e.g., for `std::chrono::duration`)
+// are honored as a last resort, as long as we can query it without a hard
+// error.
+template <typename D1, typename D2, typename Enable = void>
+struct common_type_std {};
+
+#if SLB_COMMON_TYPE_SFINAE
+template <typename D1, typename D2>
+struct common_type_std<D1,
+                       D2,
+                       typename lib::always_void<
+                           typename std::common_type<D1, D2>::type>::type> {
+  using type = typename std::common_type<D1, D2>::type;
+};
+#endif
+
+// Otherwise, if `COND-RES(CREF(D1), CREF(D2))` denotes a type, let `C` denote
+// the type `decay_t<COND-RES(CREF(D1), CREF(D2))>`.
+template <typename D1, typename D2, typename Enable = void>
+struct common_type_cref : common_type_std<D1, D2> {};
+
+template <typename D1, typename D2>
+struct common_type_cref<
+    D1,
+    D2,
+    typename lib::always_void<
+        typename cond_res<D1 const&, D2 const&>::type>::type> {
+  using type =
+      typename std::decay<typename cond_res<D1 const&, D2 const&>::type>::type;
+};
+
+// Otherwise, if `decay_t<decltype(false ? declval<D1>() : declval<D2>())>`
+// denotes a valid type, let `C` denote that type.
+template <typename D1, typename D2, typename Enable = void>
+struct common_type_cond : common_type_cref<D1, D2> {};
+
+template <typename D1, typename D2>
+struct common_type_cond<D1,
+                        D2,
+                        typename lib::always_void<decltype(
+                            false ? std::declval<D1>()
+                                  : std::declval<D2>())>::type> {
+  using type = typename std::decay<decltype(
+      false ? std::declval<D1>() : std::declval<D2>())>::type;
+};
+
+// If `is_same_v<T1, D1>` is `false` or `is_same_v<T2, D2>` is `false`, let `C`
+// denote the same type, if any, as `common_type_t<D1, D2>`.
+template <typename T1,
+          typename T2,
+          typename D1 = typename std::decay<T1>::type,
+          typename D2 = typename std::decay<T2>::type>
+struct common_type2 : slb::common_type<D1, D2> {};
+
+template <typename D1, typename D2>
+struct common_type2<D1, D2, D1, D2> : common_type_cond<D1, D2> {};
+
+} // namespace detail
+
+template <typename... Ts>
+struct common_type : detail::type_fold<slb::common_type, void, Ts...> {};
+
+template <>
+struct common_type<> {};
+
+template <typename T>
+struct common_type<T> : slb::common_type<T, T> {};
+
+template <typename T1, typename T2>
+struct common_type<T1, T2> : detail::common_type2<T1, T2> {};
+
+namespace detail {
+
+template <typename From, typename To>
+struct copy_cv {
+  using type = To;
+};
+
+template <typename From, typename To>
+struct copy_cv<From const, To> {
+  using type = To const;
+};
+
+template <typename From, typename To>
+struct copy_cv<From volatile, To> {
+  using type = To volatile;
+};
+
+template <typename From, typename To>
+struct copy_cv<From const volatile, To> {
+  using type = To const volatile;
+};
+
+// `XREF(A)` denotes a unary alias template `T` such that `T<U>` denotes the
+// same type as `U` with the addition of `A`'s cv and reference qualifiers.
+template <typename A>
+struct xref {
+  template <typename U>
+  using type = typename copy_cv<A, U>::type;
+};
+
+template <typename A>
+struct xref<A&> {
+  template <typename U>
+  using type = typename copy_cv<A, U>::type&;
+};
+
+template <typename A>
+struct xref<A&&> {
+  template <typename U>
+  using type = typename copy_cv<A, U>::type&&;
+};
+
+// `COMMON-REF(A, B)`
+template <typename A, typename B, typename Enable = void>
+struct common_ref {};
+
+// If `A` is an lvalue reference type of the form `X&` and `B` is an lvalue
+// reference type of the form `Y&`, then `COND-RES(COPYCV(X, Y)&,
+// COPYCV(Y, X)&)` if that type exists and is a reference type.
+template <typename X, typename Y>
+struct common_ref<
+    X&,
+    Y&,
+    typename std::enable_if<std::is_reference<typename cond_res<
+        typename copy_cv<X, Y>::type&,
+        typename copy_cv<Y, X>::type&>::type>::value>::type> {
+  using type = typename cond_res<typename copy_cv<X, Y>::type&,
+                                 typename copy_cv<Y, X>::type&>::type;
+};
+
+// Otherwise, if `A` and `B` are both rvalue reference types of the form `X&&`
+// and `Y&&`, let `C` be `remove_reference_t<COMMON-REF(X&, Y&)>&&`. If
+// `is_convertible_v<A, C>` and `is_convertible_v<B, C>` are `true`, then `C`.
+template <typename X, typename Y>
+struct common_ref<
+    X&&,
+    Y&&,
+    typename std::enable_if<
+        std::is_convertible<X&&,
+                            typename std::remove_reference<
+                                typename common_ref<X&, Y&>::type>::type&&>::
+            value &&
+        std::is_convertible<Y&&,
+                            typename std::remove_reference<
+                                typename common_ref<X&, Y&>::type>::type&&>::
+            value>::type> {
+  using type = typename std::remove_reference<
+      typename common_ref<X&, Y&>::type>::type&&;
+};
+
+// Otherwise, if `A` is an rvalue reference of the form `X&&` and `B` is an
+// lvalue reference of the form `Y&`, let `D` be `COMMON-REF(const X&, Y&)`. If
+// `is_convertible_v<A, D>` is `true`, then `D`.
+template <typename X, typename Y>
+struct common_ref<
+    X&&,
+    Y&,
+    typename std::enable_if<std::is_convertible<
+        X&&,
+        typename common_ref<X const&, Y&>::type>::value>::type> {
+  using type = typename common_ref<X const&, Y&>::type;
+};
+
+// Otherwise, if `A` is an lvalue reference and `B` is an rvalue reference,
+// then `COMMON-REF(B, A)`.
+template <typename X, typename Y>
+struct common_ref<X&, Y&&> : common_ref<Y&&, X&> {};
+
+} // namespace detail
+
+template <typename T,
+          typename U,
+          template <typename> class TQual,
+          template <typename> class UQual>
+struct basic_common_reference {};
+
+template <typename... Ts>
+struct common_reference;
+
+namespace detail {
+
+// Otherwise, if `COND-RES(T1, T2)` is well-formed, then the member typedef
+// `type` denotes that type. Otherwise, if `common_type_t<T1, T2>` is
+// well-formed, then the member typedef `type` denotes that type.
+template <typename T1, typename T2, typename Enable = void>
+struct common_reference_cond : slb::common_type<T1, T2> {};
+
+template <typename T1, typename T2>
+struct common_reference_cond<
+    T1,
+    T2,
+    typename lib::always_void<typename cond_res<T1, T2>::type>::type>
+    : cond_res<T1, T2> {};
+
+// Otherwise, if `basic_common_reference<remove_cvref_t<T1>,
+// remove_cvref_t<T2>, XREF(T1), XREF(T2)>::type` is well-formed, then the
+// member typedef `type` denotes that type.
+template <typename T1, typename T2>
+struct basic_common_reference_of
+    : slb::basic_common_reference<typename lib::remove_cvref<T1>::type,
+                                  typename lib::remove_cvref<T2>::type,
+                                  xref<T1>::template type,
+                                  xref<T2>::template type> {};
+
+template <typename T1, typename T2, typename Enable = void>
+struct common_reference_basic : common_reference_cond<T1, T2> {};
+
+template <typename T1, typename T2>
+struct common_reference_basic<
+    T1,
+    T2,
+    typename lib::always_void<
+        typename basic_common_reference_of<T1, T2>::type>::type>
+    : basic_common_reference_of<T1, T2> {};
+
+// If `T1` and `T2` are reference types and `COMMON-REF(T1, T2)` is
+// well-formed, then the member typedef `type` denotes that type.
+template <typename T1, typename T2, typename Enable = void>
+struct common_reference2 : common_reference_basic<T1, T2> {};
+
+template <typename T1, typename T2>
+struct common_reference2<
+    T1,
+    T2,
+    typename lib::always_void<typename common_ref<T1, T2>::type>::type>
+    : common_ref<T1, T2> {};
+
+} // namespace detail
+
+template <typename... Ts>
+struct common_reference
+    : detail::type_fold<slb::common_reference, void, Ts...> {};
+
+template <>
+struct common_reference<> {};
+
+template <typename T>
+struct common_reference<T> {
+  using type = T;
+};
+
+template <typename T1, typename T2>
+struct common_reference<T1, T2> : detail::common_reference2<T1, T2> {};
 
 using std::underlying_type;
 
@@ -1465,6 +1882,9 @@ using conditional_t = typename slb::conditional<B, T, F>::type;
 template <typename... Ts>
 using common_type_t = typename slb::common_type<Ts...>::type;
 
+template <typename... Ts>
+using common_reference_t = typename slb::common_reference<Ts...>::type;
+
 template <typename T>
 using underlying_type_t = typename slb::underlying_type<T>::type;
 
@@ -1488,10 +1908,30 @@ struct invoke_result_impl<F(Args...),
       decltype(detail::invoke(std::declval<F>(), std::declval<Args>()...));
 };
 
+#if SLB_INVOCABLE_BUILTINS
+template <bool Invocable, typename F, typename... Args>
+struct invoke_result_builtin {};
+
+template <typename F, typename... Args>
+struct invoke_result_builtin<true, F, Args...> {
+  using type = decltype(std::declval<F>()(std::declval<Args>()...));
+};
+
+template <typename F, typename... Args>
+using invoke_result_dispatch = typename std::conditional<
+    std::is_member_pointer<typename lib::remove_cvref<F>::type>::value,
+    detail::invoke_result_impl<F && (Args && ...)>,
+    detail::invoke_result_builtin<__is_invocable(F, Args...), F, Args...>>::
+    type;
+#else
+template <typename F, typename... Args>
+using invoke_result_dispatch = detail::invoke_result_impl<F && (Args && ...)>;
+#endif
+
 } // namespace detail
 
 template <typename F, typename... Args>
-struct invoke_result : detail::invoke_result_impl<F && (Args && ...)> {};
+struct invoke_result : detail::invoke_result_dispatch<F, Args...> {};
 
 template <typename F, typename... Args>
 using invoke_result_t = typename slb::invoke_result<F, Args...>::type;
@@ -1666,6 +2106,10 @@ template <typename T>
 SLB_CXX17_INLINE_VARIABLE constexpr bool is_trivially_copyable_v =
     slb::is_trivially_copyable<T>::value;
 
+template <typename T>
+SLB_CXX17_INLINE_VARIABLE constexpr bool is_trivially_relocatable_v =
+    slb::is_trivially_relocatable<T>::value;
+
 template <typename T>
 SLB_CXX17_INLINE_VARIABLE constexpr bool is_standard_layout_v =
     slb::is_standard_layout<T>::value;
@@ -1723,14 +2167,13 @@ template <typename T>
 SLB_CXX17_INLINE_VARIABLE constexpr bool is_move_assignable_v =
     slb::is_move_assignable<T>::value;
 
-// TODO
-// template <typename T, typename U>
-// SLB_CXX17_INLINE_VARIABLE constexpr bool is_swappable_with_v =
-//     slb::is_swappable_with<T, U>::value;
-//
-// template <typename T>
-// SLB_CXX17_INLINE_VARIABLE constexpr bool is_swappable_v =
-//     slb::is_swappable<T>::value;
+template <typename T, typename U>
+SLB_CXX17_INLINE_VARIABLE constexpr bool is_swappable_with_v =
+    slb::is_swappable_with<T, U>::value;
+
+template <typename T>
+SLB_CXX17_INLINE_VARIABLE constexpr bool is_swappable_v =
+    slb::is_swappable<T>::value;
 
 template <typename T>
 SLB_CXX17_INLINE_VARIABLE constexpr bool is_destructible_v =
@@ -1796,14 +2239,13 @@ template <typename T>
 SLB_CXX17_INLINE_VARIABLE constexpr bool is_nothrow_move_assignable_v =
     slb::is_nothrow_move_assignable<T>::value;
 
-// TODO
-// template <typename T, typename U>
-// SLB_CXX17_INLINE_VARIABLE constexpr bool is_nothrow_swappable_with_v =
-//     slb::is_nothrow_swappable_with<T, U>::value;
-//
-// template <typename T>
-// SLB_CXX17_INLINE_VARIABLE constexpr bool is_nothrow_swappable_v =
-//     slb::is_nothrow_swappable<T>::value;
+template <typename T, typename U>
+SLB_CXX17_INLINE_VARIABLE constexpr bool is_nothrow_swappable_with_v =
+    slb::is_nothrow_swappable_with<T, U>::value;
+
+template <typename T>
+SLB_CXX17_INLINE_VARIABLE constexpr bool is_nothrow_swappable_v =
+    slb::is_nothrow_swappable<T>::value;
 
 template <typename T>
 SLB_CXX17_INLINE_VARIABLE constexpr bool is_nothrow_destructible_v =
@@ -0,0 +1,351 @@
+/*
+  SLB.UnorderedFlatSet
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SLB_UNORDERED_FLAT_SET_HPP
+#define SLB_UNORDERED_FLAT_SET_HPP
+
+/*
+
+Header <slb/unordered_flat_set.hpp> synopsis
+
+namespace slb {
+  // hasher
+  template<class Key>
+    struct unordered_flat_hash;
+
+  // class template unordered_flat_set
+  template<class Key,
+           class Hash = unordered_flat_hash<Key>,
+           class Pred = equal_to<Key>,
+           class Allocator = allocator<Key>>
+    class unordered_flat_set;
+
+  template<class Key, class Hash, class Pred, class Alloc>
+    bool operator==(const unordered_flat_set<Key, Hash, Pred, Alloc>& a,
+                    const unordered_flat_set<Key, Hash, Pred, Alloc>& b);
+  template<class Key, class Hash, class Pred, class Alloc>
+    bool operator!=(const unordered_flat_set<Key, Hash, Pred, Alloc>& a,
+                    const unordered_flat_set<Key, Hash, Pred, Alloc>& b);
+
+  template<class Key, class Hash, class Pred, class Alloc>
+    void swap(unordered_flat_set<Key, Hash, Pred, Alloc>& x,
+              unordered_flat_set<Key, Hash, Pred, Alloc>& y)
+      noexcept(noexcept(x.swap(y)));
+
+  // erasure
+  template<class K, class H, class P, class A, class Predicate>
+    typename unordered_flat_set<K, H, P, A>::size_type
+      erase_if(unordered_flat_set<K, H, P, A>& c, Predicate pred);
+}
+
+*/
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "detail/config.hpp"
+#include "detail/lib.hpp"
+#include "detail/swiss_table.hpp"
+#include "memory.hpp"
+
+namespace slb {
+
+namespace detail {
+
+template <typename Key>
+struct unordered_flat_set_policy {
+  using key_type = Key;
+  using value_type = Key;
+
+  static Key const& key(value_type const& x) noexcept { return x; }
+};
+
+} // namespace detail
+
+// An unordered associative container with the interface of
+// `std::unordered_set`, stored in a single array of slots probed with
+// open addressing rather than in a list of nodes per bucket.
+//
+// Unlike `std::unordered_set`, rehashing moves the elements and invalidates
+// all references to them, and there is no bucket interface besides
+// `bucket_count()`. The maximum load factor is fixed at 7/8.
+template <typename Key,
+          typename Hash = unordered_flat_hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class unordered_flat_set {
+  using table_type = detail::swiss_table<detail::unordered_flat_set_policy<Key>,
+                                         Hash,
+                                         KeyEqual,
+                                         Allocator>;
+
+  template <typename K>
+  using enable_if_transparent =
+      detail::enable_if_transparent_hash<Hash, KeyEqual, K>;
+
+public:
+  // types
+  using key_type = Key;
+  using value_type = Key;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using pointer = typename std::allocator_traits<Allocator>::pointer;
+  using const_pointer =
+      typename std::allocator_traits<Allocator>::const_pointer;
+  using reference = value_type&;
+  using const_reference = value_type const&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = typename table_type::const_iterator;
+  using const_iterator = typename table_type::const_iterator;
+
+  // construct/copy/destroy
+  unordered_flat_set() : unordered_flat_set(size_type(0)) {}
+
+  explicit unordered_flat_set(size_type n,
+                              hasher const& hf = hasher(),
+                              key_equal const& eql = key_equal(),
+                              allocator_type const& a = allocator_type())
+      : table_(n, hf, eql, a) {}
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  unordered_flat_set(InputIt f,
+                     InputIt l,
+                     size_type n = 0,
+                     hasher const& hf = hasher(),
+                     key_equal const& eql = key_equal(),
+                     allocator_type const& a = allocator_type())
+      : table_(n, hf, eql, a) {
+    insert(f, l);
+  }
+
+  unordered_flat_set(unordered_flat_set const& other) = default;
+  unordered_flat_set(unordered_flat_set&& other) = default;
+
+  explicit unordered_flat_set(allocator_type const& a)
+      : table_(0, hasher(), key_equal(), a) {}
+
+  unordered_flat_set(unordered_flat_set const& other,
+                     allocator_type const& a)
+      : table_(other.table_, a) {}
+
+  unordered_flat_set(std::initializer_list<value_type> il,
+                     size_type n = 0,
+                     hasher const& hf = hasher(),
+                     key_equal const& eql = key_equal(),
+                     allocator_type const& a = allocator_type())
+      : unordered_flat_set(il.begin(), il.end(), n, hf, eql, a) {}
+
+  unordered_flat_set(size_type n, allocator_type const& a)
+      : unordered_flat_set(n, hasher(), key_equal(), a) {}
+
+  unordered_flat_set(size_type n, hasher const& hf, allocator_type const& a)
+      : unordered_flat_set(n, hf, key_equal(), a) {}
+
+  unordered_flat_set& operator=(unordered_flat_set const& other) = default;
+  unordered_flat_set& operator=(unordered_flat_set&& other) = default;
+
+  unordered_flat_set& operator=(std::initializer_list<value_type> il) {
+    clear();
+    insert(il);
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return table_.get_allocator();
+  }
+
+  // iterators
+  iterator begin() const noexcept { return table_.begin(); }
+  iterator end() const noexcept { return table_.end(); }
+  const_iterator cbegin() const noexcept { return table_.begin(); }
+  const_iterator cend() const noexcept { return table_.end(); }
+
+  // capacity
+  bool empty() const noexcept { return table_.empty(); }
+  size_type size() const noexcept { return table_.size(); }
+  size_type max_size() const noexcept { return table_.max_size(); }
+
+  // modifiers
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type x(std::forward<Args>(args)...);
+    return table_.emplace_unique(x, std::move(x));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  std::pair<iterator, bool> insert(value_type const& x) {
+    return table_.emplace_unique(x, x);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& x) {
+    return table_.emplace_unique(x, std::move(x));
+  }
+
+  iterator insert(const_iterator, value_type const& x) {
+    return insert(x).first;
+  }
+
+  iterator insert(const_iterator, value_type&& x) {
+    return insert(std::move(x)).first;
+  }
+
+  template <typename InputIt,
+            typename = detail::enable_if_input_iterator<InputIt>>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      emplace(*first);
+    }
+  }
+
+  void insert(std::initializer_list<value_type> il) {
+    table_.reserve(size() + il.size());
+    insert(il.begin(), il.end());
+  }
+
+  iterator erase(const_iterator position) { return table_.erase(position); }
+  size_type erase(key_type const& k) { return table_.erase_key(k); }
+
+  template <typename K,
+            typename = enable_if_transparent<K>,
+            typename = typename std::enable_if<
+                !std::is_convertible<K&&, const_iterator>::value>::type>
+  size_type erase(K&& k) {
+    return table_.erase_key(k);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    return table_.erase(first, last);
+  }
+
+  void swap(unordered_flat_set& other) noexcept(
+      noexcept(std::declval<table_type&>().swap(std::declval<table_type&>()))) {
+    table_.swap(other.table_);
+  }
+
+  void clear() noexcept { table_.clear(); }
+
+  // observers
+  hasher hash_function() const { return table_.hash_function(); }
+  key_equal key_eq() const { return table_.key_eq(); }
+
+  // set operations
+  const_iterator find(key_type const& k) const { return table_.find(k); }
+
+  template <typename K, typename = enable_if_transparent<K>>
+  const_iterator find(K const& k) const {
+    return table_.find(k);
+  }
+
+  size_type count(key_type const& k) const { return contains(k) ? 1 : 0; }
+
+  template <typename K, typename = enable_if_transparent<K>>
+  size_type count(K const& k) const {
+    return contains(k) ? 1 : 0;
+  }
+
+  bool contains(key_type const& k) const { return table_.contains(k); }
+
+  template <typename K, typename = enable_if_transparent<K>>
+  bool contains(K const& k) const {
+    return table_.contains(k);
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      key_type const& k) const {
+    return range_at(find(k));
+  }
+
+  template <typename K, typename = enable_if_transparent<K>>
+  std::pair<const_iterator, const_iterator> equal_range(K const& k) const {
+    return range_at(find(k));
+  }
+
+  // bucket interface
+  size_type bucket_count() const noexcept { return table_.bucket_count(); }
+
+  // hash policy
+  float load_factor() const noexcept { return table_.load_factor(); }
+  float max_load_factor() const noexcept { return table_.max_load_factor(); }
+
+  // The maximum load factor is fixed; the hint is ignored.
+  void max_load_factor(float) noexcept {}
+
+  void rehash(size_type n) { table_.rehash(n); }
+  void reserve(size_type n) { table_.reserve(n); }
+
+  friend bool operator==(unordered_flat_set const& x,
+                         unordered_flat_set const& y) {
+    if (x.size() != y.size()) {
+      return false;
+    }
+    for (const_reference v : x) {
+      if (!y.contains(v)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  friend bool operator!=(unordered_flat_set const& x,
+                         unordered_flat_set const& y) {
+    return !(x == y);
+  }
+
+  friend void swap(unordered_flat_set& x,
+                   unordered_flat_set& y) noexcept(noexcept(x.swap(y))) {
+    x.swap(y);
+  }
+
+private:
+  std::pair<const_iterator, const_iterator> range_at(
+      const_iterator it) const {
+    const_iterator last = it;
+    if (it != end()) {
+      ++last;
+    }
+    return {it, last};
+  }
+
+  table_type table_;
+};
+
+template <typename Key,
+          typename Hash,
+          typename KeyEqual,
+          typename Allocator,
+          typename Predicate>
+typename unordered_flat_set<Key, Hash, KeyEqual, Allocator>::size_type
+erase_if(unordered_flat_set<Key, Hash, KeyEqual, Allocator>& c,
+         Predicate pred) {
+  auto const original_size = c.size();
+  for (auto it = c.begin(), last = c.end(); it != last;) {
+    if (pred(*it)) {
+      it = c.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return original_size - c.size();
+}
+
+} // namespace slb
+
+#endif // SLB_UNORDERED_FLAT_SET_HPP
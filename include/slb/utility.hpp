@@ -153,14 +153,146 @@ namespace std {
 #include <utility>
 
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
+#include <memory>
 #include <type_traits>
 
 #include "detail/config.hpp"
 #include "detail/lib.hpp"
+#include "type_traits.hpp"
 
 namespace slb {
 
+// [utility.swap], swap
+
+namespace detail {
+
+// Checks whether argument-dependent lookup finds a `swap` for `T` other than
+// the generic `std::swap`. The probe below is found by ordinary lookup; it is
+// ambiguous with the generic `std::swap` and loses to anything more
+// specialized.
+namespace swap_probe {
+
+struct not_found {};
+
+template <typename T>
+not_found swap(T&, T&);
+
+template <typename T, typename Enable = void>
+struct has_adl_swap : std::false_type {};
+
+template <typename T>
+struct has_adl_swap<T,
+                    typename lib::always_void<decltype(swap(
+                        std::declval<T&>(), std::declval<T&>()))>::type>
+    : slb::bool_constant<!std::is_same<decltype(swap(std::declval<T&>(),
+                                                     std::declval<T&>())),
+                                       not_found>::value> {};
+
+} // namespace swap_probe
+
+// Objects that are trivially copyable and have no user-provided `swap` can be
+// swapped by exchanging their object representations. Doing so in fixed-size
+// blocks through a small stack buffer lets each `memcpy` lower to a handful of
+// wide vector moves, which the element-wise loop over an array does not
+// always get.
+#if SLB_TRIVIALITY_TRAITS
+template <typename T>
+struct is_bitwise_swappable
+    : slb::bool_constant<slb::is_trivially_copyable<T>::value &&
+                         std::is_move_constructible<T>::value &&
+                         std::is_move_assignable<T>::value &&
+                         !std::is_volatile<T>::value &&
+                         !swap_probe::has_adl_swap<T>::value> {};
+#else
+template <typename T>
+struct is_bitwise_swappable
+    : slb::bool_constant<std::is_trivial<T>::value &&
+                         std::is_move_assignable<T>::value &&
+                         !std::is_volatile<T>::value &&
+                         !swap_probe::has_adl_swap<T>::value> {};
+#endif
+
+SLB_CXX17_INLINE_VARIABLE constexpr std::size_t swap_block_size = 64;
+
+inline void swap_bytes(void* a, void* b, std::size_t n) noexcept {
+  if (a == b || n == 0) {
+    return;
+  }
+  unsigned char* lhs = static_cast<unsigned char*>(a);
+  unsigned char* rhs = static_cast<unsigned char*>(b);
+  unsigned char buffer[swap_block_size];
+  for (; n >= swap_block_size;
+       lhs += swap_block_size, rhs += swap_block_size, n -= swap_block_size) {
+    std::memcpy(buffer, lhs, swap_block_size);
+    std::memcpy(lhs, rhs, swap_block_size);
+    std::memcpy(rhs, buffer, swap_block_size);
+  }
+  std::memcpy(buffer, lhs, n);
+  std::memcpy(lhs, rhs, n);
+  std::memcpy(rhs, buffer, n);
+}
+
+// Only arrays are swapped as blocks of bytes, since the alternative is an
+// element-wise loop. A single object may be a base class subobject, whose
+// tail padding can hold members of the derived class; copying `sizeof(T)`
+// bytes would swap those too.
+template <typename T>
+struct use_swap_bytes
+    : slb::bool_constant<
+          std::is_array<T>::value &&
+          is_bitwise_swappable<
+              typename std::remove_all_extents<T>::type>::value> {};
+
+template <typename T>
+void swap(std::true_type, T& a, T& b) noexcept {
+  detail::swap_bytes(std::addressof(a), std::addressof(b), sizeof(T));
+}
+
+template <typename T>
+void swap(std::false_type, T& a, T& b) noexcept(
+    std::is_nothrow_move_constructible<T>::value &&
+    std::is_nothrow_move_assignable<T>::value) {
+  T tmp = std::move(a);
+  a = std::move(b);
+  b = std::move(tmp);
+}
+
+template <typename T, std::size_t N>
+void swap(std::false_type, T (&a)[N], T (&b)[N]) noexcept(
+    slb::is_nothrow_swappable<T>::value) {
+  using std::swap;
+  for (std::size_t i = 0; i < N; ++i) {
+    swap(a[i], b[i]);
+  }
+}
+
+// `slb::swap` is declared in a namespace that is only nominated by a
+// using-directive, so that qualified calls find it but argument-dependent
+// lookup for types in `slb` does not; otherwise it would be ambiguous with
+// `std::swap` in the usual `using std::swap; swap(a, b);` idiom.
+namespace adl_barrier {
+
+template <typename T>
+typename std::enable_if<std::is_move_constructible<T>::value &&
+                        std::is_move_assignable<T>::value>::type
+swap(T& a, T& b) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                          std::is_nothrow_move_assignable<T>::value) {
+  detail::swap(std::false_type{}, a, b);
+}
+
+template <typename T, std::size_t N>
+typename std::enable_if<slb::is_swappable<T>::value>::type swap(
+    T (&a)[N], T (&b)[N]) noexcept(slb::is_nothrow_swappable<T>::value) {
+  detail::swap(detail::use_swap_bytes<T[N]>{}, a, b);
+}
+
+} // namespace adl_barrier
+} // namespace detail
+
+using namespace detail::adl_barrier;
+
 // [utility.exchange], exchange
 
 template <typename T, typename U = T>
@@ -190,19 +322,22 @@ using std::forward;
 using std::move;
 #else
 template <typename T>
-constexpr T&& forward(typename std::remove_reference<T>::type& t) noexcept {
+SLB_INLINE_CAST constexpr T&&
+forward(typename std::remove_reference<T>::type& t) noexcept {
   return static_cast<T&&>(t);
 }
 
 template <typename T>
-constexpr T&& forward(typename std::remove_reference<T>::type&& t) noexcept {
+SLB_INLINE_CAST constexpr T&&
+forward(typename std::remove_reference<T>::type&& t) noexcept {
   static_assert(!std::is_lvalue_reference<T>::value,
                 "can not forward an rvalue as an lvalue");
   return static_cast<T&&>(t);
 }
 
 template <typename T>
-constexpr typename std::remove_reference<T>::type&& move(T&& t) noexcept {
+SLB_INLINE_CAST constexpr typename std::remove_reference<T>::type&&
+move(T&& t) noexcept {
   return static_cast<typename std::remove_reference<T>::type&&>(t);
 }
 #endif
@@ -224,7 +359,8 @@ constexpr
 // [utility.as_const], as_const
 
 template <typename T>
-constexpr typename std::add_const<T>::type& as_const(T& t) noexcept {
+SLB_INLINE_CAST constexpr typename std::add_const<T>::type&
+as_const(T& t) noexcept {
   return t;
 }
 
@@ -331,6 +467,41 @@ using make_integer_sequence = typename detail::make_integer_sequence_impl<
 template <typename... Ts>
 using index_sequence_for = slb::make_index_sequence<sizeof...(Ts)>;
 
+// in-place construction
+
+#if __cplusplus >= 201703L // C++17
+using std::in_place_t;
+using std::in_place;
+using std::in_place_type_t;
+using std::in_place_type;
+using std::in_place_index_t;
+using std::in_place_index;
+#else
+struct in_place_t {
+  explicit in_place_t() = default;
+};
+
+SLB_CXX17_INLINE_VARIABLE constexpr in_place_t in_place{};
+
+template <typename T>
+struct in_place_type_t {
+  explicit in_place_type_t() = default;
+};
+
+template <std::size_t I>
+struct in_place_index_t {
+  explicit in_place_index_t() = default;
+};
+
+#if SLB_HAS_CXX14_VARIABLE_TEMPLATES // C++14
+template <typename T>
+SLB_CXX17_INLINE_VARIABLE constexpr in_place_type_t<T> in_place_type{};
+
+template <std::size_t I>
+SLB_CXX17_INLINE_VARIABLE constexpr in_place_index_t<I> in_place_index{};
+#endif
+#endif
+
 } // namespace slb
 
 #endif // SLB_UTILITY_HPP
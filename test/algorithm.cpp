@@ -0,0 +1,85 @@
+/*
+  SLB.Algorithm
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/algorithm.hpp>
+
+#include <list>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "catch.hpp"
+
+// [alg.swap], swap
+
+namespace swap_ranges_adl {
+struct Counted {
+  int val;
+  static int swaps;
+};
+int Counted::swaps = 0;
+
+void swap(Counted& a, Counted& b) {
+  ++Counted::swaps;
+  int tmp = a.val;
+  a.val = b.val;
+  b.val = tmp;
+}
+} // namespace swap_ranges_adl
+
+// template<class ForwardIterator1, class ForwardIterator2>
+//   ForwardIterator2 swap_ranges(ForwardIterator1 first1,
+//                                ForwardIterator1 last1,
+//                                ForwardIterator2 first2);
+TEST_CASE("swap_ranges", "[alg.swap]") {
+  /* trivially copyable */ {
+    std::vector<int> a(1000), b(1000);
+    for (int i = 0; i < 1000; ++i) {
+      a[i] = i;
+      b[i] = -i;
+    }
+    int* r = slb::swap_ranges(a.data() + 1, a.data() + 998, b.data() + 1);
+    CHECK(r == b.data() + 998);
+    bool swapped = true;
+    for (int i = 1; i < 998; ++i) {
+      swapped = swapped && a[i] == -i && b[i] == i;
+    }
+    CHECK(swapped);
+    CHECK(a[0] == 0);
+    CHECK(a[998] == 998);
+    CHECK(b[999] == -999);
+  }
+
+  /* empty */ {
+    int* p = nullptr;
+    CHECK(slb::swap_ranges(p, p, p) == p);
+  }
+
+  /* not trivially copyable */ {
+    std::string a[3] = {"a", "b", "c"};
+    std::list<std::string> b = {"d", "e", "f"};
+    auto r = slb::swap_ranges(a, a + 2, b.begin());
+    CHECK(r == std::next(b.begin(), 2));
+    CHECK(a[0] == "d");
+    CHECK(a[1] == "e");
+    CHECK(a[2] == "c");
+    CHECK(b.front() == "a");
+    CHECK(b.back() == "f");
+  }
+
+  /* user-provided swap */ {
+    swap_ranges_adl::Counted a[2] = {{1}, {2}}, b[2] = {{3}, {4}};
+    swap_ranges_adl::Counted::swaps = 0;
+    slb::swap_ranges(a, a + 2, b);
+    CHECK(swap_ranges_adl::Counted::swaps == 2);
+    CHECK(a[0].val == 3);
+    CHECK(b[1].val == 2);
+  }
+}
@@ -0,0 +1,251 @@
+/*
+  SLB.Atomic
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/atomic.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace atomic {
+
+struct Pair {
+  std::int32_t first;
+  std::int32_t second;
+};
+
+// A plain struct, as it might be laid out in a shared memory segment.
+struct Segment {
+  alignas(8) std::uint64_t counter;
+  std::int32_t flags;
+  double total;
+  int* cursor;
+};
+
+// Two threads take turns incrementing `turn`, each waiting for the other's
+// increment before making its own.
+template <typename T>
+T ping_pong(int rounds) {
+  std::atomic<T> turn(T(0));
+  std::thread pong([&turn, rounds] {
+    for (int i = 0; i < rounds; ++i) {
+      slb::atomic_wait(&turn, static_cast<T>(2 * i));
+      turn.store(static_cast<T>(2 * i + 2));
+      slb::atomic_notify_one(&turn);
+    }
+  });
+  for (int i = 0; i < rounds; ++i) {
+    turn.store(static_cast<T>(2 * i + 1));
+    slb::atomic_notify_one(&turn);
+    slb::atomic_wait(&turn, static_cast<T>(2 * i + 1));
+  }
+  pong.join();
+  return turn.load();
+}
+
+} // namespace atomic
+
+TEST_CASE("atomic_ref", "[atomics.ref.generic]") {
+  CHECK((std::is_same<slb::atomic_ref<atomic::Pair>::value_type,
+                      atomic::Pair>::value));
+  CHECK(slb::atomic_ref<atomic::Pair>::required_alignment == 8);
+  CHECK(slb::atomic_ref<atomic::Pair>::is_always_lock_free);
+  CHECK(slb::atomic_ref<char>::required_alignment == 1);
+  CHECK(slb::atomic_ref<std::int64_t>::required_alignment == 8);
+  CHECK(slb::atomic_ref<int>::is_always_lock_free);
+  CHECK_FALSE((std::is_assignable<slb::atomic_ref<int>&,
+                                  slb::atomic_ref<int> const&>::value));
+  CHECK_FALSE((std::is_convertible<int&, slb::atomic_ref<int>>::value));
+
+  alignas(8) atomic::Pair p = {1, 2};
+  slb::atomic_ref<atomic::Pair> const ref(p);
+  CHECK(ref.is_lock_free());
+  CHECK(ref.load().first == 1);
+
+  ref.store({3, 4});
+  CHECK(p.first == 3);
+  CHECK(p.second == 4);
+
+  atomic::Pair const old = ref.exchange({5, 6}, std::memory_order_acq_rel);
+  CHECK(old.first == 3);
+  CHECK(static_cast<atomic::Pair>(ref).second == 6);
+
+  atomic::Pair expected = {0, 0};
+  CHECK_FALSE(ref.compare_exchange_strong(expected, {7, 8}));
+  CHECK(expected.first == 5);
+  CHECK(ref.compare_exchange_strong(expected, {7, 8}));
+  CHECK(p.first == 7);
+  while (!ref.compare_exchange_weak(expected = p,
+                                    {9, 10},
+                                    std::memory_order_release,
+                                    std::memory_order_relaxed)) {
+  }
+  CHECK(p.second == 10);
+
+  // copies refer to the same object
+  slb::atomic_ref<atomic::Pair> const copy = ref;
+  copy.store({11, 12}, std::memory_order_relaxed);
+  CHECK(ref.load(std::memory_order_acquire).first == 11);
+
+  bool b = false;
+  slb::atomic_ref<bool> const flag(b);
+  CHECK_FALSE(flag.exchange(true));
+  CHECK(b);
+  CHECK((flag = false) == false);
+}
+
+TEST_CASE("atomic_ref(integral)", "[atomics.ref.int]") {
+  CHECK((std::is_same<slb::atomic_ref<int>::difference_type, int>::value));
+
+  int x = 10;
+  slb::atomic_ref<int> const ref(x);
+  CHECK(ref.fetch_add(5) == 10);
+  CHECK(ref.fetch_sub(3, std::memory_order_relaxed) == 15);
+  CHECK(ref.fetch_and(0x6) == 12);
+  CHECK(ref.fetch_or(0x9) == 4);
+  CHECK(ref.fetch_xor(0xF) == 13);
+  CHECK(x == 2);
+
+  CHECK(ref++ == 2);
+  CHECK(++ref == 4);
+  CHECK(ref-- == 4);
+  CHECK(--ref == 2);
+  CHECK((ref += 10) == 12);
+  CHECK((ref -= 2) == 10);
+  CHECK((ref &= 6) == 2);
+  CHECK((ref |= 5) == 7);
+  CHECK((ref ^= 1) == 6);
+  CHECK((ref = 42) == 42);
+  CHECK(x == 42);
+
+  std::uint8_t small = 255;
+  slb::atomic_ref<std::uint8_t> const wrap(small);
+  CHECK(++wrap == 0);
+}
+
+TEST_CASE("atomic_ref(floating)", "[atomics.ref.float]") {
+  CHECK((std::is_same<slb::atomic_ref<double>::difference_type,
+                      double>::value));
+
+  double x = 1.5;
+  slb::atomic_ref<double> const ref(x);
+  CHECK(ref.fetch_add(2.0) == 1.5);
+  CHECK(ref.fetch_sub(0.5, std::memory_order_relaxed) == 3.5);
+  CHECK((ref += 1.0) == 4.0);
+  CHECK((ref -= 3.0) == 1.0);
+  CHECK(x == 1.0);
+}
+
+TEST_CASE("atomic_ref(pointer)", "[atomics.ref.pointer]") {
+  CHECK((std::is_same<slb::atomic_ref<int*>::difference_type,
+                      std::ptrdiff_t>::value));
+
+  int values[8] = {};
+  int* p = values;
+  slb::atomic_ref<int*> const ref(p);
+  CHECK(ref.fetch_add(3) == values);
+  CHECK(p == values + 3);
+  CHECK(ref.fetch_sub(1) == values + 3);
+  CHECK(ref++ == values + 2);
+  CHECK(++ref == values + 4);
+  CHECK(ref-- == values + 4);
+  CHECK(--ref == values + 2);
+  CHECK((ref += 5) == values + 7);
+  CHECK((ref -= 7) == values);
+}
+
+TEST_CASE("atomic_ref(concurrent)", "[atomics.ref]") {
+  atomic::Segment segment = {0, 0, 0.0, nullptr};
+  int slots[4000] = {};
+  segment.cursor = slots;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&segment] {
+      for (int i = 0; i < 1000; ++i) {
+        slb::atomic_ref<std::uint64_t>(segment.counter)
+            .fetch_add(1, std::memory_order_relaxed);
+        slb::atomic_ref<std::int32_t>(segment.flags) |= 1 << (i % 31);
+        slb::atomic_ref<double>(segment.total) += 0.5;
+        *slb::atomic_ref<int*>(segment.cursor)++ += 1;
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  CHECK(segment.counter == 4000);
+  CHECK(segment.flags == 0x7FFFFFFF);
+  CHECK(segment.total == 2000.0);
+  CHECK(segment.cursor == slots + 4000);
+  int sum = 0;
+  for (int slot : slots) {
+    sum += slot;
+  }
+  CHECK(sum == 4000);
+}
+
+TEST_CASE("atomic_ref(wait)", "[atomics.ref.generic]") {
+  std::int32_t flag = 0;
+  atomic::Pair pair = {0, 0};
+  std::thread setter([&flag, &pair] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    slb::atomic_ref<atomic::Pair>(pair).store(atomic::Pair{1, 2});
+    slb::atomic_ref<atomic::Pair>(pair).notify_all();
+    slb::atomic_ref<std::int32_t>(flag).store(1);
+    slb::atomic_ref<std::int32_t>(flag).notify_one();
+  });
+  slb::atomic_ref<std::int32_t>(flag).wait(0);
+  CHECK(flag == 1);
+  slb::atomic_ref<atomic::Pair>(pair).wait(atomic::Pair{0, 0});
+  CHECK(pair.second == 2);
+  setter.join();
+
+  // A value other than the current one returns immediately.
+  slb::atomic_ref<std::int32_t>(flag).wait(0, std::memory_order_acquire);
+}
+
+TEST_CASE("atomic_wait", "[atomics.wait]") {
+  std::atomic<int> value(1);
+  slb::atomic_wait(&value, 0);
+  slb::atomic_wait_explicit(&value, 0, std::memory_order_acquire);
+  slb::atomic_notify_one(&value);
+  slb::atomic_notify_all(&value);
+
+  // Objects the kernel waits on directly, and ones it does not.
+  CHECK(atomic::ping_pong<std::int32_t>(1000) == 2000);
+  CHECK(atomic::ping_pong<std::uint64_t>(1000) == 2000);
+  CHECK(atomic::ping_pong<std::int16_t>(1000) == 2000);
+
+  // Notifying all wakes every waiter.
+  std::atomic<std::uint64_t> gate(0);
+  std::atomic<int> woken(0);
+  std::vector<std::thread> waiters;
+  for (int i = 0; i < 4; ++i) {
+    waiters.emplace_back([&gate, &woken] {
+      slb::atomic_wait(&gate, std::uint64_t(0));
+      ++woken;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  gate.store(1);
+  slb::atomic_notify_all(&gate);
+  for (std::thread& w : waiters) {
+    w.join();
+  }
+  CHECK(woken.load() == 4);
+}
@@ -0,0 +1,104 @@
+/*
+  SLB.Barrier
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/barrier.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace barrier {
+
+struct Counter {
+  void operator()() noexcept { ++*count; }
+
+  int* count;
+};
+
+} // namespace barrier
+
+TEST_CASE("barrier", "[thread.barrier.class]") {
+  CHECK(slb::barrier<>::max() > 0);
+
+  int phases = 0;
+  slb::barrier<barrier::Counter> sync(2, barrier::Counter{&phases});
+  auto token = sync.arrive();
+  CHECK(phases == 0);
+  sync.arrive_and_wait();
+  CHECK(phases == 1);
+  sync.wait(std::move(token));
+
+  // A single thread can complete a phase with one update.
+  token = sync.arrive(2);
+  CHECK(phases == 2);
+  sync.wait(std::move(token));
+
+  // Dropping lowers the expected count of the following phases.
+  sync.arrive_and_drop();
+  CHECK(phases == 2);
+  sync.arrive_and_wait();
+  CHECK(phases == 3);
+  sync.arrive_and_wait();
+  CHECK(phases == 4);
+
+  slb::barrier<> plain(1);
+  plain.arrive_and_wait();
+  plain.arrive_and_wait();
+}
+
+TEST_CASE("barrier(concurrent)", "[thread.barrier.class]") {
+  enum : int { threads = 4, phases = 100 };
+  int completions = 0;
+  std::atomic<int> arrivals(0);
+  bool consistent = true;
+  auto on_completion = [&]() noexcept {
+    // All arrivals of the phase happen before its completion step.
+    consistent = consistent && arrivals.load() == (completions + 1) * threads;
+    ++completions;
+  };
+  slb::barrier<decltype(on_completion)> sync(threads, on_completion);
+
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; ++i) {
+    workers.emplace_back([&] {
+      for (int j = 0; j < phases; ++j) {
+        ++arrivals;
+        sync.arrive_and_wait();
+      }
+    });
+  }
+  for (std::thread& w : workers) {
+    w.join();
+  }
+  CHECK(completions == phases);
+  CHECK(consistent);
+
+  // The threads that drop out no longer hold back the others.
+  std::atomic<int> rounds(0);
+  slb::barrier<> shrinking(threads);
+  std::vector<std::thread> leavers;
+  for (int i = 0; i < threads; ++i) {
+    leavers.emplace_back([&, i] {
+      for (int j = 0; j < i; ++j) {
+        shrinking.arrive_and_wait();
+        ++rounds;
+      }
+      shrinking.arrive_and_drop();
+    });
+  }
+  for (std::thread& l : leavers) {
+    l.join();
+  }
+  CHECK(rounds.load() == 0 + 1 + 2 + 3);
+}
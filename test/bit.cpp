@@ -0,0 +1,196 @@
+/*
+  SLB.Bit
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/bit.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "catch.hpp"
+
+// [bit.cast], bit_cast
+
+// template<class To, class From>
+//   constexpr To bit_cast(const From& from) noexcept;
+TEST_CASE("bit_cast", "[bit.cast]") {
+  float f = 1.0f;
+  std::uint32_t u = slb::bit_cast<std::uint32_t>(f);
+  CHECK(u == 0x3F800000u);
+  CHECK(slb::bit_cast<float>(u) == 1.0f);
+  CHECK(noexcept(slb::bit_cast<std::uint32_t>(f)));
+
+  struct S {
+    std::uint16_t a;
+    std::uint16_t b;
+  };
+  S s = slb::bit_cast<S>(u);
+  std::uint32_t v;
+  std::memcpy(&v, &s, sizeof(v));
+  CHECK(v == u);
+
+#if __has_builtin(__builtin_bit_cast) || __cpp_lib_bit_cast
+  constexpr std::uint64_t d = slb::bit_cast<std::uint64_t>(1.0);
+  CHECK(d == 0x3FF0000000000000ull);
+#endif
+}
+
+// [bit.byteswap], byteswap
+
+// template<class T>
+//   constexpr T byteswap(T value) noexcept;
+TEST_CASE("byteswap", "[bit.byteswap]") {
+  constexpr std::uint16_t u16 = slb::byteswap(std::uint16_t(0x1234));
+  CHECK(u16 == 0x3412);
+  constexpr std::uint32_t u32 = slb::byteswap(std::uint32_t(0x12345678));
+  CHECK(u32 == 0x78563412u);
+  constexpr std::uint64_t u64 =
+      slb::byteswap(std::uint64_t(0x0123456789ABCDEFull));
+  CHECK(u64 == 0xEFCDAB8967452301ull);
+  CHECK(slb::byteswap(std::uint8_t(0x12)) == 0x12);
+  CHECK(slb::byteswap(std::int16_t(0x0080)) == std::int16_t(-32768));
+  CHECK(std::is_same<decltype(slb::byteswap(0)), int>::value);
+}
+
+// [bit.pow.two], integral powers of 2
+
+// template<class T>
+//   constexpr bool has_single_bit(T x) noexcept;
+TEST_CASE("has_single_bit", "[bit.pow.two]") {
+  constexpr bool b = slb::has_single_bit(64u);
+  CHECK(b);
+  CHECK_FALSE(slb::has_single_bit(0u));
+  CHECK(slb::has_single_bit(1u));
+  CHECK_FALSE(slb::has_single_bit(3u));
+  CHECK(slb::has_single_bit(std::uint8_t(0x80)));
+  CHECK(slb::has_single_bit(1ull << 63));
+}
+
+// template<class T>
+//   constexpr T bit_ceil(T x);
+TEST_CASE("bit_ceil", "[bit.pow.two]") {
+  constexpr unsigned c = slb::bit_ceil(5u);
+  CHECK(c == 8u);
+  CHECK(slb::bit_ceil(0u) == 1u);
+  CHECK(slb::bit_ceil(1u) == 1u);
+  CHECK(slb::bit_ceil(2u) == 2u);
+  CHECK(slb::bit_ceil(std::uint8_t(100)) == 128);
+  CHECK(std::is_same<decltype(slb::bit_ceil(std::uint8_t(1))),
+                     std::uint8_t>::value);
+  CHECK(slb::bit_ceil((1ull << 62) + 1) == (1ull << 63));
+}
+
+// template<class T>
+//   constexpr T bit_floor(T x) noexcept;
+TEST_CASE("bit_floor", "[bit.pow.two]") {
+  constexpr unsigned f = slb::bit_floor(5u);
+  CHECK(f == 4u);
+  CHECK(slb::bit_floor(0u) == 0u);
+  CHECK(slb::bit_floor(1u) == 1u);
+  CHECK(slb::bit_floor(std::uint16_t(0xFFFF)) == 0x8000);
+  CHECK(slb::bit_floor(~0ull) == (1ull << 63));
+}
+
+// template<class T>
+//   constexpr int bit_width(T x) noexcept;
+TEST_CASE("bit_width", "[bit.pow.two]") {
+  constexpr int w = slb::bit_width(5u);
+  CHECK(w == 3);
+  CHECK(slb::bit_width(0u) == 0);
+  CHECK(slb::bit_width(std::uint8_t(0xFF)) == 8);
+  CHECK(slb::bit_width(~0ull) == 64);
+}
+
+// [bit.rotate], rotating
+
+// template<class T>
+//   constexpr T rotl(T x, int s) noexcept;
+TEST_CASE("rotl", "[bit.rotate]") {
+  constexpr std::uint8_t r = slb::rotl(std::uint8_t(0x1D), 1);
+  CHECK(r == 0x3A);
+  CHECK(slb::rotl(std::uint8_t(0x1D), 0) == 0x1D);
+  CHECK(slb::rotl(std::uint8_t(0x1D), 4) == 0xD1);
+  CHECK(slb::rotl(std::uint8_t(0x1D), 9) == 0x3A);
+  CHECK(slb::rotl(std::uint8_t(0x1D), -1) == 0x8E);
+  CHECK(slb::rotl(0x80000000u, 1) == 1u);
+  CHECK(slb::rotl(1ull, 64) == 1ull);
+}
+
+// template<class T>
+//   constexpr T rotr(T x, int s) noexcept;
+TEST_CASE("rotr", "[bit.rotate]") {
+  constexpr std::uint8_t r = slb::rotr(std::uint8_t(0x1D), 1);
+  CHECK(r == 0x8E);
+  CHECK(slb::rotr(std::uint8_t(0x1D), 0) == 0x1D);
+  CHECK(slb::rotr(std::uint8_t(0x1D), 9) == 0x8E);
+  CHECK(slb::rotr(std::uint8_t(0x1D), -1) == 0x3A);
+  CHECK(slb::rotr(1u, 1) == 0x80000000u);
+  CHECK(slb::rotr(1u, std::numeric_limits<int>::min()) == 1u);
+}
+
+// [bit.count], counting
+
+// template<class T>
+//   constexpr int countl_zero(T x) noexcept;
+TEST_CASE("countl_zero", "[bit.count]") {
+  constexpr int n = slb::countl_zero(1u);
+  CHECK(n == 31);
+  CHECK(slb::countl_zero(0u) == 32);
+  CHECK(slb::countl_zero(std::uint8_t(0)) == 8);
+  CHECK(slb::countl_zero(std::uint8_t(1)) == 7);
+  CHECK(slb::countl_zero(std::uint16_t(0x00F0)) == 8);
+  CHECK(slb::countl_zero(1ull) == 63);
+  CHECK(slb::countl_zero(~0ull) == 0);
+}
+
+// template<class T>
+//   constexpr int countl_one(T x) noexcept;
+TEST_CASE("countl_one", "[bit.count]") {
+  constexpr int n = slb::countl_one(0xF0000000u);
+  CHECK(n == 4);
+  CHECK(slb::countl_one(0u) == 0);
+  CHECK(slb::countl_one(std::uint8_t(0xFF)) == 8);
+  CHECK(slb::countl_one(std::uint8_t(0xE1)) == 3);
+  CHECK(slb::countl_one(~0ull) == 64);
+}
+
+// template<class T>
+//   constexpr int countr_zero(T x) noexcept;
+TEST_CASE("countr_zero", "[bit.count]") {
+  constexpr int n = slb::countr_zero(8u);
+  CHECK(n == 3);
+  CHECK(slb::countr_zero(0u) == 32);
+  CHECK(slb::countr_zero(std::uint8_t(0)) == 8);
+  CHECK(slb::countr_zero(std::uint16_t(0x8000)) == 15);
+  CHECK(slb::countr_zero(1ull << 63) == 63);
+}
+
+// template<class T>
+//   constexpr int countr_one(T x) noexcept;
+TEST_CASE("countr_one", "[bit.count]") {
+  constexpr int n = slb::countr_one(7u);
+  CHECK(n == 3);
+  CHECK(slb::countr_one(0u) == 0);
+  CHECK(slb::countr_one(std::uint8_t(0xFF)) == 8);
+  CHECK(slb::countr_one(~0ull) == 64);
+}
+
+// template<class T>
+//   constexpr int popcount(T x) noexcept;
+TEST_CASE("popcount", "[bit.count]") {
+  constexpr int n = slb::popcount(0xF0F0u);
+  CHECK(n == 8);
+  CHECK(slb::popcount(0u) == 0);
+  CHECK(slb::popcount(std::uint8_t(0xFF)) == 8);
+  CHECK(slb::popcount(0x8000000000000001ull) == 2);
+  CHECK(slb::popcount(~0ull) == 64);
+  CHECK(std::is_same<decltype(slb::popcount(0u)), int>::value);
+}
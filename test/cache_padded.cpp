@@ -0,0 +1,93 @@
+/*
+  SLB.CachePadded
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/cache_padded.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <slb/new.hpp>
+#include <slb/utility.hpp>
+
+#include "catch.hpp"
+
+namespace cache_padded {
+
+struct Point {
+  Point(int x, int y) : x(x), y(y) {}
+
+  int x;
+  int y;
+};
+
+} // namespace cache_padded
+
+TEST_CASE("cache_padded", "[cache.padded]") {
+  using padded = slb::cache_padded<std::uint64_t>;
+  CHECK(padded::alignment >= slb::hardware_destructive_interference_size);
+  CHECK(alignof(padded) == padded::alignment);
+  CHECK(sizeof(padded) == padded::alignment);
+  CHECK(sizeof(slb::cache_padded<char[200]>) % padded::alignment == 0);
+  CHECK((std::is_same<padded::value_type, std::uint64_t>::value));
+
+  // neighbors never share a cache line
+  padded counters[4];
+  for (std::size_t i = 1; i < 4; ++i) {
+    std::uintptr_t const prev =
+        reinterpret_cast<std::uintptr_t>(&counters[i - 1].get());
+    std::uintptr_t const next =
+        reinterpret_cast<std::uintptr_t>(&counters[i].get());
+    CHECK(next - prev >= slb::hardware_destructive_interference_size);
+    CHECK(*counters[i] == 0);
+  }
+
+  constexpr slb::cache_padded<int> c(42);
+  CHECK(c.get() == 42);
+
+  slb::cache_padded<std::string> s(std::string("hello"));
+  CHECK(s->size() == 5);
+  *s += " world";
+  CHECK(s.get() == "hello world");
+
+  slb::cache_padded<cache_padded::Point> const p(slb::in_place, 1, 2);
+  CHECK(p->x == 1);
+  CHECK((*p).y == 2);
+  CHECK_FALSE((std::is_constructible<slb::cache_padded<cache_padded::Point>,
+                                     slb::in_place_t,
+                                     std::string>::value));
+}
+
+TEST_CASE("cache_padded(concurrent)", "[cache.padded]") {
+  slb::cache_padded<std::atomic<std::uint64_t>> counters[4];
+  for (auto& counter : counters) {
+    counter->store(0);
+  }
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&counters, t] {
+      for (int i = 0; i < 10000; ++i) {
+        counters[t]->fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  for (auto const& counter : counters) {
+    CHECK(counter->load() == 10000);
+  }
+}
@@ -0,0 +1,351 @@
+/*
+  SLB.CharConv
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/charconv.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+
+#include "catch.hpp"
+
+namespace charconv {
+
+template <typename T, typename... Args>
+std::string to_string(T value, Args... args) {
+  char buffer[400];
+  slb::to_chars_result r =
+      slb::to_chars(buffer, buffer + sizeof(buffer), value, args...);
+  REQUIRE(r.ec == std::errc());
+  return std::string(buffer, r.ptr);
+}
+
+template <typename T, typename... Args>
+T from_string(std::string const& s, Args... args) {
+  T value{};
+  slb::from_chars_result r =
+      slb::from_chars(s.data(), s.data() + s.size(), value, args...);
+  REQUIRE(r.ec == std::errc());
+  REQUIRE(r.ptr == s.data() + s.size());
+  return value;
+}
+
+template <typename T>
+bool same_bits(T lhs, T rhs) {
+  return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+}
+
+} // namespace charconv
+
+// [charconv.to.chars], primitive numerical output conversion
+
+// to_chars_result to_chars(char* first, char* last, see below value,
+//                          int base = 10);
+TEST_CASE("to_chars(integer)", "[charconv.to.chars]") {
+  using charconv::to_string;
+  CHECK(to_string(0) == "0");
+  CHECK(to_string(7) == "7");
+  CHECK(to_string(-42) == "-42");
+  CHECK(to_string(1000000) == "1000000");
+  CHECK(to_string(std::numeric_limits<int>::min()) == "-2147483648");
+  CHECK(to_string(std::numeric_limits<unsigned long long>::max()) ==
+        "18446744073709551615");
+  CHECK(to_string(std::numeric_limits<long long>::min()) ==
+        "-9223372036854775808");
+  CHECK(to_string(static_cast<signed char>(-128)) == "-128");
+  CHECK(to_string(static_cast<unsigned char>(255)) == "255");
+  CHECK(to_string('A') == "65");
+
+  for (std::uint64_t x = 1, i = 0; i < 20; x *= 10, ++i) {
+    CHECK(to_string(x - 1) == (i == 0 ? "0" : std::string(i, '9')));
+    CHECK(to_string(x) == "1" + std::string(i, '0'));
+  }
+
+  CHECK(to_string(255, 16) == "ff");
+  CHECK(to_string(-255, 16) == "-ff");
+  CHECK(to_string(5, 2) == "101");
+  CHECK(to_string(0, 2) == "0");
+  CHECK(to_string(35, 36) == "z");
+  CHECK(to_string(100, 7) == "202");
+  CHECK(to_string(std::numeric_limits<std::uint64_t>::max(), 2) ==
+        std::string(64, '1'));
+  CHECK(to_string(std::numeric_limits<std::int64_t>::min(), 8) ==
+        "-1000000000000000000000");
+
+  char buffer[4];
+  slb::to_chars_result r = slb::to_chars(buffer, buffer + 4, 12345);
+  CHECK(r.ec == std::errc::value_too_large);
+  CHECK(r.ptr == buffer + 4);
+  r = slb::to_chars(buffer, buffer + 4, -1234);
+  CHECK(r.ec == std::errc::value_too_large);
+  r = slb::to_chars(buffer, buffer + 4, 1234);
+  CHECK(r.ec == std::errc());
+  CHECK(r.ptr == buffer + 4);
+}
+
+// to_chars_result to_chars(char* first, char* last, float value);
+// to_chars_result to_chars(char* first, char* last, double value);
+TEST_CASE("to_chars(floating)", "[charconv.to.chars]") {
+  using charconv::to_string;
+  CHECK(to_string(0.0) == "0");
+  CHECK(to_string(-0.0) == "-0");
+  CHECK(to_string(1.0) == "1");
+  CHECK(to_string(0.1) == "0.1");
+  CHECK(to_string(-1.5) == "-1.5");
+  CHECK(to_string(0.3) == "0.3");
+  CHECK(to_string(0.1 + 0.2) == "0.30000000000000004");
+  CHECK(to_string(1.0 / 3) == "0.3333333333333333");
+  CHECK(to_string(1.0f / 3) == "0.33333334");
+  CHECK(to_string(10000.0) == "10000");
+  CHECK(to_string(100000.0) == "1e+05");
+  CHECK(to_string(1200000.0) == "1200000");
+  CHECK(to_string(0.001) == "0.001");
+  CHECK(to_string(0.0001) == "1e-04");
+  CHECK(to_string(0.0001234) == "0.0001234");
+  CHECK(to_string(1e100) == "1e+100");
+  CHECK(to_string(5e-324) == "5e-324");
+  CHECK(to_string(std::numeric_limits<double>::max()) ==
+        "1.7976931348623157e+308");
+  CHECK(to_string(std::numeric_limits<float>::max()) == "3.4028235e+38");
+  CHECK(to_string(std::numeric_limits<float>::denorm_min()) == "1e-45");
+  CHECK(to_string(9007199254740993.0 * 4) == "36028797018963968");
+  CHECK(to_string(std::numeric_limits<double>::infinity()) == "inf");
+  CHECK(to_string(-std::numeric_limits<float>::infinity()) == "-inf");
+  CHECK(to_string(std::numeric_limits<double>::quiet_NaN()) == "nan");
+
+  char buffer[4];
+  slb::to_chars_result r = slb::to_chars(buffer, buffer + 4, 0.125);
+  CHECK(r.ec == std::errc::value_too_large);
+  CHECK(r.ptr == buffer + 4);
+  r = slb::to_chars(buffer, buffer + 4, 0.25);
+  CHECK(r.ec == std::errc());
+  CHECK(r.ptr == buffer + 4);
+}
+
+// to_chars_result to_chars(char* first, char* last, float value,
+//                          chars_format fmt);
+// to_chars_result to_chars(char* first, char* last, double value,
+//                          chars_format fmt);
+TEST_CASE("to_chars(floating_format)", "[charconv.to.chars]") {
+  using charconv::to_string;
+  slb::chars_format const scientific = slb::chars_format::scientific;
+  slb::chars_format const fixed = slb::chars_format::fixed;
+  slb::chars_format const general = slb::chars_format::general;
+  slb::chars_format const hex = slb::chars_format::hex;
+
+  CHECK(to_string(0.0, scientific) == "0e+00");
+  CHECK(to_string(1234.5, scientific) == "1.2345e+03");
+  CHECK(to_string(1e-300, scientific) == "1e-300");
+  CHECK(to_string(0.0, fixed) == "0");
+  CHECK(to_string(1e-5, fixed) == "0.00001");
+  CHECK(to_string(1234.5, fixed) == "1234.5");
+  CHECK(to_string(1e22, fixed) == "10000000000000000000000");
+  CHECK(to_string(1e23, fixed) == "99999999999999991611392");
+  CHECK(to_string(3e10f, fixed) == "30000001024");
+  CHECK(to_string(100000.0, general) == "100000");
+  CHECK(to_string(1e6, general) == "1e+06");
+  CHECK(to_string(123456.7, general) == "123456.7");
+  CHECK(to_string(1234567.0, general) == "1.234567e+06");
+  CHECK(to_string(0.0001, general) == "0.0001");
+  CHECK(to_string(1e-5, general) == "1e-05");
+
+  CHECK(to_string(0.0, hex) == "0p+0");
+  CHECK(to_string(-0.0, hex) == "-0p+0");
+  CHECK(to_string(1.0, hex) == "1p+0");
+  CHECK(to_string(10.5, hex) == "1.5p+3");
+  CHECK(to_string(0.1f, hex) == "1.99999ap-4");
+  CHECK(to_string(std::numeric_limits<double>::max(), hex) ==
+        "1.fffffffffffffp+1023");
+  CHECK(to_string(std::numeric_limits<double>::denorm_min(), hex) ==
+        "0.0000000000001p-1022");
+  CHECK(to_string(std::numeric_limits<float>::denorm_min(), hex) ==
+        "0.000002p-126");
+}
+
+// [charconv.from.chars], primitive numerical input conversion
+
+// from_chars_result from_chars(const char* first, const char* last,
+//                              see below& value, int base = 10);
+TEST_CASE("from_chars(integer)", "[charconv.from.chars]") {
+  using charconv::from_string;
+  CHECK(from_string<int>("0") == 0);
+  CHECK(from_string<int>("-42") == -42);
+  CHECK(from_string<int>("000123") == 123);
+  CHECK(from_string<int>("-2147483648") == std::numeric_limits<int>::min());
+  CHECK(from_string<unsigned long long>("18446744073709551615") ==
+        std::numeric_limits<unsigned long long>::max());
+  CHECK(from_string<signed char>("-128") == -128);
+  CHECK(from_string<int>("ff", 16) == 255);
+  CHECK(from_string<int>("FF", 16) == 255);
+  CHECK(from_string<int>("-z", 36) == -35);
+  CHECK(from_string<unsigned>("101", 2) == 5u);
+
+  std::string const s = "123abc";
+  int value = 7;
+  slb::from_chars_result r =
+      slb::from_chars(s.data(), s.data() + s.size(), value);
+  CHECK(r.ec == std::errc());
+  CHECK(r.ptr == s.data() + 3);
+  CHECK(value == 123);
+
+  for (char const* invalid : {"", "-", "+1", " 1", "x"}) {
+    value = 7;
+    r = slb::from_chars(invalid, invalid + std::strlen(invalid), value);
+    CHECK(r.ec == std::errc::invalid_argument);
+    CHECK(r.ptr == invalid);
+    CHECK(value == 7);
+  }
+
+  std::string const unsigned_negative = "-1";
+  unsigned u = 7;
+  r = slb::from_chars(unsigned_negative.data(),
+                      unsigned_negative.data() + unsigned_negative.size(),
+                      u);
+  CHECK(r.ec == std::errc::invalid_argument);
+  CHECK(u == 7u);
+
+  for (char const* overflow : {"128", "-129", "99999999999999999999"}) {
+    signed char c = 7;
+    r = slb::from_chars(overflow, overflow + std::strlen(overflow), c);
+    CHECK(r.ec == std::errc::result_out_of_range);
+    CHECK(r.ptr == overflow + std::strlen(overflow));
+    CHECK(c == 7);
+  }
+}
+
+// from_chars_result from_chars(const char* first, const char* last,
+//                              float& value,
+//                              chars_format fmt = chars_format::general);
+// from_chars_result from_chars(const char* first, const char* last,
+//                              double& value,
+//                              chars_format fmt = chars_format::general);
+TEST_CASE("from_chars(floating)", "[charconv.from.chars]") {
+  using charconv::from_string;
+  using charconv::same_bits;
+  CHECK(from_string<double>("0") == 0.0);
+  CHECK(same_bits(from_string<double>("-0"), -0.0));
+  CHECK(from_string<double>("1") == 1.0);
+  CHECK(from_string<double>("0.1") == 0.1);
+  CHECK(from_string<double>(".5") == 0.5);
+  CHECK(from_string<double>("1.") == 1.0);
+  CHECK(from_string<double>("-1.5e3") == -1500.0);
+  CHECK(from_string<double>("1E-2") == 0.01);
+  CHECK(from_string<double>("1.7976931348623157e308") ==
+        std::numeric_limits<double>::max());
+  CHECK(from_string<double>("4.9406564584124654e-324") ==
+        std::numeric_limits<double>::denorm_min());
+  CHECK(from_string<float>("3.4028235e38") ==
+        std::numeric_limits<float>::max());
+  CHECK(from_string<float>("0.1") == 0.1f);
+
+  // Halfway cases that need more than 19 digits to decide.
+  CHECK(from_string<double>("9007199254740993") == 9007199254740992.0);
+  CHECK(from_string<double>("9007199254740993.0000000000000000001") ==
+        9007199254740994.0);
+  CHECK(from_string<double>("9007199254740992.9999999999999999999") ==
+        9007199254740992.0);
+  CHECK(from_string<double>(
+            "1.00000000000000011102230246251565404236316680908203125") ==
+        1.0);
+  CHECK(from_string<double>(
+            "1.000000000000000111022302462515654042363166809082031251") ==
+        1.0000000000000002);
+  CHECK(from_string<double>("2.4703282292062328e-324") ==
+        std::numeric_limits<double>::denorm_min());
+
+  CHECK(std::isinf(from_string<double>("inf")));
+  CHECK(std::isinf(from_string<double>("-INFINITY")));
+  CHECK(std::isnan(from_string<double>("nan")));
+  CHECK(std::isnan(from_string<float>("nan(abc_123)")));
+
+  slb::chars_format const scientific = slb::chars_format::scientific;
+  slb::chars_format const fixed = slb::chars_format::fixed;
+  slb::chars_format const hex = slb::chars_format::hex;
+  CHECK(from_string<double>("1e5", scientific) == 1e5);
+  CHECK(from_string<double>("1.8p+1", hex) == 3.0);
+  CHECK(from_string<double>("ff.8", hex) == 255.5);
+  CHECK(from_string<double>("1p-1074", hex) ==
+        std::numeric_limits<double>::denorm_min());
+  CHECK(from_string<float>("1.fffffep127", hex) ==
+        std::numeric_limits<float>::max());
+
+  struct {
+    char const* input;
+    slb::chars_format fmt;
+    std::ptrdiff_t consumed;
+    std::errc ec;
+  } const cases[] = {
+      {"", slb::chars_format::general, 0, std::errc::invalid_argument},
+      {".", slb::chars_format::general, 0, std::errc::invalid_argument},
+      {"+1", slb::chars_format::general, 0, std::errc::invalid_argument},
+      {"e5", slb::chars_format::general, 0, std::errc::invalid_argument},
+      {"1e", slb::chars_format::general, 1, std::errc()},
+      {"1e+", slb::chars_format::general, 1, std::errc()},
+      {"1e5", fixed, 1, std::errc()},
+      {"1", scientific, 0, std::errc::invalid_argument},
+      {"0x1p3", hex, 1, std::errc()},
+      {"1p", hex, 1, std::errc()},
+      {"infin", slb::chars_format::general, 3, std::errc()},
+      {"nan(ab", slb::chars_format::general, 3, std::errc()},
+      {"1e400", slb::chars_format::general, 5, std::errc::result_out_of_range},
+      {"-1e400", slb::chars_format::general, 6, std::errc::result_out_of_range},
+      {"1e-400", slb::chars_format::general, 6, std::errc::result_out_of_range},
+      {"2e-324", slb::chars_format::general, 6, std::errc::result_out_of_range},
+      {"0e-400", slb::chars_format::general, 6, std::errc()},
+      {"1p1024", hex, 6, std::errc::result_out_of_range},
+  };
+  for (auto const& c : cases) {
+    double value = 42.0;
+    slb::from_chars_result r = slb::from_chars(
+        c.input, c.input + std::strlen(c.input), value, c.fmt);
+    CHECK(r.ptr - c.input == c.consumed);
+    CHECK(r.ec == c.ec);
+    if (r.ec != std::errc()) {
+      CHECK(value == 42.0);
+    }
+  }
+
+  float f = 42.0f;
+  char const s[] = "1e39";
+  CHECK(slb::from_chars(s, s + 4, f).ec == std::errc::result_out_of_range);
+  CHECK(f == 42.0f);
+}
+
+TEST_CASE("charconv_round_trip", "[charconv]") {
+  using charconv::from_string;
+  using charconv::same_bits;
+  using charconv::to_string;
+  std::uint64_t state = 0x9E3779B97F4A7C15ull;
+  for (int i = 0; i < 10000; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    double d;
+    std::memcpy(&d, &state, sizeof(d));
+    if (std::isfinite(d)) {
+      CHECK(same_bits(from_string<double>(to_string(d)), d));
+      CHECK(same_bits(
+          from_string<double>(to_string(d, slb::chars_format::hex),
+                              slb::chars_format::hex),
+          d));
+    }
+
+    std::uint32_t const bits = static_cast<std::uint32_t>(state >> 32);
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    if (std::isfinite(f)) {
+      CHECK(same_bits(from_string<float>(to_string(f)), f));
+    }
+  }
+}
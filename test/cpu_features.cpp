@@ -0,0 +1,146 @@
+/*
+  SLB.CpuFeatures
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/cpu_features.hpp>
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace cpu_features {
+
+int resolutions = 0;
+
+std::size_t count_baseline(char const* s, std::size_t n, char c) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    count += s[i] == c;
+  }
+  return count;
+}
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                               \
+    (defined(__x86_64__) || defined(__i386__))
+__attribute__((target("avx2"))) std::size_t count_avx2(char const* s,
+                                                        std::size_t n,
+                                                        char c) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    count += s[i] == c;
+  }
+  return count;
+}
+
+auto resolve_count(slb::cpu_features const& features)
+    -> decltype(&count_baseline) {
+  ++resolutions;
+  return features.has(slb::cpu_feature::avx2) ? &count_avx2 : &count_baseline;
+}
+#else
+auto resolve_count(slb::cpu_features const&) -> decltype(&count_baseline) {
+  ++resolutions;
+  return &count_baseline;
+}
+#endif
+
+using count = slb::cpu_dispatch<std::size_t(char const*, std::size_t, char),
+                                resolve_count>;
+
+std::string concat(std::string const& a, std::string&& b) { return a + b; }
+
+auto resolve_concat(slb::cpu_features const&) -> decltype(&concat) {
+  return &concat;
+}
+
+} // namespace cpu_features
+
+TEST_CASE("cpu_features", "[cpu.features]") {
+  slb::cpu_features const& features = slb::cpu_features::get();
+  CHECK(&features == &slb::cpu_features::get());
+
+  // Features enabled at compile time are available at runtime.
+#if defined(__SSE2__) || defined(_M_X64)
+  CHECK(features.has(slb::cpu_feature::sse2));
+#endif
+#if defined(__SSE4_2__)
+  CHECK(features.has(slb::cpu_feature::sse4_2));
+#endif
+#if defined(__AVX__)
+  CHECK(features.has(slb::cpu_feature::avx));
+#endif
+#if defined(__AVX2__)
+  CHECK(features.has(slb::cpu_feature::avx2));
+#endif
+#if defined(__AVX512F__)
+  CHECK(features.has(slb::cpu_feature::avx512f));
+#endif
+
+  // Extensions imply the ones they build upon.
+  if (features.has(slb::cpu_feature::avx2)) {
+    CHECK(features.has(slb::cpu_feature::avx));
+  }
+  if (features.has(slb::cpu_feature::avx)) {
+    CHECK(features.has(slb::cpu_feature::sse4_2));
+  }
+  if (features.has(slb::cpu_feature::avx512bw)) {
+    CHECK(features.has(slb::cpu_feature::avx512f));
+  }
+  if (features.has(slb::cpu_feature::sse4_2)) {
+    CHECK(features.has(slb::cpu_feature::sse2));
+  }
+
+  constexpr slb::cpu_features none{};
+  CHECK_FALSE(none.has(slb::cpu_feature::sse2));
+
+  slb::cpu_features custom;
+  custom.set(slb::cpu_feature::avx2);
+  custom.set(slb::cpu_feature::bmi2);
+  CHECK(custom.has(slb::cpu_feature::avx2));
+  CHECK(custom.has(slb::cpu_feature::bmi2));
+  CHECK_FALSE(custom.has(slb::cpu_feature::avx));
+  custom.set(slb::cpu_feature::avx2, false);
+  CHECK_FALSE(custom.has(slb::cpu_feature::avx2));
+  CHECK(custom.has(slb::cpu_feature::bmi2));
+}
+
+TEST_CASE("cpu_dispatch", "[cpu.features]") {
+  std::string const text = "mississippi";
+  CHECK(cpu_features::resolutions == 0);
+  CHECK(cpu_features::count::call(text.data(), text.size(), 's') == 4);
+  CHECK(cpu_features::resolutions == 1);
+
+  for (int i = 0; i < 100; ++i) {
+    CHECK(cpu_features::count()(text.data(), text.size(), 'i') == 4);
+  }
+  CHECK(cpu_features::resolutions == 1);
+
+  CHECK(cpu_features::count::resolve() ==
+        cpu_features::resolve_count(slb::cpu_features::get()));
+
+  // Concurrent first calls all reach the selected implementation.
+  using concat =
+      slb::cpu_dispatch<std::string(std::string const&, std::string&&),
+                        cpu_features::resolve_concat>;
+  std::vector<std::string> results(4);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&results, i] {
+      results[i] = concat::call("a", std::string(i + 1, 'b'));
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  CHECK(results[0] == "ab");
+  CHECK(results[3] == "abbbb");
+}
@@ -0,0 +1,393 @@
+/*
+  SLB.Expected
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/expected.hpp>
+
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace expected {
+
+enum class errc { none, bad, worse };
+
+// Moves succeed until `throw_countdown` reaches zero.
+int throw_countdown = -1;
+
+struct Throwing {
+  int value;
+
+  Throwing(int v) : value(v) {}
+  Throwing(Throwing const& other) : value(other.value) { tick(); }
+  Throwing(Throwing&& other) : value(other.value) { tick(); }
+  Throwing& operator=(Throwing const&) = default;
+
+  static void tick() {
+    if (throw_countdown >= 0 && throw_countdown-- == 0) {
+      throw std::runtime_error("move");
+    }
+  }
+};
+
+// Copyable, but not assignable.
+struct ConstInt {
+  int const value;
+};
+
+struct ConstString {
+  std::string const value;
+};
+
+slb::expected<int, errc> parse(char c) {
+  if (c < '0' || c > '9') {
+    return slb::unexpected<errc>(errc::bad);
+  }
+  return c - '0';
+}
+
+} // namespace expected
+
+TEST_CASE("unexpected", "[expected.unexpected]") {
+  using expected::errc;
+
+  slb::unexpected<errc> u(errc::bad);
+  CHECK(u.error() == errc::bad);
+  u.error() = errc::worse;
+  CHECK(u == slb::unexpected<errc>(errc::worse));
+  CHECK(u != slb::unexpected<errc>(errc::bad));
+
+  slb::unexpected<std::string> s(slb::in_place, 3, 'x');
+  CHECK(s.error() == "xxx");
+  slb::unexpected<std::vector<int>> v(slb::in_place, {1, 2, 3});
+  CHECK(v.error().size() == 3);
+  std::string m = std::move(s).error();
+  CHECK(m == "xxx");
+
+  slb::unexpected<std::string> t(std::string("y"));
+  swap(s, t);
+  CHECK(s.error() == "y");
+
+  constexpr slb::unexpected<int> c(42);
+  static_assert(c.error() == 42, "");
+}
+
+TEST_CASE("bad_expected_access", "[expected.bad]") {
+  slb::bad_expected_access<int> e(42);
+  CHECK(e.error() == 42);
+  CHECK(std::move(e).error() == 42);
+  CHECK(std::string(e.what()).size() != 0);
+  CHECK((std::is_base_of<std::exception,
+                         slb::bad_expected_access<void>>::value));
+  CHECK((std::is_base_of<slb::bad_expected_access<void>,
+                         slb::bad_expected_access<int>>::value));
+}
+
+TEST_CASE("expected(construct)", "[expected.object.cons]") {
+  using expected::errc;
+
+  /* default */ {
+    slb::expected<int, errc> const x;
+    CHECK(x.has_value());
+    CHECK(*x == 0);
+    CHECK_FALSE((std::is_default_constructible<
+                 slb::expected<expected::Throwing, errc>>::value));
+  }
+
+  /* value */ {
+    slb::expected<std::string, errc> const x = "abc";
+    CHECK(x.has_value());
+    CHECK(*x == "abc");
+    slb::expected<std::string, errc> const y(slb::in_place, 2, 'y');
+    CHECK(*y == "yy");
+    slb::expected<std::vector<int>, errc> const z(slb::in_place, {1, 2});
+    CHECK(z->size() == 2);
+  }
+
+  /* error */ {
+    slb::expected<int, std::string> const x = slb::unexpected<char const*>("e");
+    CHECK_FALSE(x.has_value());
+    CHECK(x.error() == "e");
+    slb::expected<int, std::string> const y(slb::unexpect, 2, 'e');
+    CHECK(y.error() == "ee");
+  }
+
+  /* copy, move */ {
+    slb::expected<std::string, int> x = "abc";
+    slb::expected<std::string, int> y = x;
+    CHECK(*y == "abc");
+    slb::expected<std::string, int> z = std::move(x);
+    CHECK(*z == "abc");
+    slb::expected<std::string, int> const e = slb::unexpected<int>(1);
+    slb::expected<std::string, int> f = e;
+    CHECK(f.error() == 1);
+  }
+
+  /* move-only */ {
+    slb::expected<std::unique_ptr<int>, int> x(new int(42));
+    slb::expected<std::unique_ptr<int>, int> y = std::move(x);
+    CHECK(**y == 42);
+    CHECK_FALSE((std::is_copy_constructible<
+                 slb::expected<std::unique_ptr<int>, int>>::value));
+    CHECK((std::is_move_constructible<
+           slb::expected<std::unique_ptr<int>, int>>::value));
+  }
+
+  /* converting */ {
+    slb::expected<int, int> const x = 42;
+    slb::expected<long, long> const y = x;
+    CHECK(*y == 42);
+    slb::expected<std::string, int> const z(
+        slb::expected<char const*, int>("abc"));
+    CHECK(*z == "abc");
+    CHECK((std::is_convertible<slb::expected<int, int>,
+                               slb::expected<long, long>>::value));
+    CHECK_FALSE((std::is_convertible<slb::expected<int, int>,
+                                     slb::expected<std::vector<int>, int>>::
+                     value));
+    CHECK((std::is_constructible<slb::expected<std::vector<int>, int>,
+                                 slb::expected<int, int>>::value));
+  }
+
+  /* constexpr */ {
+    constexpr slb::expected<int, errc> x = 42;
+    static_assert(x.has_value() && *x == 42, "");
+    constexpr slb::expected<int, errc> y(slb::unexpect, errc::bad);
+    static_assert(!y && y.error() == errc::bad, "");
+  }
+}
+
+TEST_CASE("expected(assign)", "[expected.object.assign]") {
+  using expected::Throwing;
+  using expected::throw_countdown;
+
+  slb::expected<std::string, int> x = "abc";
+  x = "def";
+  CHECK(*x == "def");
+  x = slb::unexpected<int>(1);
+  CHECK(x.error() == 1);
+  x = slb::unexpected<int>(2);
+  CHECK(x.error() == 2);
+  x = "ghi";
+  CHECK(*x == "ghi");
+
+  slb::expected<std::string, int> y = slb::unexpected<int>(3);
+  y = x;
+  CHECK(*y == "ghi");
+  x = slb::unexpected<int>(4);
+  y = std::move(x);
+  CHECK(y.error() == 4);
+
+  slb::expected<int, std::string> e(slb::unexpect, "e");
+  CHECK(e.emplace(42) == 42);
+  CHECK(*e == 42);
+
+  // Replacing a value with an error that fails to construct leaves the
+  // value as it was.
+  slb::expected<int, Throwing> z = 1;
+  Throwing const t(2);
+  throw_countdown = 0;
+  CHECK_THROWS_AS(z = slb::unexpected<Throwing>(slb::in_place, t),
+                  std::runtime_error);
+  throw_countdown = -1;
+  CHECK(*z == 1);
+
+  slb::expected<Throwing, int> w = slb::unexpected<int>(1);
+  throw_countdown = 0;
+  CHECK_THROWS_AS(w = t, std::runtime_error);
+  throw_countdown = -1;
+  CHECK(w.error() == 1);
+
+  /* constraints */ {
+    using expected::ConstInt;
+    using expected::ConstString;
+    CHECK_FALSE(std::is_copy_assignable<slb::expected<ConstInt, int>>::value);
+    CHECK_FALSE(std::is_move_assignable<slb::expected<ConstInt, int>>::value);
+    CHECK_FALSE(
+        std::is_copy_assignable<slb::expected<ConstString, int>>::value);
+    CHECK_FALSE(
+        std::is_move_assignable<slb::expected<ConstString, int>>::value);
+    CHECK_FALSE(
+        std::is_copy_assignable<slb::expected<int, ConstString>>::value);
+    CHECK(std::is_copy_constructible<slb::expected<ConstString, int>>::value);
+
+    // Neither the value nor the error can be moved without throwing.
+    CHECK(std::is_copy_assignable<slb::expected<Throwing, int>>::value);
+    CHECK(std::is_move_assignable<slb::expected<Throwing, int>>::value);
+    CHECK_FALSE(
+        std::is_copy_assignable<slb::expected<Throwing, Throwing>>::value);
+    CHECK_FALSE(
+        std::is_move_assignable<slb::expected<Throwing, Throwing>>::value);
+    CHECK(std::is_copy_constructible<
+          slb::expected<Throwing, Throwing>>::value);
+
+    CHECK_FALSE(
+        std::is_copy_assignable<slb::expected<void, ConstString>>::value);
+    CHECK_FALSE(
+        std::is_move_assignable<slb::expected<void, ConstString>>::value);
+    CHECK(std::is_copy_assignable<slb::expected<void, Throwing>>::value);
+    CHECK(std::is_move_assignable<slb::expected<void, Throwing>>::value);
+  }
+}
+
+TEST_CASE("expected(observers)", "[expected.object.obs]") {
+  using expected::errc;
+
+  slb::expected<std::string, errc> x = "abc";
+  CHECK(static_cast<bool>(x));
+  CHECK(x->size() == 3);
+  CHECK(x.value() == "abc");
+  CHECK(std::move(x).value() == "abc");
+  CHECK(x.value_or("def") == "abc");
+  CHECK(x.error_or(errc::worse) == errc::worse);
+
+  slb::expected<std::string, errc> const y = slb::unexpected<errc>(errc::bad);
+  CHECK_FALSE(y);
+  CHECK(y.error() == errc::bad);
+  CHECK(y.value_or("def") == "def");
+  CHECK(y.error_or(errc::worse) == errc::bad);
+  CHECK_THROWS_AS(y.value(), slb::bad_expected_access<errc>);
+  CHECK_THROWS_AS(y.value(), slb::bad_expected_access<void>);
+  try {
+    y.value();
+  } catch (slb::bad_expected_access<errc> const& e) {
+    CHECK(e.error() == errc::bad);
+  }
+}
+
+TEST_CASE("expected(monadic)", "[expected.object.monadic]") {
+  using expected::errc;
+  using expected::parse;
+
+  auto twice = [](int x) { return x * 2; };
+  auto add = [](int y) {
+    return [y](int x) -> slb::expected<int, errc> { return x * 10 + y; };
+  };
+
+  CHECK(parse('4').transform(twice) == 8);
+  CHECK(parse('x').transform(twice).error() == errc::bad);
+  CHECK(parse('4').and_then(add(2)) == 42);
+  CHECK(parse('x').and_then(add(1)).error() == errc::bad);
+
+  auto recover = [](errc) { return slb::expected<int, errc>(0); };
+  CHECK(parse('x').or_else(recover) == 0);
+  CHECK(parse('7').or_else(recover) == 7);
+
+  auto describe = [](errc e) {
+    return e == errc::bad ? std::string("bad") : std::string("?");
+  };
+  slb::expected<int, std::string> const d =
+      parse('x').transform_error(describe);
+  CHECK(d.error() == "bad");
+  CHECK(*parse('3').transform_error(describe) == 3);
+
+  // The value is moved out of an rvalue.
+  slb::expected<std::unique_ptr<int>, errc> p(new int(5));
+  slb::expected<int, errc> q =
+      std::move(p).transform([](std::unique_ptr<int> x) { return *x; });
+  CHECK(q == 5);
+
+  slb::expected<void, errc> v = parse('1').transform([](int) {});
+  CHECK(v.has_value());
+}
+
+TEST_CASE("expected(void)", "[expected.void]") {
+  using expected::errc;
+
+  slb::expected<void, errc> x;
+  CHECK(x.has_value());
+  x.value();
+  x = slb::unexpected<errc>(errc::bad);
+  CHECK_FALSE(x);
+  CHECK(x.error() == errc::bad);
+  CHECK_THROWS_AS(x.value(), slb::bad_expected_access<errc>);
+  CHECK(x.error_or(errc::none) == errc::bad);
+  x.emplace();
+  CHECK(x);
+
+  slb::expected<void, std::string> y(slb::unexpect, "e");
+  slb::expected<void, std::string> z = y;
+  CHECK(z.error() == "e");
+  slb::expected<void, std::string> w;
+  swap(y, w);
+  CHECK(y.has_value());
+  CHECK(w.error() == "e");
+
+  int calls = 0;
+  auto count = [&calls]() -> slb::expected<int, errc> { return ++calls; };
+  CHECK(x.and_then(count) == 1);
+  CHECK(x.transform([] { return 2; }) == 2);
+  x = slb::unexpected<errc>(errc::worse);
+  CHECK(x.and_then(count).error() == errc::worse);
+  CHECK(calls == 1);
+  CHECK(x.or_else([](errc) { return slb::expected<void, errc>(); }));
+  CHECK(x.transform_error([](errc) { return 0; }).error() == 0);
+
+  constexpr slb::expected<void, int> c;
+  static_assert(c.has_value(), "");
+}
+
+TEST_CASE("expected(swap)", "[expected.object.swap]") {
+  slb::expected<std::string, int> x = "abc";
+  slb::expected<std::string, int> y = slb::unexpected<int>(1);
+  swap(x, y);
+  CHECK(x.error() == 1);
+  CHECK(*y == "abc");
+  x.swap(y);
+  CHECK(*x == "abc");
+  CHECK(y.error() == 1);
+
+  slb::expected<std::string, int> z = "def";
+  swap(x, z);
+  CHECK(*x == "def");
+  CHECK(*z == "abc");
+}
+
+TEST_CASE("expected(compare)", "[expected.object.eq]") {
+  slb::expected<int, int> const a = 1;
+  slb::expected<long, long> const b = 1;
+  slb::expected<int, int> const e = slb::unexpected<int>(1);
+  CHECK(a == b);
+  CHECK(a != e);
+  CHECK(e == slb::expected<int, int>(slb::unexpect, 1));
+  CHECK(a == 1);
+  CHECK(1 == a);
+  CHECK(a != 2);
+  CHECK(e != 1);
+  CHECK(e == slb::unexpected<int>(1));
+  CHECK(slb::unexpected<int>(1) == e);
+  CHECK(a != slb::unexpected<int>(1));
+
+  slb::expected<void, int> const v;
+  CHECK(v == slb::expected<void, long>());
+  CHECK(v != slb::unexpected<int>(1));
+}
+
+TEST_CASE("expected(triviality)", "[expected.object]") {
+  using expected::errc;
+
+  CHECK((std::is_trivially_destructible<slb::expected<int, errc>>::value));
+  CHECK((std::is_trivially_destructible<slb::expected<void, errc>>::value));
+  CHECK_FALSE(
+      (std::is_trivially_destructible<slb::expected<std::string, errc>>::
+           value));
+#if SLB_TRIVIALITY_TRAITS
+  CHECK((slb::is_trivially_copyable<slb::expected<int, errc>>::value));
+  CHECK((slb::is_trivially_copyable<slb::expected<void, errc>>::value));
+  CHECK_FALSE(
+      (slb::is_trivially_copyable<slb::expected<std::string, errc>>::value));
+#endif
+  CHECK(sizeof(slb::expected<int, errc>) == 2 * sizeof(int));
+}
@@ -0,0 +1,223 @@
+/*
+  SLB.FlatMap
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/flat_map.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace flat_map {
+
+struct string_less {
+  using is_transparent = void;
+
+  bool operator()(std::string const& x, std::string const& y) const {
+    return x < y;
+  }
+  bool operator()(std::string const& x, char const* y) const {
+    return std::strcmp(x.c_str(), y) < 0;
+  }
+  bool operator()(char const* x, std::string const& y) const {
+    return std::strcmp(x, y.c_str()) < 0;
+  }
+};
+
+using map = slb::flat_map<int, std::string>;
+
+} // namespace flat_map
+
+// [flat.map], class template flat_map
+TEST_CASE("flat_map(iterator)", "[flat.map]") {
+  using flat_map::map;
+  CHECK((std::is_same<std::iterator_traits<map::iterator>::iterator_category,
+                      std::random_access_iterator_tag>::value));
+  CHECK((std::is_convertible<map::iterator, map::const_iterator>::value));
+  CHECK_FALSE(
+      (std::is_convertible<map::const_iterator, map::iterator>::value));
+
+  map m = {{1, "a"}, {2, "b"}, {3, "c"}};
+  map::iterator it = m.begin();
+  CHECK(it->first == 1);
+  it->second = "x";
+  CHECK(m.values()[0] == "x");
+  CHECK((*++it).first == 2);
+  CHECK(it[1].second == "c");
+  CHECK(m.end() - m.begin() == 3);
+  CHECK(m.begin() + 3 == m.end());
+  CHECK(m.cbegin() < m.cend());
+  map::const_iterator cit = it;
+  CHECK(cit == it);
+  CHECK(std::prev(m.rend())->first == 1);
+  CHECK(m.crbegin()->first == 3);
+}
+
+// [flat.map.cons], constructors
+TEST_CASE("flat_map(construct)", "[flat.map.cons]") {
+  using flat_map::map;
+
+  /* default */ {
+    map const m;
+    CHECK(m.empty());
+    CHECK(m.size() == 0);
+  }
+
+  /* containers */ {
+    // Sorted by key; the first of any equivalent keys is kept.
+    map const m(std::vector<int>{3, 1, 2, 1}, {"c", "a", "b", "z"});
+    CHECK((m.keys() == std::vector<int>{1, 2, 3}));
+    CHECK((m.values() == std::vector<std::string>{"a", "b", "c"}));
+
+    slb::flat_map<int, int, std::greater<int>> const g = {{1, 1}, {3, 3}};
+    CHECK(g.begin()->first == 3);
+  }
+
+  /* sorted_unique */ {
+    map const m(slb::sorted_unique, {1, 2, 4}, {"a", "b", "d"});
+    CHECK(m.size() == 3);
+    CHECK(m.at(4) == "d");
+
+    std::pair<int, std::string> const arr[] = {{1, "a"}, {5, "e"}};
+    map const r(slb::sorted_unique, arr, arr + 2);
+    CHECK(r.at(5) == "e");
+  }
+
+  /* range */ {
+    std::pair<int, std::string> const arr[] = {{5, "e"}, {1, "a"}, {5, "x"}};
+    slb::flat_map<int, std::string, std::less<int>, std::deque<int>,
+                  std::deque<std::string>> const m(arr, arr + 3);
+    CHECK(m.size() == 2);
+    CHECK(m.at(5) == "e");
+  }
+}
+
+// [flat.map.access], element access
+// [flat.map.modifiers], modifiers
+TEST_CASE("flat_map(modifiers)", "[flat.map.modifiers]") {
+  using flat_map::map;
+
+  map m;
+  m[2] = "b";
+  m[1] = "a";
+  CHECK(m.size() == 2);
+  CHECK(m.at(1) == "a");
+  CHECK_THROWS_AS(m.at(3), std::out_of_range);
+
+  std::pair<map::iterator, bool> r = m.insert({3, "c"});
+  CHECK(r.second);
+  CHECK(r.first->second == "c");
+  r = m.insert(std::make_pair(3, "z"));
+  CHECK_FALSE(r.second);
+  CHECK(r.first->second == "c");
+  CHECK(m.emplace(0, "0").second);
+  CHECK(m.try_emplace(0, "z").second == false);
+  CHECK(m.try_emplace(4, 2, 'd').first->second == "dd");
+  CHECK_FALSE(m.insert_or_assign(4, "d").second);
+  CHECK(m.at(4) == "d");
+  CHECK(m.insert_or_assign(m.end(), 5, "e")->first == 5);
+  CHECK((m.keys() == std::vector<int>{0, 1, 2, 3, 4, 5}));
+
+  // Bulk insertion merges, and keeps the existing elements.
+  m.insert({{7, "g"}, {2, "z"}, {6, "f"}, {7, "z"}});
+  CHECK((m.keys() == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+  CHECK(m.at(2) == "b");
+  CHECK(m.at(7) == "g");
+  m.insert(slb::sorted_unique, {{8, "h"}, {9, "i"}});
+  CHECK(m.size() == 10);
+
+  CHECK(m.erase(3) == 1);
+  CHECK(m.erase(3) == 0);
+  CHECK(m.erase(m.begin())->first == 1);
+  CHECK(m.erase(m.cbegin(), m.cbegin() + 2)->first == 4);
+  CHECK((m.keys() == std::vector<int>{4, 5, 6, 7, 8, 9}));
+
+  CHECK(slb::erase_if(m, [](map::const_reference x) {
+          return x.first % 2 == 0;
+        }) == 3);
+  CHECK((m.keys() == std::vector<int>{5, 7, 9}));
+  CHECK((m.values() == std::vector<std::string>{"e", "g", "i"}));
+
+  map::containers c = std::move(m).extract();
+  CHECK(m.empty());
+  CHECK((c.keys == std::vector<int>{5, 7, 9}));
+  c.keys.push_back(10);
+  c.values.push_back("j");
+  m.replace(std::move(c.keys), std::move(c.values));
+  CHECK(m.at(10) == "j");
+
+  map n = {{1, "a"}};
+  swap(m, n);
+  CHECK(m.size() == 1);
+  CHECK(n.size() == 4);
+  n.clear();
+  CHECK(n.empty());
+}
+
+// map operations
+TEST_CASE("flat_map(lookup)", "[flat.map]") {
+  using flat_map::map;
+
+  map const m = {{1, "a"}, {3, "c"}, {5, "e"}};
+  CHECK(m.find(3)->second == "c");
+  CHECK(m.find(2) == m.end());
+  CHECK(m.count(5) == 1);
+  CHECK(m.contains(1));
+  CHECK_FALSE(m.contains(0));
+  CHECK(m.lower_bound(2)->first == 3);
+  CHECK(m.lower_bound(3)->first == 3);
+  CHECK(m.upper_bound(3)->first == 5);
+  CHECK(m.upper_bound(5) == m.end());
+  CHECK(m.equal_range(3).first == m.begin() + 1);
+  CHECK(m.equal_range(3).second == m.begin() + 2);
+  CHECK(m.equal_range(4).first == m.equal_range(4).second);
+  CHECK(m.key_comp()(1, 2));
+  CHECK(m.value_comp()(*m.begin(), *(m.begin() + 1)));
+}
+
+TEST_CASE("flat_map(transparent)", "[flat.map]") {
+  slb::flat_map<std::string, int, flat_map::string_less> m = {{"b", 2},
+                                                              {"a", 1}};
+  CHECK(m.contains("a"));
+  CHECK(m.find("b")->second == 2);
+  CHECK(m.count("c") == 0);
+  CHECK(m.at("a") == 1);
+  CHECK(m.lower_bound("b") == m.begin() + 1);
+  CHECK(m.upper_bound("a") == m.begin() + 1);
+  CHECK(m.equal_range("a").second == m.begin() + 1);
+  m["c"] = 3;
+  CHECK(m.try_emplace("d", 4).second);
+  CHECK_FALSE(m.insert_or_assign("d", 5).second);
+  CHECK(m.at("d") == 5);
+  CHECK(m.erase("a") == 1);
+  CHECK(m.size() == 3);
+}
+
+TEST_CASE("flat_map(compare)", "[flat.map]") {
+  using flat_map::map;
+  map const a = {{1, "a"}, {2, "b"}};
+  map const b = {{1, "a"}, {2, "c"}};
+  map const c = {{1, "a"}};
+  CHECK(a == a);
+  CHECK(a != b);
+  CHECK(a < b);
+  CHECK(c < a);
+  CHECK(b > a);
+  CHECK(a <= a);
+  CHECK(b >= a);
+}
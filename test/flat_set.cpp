@@ -0,0 +1,199 @@
+/*
+  SLB.FlatSet
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/flat_set.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace flat_set {
+
+struct string_less {
+  using is_transparent = void;
+
+  bool operator()(std::string const& x, std::string const& y) const {
+    return x < y;
+  }
+  bool operator()(std::string const& x, char const* y) const {
+    return std::strcmp(x.c_str(), y) < 0;
+  }
+  bool operator()(char const* x, std::string const& y) const {
+    return std::strcmp(x, y.c_str()) < 0;
+  }
+};
+
+// Only explicitly constructible from the `int` it compares with.
+struct id {
+  explicit id(int v) : v(v) {}
+
+  int v;
+};
+
+struct id_less {
+  using is_transparent = void;
+
+  bool operator()(id x, id y) const { return x.v < y.v; }
+  bool operator()(id x, int y) const { return x.v < y; }
+  bool operator()(int x, id y) const { return x < y.v; }
+};
+
+} // namespace flat_set
+
+// [flat.set.cons], constructors
+TEST_CASE("flat_set(construct)", "[flat.set.cons]") {
+  /* default */ {
+    slb::flat_set<int> const s;
+    CHECK(s.empty());
+    CHECK(s.size() == 0);
+  }
+
+  /* container */ {
+    slb::flat_set<int> const s(std::vector<int>{3, 1, 2, 3, 1});
+    CHECK(s.size() == 3);
+    CHECK((std::vector<int>(s.begin(), s.end()) == std::vector<int>{1, 2, 3}));
+
+    slb::flat_set<int, std::greater<int>> const g = {1, 3, 2};
+    CHECK(*g.begin() == 3);
+  }
+
+  /* sorted_unique */ {
+    slb::flat_set<int> const s(slb::sorted_unique, std::vector<int>{1, 2, 4});
+    CHECK(s.size() == 3);
+    int const arr[] = {1, 5, 7};
+    slb::flat_set<int> const r(slb::sorted_unique, arr, arr + 3);
+    CHECK(r.contains(5));
+    slb::flat_set<int> const il(slb::sorted_unique, {1, 2});
+    CHECK(il.size() == 2);
+  }
+
+  /* range */ {
+    int const arr[] = {5, 3, 5, 1};
+    slb::flat_set<int, std::less<int>, std::deque<int>> const s(arr, arr + 4);
+    CHECK(s.size() == 3);
+    CHECK(*s.begin() == 1);
+  }
+}
+
+// [flat.set.modifiers], modifiers
+TEST_CASE("flat_set(modifiers)", "[flat.set.modifiers]") {
+  slb::flat_set<int> s = {1, 3};
+  std::pair<slb::flat_set<int>::iterator, bool> r = s.insert(2);
+  CHECK(r.second);
+  CHECK(*r.first == 2);
+  r = s.insert(2);
+  CHECK_FALSE(r.second);
+  CHECK(*s.emplace(0).first == 0);
+  CHECK(*s.insert(s.end(), 4) == 4);
+  CHECK(s.size() == 5);
+
+  // Bulk insertion merges, and keeps the existing elements.
+  s.insert({7, 2, 5, 7});
+  CHECK((std::vector<int>(s.begin(), s.end()) ==
+         std::vector<int>{0, 1, 2, 3, 4, 5, 7}));
+  s.insert(slb::sorted_unique, {6, 8});
+  CHECK(s.size() == 9);
+  CHECK(std::is_sorted(s.begin(), s.end()));
+
+  CHECK(s.erase(3) == 1);
+  CHECK(s.erase(3) == 0);
+  CHECK(*s.erase(s.begin()) == 1);
+  CHECK(s.erase(s.begin(), s.begin() + 2) == s.begin());
+  CHECK((std::vector<int>(s.begin(), s.end()) ==
+         std::vector<int>{4, 5, 6, 7, 8}));
+
+  CHECK(slb::erase_if(s, [](int x) { return x % 2 == 0; }) == 3);
+  CHECK(s.size() == 2);
+
+  std::vector<int> v = std::move(s).extract();
+  CHECK((v == std::vector<int>{5, 7}));
+  CHECK(s.empty());
+  v.push_back(9);
+  s.replace(std::move(v));
+  CHECK(s.size() == 3);
+
+  slb::flat_set<int> t = {1};
+  swap(s, t);
+  CHECK(s.size() == 1);
+  CHECK(t.size() == 3);
+  t.clear();
+  CHECK(t.empty());
+}
+
+// set operations
+TEST_CASE("flat_set(lookup)", "[flat.set]") {
+  // Checks the branchless searches against the standard ones for every
+  // position in ranges of several sizes.
+  for (int n = 0; n < 20; ++n) {
+    std::vector<int> v;
+    for (int i = 0; i < n; ++i) {
+      v.push_back(2 * i);
+    }
+    slb::flat_set<int> const s(slb::sorted_unique, v);
+    for (int x = -1; x <= 2 * n; ++x) {
+      CHECK(s.lower_bound(x) - s.begin() ==
+            std::lower_bound(v.begin(), v.end(), x) - v.begin());
+      CHECK(s.upper_bound(x) - s.begin() ==
+            std::upper_bound(v.begin(), v.end(), x) - v.begin());
+      CHECK(s.contains(x) == (x >= 0 && x % 2 == 0 && x < 2 * n));
+    }
+  }
+
+  slb::flat_set<int> const s = {1, 2, 3};
+  CHECK(s.find(2) == s.begin() + 1);
+  CHECK(s.find(4) == s.end());
+  CHECK(s.count(3) == 1);
+  CHECK(s.count(4) == 0);
+  CHECK(s.equal_range(2).first == s.begin() + 1);
+  CHECK(s.equal_range(2).second == s.begin() + 2);
+  CHECK(s.equal_range(0).first == s.equal_range(0).second);
+}
+
+TEST_CASE("flat_set(transparent)", "[flat.set]") {
+  slb::flat_set<std::string, flat_set::string_less> s = {"b", "c", "a"};
+  CHECK(s.contains("b"));
+  CHECK(s.find("c") == s.begin() + 2);
+  CHECK(s.count("d") == 0);
+  CHECK(s.lower_bound("b") == s.begin() + 1);
+  CHECK(s.upper_bound("b") == s.begin() + 2);
+  CHECK(s.equal_range("a").second == s.begin() + 1);
+  CHECK(s.insert("d").second);
+  CHECK(s.erase("a") == 1);
+  CHECK(s.size() == 3);
+
+  /* explicit construction */ {
+    slb::flat_set<flat_set::id, flat_set::id_less> ids;
+    CHECK(ids.insert(2).second);
+    CHECK(ids.insert(1).second);
+    CHECK_FALSE(ids.insert(2).second);
+    CHECK(ids.size() == 2);
+    CHECK(ids.begin()->v == 1);
+  }
+}
+
+TEST_CASE("flat_set(compare)", "[flat.set]") {
+  slb::flat_set<int> const a = {1, 2, 3};
+  slb::flat_set<int> const b = {1, 2, 4};
+  slb::flat_set<int> const c = {1, 2};
+  CHECK(a == a);
+  CHECK(a != b);
+  CHECK(a < b);
+  CHECK(c < a);
+  CHECK(b > a);
+  CHECK(a <= a);
+  CHECK(b >= a);
+}
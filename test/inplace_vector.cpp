@@ -0,0 +1,268 @@
+/*
+  SLB.InplaceVector
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/inplace_vector.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "catch.hpp"
+
+namespace inplace_vector {
+
+// Tracks the number of live objects.
+struct Counted {
+  static int live;
+
+  int value;
+
+  Counted(int value = 0) : value(value) { ++live; }
+  Counted(Counted const& that) : value(that.value) { ++live; }
+  Counted(Counted&& that) noexcept : value(that.value) {
+    ++live;
+    that.value = -1;
+  }
+  Counted& operator=(Counted const&) = default;
+  Counted& operator=(Counted&&) = default;
+  ~Counted() { --live; }
+
+  friend bool operator==(Counted const& lhs, Counted const& rhs) {
+    return lhs.value == rhs.value;
+  }
+};
+
+int Counted::live = 0;
+
+} // namespace inplace_vector
+
+// [inplace.vector], class template inplace_vector
+TEST_CASE("inplace_vector(layout)", "[inplace.vector]") {
+  // The size is stored in the smallest type that can represent the capacity.
+  CHECK((sizeof(slb::inplace_vector<char, 8>) == 9));
+  CHECK((sizeof(slb::inplace_vector<char, 255>) == 256));
+  CHECK((sizeof(slb::inplace_vector<char, 256>) ==
+         256 + sizeof(unsigned short)));
+  CHECK((sizeof(slb::inplace_vector<int, 4>) == 5 * sizeof(int)));
+  CHECK((alignof(slb::inplace_vector<double, 2>) == alignof(double)));
+
+  // Trivially copyable elements make for a trivially copyable vector.
+  CHECK((std::is_trivially_copyable<slb::inplace_vector<int, 4>>::value));
+  CHECK((std::is_trivially_destructible<slb::inplace_vector<int, 4>>::value));
+  CHECK((std::is_trivially_copyable<
+         slb::inplace_vector<std::string, 0>>::value));
+  CHECK_FALSE((std::is_trivially_copyable<
+               slb::inplace_vector<std::string, 4>>::value));
+  CHECK((std::is_nothrow_move_constructible<
+         slb::inplace_vector<std::string, 4>>::value));
+
+  CHECK((slb::inplace_vector<int, 4>::capacity() == 4));
+  CHECK((slb::inplace_vector<int, 4>::max_size() == 4));
+}
+
+// [inplace.vector.cons], construct/copy/destroy
+TEST_CASE("inplace_vector(construct)", "[inplace.vector.cons]") {
+  using inplace_vector::Counted;
+
+  /* default */ {
+    slb::inplace_vector<int, 4> const v;
+    CHECK(v.empty());
+    CHECK(v.size() == 0);
+  }
+
+  /* count */ {
+    slb::inplace_vector<int, 4> const v(3);
+    CHECK(v.size() == 3);
+    CHECK(v[0] == 0);
+    CHECK(v[2] == 0);
+
+    slb::inplace_vector<int, 4> const w(2, 7);
+    CHECK(w.size() == 2);
+    CHECK(w[1] == 7);
+
+    CHECK_THROWS_AS((slb::inplace_vector<int, 4>(5)), std::bad_alloc);
+  }
+
+  /* range */ {
+    int const arr[] = {1, 2, 3};
+    slb::inplace_vector<int, 4> const v(arr, arr + 3);
+    CHECK(v.size() == 3);
+    CHECK(v.back() == 3);
+
+    std::istringstream in("4 5 6");
+    slb::inplace_vector<int, 4> const w((std::istream_iterator<int>(in)),
+                                        std::istream_iterator<int>());
+    CHECK(w.size() == 3);
+    CHECK(w.front() == 4);
+
+    slb::inplace_vector<int, 4> const il = {1, 2, 3, 4};
+    CHECK(il.size() == 4);
+    CHECK_THROWS_AS((slb::inplace_vector<int, 2>(arr, arr + 3)),
+                    std::bad_alloc);
+  }
+
+  /* copy and move */ {
+    {
+      slb::inplace_vector<Counted, 4> v = {1, 2, 3};
+      CHECK(Counted::live == 3);
+
+      slb::inplace_vector<Counted, 4> copy = v;
+      CHECK(Counted::live == 6);
+      CHECK(copy == v);
+
+      slb::inplace_vector<Counted, 4> moved = std::move(v);
+      CHECK(Counted::live == 9);
+      CHECK(moved == copy);
+
+      slb::inplace_vector<Counted, 4> shorter = {7};
+      shorter = copy;
+      CHECK(shorter == copy);
+      CHECK(Counted::live == 12);
+
+      slb::inplace_vector<Counted, 4> longer = {1, 2, 3, 4};
+      CHECK(Counted::live == 16);
+      longer = std::move(shorter);
+      CHECK(longer == copy);
+      CHECK(Counted::live == 15);
+    }
+    CHECK(Counted::live == 0);
+  }
+
+  /* assign */ {
+    slb::inplace_vector<std::string, 4> v = {"a", "b"};
+    v.assign(3, "c");
+    CHECK(v.size() == 3);
+    CHECK(v[2] == "c");
+    v = {"d"};
+    CHECK(v.size() == 1);
+    CHECK(v[0] == "d");
+    std::string const arr[] = {"e", "f"};
+    v.assign(arr, arr + 2);
+    CHECK(v.size() == 2);
+    CHECK(v[1] == "f");
+    CHECK_THROWS_AS(v.assign(5, "g"), std::bad_alloc);
+  }
+}
+
+// [inplace.vector.capacity], size/capacity
+// [inplace.vector.data], data access
+TEST_CASE("inplace_vector(access)", "[inplace.vector.capacity]") {
+  slb::inplace_vector<int, 4> v = {1, 2};
+  v.resize(4);
+  CHECK(v.size() == 4);
+  CHECK(v[3] == 0);
+  v.resize(1);
+  CHECK(v.size() == 1);
+  v.resize(3, 5);
+  CHECK(v[2] == 5);
+  CHECK_THROWS_AS(v.resize(5), std::bad_alloc);
+  CHECK_THROWS_AS(v.reserve(5), std::bad_alloc);
+  v.reserve(4);
+  v.shrink_to_fit();
+
+  CHECK(v.at(2) == 5);
+  CHECK_THROWS_AS(v.at(3), std::out_of_range);
+  CHECK(v.data() == &v.front());
+  CHECK(v.end() - v.begin() == 3);
+  CHECK(*v.rbegin() == 5);
+  CHECK(v.crend() - v.crbegin() == 3);
+}
+
+// [inplace.vector.modifiers], modifiers
+TEST_CASE("inplace_vector(modifiers)", "[inplace.vector.modifiers]") {
+  using inplace_vector::Counted;
+
+  /* append */ {
+    slb::inplace_vector<std::unique_ptr<int>, 2> v;
+    v.emplace_back(new int(1));
+    CHECK(*v.push_back(std::unique_ptr<int>(new int(2))) == 2);
+    CHECK_THROWS_AS(v.emplace_back(), std::bad_alloc);
+    CHECK(v.try_emplace_back() == nullptr);
+
+    std::unique_ptr<int> p(new int(3));
+    CHECK(v.try_push_back(std::move(p)) == nullptr);
+    CHECK(p != nullptr); // not moved from
+    v.pop_back();
+    std::unique_ptr<int>* const q = v.try_push_back(std::move(p));
+    CHECK(q == &v.back());
+    CHECK(*v.back() == 3);
+    v.pop_back();
+    CHECK(*v.unchecked_emplace_back(new int(4)) == 4);
+  }
+
+  /* insert */ {
+    slb::inplace_vector<int, 8> v = {1, 5};
+    CHECK(*v.insert(v.begin() + 1, 2) == 2);
+    int const arr[] = {3, 4};
+    CHECK(*v.insert(v.begin() + 2, arr, arr + 2) == 3);
+    CHECK(*v.emplace(v.end(), 6) == 6);
+    CHECK(*v.insert(v.begin(), 2, 0) == 0);
+    CHECK(v == (slb::inplace_vector<int, 8>{0, 0, 1, 2, 3, 4, 5, 6}));
+    CHECK_THROWS_AS(v.insert(v.begin(), 1), std::bad_alloc);
+
+    // Inserting an element of the vector itself.
+    slb::inplace_vector<std::string, 4> s = {"a", "b"};
+    s.insert(s.begin(), s.back());
+    CHECK(s == (slb::inplace_vector<std::string, 4>{"b", "a", "b"}));
+  }
+
+  /* erase */ {
+    {
+      slb::inplace_vector<Counted, 8> v = {0, 1, 2, 3, 4, 5};
+      CHECK(v.erase(v.begin())->value == 1);
+      CHECK(v.erase(v.begin() + 1, v.begin() + 3)->value == 4);
+      CHECK(v == (slb::inplace_vector<Counted, 8>{1, 4, 5}));
+      CHECK(Counted::live == 3);
+      v.clear();
+      CHECK(v.empty());
+      CHECK(Counted::live == 0);
+    }
+
+    slb::inplace_vector<int, 8> v = {1, 2, 3, 2, 1};
+    CHECK(slb::erase(v, 2) == 2);
+    CHECK(v == (slb::inplace_vector<int, 8>{1, 3, 1}));
+    CHECK(slb::erase_if(v, [](int x) { return x < 2; }) == 2);
+    CHECK(v.size() == 1);
+  }
+
+  /* swap */ {
+    {
+      slb::inplace_vector<Counted, 4> a = {1, 2, 3};
+      slb::inplace_vector<Counted, 4> b = {4};
+      swap(a, b);
+      CHECK(a == (slb::inplace_vector<Counted, 4>{4}));
+      CHECK(b == (slb::inplace_vector<Counted, 4>{1, 2, 3}));
+      a.swap(b);
+      CHECK(a.size() == 3);
+      CHECK(b.size() == 1);
+      CHECK(Counted::live == 4);
+    }
+    CHECK(Counted::live == 0);
+  }
+}
+
+TEST_CASE("inplace_vector(compare)", "[inplace.vector]") {
+  slb::inplace_vector<int, 4> const a = {1, 2, 3};
+  slb::inplace_vector<int, 4> const b = {1, 2, 4};
+  slb::inplace_vector<int, 4> const c = {1, 2};
+  CHECK(a == a);
+  CHECK(a != b);
+  CHECK(a < b);
+  CHECK(c < a);
+  CHECK(b > a);
+  CHECK(a <= a);
+  CHECK(b >= a);
+}
@@ -0,0 +1,71 @@
+/*
+  SLB.Latch
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/latch.hpp>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+TEST_CASE("latch", "[thread.latch.class]") {
+  CHECK(slb::latch::max() > 0);
+
+  slb::latch done(3);
+  CHECK_FALSE(done.try_wait());
+  done.count_down();
+  CHECK_FALSE(done.try_wait());
+  done.count_down(2);
+  CHECK(done.try_wait());
+  done.wait();
+
+  slb::latch zero(0);
+  CHECK(zero.try_wait());
+  zero.wait();
+
+  slb::latch one(1);
+  one.arrive_and_wait();
+  CHECK(one.try_wait());
+}
+
+TEST_CASE("latch(concurrent)", "[thread.latch.class]") {
+  enum : int { threads = 4 };
+  slb::latch start(1);
+  slb::latch done(threads);
+  std::vector<int> results(threads);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; ++i) {
+    workers.emplace_back([&, i] {
+      start.wait();
+      results[static_cast<std::size_t>(i)] = i + 1;
+      done.count_down();
+    });
+  }
+  start.count_down();
+  done.wait();
+  for (int i = 0; i < threads; ++i) {
+    CHECK(results[static_cast<std::size_t>(i)] == i + 1);
+  }
+  for (std::thread& w : workers) {
+    w.join();
+  }
+
+  // Every thread returns from `arrive_and_wait` only after all arrived.
+  slb::latch sync(threads);
+  std::vector<std::thread> arrivals;
+  for (int i = 0; i < threads; ++i) {
+    arrivals.emplace_back([&] { sync.arrive_and_wait(); });
+  }
+  for (std::thread& a : arrivals) {
+    a.join();
+  }
+  CHECK(sync.try_wait());
+}
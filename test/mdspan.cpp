@@ -0,0 +1,382 @@
+/*
+  SLB.MDSpan
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/mdspan.hpp>
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "catch.hpp"
+
+namespace mdspan {
+
+using slb::dynamic_extent;
+
+// Matrix multiply over static extents, checked against the same loop with
+// the offsets written out by hand.
+template <typename A, typename B, typename C>
+void multiply(A a, B b, C c) {
+  for (std::size_t i = 0; i < c.extent(0); ++i) {
+    for (std::size_t j = 0; j < c.extent(1); ++j) {
+      int sum = 0;
+      for (std::size_t k = 0; k < a.extent(1); ++k) {
+        sum += a(i, k) * b(k, j);
+      }
+      c(i, j) = sum;
+    }
+  }
+}
+
+} // namespace mdspan
+
+// [mdspan.extents], class template extents
+
+TEST_CASE("extents", "[mdspan.extents]") {
+  using mdspan::dynamic_extent;
+
+  using E = slb::extents<int, 2, dynamic_extent, 4, dynamic_extent>;
+  CHECK(E::rank() == 4);
+  CHECK(E::rank_dynamic() == 2);
+  CHECK(E::static_extent(0) == 2);
+  CHECK(E::static_extent(1) == dynamic_extent);
+  CHECK((std::is_same<E::index_type, int>::value));
+  CHECK((std::is_same<E::size_type, unsigned>::value));
+
+  constexpr E e(3, 5);
+  static_assert(e.extent(0) == 2 && e.extent(1) == 3, "");
+  static_assert(e.extent(2) == 4 && e.extent(3) == 5, "");
+  constexpr E all(2, 3, 4, 5);
+  static_assert(all == e, "");
+  E const arr(std::array<int, 2>{{3, 5}});
+  CHECK(arr == e);
+  E const arr_all(std::array<long, 4>{{2, 3, 4, 5}});
+  CHECK(arr_all == e);
+  E const zero;
+  CHECK(zero.extent(1) == 0);
+  CHECK(zero != e);
+
+  // Static extents take no space.
+  CHECK(std::is_empty<slb::extents<int, 2, 3>>::value);
+  CHECK(sizeof(E) == 2 * sizeof(int));
+  CHECK(std::is_empty<slb::extents<int>>::value);
+
+  // Conversions that may not hold are explicit.
+  CHECK((std::is_convertible<slb::extents<int, 2, 3>,
+                             slb::extents<long, 2, dynamic_extent>>::value));
+  CHECK_FALSE((std::is_convertible<slb::extents<int, dynamic_extent>,
+                                   slb::extents<int, 3>>::value));
+  CHECK((std::is_constructible<slb::extents<int, 3>,
+                               slb::extents<int, dynamic_extent>>::value));
+  CHECK_FALSE((std::is_convertible<slb::extents<long, 3>,
+                                   slb::extents<int, 3>>::value));
+  CHECK_FALSE((std::is_constructible<slb::extents<int, 3>,
+                                     slb::extents<int, 4>>::value));
+  CHECK_FALSE((std::is_constructible<slb::extents<int, 3>,
+                                     slb::extents<int, 3, 1>>::value));
+  slb::extents<int, 2, dynamic_extent> const c = slb::extents<short, 2, 7>();
+  CHECK(c.extent(1) == 7);
+  CHECK(c == slb::extents<short, 2, 7>());
+
+  CHECK((std::is_same<slb::dextents<int, 2>,
+                      slb::extents<int, dynamic_extent, dynamic_extent>>::
+             value));
+  CHECK((std::is_same<slb::dextents<int, 0>, slb::extents<int>>::value));
+}
+
+// [mdspan.layout], layout mapping
+
+TEST_CASE("layout_right", "[mdspan.layout.right]") {
+  using mapping = slb::layout_right::mapping<slb::extents<int, 2, 3, 4>>;
+  constexpr mapping m;
+  static_assert(m(0, 0, 0) == 0, "");
+  static_assert(m(0, 0, 1) == 1, "");
+  static_assert(m(0, 1, 0) == 4, "");
+  static_assert(m(1, 2, 3) == 23, "");
+  static_assert(m.required_span_size() == 24, "");
+  static_assert(m.stride(0) == 12 && m.stride(1) == 4 && m.stride(2) == 1,
+                "");
+  CHECK(mapping::is_always_exhaustive());
+  CHECK(m.is_unique());
+
+  slb::layout_right::mapping<slb::dextents<int, 3>> const d(
+      slb::dextents<int, 3>(2, 3, 4));
+  CHECK(d == m);
+  CHECK(d(1, 2, 3) == 23);
+
+  slb::layout_right::mapping<slb::extents<int>> const r0;
+  CHECK(r0() == 0);
+  CHECK(r0.required_span_size() == 1);
+
+  slb::layout_right::mapping<slb::extents<int, 2, 0>> const empty;
+  CHECK(empty.required_span_size() == 0);
+}
+
+TEST_CASE("layout_left", "[mdspan.layout.left]") {
+  using mapping = slb::layout_left::mapping<slb::extents<int, 2, 3, 4>>;
+  constexpr mapping m;
+  static_assert(m(0, 0, 0) == 0, "");
+  static_assert(m(1, 0, 0) == 1, "");
+  static_assert(m(0, 1, 0) == 2, "");
+  static_assert(m(1, 2, 3) == 23, "");
+  static_assert(m.required_span_size() == 24, "");
+  static_assert(m.stride(0) == 1 && m.stride(1) == 2 && m.stride(2) == 6, "");
+
+  // With a rank of one, the layouts coincide.
+  slb::layout_right::mapping<slb::extents<int, 5>> const r;
+  slb::layout_left::mapping<slb::extents<int, 5>> const l(r);
+  CHECK(l(3) == r(3));
+}
+
+TEST_CASE("layout_stride", "[mdspan.layout.stride]") {
+  using E = slb::extents<int, 2, 3>;
+  slb::layout_stride::mapping<E> const m(E(), std::array<int, 2>{{1, 4}});
+  CHECK(m(1, 2) == 9);
+  CHECK(m.stride(1) == 4);
+  CHECK(m.required_span_size() == 10);
+  CHECK_FALSE(m.is_exhaustive());
+  CHECK((m.strides() == std::array<int, 2>{{1, 4}}));
+
+  slb::layout_stride::mapping<E> const d;
+  CHECK(d.stride(0) == 3);
+  CHECK(d.stride(1) == 1);
+  CHECK(d.is_exhaustive());
+  CHECK(d == slb::layout_stride::mapping<E>(slb::layout_right::mapping<E>()));
+  CHECK(d != m);
+
+  slb::layout_stride::mapping<E> const l = slb::layout_left::mapping<E>();
+  CHECK(l.stride(0) == 1);
+  CHECK(l.stride(1) == 2);
+  CHECK(l.is_exhaustive());
+  CHECK(l(1, 2) == slb::layout_left::mapping<E>()(1, 2));
+
+  int const s[] = {3, 1};
+  slb::span<int const, 2> const ss(s);
+  slb::layout_stride::mapping<E> const sp(E(), ss);
+  CHECK(sp == d);
+
+  slb::layout_stride::mapping<slb::extents<int, 2, 0>> const empty;
+  CHECK(empty.required_span_size() == 0);
+}
+
+// [mdspan.mdspan], class template mdspan
+
+TEST_CASE("mdspan(construct)", "[mdspan.mdspan.cons]") {
+  using mdspan::dynamic_extent;
+  int data[24] = {};
+
+  slb::mdspan<int, slb::extents<int, 2, dynamic_extent>> const a(data, 12);
+  CHECK(a.data_handle() == data);
+  CHECK(a.extent(0) == 2);
+  CHECK(a.extent(1) == 12);
+  CHECK(a.size() == 24);
+  CHECK_FALSE(a.empty());
+  CHECK(a.rank() == 2);
+  CHECK(a.rank_dynamic() == 1);
+  CHECK(a.static_extent(0) == 2);
+
+  slb::mdspan<int, slb::dextents<int, 3>> const b(data, 2, 3, 4);
+  CHECK(b.size() == 24);
+  slb::mdspan<int, slb::dextents<int, 2>> const c(
+      data, std::array<int, 2>{{4, 6}});
+  CHECK(c.extent(1) == 6);
+  slb::mdspan<int, slb::extents<int, 4, 6>, slb::layout_left> const d(
+      data, slb::extents<int, 4, 6>());
+  CHECK(d.stride(1) == 4);
+  slb::mdspan<int, slb::extents<int, 4, 6>> const e(
+      data, slb::layout_right::mapping<slb::extents<int, 4, 6>>());
+  CHECK(e.stride(0) == 6);
+
+  // Adding `const` and erasing static extents is implicit.
+  slb::mdspan<int const, slb::dextents<int, 2>> const f = e;
+  CHECK(f.extent(0) == 4);
+  CHECK(&f(1, 1) == &e(1, 1));
+  CHECK_FALSE((std::is_convertible<
+               slb::mdspan<int const, slb::dextents<int, 2>>,
+               slb::mdspan<int, slb::dextents<int, 2>>>::value));
+  CHECK_FALSE((std::is_convertible<
+               slb::mdspan<int, slb::dextents<int, 2>>,
+               slb::mdspan<int, slb::extents<int, 4, 6>>>::value));
+  slb::mdspan<int, slb::extents<int, 4, 6>> const g(c);
+  CHECK(g.extent(1) == 6);
+
+  slb::mdspan<int, slb::dextents<int, 2>> h;
+  CHECK(h.data_handle() == nullptr);
+  CHECK(h.empty());
+  slb::mdspan<int, slb::dextents<int, 2>> k = c;
+  swap(h, k);
+  CHECK(h.extent(0) == 4);
+  CHECK(k.empty());
+  CHECK_FALSE((std::is_default_constructible<
+               slb::mdspan<int, slb::extents<int, 2>>>::value));
+
+#if __cpp_deduction_guides
+  slb::mdspan i(data, 4, 6);
+  CHECK((std::is_same<decltype(i),
+                      slb::mdspan<int, slb::dextents<std::size_t, 2>>>::value));
+  slb::mdspan j(data, slb::extents<int, 4, 6>());
+  CHECK((std::is_same<decltype(j),
+                      slb::mdspan<int, slb::extents<int, 4, 6>>>::value));
+#endif
+}
+
+TEST_CASE("mdspan(access)", "[mdspan.mdspan.members]") {
+  using mdspan::dynamic_extent;
+  int data[12];
+  for (int n = 0; n < 12; ++n) {
+    data[n] = n;
+  }
+
+  slb::mdspan<int, slb::extents<int, 3, 4>> const r(data);
+  CHECK(r(0, 0) == 0);
+  CHECK(r(1, 2) == 6);
+  CHECK(r(2, 3) == 11);
+  CHECK((r[std::array<int, 2>{{2, 1}}] == 9));
+  std::size_t const idx[] = {1, 3};
+  CHECK((r[slb::span<std::size_t const, 2>(idx)] == 7));
+
+  slb::mdspan<int, slb::extents<int, dynamic_extent, 4>, slb::layout_left>
+      const l(data, 3);
+  CHECK(l(1, 2) == 7);
+  l(1, 2) = 42;
+  CHECK(data[7] == 42);
+
+  slb::mdspan<int, slb::extents<int>> const s(data + 5);
+  CHECK(s() == 5);
+  CHECK(s.size() == 1);
+
+#if __cpp_multidimensional_subscript >= 202110L
+  CHECK(r[1, 2] == 6);
+#endif
+
+  int a[6] = {1, 2, 3, 4, 5, 6};
+  int b[6] = {1, 0, 0, 1, 1, 1};
+  int c[4] = {};
+  int h[4] = {};
+  mdspan::multiply(slb::mdspan<int, slb::extents<std::size_t, 2, 3>>(a),
+                   slb::mdspan<int, slb::extents<std::size_t, 3, 2>>(b),
+                   slb::mdspan<int, slb::extents<std::size_t, 2, 2>>(c));
+  for (std::size_t i = 0; i < 2; ++i) {
+    for (std::size_t j = 0; j < 2; ++j) {
+      for (std::size_t k = 0; k < 3; ++k) {
+        h[i * 2 + j] += a[i * 3 + k] * b[k * 2 + j];
+      }
+    }
+  }
+  CHECK(c[0] == h[0]);
+  CHECK(c[1] == h[1]);
+  CHECK(c[2] == h[2]);
+  CHECK(c[3] == h[3]);
+}
+
+// [mdspan.sub], submdspan creation
+
+TEST_CASE("submdspan", "[mdspan.sub]") {
+  using mdspan::dynamic_extent;
+  int data[24];
+  for (int n = 0; n < 24; ++n) {
+    data[n] = n;
+  }
+  slb::mdspan<int, slb::extents<int, 2, 3, 4>> const m(data);
+
+  /* index */ {
+    auto row = slb::submdspan(m, 1, 2, slb::full_extent);
+    CHECK((std::is_same<decltype(row)::extents_type,
+                        slb::extents<int, 4>>::value));
+    CHECK((std::is_same<decltype(row)::layout_type,
+                        slb::layout_right>::value));
+    CHECK(row(0) == 20);
+    CHECK(row(3) == 23);
+
+    auto col = slb::submdspan(m, 1, slb::full_extent, 2);
+    CHECK((std::is_same<decltype(col)::layout_type,
+                        slb::layout_stride>::value));
+    CHECK(col.extent(0) == 3);
+    CHECK(col.stride(0) == 4);
+    CHECK(col(2) == 22);
+
+    auto elem = slb::submdspan(m, 1, 1, 1);
+    CHECK(elem.rank() == 0);
+    CHECK(elem() == 17);
+  }
+
+  /* range */ {
+    auto block = slb::submdspan(m, slb::full_extent, std::make_pair(1, 3),
+                                std::make_tuple(1, 3));
+    CHECK((std::is_same<decltype(block)::extents_type,
+                        slb::extents<int, 2, dynamic_extent,
+                                     dynamic_extent>>::value));
+    CHECK((std::is_same<decltype(block)::layout_type,
+                        slb::layout_stride>::value));
+    CHECK(block.extent(1) == 2);
+    CHECK(block.extent(2) == 2);
+    CHECK(block(0, 0, 0) == 5);
+    CHECK(block(1, 1, 1) == 22);
+
+    auto rows = slb::submdspan(m, 1, std::make_pair(1, 3), slb::full_extent);
+    CHECK((std::is_same<decltype(rows)::layout_type,
+                        slb::layout_right>::value));
+    CHECK(rows(0, 0) == 16);
+    CHECK(rows(1, 3) == 23);
+  }
+
+  /* strided */ {
+    auto even =
+        slb::submdspan(m, 0, 1, slb::strided_slice<int, int, int>{0, 4, 2});
+    CHECK(even.extent(0) == 2);
+    CHECK(even.stride(0) == 2);
+    CHECK(even(0) == 4);
+    CHECK(even(1) == 6);
+  }
+
+  /* layout_left */ {
+    slb::mdspan<int, slb::extents<int, 4, 6>, slb::layout_left> const l(data);
+    auto col = slb::submdspan(l, slb::full_extent, 2);
+    CHECK((std::is_same<decltype(col)::layout_type,
+                        slb::layout_left>::value));
+    CHECK(col(3) == 11);
+    auto sub = slb::submdspan(col, std::make_pair(1, 3));
+    CHECK(sub(0) == 9);
+
+    // Slicing a strided view keeps the strides.
+    auto row = slb::submdspan(l, 1, slb::full_extent);
+    auto part = slb::submdspan(row, std::make_pair(2, 5));
+    CHECK((std::is_same<decltype(part)::layout_type,
+                        slb::layout_stride>::value));
+    CHECK(part(0) == 9);
+    CHECK(part.stride(0) == 4);
+  }
+
+  // A 5-point stencil over the interior of a grid.
+  int grid[5 * 6];
+  for (int n = 0; n < 30; ++n) {
+    grid[n] = n * n;
+  }
+  slb::mdspan<int, slb::extents<int, 5, 6>> const g(grid);
+  auto interior =
+      slb::submdspan(g, std::make_pair(1, 4), std::make_pair(1, 5));
+  int sum = 0;
+  for (int i = 0; i < interior.extent(0); ++i) {
+    for (int j = 0; j < interior.extent(1); ++j) {
+      sum += g(i, j + 1) + g(i + 2, j + 1) + g(i + 1, j) + g(i + 1, j + 2) -
+             4 * interior(i, j);
+    }
+  }
+  int ref = 0;
+  for (int i = 1; i < 4; ++i) {
+    for (int j = 1; j < 5; ++j) {
+      ref += grid[(i - 1) * 6 + j] + grid[(i + 1) * 6 + j] +
+             grid[i * 6 + j - 1] + grid[i * 6 + j + 1] - 4 * grid[i * 6 + j];
+    }
+  }
+  CHECK(sum == ref);
+}
@@ -0,0 +1,468 @@
+/*
+  SLB.Memory
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/memory.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "catch.hpp"
+
+// Tracks the number of live objects, and optionally throws on the N-th
+// construction.
+struct Counted {
+  static int live;
+  static int throw_countdown;
+
+  int value;
+
+  Counted() : value(0) { construct(); }
+  explicit Counted(int value) : value(value) { construct(); }
+  Counted(Counted const& that) : value(that.value) { construct(); }
+  Counted(Counted&& that) : value(that.value) {
+    construct();
+    that.value = -1;
+  }
+  ~Counted() { --live; }
+
+private:
+  static void construct() {
+    if (throw_countdown > 0 && --throw_countdown == 0) {
+      throw 0;
+    }
+    ++live;
+  }
+};
+
+int Counted::live = 0;
+int Counted::throw_countdown = 0;
+
+template <typename T, std::size_t N>
+struct raw_buffer {
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type data[N];
+
+  T* get() noexcept { return reinterpret_cast<T*>(data); }
+};
+
+// [specialized.destroy], destroy
+
+// template<class T>
+//   void destroy_at(T* location);
+TEST_CASE("destroy_at", "[specialized.destroy]") {
+  raw_buffer<Counted, 1> buffer;
+  ::new (static_cast<void*>(buffer.get())) Counted(42);
+  CHECK(Counted::live == 1);
+  slb::destroy_at(buffer.get());
+  CHECK(Counted::live == 0);
+}
+
+// template<class NoThrowForwardIterator>
+//   void destroy(NoThrowForwardIterator first, NoThrowForwardIterator last);
+TEST_CASE("destroy", "[specialized.destroy]") {
+  raw_buffer<Counted, 3> buffer;
+  for (int i = 0; i < 3; ++i) {
+    ::new (static_cast<void*>(buffer.get() + i)) Counted(i);
+  }
+  CHECK(Counted::live == 3);
+  slb::destroy(buffer.get(), buffer.get() + 3);
+  CHECK(Counted::live == 0);
+
+  int ints[] = {1, 2, 3};
+  slb::destroy(ints, ints + 3);
+}
+
+// template<class NoThrowForwardIterator, class Size>
+//   NoThrowForwardIterator destroy_n(NoThrowForwardIterator first, Size n);
+TEST_CASE("destroy_n", "[specialized.destroy]") {
+  raw_buffer<Counted, 3> buffer;
+  for (int i = 0; i < 3; ++i) {
+    ::new (static_cast<void*>(buffer.get() + i)) Counted(i);
+  }
+  CHECK(slb::destroy_n(buffer.get(), 2) == buffer.get() + 2);
+  CHECK(Counted::live == 1);
+  CHECK(slb::destroy_n(buffer.get() + 2, 1) == buffer.get() + 3);
+  CHECK(Counted::live == 0);
+
+  int ints[] = {1, 2, 3};
+  CHECK(slb::destroy_n(ints, 3) == ints + 3);
+}
+
+// [uninitialized.copy], uninitialized_copy
+
+// template<class InputIterator, class NoThrowForwardIterator>
+//   NoThrowForwardIterator uninitialized_copy(InputIterator first,
+//                                             InputIterator last,
+//                                             NoThrowForwardIterator result);
+TEST_CASE("uninitialized_copy", "[uninitialized.copy]") {
+  /* trivial */ {
+    int const source[] = {1, 2, 3};
+    raw_buffer<int, 3> buffer;
+    CHECK(slb::uninitialized_copy(source, source + 3, buffer.get()) ==
+          buffer.get() + 3);
+    CHECK(buffer.get()[0] == 1);
+    CHECK(buffer.get()[2] == 3);
+    CHECK(slb::uninitialized_copy(source, source, buffer.get()) ==
+          buffer.get());
+  }
+
+  /* non-trivial */ {
+    Counted source[] = {Counted(1), Counted(2), Counted(3)};
+    raw_buffer<Counted, 3> buffer;
+    CHECK(slb::uninitialized_copy(source, source + 3, buffer.get()) ==
+          buffer.get() + 3);
+    CHECK(Counted::live == 6);
+    CHECK(buffer.get()[2].value == 3);
+    CHECK(source[2].value == 3);
+    slb::destroy(buffer.get(), buffer.get() + 3);
+  }
+
+  /* throws */ {
+    Counted source[] = {Counted(1), Counted(2), Counted(3)};
+    raw_buffer<Counted, 3> buffer;
+    Counted::throw_countdown = 3;
+    CHECK_THROWS(slb::uninitialized_copy(source, source + 3, buffer.get()));
+    CHECK(Counted::live == 3);
+  }
+}
+
+// template<class InputIterator, class Size, class NoThrowForwardIterator>
+//   NoThrowForwardIterator uninitialized_copy_n(InputIterator first, Size n,
+//                                               NoThrowForwardIterator result);
+TEST_CASE("uninitialized_copy_n", "[uninitialized.copy]") {
+  /* trivial */ {
+    int const source[] = {1, 2, 3};
+    raw_buffer<int, 3> buffer;
+    CHECK(slb::uninitialized_copy_n(source, 2, buffer.get()) ==
+          buffer.get() + 2);
+    CHECK(buffer.get()[1] == 2);
+  }
+
+  /* non-trivial */ {
+    Counted source[] = {Counted(1), Counted(2), Counted(3)};
+    raw_buffer<Counted, 3> buffer;
+    CHECK(slb::uninitialized_copy_n(source, 2, buffer.get()) ==
+          buffer.get() + 2);
+    CHECK(Counted::live == 5);
+    CHECK(buffer.get()[1].value == 2);
+    slb::destroy_n(buffer.get(), 2);
+  }
+}
+
+// [uninitialized.move], uninitialized_move
+
+// template<class InputIterator, class NoThrowForwardIterator>
+//   NoThrowForwardIterator uninitialized_move(InputIterator first,
+//                                             InputIterator last,
+//                                             NoThrowForwardIterator result);
+TEST_CASE("uninitialized_move", "[uninitialized.move]") {
+  /* trivial */ {
+    int source[] = {1, 2, 3};
+    raw_buffer<int, 3> buffer;
+    CHECK(slb::uninitialized_move(source, source + 3, buffer.get()) ==
+          buffer.get() + 3);
+    CHECK(buffer.get()[2] == 3);
+  }
+
+  /* non-trivial */ {
+    Counted source[] = {Counted(1), Counted(2), Counted(3)};
+    raw_buffer<Counted, 3> buffer;
+    CHECK(slb::uninitialized_move(source, source + 3, buffer.get()) ==
+          buffer.get() + 3);
+    CHECK(Counted::live == 6);
+    CHECK(buffer.get()[2].value == 3);
+    CHECK(source[2].value == -1);
+    slb::destroy(buffer.get(), buffer.get() + 3);
+  }
+
+  /* throws */ {
+    Counted source[] = {Counted(1), Counted(2), Counted(3)};
+    raw_buffer<Counted, 3> buffer;
+    Counted::throw_countdown = 2;
+    CHECK_THROWS(slb::uninitialized_move(source, source + 3, buffer.get()));
+    CHECK(Counted::live == 3);
+  }
+}
+
+// template<class InputIterator, class Size, class NoThrowForwardIterator>
+//   pair<InputIterator, NoThrowForwardIterator>
+//     uninitialized_move_n(InputIterator first, Size n,
+//                          NoThrowForwardIterator result);
+TEST_CASE("uninitialized_move_n", "[uninitialized.move]") {
+  /* trivial */ {
+    int source[] = {1, 2, 3};
+    raw_buffer<int, 3> buffer;
+    std::pair<int*, int*> result =
+        slb::uninitialized_move_n(source, 2, buffer.get());
+    CHECK(result.first == source + 2);
+    CHECK(result.second == buffer.get() + 2);
+    CHECK(buffer.get()[1] == 2);
+  }
+
+  /* non-trivial */ {
+    Counted source[] = {Counted(1), Counted(2), Counted(3)};
+    raw_buffer<Counted, 3> buffer;
+    std::pair<Counted*, Counted*> result =
+        slb::uninitialized_move_n(source, 2, buffer.get());
+    CHECK(result.first == source + 2);
+    CHECK(result.second == buffer.get() + 2);
+    CHECK(Counted::live == 5);
+    CHECK(source[1].value == -1);
+    slb::destroy_n(buffer.get(), 2);
+  }
+}
+
+// [uninitialized.construct.default], uninitialized_default_construct
+
+// template<class NoThrowForwardIterator>
+//   void uninitialized_default_construct(NoThrowForwardIterator first,
+//                                        NoThrowForwardIterator last);
+TEST_CASE("uninitialized_default_construct",
+          "[uninitialized.construct.default]") {
+  /* trivial */ {
+    raw_buffer<int, 3> buffer;
+    slb::uninitialized_default_construct(buffer.get(), buffer.get() + 3);
+  }
+
+  /* non-trivial */ {
+    raw_buffer<Counted, 3> buffer;
+    slb::uninitialized_default_construct(buffer.get(), buffer.get() + 3);
+    CHECK(Counted::live == 3);
+    CHECK(buffer.get()[2].value == 0);
+    slb::destroy(buffer.get(), buffer.get() + 3);
+  }
+
+  /* throws */ {
+    raw_buffer<Counted, 3> buffer;
+    Counted::throw_countdown = 3;
+    CHECK_THROWS(
+        slb::uninitialized_default_construct(buffer.get(), buffer.get() + 3));
+    CHECK(Counted::live == 0);
+  }
+}
+
+// template<class NoThrowForwardIterator, class Size>
+//   NoThrowForwardIterator
+//     uninitialized_default_construct_n(NoThrowForwardIterator first, Size n);
+TEST_CASE("uninitialized_default_construct_n",
+          "[uninitialized.construct.default]") {
+  /* trivial */ {
+    raw_buffer<int, 3> buffer;
+    CHECK(slb::uninitialized_default_construct_n(buffer.get(), 3) ==
+          buffer.get() + 3);
+  }
+
+  /* non-trivial */ {
+    raw_buffer<Counted, 3> buffer;
+    CHECK(slb::uninitialized_default_construct_n(buffer.get(), 2) ==
+          buffer.get() + 2);
+    CHECK(Counted::live == 2);
+    slb::destroy_n(buffer.get(), 2);
+  }
+}
+
+// [uninitialized.construct.value], uninitialized_value_construct
+
+// template<class NoThrowForwardIterator>
+//   void uninitialized_value_construct(NoThrowForwardIterator first,
+//                                      NoThrowForwardIterator last);
+TEST_CASE("uninitialized_value_construct", "[uninitialized.construct.value]") {
+  struct S {
+    int x;
+  };
+
+  /* scalar */ {
+    int values[] = {1, 2, 3};
+    slb::uninitialized_value_construct(values, values + 3);
+    CHECK(values[0] == 0);
+    CHECK(values[2] == 0);
+
+    int* pointers[] = {values, values};
+    slb::uninitialized_value_construct(pointers, pointers + 2);
+    CHECK(pointers[1] == nullptr);
+
+    int S::*members[] = {&S::x, &S::x};
+    slb::uninitialized_value_construct(members, members + 2);
+    CHECK(members[1] == nullptr);
+  }
+
+  /* trivial */ {
+    S values[] = {{1}, {2}};
+    slb::uninitialized_value_construct(values, values + 2);
+    CHECK(values[1].x == 0);
+  }
+
+  /* non-trivial */ {
+    raw_buffer<Counted, 3> buffer;
+    slb::uninitialized_value_construct(buffer.get(), buffer.get() + 3);
+    CHECK(Counted::live == 3);
+    slb::destroy(buffer.get(), buffer.get() + 3);
+  }
+
+  /* throws */ {
+    raw_buffer<Counted, 3> buffer;
+    Counted::throw_countdown = 2;
+    CHECK_THROWS(
+        slb::uninitialized_value_construct(buffer.get(), buffer.get() + 3));
+    CHECK(Counted::live == 0);
+  }
+}
+
+// template<class NoThrowForwardIterator, class Size>
+//   NoThrowForwardIterator
+//     uninitialized_value_construct_n(NoThrowForwardIterator first, Size n);
+TEST_CASE("uninitialized_value_construct_n",
+          "[uninitialized.construct.value]") {
+  /* scalar */ {
+    double values[] = {1.0, 2.0, 3.0};
+    CHECK(slb::uninitialized_value_construct_n(values, 2) == values + 2);
+    CHECK(values[1] == 0.0);
+    CHECK(values[2] == 3.0);
+  }
+
+  /* non-trivial */ {
+    raw_buffer<Counted, 3> buffer;
+    CHECK(slb::uninitialized_value_construct_n(buffer.get(), 2) ==
+          buffer.get() + 2);
+    CHECK(Counted::live == 2);
+    slb::destroy_n(buffer.get(), 2);
+  }
+}
+
+// P1144: "Object relocation in terms of move plus destroy"
+
+// template<class T>
+//   T* relocate_at(T* source, T* dest);
+TEST_CASE("relocate_at", "[specialized.relocate]") {
+  /* trivially relocatable */ {
+    raw_buffer<int, 2> buffer;
+    int* source = ::new (static_cast<void*>(buffer.get())) int(42);
+    int* dest = buffer.get() + 1;
+    CHECK(noexcept(slb::relocate_at(source, dest)));
+    CHECK(slb::relocate_at(source, dest) == dest);
+    CHECK(*dest == 42);
+  }
+
+  /* move + destroy */ {
+    raw_buffer<Counted, 2> buffer;
+    Counted* source = ::new (static_cast<void*>(buffer.get())) Counted(42);
+    Counted* dest = buffer.get() + 1;
+    CHECK_FALSE(noexcept(slb::relocate_at(source, dest)));
+    CHECK(slb::relocate_at(source, dest) == dest);
+    CHECK(dest->value == 42);
+    CHECK(Counted::live == 1);
+    slb::destroy_at(dest);
+  }
+
+  /* throws */ {
+    raw_buffer<Counted, 2> buffer;
+    Counted* source = ::new (static_cast<void*>(buffer.get())) Counted(42);
+    Counted::throw_countdown = 1;
+    CHECK_THROWS(slb::relocate_at(source, buffer.get() + 1));
+    CHECK(Counted::live == 0);
+  }
+}
+
+// template<class InputIterator, class NoThrowForwardIterator>
+//   NoThrowForwardIterator uninitialized_relocate(InputIterator first,
+//                                                 InputIterator last,
+//                                                 NoThrowForwardIterator result);
+TEST_CASE("uninitialized_relocate", "[specialized.relocate]") {
+  /* trivially relocatable */ {
+    int source[] = {1, 2, 3, 4};
+    raw_buffer<int, 4> buffer;
+    int* dest = buffer.get();
+    CHECK(slb::uninitialized_relocate(source, source + 4, dest) == dest + 4);
+    CHECK(dest[0] == 1);
+    CHECK(dest[3] == 4);
+    CHECK(slb::uninitialized_relocate(source, source, dest) == dest);
+  }
+
+  /* overlapping */ {
+    int values[] = {1, 2, 3, 4, 0};
+    CHECK(slb::uninitialized_relocate(values, values + 4, values + 1) ==
+          values + 5);
+    CHECK(values[1] == 1);
+    CHECK(values[4] == 4);
+  }
+
+  /* move + destroy */ {
+    raw_buffer<Counted, 3> source;
+    raw_buffer<Counted, 3> dest;
+    for (int i = 0; i < 3; ++i) {
+      ::new (static_cast<void*>(source.get() + i)) Counted(i);
+    }
+    CHECK(slb::uninitialized_relocate(source.get(), source.get() + 3,
+                                      dest.get()) == dest.get() + 3);
+    CHECK(Counted::live == 3);
+    CHECK(dest.get()[2].value == 2);
+    for (int i = 0; i < 3; ++i) {
+      slb::destroy_at(dest.get() + i);
+    }
+  }
+
+  /* throws */ {
+    raw_buffer<Counted, 3> source;
+    raw_buffer<Counted, 3> dest;
+    for (int i = 0; i < 3; ++i) {
+      ::new (static_cast<void*>(source.get() + i)) Counted(i);
+    }
+    Counted::throw_countdown = 2;
+    CHECK_THROWS(slb::uninitialized_relocate(source.get(), source.get() + 3,
+                                             dest.get()));
+    CHECK(Counted::live == 0);
+  }
+}
+
+// template<class InputIterator, class Size, class NoThrowForwardIterator>
+//   pair<InputIterator, NoThrowForwardIterator>
+//     uninitialized_relocate_n(InputIterator first, Size n,
+//                              NoThrowForwardIterator result);
+TEST_CASE("uninitialized_relocate_n", "[specialized.relocate]") {
+  /* trivially relocatable */ {
+    int source[] = {1, 2, 3, 4};
+    raw_buffer<int, 4> buffer;
+    int* dest = buffer.get();
+    std::pair<int*, int*> result =
+        slb::uninitialized_relocate_n(source, 3, dest);
+    CHECK(result.first == source + 3);
+    CHECK(result.second == dest + 3);
+    CHECK(dest[2] == 3);
+  }
+
+  /* move + destroy */ {
+    raw_buffer<Counted, 3> source;
+    raw_buffer<Counted, 3> dest;
+    for (int i = 0; i < 3; ++i) {
+      ::new (static_cast<void*>(source.get() + i)) Counted(i);
+    }
+    std::pair<Counted*, Counted*> result =
+        slb::uninitialized_relocate_n(source.get(), 3, dest.get());
+    CHECK(result.first == source.get() + 3);
+    CHECK(result.second == dest.get() + 3);
+    CHECK(Counted::live == 3);
+    for (int i = 0; i < 3; ++i) {
+      slb::destroy_at(dest.get() + i);
+    }
+  }
+
+  /* throws */ {
+    raw_buffer<Counted, 3> source;
+    raw_buffer<Counted, 3> dest;
+    for (int i = 0; i < 3; ++i) {
+      ::new (static_cast<void*>(source.get() + i)) Counted(i);
+    }
+    Counted::throw_countdown = 3;
+    CHECK_THROWS(slb::uninitialized_relocate_n(source.get(), 3, dest.get()));
+    CHECK(Counted::live == 0);
+  }
+}
@@ -0,0 +1,381 @@
+/*
+  SLB.MemoryResource
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/memory_resource.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace memory_resource {
+
+// Forwards to `new_delete_resource`, keeping count of what is outstanding.
+class counting_resource : public slb::pmr::memory_resource {
+public:
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t bytes = 0;
+
+private:
+  void* do_allocate(std::size_t n, std::size_t alignment) override {
+    void* const p = slb::pmr::new_delete_resource()->allocate(n, alignment);
+    ++allocations;
+    bytes += n;
+    return p;
+  }
+
+  void do_deallocate(void* p, std::size_t n, std::size_t alignment) override {
+    slb::pmr::new_delete_resource()->deallocate(p, n, alignment);
+    ++deallocations;
+    bytes -= n;
+  }
+
+  bool do_is_equal(
+      slb::pmr::memory_resource const& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+bool is_aligned(void* p, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+// A type that uses a polymorphic allocator, in either convention.
+struct leading {
+  using allocator_type = slb::pmr::polymorphic_allocator<char>;
+  leading(std::allocator_arg_t, allocator_type const& alloc, int v)
+      : resource(alloc.resource()), value(v) {}
+  slb::pmr::memory_resource* resource;
+  int value;
+};
+
+struct trailing {
+  using allocator_type = slb::pmr::polymorphic_allocator<char>;
+  trailing(int v, allocator_type const& alloc)
+      : resource(alloc.resource()), value(v) {}
+  slb::pmr::memory_resource* resource;
+  int value;
+};
+
+} // namespace memory_resource
+
+// [mem.res.global], global memory resources
+TEST_CASE("memory_resource", "[mem.res]") {
+  slb::pmr::memory_resource* const new_delete =
+      slb::pmr::new_delete_resource();
+  CHECK(new_delete == slb::pmr::new_delete_resource());
+  CHECK(*new_delete == *slb::pmr::new_delete_resource());
+  CHECK(*new_delete != *slb::pmr::null_memory_resource());
+
+  void* const p = new_delete->allocate(24);
+  CHECK(memory_resource::is_aligned(p, alignof(std::max_align_t)));
+  new_delete->deallocate(p, 24);
+
+  void* const q = new_delete->allocate(100, 256);
+  CHECK(memory_resource::is_aligned(q, 256));
+  new_delete->deallocate(q, 100, 256);
+
+  CHECK_THROWS_AS(slb::pmr::null_memory_resource()->allocate(1),
+                  std::bad_alloc);
+
+  CHECK(slb::pmr::get_default_resource() == new_delete);
+  memory_resource::counting_resource counting;
+  CHECK(slb::pmr::set_default_resource(&counting) == new_delete);
+  CHECK(slb::pmr::get_default_resource() == &counting);
+  CHECK(slb::pmr::set_default_resource(nullptr) == &counting);
+  CHECK(slb::pmr::get_default_resource() == new_delete);
+}
+
+// [mem.poly.allocator.class], class template polymorphic_allocator
+TEST_CASE("polymorphic_allocator", "[mem.poly.allocator.class]") {
+  memory_resource::counting_resource counting;
+  slb::pmr::polymorphic_allocator<int> alloc(&counting);
+  CHECK(alloc.resource() == &counting);
+  CHECK(slb::pmr::polymorphic_allocator<int>().resource() ==
+        slb::pmr::get_default_resource());
+
+  slb::pmr::polymorphic_allocator<double> const rebound(alloc);
+  CHECK(rebound.resource() == &counting);
+  CHECK(rebound == alloc);
+  CHECK(alloc != slb::pmr::polymorphic_allocator<int>());
+  CHECK(alloc.select_on_container_copy_construction().resource() ==
+        slb::pmr::get_default_resource());
+
+  int* const p = alloc.allocate(4);
+  CHECK(counting.bytes == 4 * sizeof(int));
+  alloc.deallocate(p, 4);
+  CHECK(counting.bytes == 0);
+
+  /* container */ {
+    std::vector<int, slb::pmr::polymorphic_allocator<int>> v(alloc);
+    v.push_back(1);
+    v.push_back(2);
+    CHECK(counting.allocations > 0);
+  }
+  CHECK(counting.bytes == 0);
+
+  /* uses-allocator construction */ {
+    slb::pmr::polymorphic_allocator<char> a(&counting);
+    alignas(memory_resource::leading) unsigned char storage[64];
+
+    auto* const l = reinterpret_cast<memory_resource::leading*>(storage);
+    a.construct(l, 1);
+    CHECK(l->resource == &counting);
+    CHECK(l->value == 1);
+    std::allocator_traits<decltype(a)>::destroy(a, l);
+
+    auto* const t = reinterpret_cast<memory_resource::trailing*>(storage);
+    a.construct(t, 2);
+    CHECK(t->resource == &counting);
+    CHECK(t->value == 2);
+    std::allocator_traits<decltype(a)>::destroy(a, t);
+
+    using pair = std::pair<memory_resource::leading, memory_resource::trailing>;
+    auto* const pr = reinterpret_cast<pair*>(storage);
+    static_assert(sizeof(pair) <= sizeof(storage), "");
+    a.construct(pr, 3, 4);
+    CHECK(pr->first.resource == &counting);
+    CHECK(pr->second.resource == &counting);
+    CHECK(pr->second.value == 4);
+    std::allocator_traits<decltype(a)>::destroy(a, pr);
+
+    a.construct(pr,
+                std::piecewise_construct,
+                std::forward_as_tuple(5),
+                std::forward_as_tuple(6));
+    CHECK(pr->first.value == 5);
+    CHECK(pr->second.resource == &counting);
+    std::allocator_traits<decltype(a)>::destroy(a, pr);
+  }
+
+  /* map */ {
+    using value_type = std::pair<int const, memory_resource::trailing>;
+    std::map<int,
+             memory_resource::trailing,
+             std::less<int>,
+             slb::pmr::polymorphic_allocator<value_type>>
+        m(alloc);
+    m.emplace(std::piecewise_construct,
+              std::forward_as_tuple(1),
+              std::forward_as_tuple(7));
+    CHECK(m.at(1).resource == &counting);
+  }
+  CHECK(counting.bytes == 0);
+}
+
+// [mem.res.monotonic.buffer], class monotonic_buffer_resource
+TEST_CASE("monotonic_buffer_resource", "[mem.res.monotonic.buffer]") {
+  memory_resource::counting_resource upstream;
+  alignas(std::max_align_t) unsigned char buffer[64];
+  /* initial buffer */ {
+    slb::pmr::monotonic_buffer_resource mr(buffer, sizeof(buffer), &upstream);
+    CHECK(mr.upstream_resource() == &upstream);
+
+    void* const a = mr.allocate(1, 1);
+    void* const b = mr.allocate(8, 8);
+    CHECK(a == buffer);
+    CHECK(memory_resource::is_aligned(b, 8));
+    CHECK(b == buffer + 8);
+    CHECK(upstream.allocations == 0);
+
+    mr.deallocate(b, 8, 8);
+    CHECK(mr.allocate(8, 8) != b);
+
+    // Exhausting the buffer goes upstream.
+    void* const c = mr.allocate(100, 64);
+    CHECK(memory_resource::is_aligned(c, 64));
+    CHECK(upstream.allocations == 1);
+    for (int i = 0; i < 1000; ++i) {
+      CHECK(mr.allocate(64) != nullptr);
+    }
+    std::size_t const chunks = upstream.allocations;
+    CHECK(chunks > 1);
+    CHECK(chunks < 32); // buffers grow geometrically
+
+    mr.release();
+    CHECK(upstream.bytes == 0);
+    CHECK(mr.allocate(1, 1) == buffer);
+  }
+  CHECK(upstream.bytes == 0);
+
+  /* initial size */ {
+    slb::pmr::monotonic_buffer_resource mr(4096, &upstream);
+    std::size_t const allocations = upstream.allocations;
+    void* const p = mr.allocate(4000);
+    CHECK(upstream.allocations == allocations + 1);
+    CHECK(upstream.bytes >= 4096);
+    void* const q = mr.allocate(8);
+    CHECK(p != q);
+    CHECK(upstream.allocations == allocations + 1);
+    CHECK(mr.allocate(200) != nullptr);
+    CHECK(upstream.allocations == allocations + 2);
+  }
+  CHECK(upstream.bytes == 0);
+
+  /* large request */ {
+    slb::pmr::monotonic_buffer_resource mr(&upstream);
+    void* const p = mr.allocate(1 << 16, 4096);
+    CHECK(memory_resource::is_aligned(p, 4096));
+  }
+  CHECK(upstream.bytes == 0);
+}
+
+// [mem.res.pool], pool resource classes
+TEST_CASE("unsynchronized_pool_resource", "[mem.res.pool]") {
+  memory_resource::counting_resource upstream;
+  /* options */ {
+    slb::pmr::pool_options opts;
+    opts.max_blocks_per_chunk = 16;
+    opts.largest_required_pool_block = 100;
+    slb::pmr::unsynchronized_pool_resource mr(opts, &upstream);
+    CHECK(mr.upstream_resource() == &upstream);
+    CHECK(mr.options().max_blocks_per_chunk == 16);
+    CHECK(mr.options().largest_required_pool_block >= 100);
+  }
+
+  /* pooling */ {
+    slb::pmr::unsynchronized_pool_resource mr(&upstream);
+    void* const a = mr.allocate(24, 8);
+    void* const b = mr.allocate(24, 8);
+    CHECK(a != b);
+    std::size_t const allocations = upstream.allocations;
+    mr.deallocate(a, 24, 8);
+    CHECK(mr.allocate(24, 8) == a); // freed blocks are reused first
+    CHECK(upstream.allocations == allocations);
+
+    for (std::size_t size = 1; size <= 4096; size *= 2) {
+      for (std::size_t alignment = 1; alignment <= size; alignment *= 2) {
+        void* const p = mr.allocate(size, alignment);
+        CHECK(memory_resource::is_aligned(p, alignment));
+        mr.deallocate(p, size, alignment);
+      }
+    }
+
+    std::vector<void*> blocks;
+    for (int i = 0; i < 1000; ++i) {
+      blocks.push_back(mr.allocate(32));
+    }
+    for (void* p : blocks) {
+      mr.deallocate(p, 32);
+    }
+    std::size_t const chunks = upstream.allocations;
+    for (int i = 0; i < 1000; ++i) {
+      CHECK(mr.allocate(32) != nullptr);
+    }
+    CHECK(upstream.allocations == chunks);
+
+    // Oversized requests go upstream.
+    void* const big = mr.allocate(1 << 20, 128);
+    CHECK(memory_resource::is_aligned(big, 128));
+    CHECK(upstream.bytes >= (1 << 20));
+    mr.deallocate(big, 1 << 20, 128);
+    CHECK(upstream.bytes < (1 << 20));
+    CHECK(mr.allocate(1 << 20) != nullptr);
+
+    mr.release();
+    CHECK(upstream.bytes == 0);
+    void* const c = mr.allocate(24, 8);
+    CHECK(c != nullptr);
+  }
+  CHECK(upstream.bytes == 0);
+  CHECK(upstream.allocations == upstream.deallocations);
+}
+
+TEST_CASE("synchronized_pool_resource", "[mem.res.pool]") {
+  memory_resource::counting_resource upstream;
+  /* threads */ {
+    slb::pmr::synchronized_pool_resource mr(&upstream);
+    CHECK(mr.upstream_resource() == &upstream);
+
+    void* const a = mr.allocate(24, 8);
+    mr.deallocate(a, 24, 8);
+    CHECK(mr.allocate(24, 8) == a);
+
+    // Blocks are allocated and freed on different threads, and threads exit
+    // with blocks still cached.
+    int const threads = 4;
+    int const count = 2000;
+    std::vector<std::vector<void*>> blocks(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+      workers.emplace_back([&mr, &blocks, t] {
+        for (int i = 0; i < count; ++i) {
+          std::size_t const size = std::size_t(8) << (i % 6);
+          void* const p = mr.allocate(size);
+          *static_cast<int*>(p) = t;
+          if (i % 3 == 0) {
+            mr.deallocate(p, size);
+          } else {
+            blocks[t].push_back(p);
+          }
+        }
+      });
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    workers.clear();
+
+    std::vector<int> mismatches(threads);
+    for (int t = 0; t < threads; ++t) {
+      workers.emplace_back([&mr, &blocks, &mismatches, t] {
+        std::vector<void*> const& theirs = blocks[(t + 1) % threads];
+        int i = 0;
+        for (void* p : theirs) {
+          while (i % 3 == 0) {
+            ++i;
+          }
+          mismatches[t] += *static_cast<int*>(p) != (t + 1) % threads;
+          mr.deallocate(p, std::size_t(8) << (i % 6));
+          ++i;
+        }
+      });
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    for (int t = 0; t < threads; ++t) {
+      CHECK(mismatches[t] == 0);
+    }
+
+    // A released resource is usable again, from any thread.
+    mr.release();
+    CHECK(upstream.bytes == 0);
+    std::thread([&mr] {
+      void* const p = mr.allocate(64);
+      mr.deallocate(p, 64);
+    }).join();
+    void* const b = mr.allocate(64);
+    mr.deallocate(b, 64);
+  }
+  CHECK(upstream.bytes == 0);
+
+  /* resource destroyed before a thread exits */ {
+    std::unique_ptr<slb::pmr::synchronized_pool_resource> mr(
+        new slb::pmr::synchronized_pool_resource(&upstream));
+    void* const p = mr->allocate(16);
+    mr->deallocate(p, 16);
+    mr.reset();
+    CHECK(upstream.bytes == 0);
+
+    slb::pmr::synchronized_pool_resource other(&upstream);
+    void* const q = other.allocate(16);
+    other.deallocate(q, 16);
+  }
+  CHECK(upstream.bytes == 0);
+}
@@ -0,0 +1,27 @@
+/*
+  SLB.New
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/new.hpp>
+
+#include <cstddef>
+
+#include "catch.hpp"
+
+TEST_CASE("hardware_interference_size", "[hardware.interference]") {
+  constexpr std::size_t destructive =
+      slb::hardware_destructive_interference_size;
+  constexpr std::size_t constructive =
+      slb::hardware_constructive_interference_size;
+
+  CHECK(destructive >= alignof(std::max_align_t));
+  CHECK((destructive & (destructive - 1)) == 0);
+  CHECK(constructive >= alignof(std::max_align_t));
+  CHECK((constructive & (constructive - 1)) == 0);
+}
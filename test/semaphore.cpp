@@ -0,0 +1,87 @@
+/*
+  SLB.Semaphore
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/semaphore.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+TEST_CASE("counting_semaphore", "[thread.sema.cnt]") {
+  CHECK(slb::counting_semaphore<5>::max() >= 5);
+  CHECK(slb::binary_semaphore::max() >= 1);
+
+  slb::counting_semaphore<5> sema(2);
+  CHECK(sema.try_acquire());
+  CHECK(sema.try_acquire());
+  CHECK_FALSE(sema.try_acquire());
+
+  sema.release(3);
+  CHECK(sema.try_acquire());
+  sema.acquire();
+  CHECK(sema.try_acquire());
+  CHECK_FALSE(sema.try_acquire());
+
+  CHECK_FALSE(sema.try_acquire_for(std::chrono::milliseconds(1)));
+  CHECK_FALSE(sema.try_acquire_until(std::chrono::system_clock::now() +
+                                     std::chrono::milliseconds(1)));
+  sema.release();
+  CHECK(sema.try_acquire_for(std::chrono::milliseconds(1)));
+}
+
+TEST_CASE("counting_semaphore(concurrent)", "[thread.sema.cnt]") {
+  // A blocked acquire returns once another thread releases.
+  slb::binary_semaphore ready(0);
+  slb::binary_semaphore done(0);
+  int value = 0;
+  std::thread t([&] {
+    ready.acquire();
+    value = 42;
+    done.release();
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ready.release();
+  done.acquire();
+  CHECK(value == 42);
+  t.join();
+
+  // A timed acquire returns once another thread releases.
+  slb::binary_semaphore late(0);
+  std::thread releaser([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    late.release();
+  });
+  CHECK(late.try_acquire_for(std::chrono::seconds(10)));
+  releaser.join();
+
+  // Producers and consumers hand off every unit.
+  enum : int { threads = 4, units = 1000 };
+  slb::counting_semaphore<> items(0);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; ++i) {
+    workers.emplace_back([&] {
+      for (int j = 0; j < units; ++j) {
+        items.release();
+      }
+    });
+    workers.emplace_back([&] {
+      for (int j = 0; j < units; ++j) {
+        items.acquire();
+      }
+    });
+  }
+  for (std::thread& w : workers) {
+    w.join();
+  }
+  CHECK_FALSE(items.try_acquire());
+}
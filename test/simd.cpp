@@ -0,0 +1,562 @@
+/*
+  SLB.Simd
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/simd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include "catch.hpp"
+
+namespace simd {
+
+struct Iota {
+  template <std::size_t I>
+  int operator()(std::integral_constant<std::size_t, I>) const {
+    return static_cast<int>(I);
+  }
+};
+
+// Checks the mask reductions against the lanes selected by `bits`.
+template <typename T, typename Abi>
+void check_mask_reductions(std::uint64_t bits) {
+  using M = slb::simd_mask<T, Abi>;
+  std::size_t const n = M::size();
+  bool values[64];
+  int count = 0;
+  int first = -1;
+  int last = -1;
+  for (std::size_t i = 0; i < n; ++i) {
+    values[i] = ((bits >> i) & 1) != 0;
+    if (values[i]) {
+      ++count;
+      last = static_cast<int>(i);
+      if (first < 0) {
+        first = static_cast<int>(i);
+      }
+    }
+  }
+
+  M const m(values, slb::element_aligned);
+  for (std::size_t i = 0; i < n; ++i) {
+    CHECK(m[i] == values[i]);
+  }
+  CHECK(slb::all_of(m) == (count == static_cast<int>(n)));
+  CHECK(slb::any_of(m) == (count != 0));
+  CHECK(slb::none_of(m) == (count == 0));
+  CHECK(slb::some_of(m) == (count != 0 && count != static_cast<int>(n)));
+  CHECK(slb::popcount(m) == count);
+  if (count != 0) {
+    CHECK(slb::find_first_set(m) == first);
+    CHECK(slb::find_last_set(m) == last);
+  }
+}
+
+template <typename T, typename Abi>
+void check_mask_reductions() {
+  std::size_t const n = slb::simd_size<T, Abi>::value;
+  std::uint64_t const all = ~std::uint64_t(0) >> (64 - n);
+  check_mask_reductions<T, Abi>(0);
+  check_mask_reductions<T, Abi>(all);
+  check_mask_reductions<T, Abi>(1);
+  check_mask_reductions<T, Abi>(std::uint64_t(1) << (n - 1));
+  check_mask_reductions<T, Abi>(all & 0x5555555555555555u);
+  check_mask_reductions<T, Abi>(all & 0xF0F0F0F0F0F0F0F0u);
+}
+
+template <typename T, typename Abi>
+void check_arithmetic() {
+  using V = slb::simd<T, Abi>;
+  V const a(Iota{});
+  V const b(2);
+
+  V const sum = a + b;
+  V const diff = a - b;
+  V const prod = a * b;
+  V const quot = a / b;
+  for (std::size_t i = 0; i < V::size(); ++i) {
+    CHECK(sum[i] == static_cast<T>(static_cast<T>(i) + 2));
+    CHECK(diff[i] == static_cast<T>(static_cast<T>(i) - 2));
+    CHECK(prod[i] == static_cast<T>(static_cast<T>(i) * 2));
+    CHECK(quot[i] == static_cast<T>(static_cast<T>(i) / 2));
+    CHECK((-a)[i] == static_cast<T>(-static_cast<T>(i)));
+    CHECK((+a)[i] == static_cast<T>(i));
+  }
+
+  V c = a;
+  c += 3;
+  c *= b;
+  c -= 1;
+  for (std::size_t i = 0; i < V::size(); ++i) {
+    CHECK(c[i] == static_cast<T>((static_cast<T>(i) + 3) * 2 - 1));
+  }
+
+  V d = a;
+  CHECK((d++)[0] == 0);
+  CHECK((++d)[0] == 2);
+  CHECK((--d)[0] == 1);
+  CHECK((d--)[0] == 1);
+  CHECK(d[0] == 0);
+}
+
+template <typename T, typename Abi>
+void check_compare() {
+  using V = slb::simd<T, Abi>;
+  using M = typename V::mask_type;
+  V const a(Iota{});
+  V const b(1);
+
+  M const eq = a == b;
+  M const ne = a != b;
+  M const lt = a < b;
+  M const le = a <= b;
+  M const gt = a > b;
+  M const ge = a >= b;
+  M const zero = !a;
+  for (std::size_t i = 0; i < V::size(); ++i) {
+    CHECK(eq[i] == (i == 1));
+    CHECK(ne[i] == (i != 1));
+    CHECK(lt[i] == (i < 1));
+    CHECK(le[i] == (i <= 1));
+    CHECK(gt[i] == (i > 1));
+    CHECK(ge[i] == (i >= 1));
+    CHECK(zero[i] == (i == 0));
+  }
+}
+
+} // namespace simd
+
+TEST_CASE("simd_abi", "[simd.abi]") {
+  CHECK(slb::is_abi_tag<slb::simd_abi::scalar>::value);
+  CHECK(slb::is_abi_tag<slb::simd_abi::fixed_size<3>>::value);
+  CHECK(slb::is_abi_tag<slb::simd_abi::native<float>>::value);
+  CHECK_FALSE(slb::is_abi_tag<int>::value);
+
+  CHECK(slb::simd_size<float, slb::simd_abi::scalar>::value == 1);
+  CHECK(slb::simd_size<float, slb::simd_abi::fixed_size<5>>::value == 5);
+  CHECK(slb::simd_size<float>::value == 4);
+  CHECK(slb::simd_size<double>::value == 2);
+  CHECK(slb::simd_size<char>::value == 16);
+  CHECK(slb::native_simd<std::int8_t>::size() >= 16);
+  CHECK(slb::native_simd<std::int8_t>::size() ==
+        4 * slb::native_simd<std::int32_t>::size());
+  CHECK((slb::fixed_size_simd<short, 7>::size() == 7));
+
+  // The layout of `fixed_size` doesn't depend on the instruction sets.
+  CHECK(alignof(slb::fixed_size_simd<float, 8>) <= 16);
+  CHECK(alignof(slb::fixed_size_simd<float, 16>) <= 16);
+  CHECK(slb::native_simd<float>::size() ==
+        slb::native_simd<std::int32_t>::size());
+
+  CHECK(slb::is_simd<slb::native_simd<int>>::value);
+  CHECK_FALSE(slb::is_simd<slb::native_simd_mask<int>>::value);
+  CHECK(slb::is_simd_mask<slb::native_simd_mask<int>>::value);
+  CHECK_FALSE(slb::is_simd_mask<bool>::value);
+  CHECK(slb::is_simd_flag_type<slb::element_aligned_tag>::value);
+  CHECK(slb::is_simd_flag_type<slb::vector_aligned_tag>::value);
+  CHECK(slb::is_simd_flag_type<slb::overaligned_tag<64>>::value);
+  CHECK_FALSE(slb::is_simd_flag_type<int>::value);
+
+  CHECK((std::is_same<slb::simd<float>::mask_type,
+                      slb::simd_mask<float>>::value));
+  CHECK((std::is_same<slb::simd_mask<float>::simd_type,
+                      slb::simd<float>>::value));
+  CHECK(slb::memory_alignment<slb::simd<float>>::value ==
+        alignof(slb::simd<float>));
+  CHECK(slb::memory_alignment<slb::simd<float>, short>::value ==
+        alignof(short));
+}
+
+TEST_CASE("simd(construct)", "[simd.class]") {
+  // broadcast
+  {
+    slb::simd<float> const a(1.5f);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      CHECK(a[i] == 1.5f);
+    }
+
+    CHECK((std::is_convertible<int, slb::simd<float>>::value));
+    CHECK((std::is_convertible<short, slb::simd<float>>::value));
+    CHECK((std::is_convertible<float, slb::simd<double>>::value));
+    CHECK((std::is_convertible<unsigned, slb::simd<unsigned char>>::value));
+    CHECK_FALSE((std::is_convertible<double, slb::simd<float>>::value));
+    CHECK_FALSE((std::is_convertible<long long, slb::simd<float>>::value));
+    CHECK_FALSE((std::is_convertible<short, slb::simd<unsigned>>::value));
+    CHECK_FALSE((std::is_convertible<unsigned, slb::simd<int>>::value));
+  }
+
+  // generator
+  {
+    slb::native_simd<int> const a(simd::Iota{});
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      CHECK(a[i] == static_cast<int>(i));
+    }
+
+    slb::fixed_size_simd<double, 3> const b(simd::Iota{});
+    CHECK(b[0] == 0.0);
+    CHECK(b[1] == 1.0);
+    CHECK(b[2] == 2.0);
+  }
+
+  // load and store
+  {
+    alignas(64) float values[32];
+    for (std::size_t i = 0; i < 32; ++i) {
+      values[i] = static_cast<float>(i + 1);
+    }
+    slb::native_simd<float> a(values, slb::element_aligned);
+    slb::native_simd<float> b(values + 1, slb::element_aligned);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      CHECK(a[i] == values[i]);
+      CHECK(b[i] == values[i + 1]);
+    }
+
+    a.copy_from(values, slb::vector_aligned);
+    CHECK(a[a.size() - 1] == values[a.size() - 1]);
+    a.copy_from(values, slb::overaligned_tag<64>());
+    CHECK(a[0] == values[0]);
+
+    alignas(64) float out[16] = {};
+    (a + 1).copy_to(out, slb::vector_aligned);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      CHECK(out[i] == values[i] + 1);
+    }
+  }
+
+  // converting load and store
+  {
+    unsigned char const bytes[4] = {1, 2, 254, 255};
+    slb::fixed_size_simd<int, 4> const a(bytes, slb::element_aligned);
+    CHECK(a[0] == 1);
+    CHECK(a[3] == 255);
+
+    double out[4] = {};
+    a.copy_to(out, slb::element_aligned);
+    CHECK(out[2] == 254.0);
+  }
+
+  // scalar
+  {
+    slb::simd<int, slb::simd_abi::scalar> const a(7);
+    CHECK(a.size() == 1);
+    CHECK(a[0] == 7);
+  }
+}
+
+TEST_CASE("simd(arithmetic)", "[simd.class]") {
+  simd::check_arithmetic<float, slb::simd_abi::compatible<float>>();
+  simd::check_arithmetic<double, slb::simd_abi::native<double>>();
+  simd::check_arithmetic<int, slb::simd_abi::native<int>>();
+  simd::check_arithmetic<short, slb::simd_abi::fixed_size<8>>();
+  simd::check_arithmetic<long long, slb::simd_abi::fixed_size<5>>();
+  simd::check_arithmetic<float, slb::simd_abi::fixed_size<3>>();
+  simd::check_arithmetic<long double, slb::simd_abi::fixed_size<2>>();
+  simd::check_arithmetic<int, slb::simd_abi::scalar>();
+
+  // integral operators
+  {
+    slb::native_simd<unsigned> const a(simd::Iota{});
+    slb::native_simd<unsigned> const b = (a << 4) | 3u;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      CHECK(b[i] == ((i << 4) | 3));
+      CHECK((b >> 4)[i] == i);
+      CHECK((b & 5u)[i] == (((i << 4) | 3) & 5));
+      CHECK((b ^ 1u)[i] == (((i << 4) | 3) ^ 1));
+      CHECK((b % 7u)[i] == ((i << 4) | 3) % 7);
+      CHECK((~a)[i] == ~static_cast<unsigned>(i));
+    }
+  }
+
+  // narrow elements wrap
+  {
+    slb::native_simd<std::uint8_t> a(250);
+    a += 10;
+    CHECK(a[0] == 4);
+    slb::fixed_size_simd<std::int8_t, 3> b(100);
+    b *= 2;
+    CHECK(b[2] == -56);
+  }
+}
+
+TEST_CASE("simd(compare)", "[simd.class]") {
+  simd::check_compare<float, slb::simd_abi::native<float>>();
+  simd::check_compare<double, slb::simd_abi::compatible<double>>();
+  simd::check_compare<char, slb::simd_abi::native<char>>();
+  simd::check_compare<unsigned short, slb::simd_abi::fixed_size<8>>();
+  simd::check_compare<std::int64_t, slb::simd_abi::fixed_size<4>>();
+  simd::check_compare<int, slb::simd_abi::fixed_size<6>>();
+  simd::check_compare<float, slb::simd_abi::scalar>();
+}
+
+TEST_CASE("simd_mask", "[simd.mask.class]") {
+  // construct
+  {
+    slb::native_simd_mask<int> const a(true);
+    slb::native_simd_mask<int> const b(false);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      CHECK(a[i]);
+      CHECK_FALSE(b[i]);
+    }
+    CHECK_FALSE((std::is_convertible<bool, slb::simd_mask<int>>::value));
+
+    bool const values[4] = {true, false, false, true};
+    slb::fixed_size_simd_mask<float, 4> m(values, slb::element_aligned);
+    bool out[4] = {};
+    (!m).copy_to(out, slb::element_aligned);
+    CHECK_FALSE(out[0]);
+    CHECK(out[1]);
+    CHECK(out[2]);
+    CHECK_FALSE(out[3]);
+  }
+
+  // logical operators
+  {
+    bool const xs[4] = {true, true, false, false};
+    bool const ys[4] = {true, false, true, false};
+    slb::simd_mask<float> const x(xs, slb::element_aligned);
+    slb::simd_mask<float> const y(ys, slb::element_aligned);
+    for (std::size_t i = 0; i < 4; ++i) {
+      CHECK((x && y)[i] == (xs[i] && ys[i]));
+      CHECK((x || y)[i] == (xs[i] || ys[i]));
+      CHECK((x & y)[i] == (xs[i] && ys[i]));
+      CHECK((x | y)[i] == (xs[i] || ys[i]));
+      CHECK((x ^ y)[i] == (xs[i] != ys[i]));
+      CHECK((x == y)[i] == (xs[i] == ys[i]));
+      CHECK((x != y)[i] == (xs[i] != ys[i]));
+    }
+
+    slb::simd_mask<float> z = x;
+    z &= y;
+    CHECK(slb::popcount(z) == 1);
+    z |= x;
+    CHECK(slb::popcount(z) == 2);
+    z ^= y;
+    CHECK(slb::popcount(z) == 2);
+  }
+
+  // reductions
+  simd::check_mask_reductions<char, slb::simd_abi::compatible<char>>();
+  simd::check_mask_reductions<char, slb::simd_abi::native<char>>();
+  simd::check_mask_reductions<std::int8_t, slb::simd_abi::fixed_size<64>>();
+  simd::check_mask_reductions<short, slb::simd_abi::compatible<short>>();
+  simd::check_mask_reductions<short, slb::simd_abi::fixed_size<32>>();
+  simd::check_mask_reductions<float, slb::simd_abi::native<float>>();
+  simd::check_mask_reductions<int, slb::simd_abi::fixed_size<2>>();
+  simd::check_mask_reductions<double, slb::simd_abi::compatible<double>>();
+  simd::check_mask_reductions<double, slb::simd_abi::fixed_size<8>>();
+  simd::check_mask_reductions<float, slb::simd_abi::fixed_size<7>>();
+  simd::check_mask_reductions<float, slb::simd_abi::scalar>();
+}
+
+TEST_CASE("where", "[simd.whereexpr]") {
+  using V = slb::fixed_size_simd<int, 8>;
+  V const iota(simd::Iota{});
+
+  // assignment
+  {
+    V a = iota;
+    slb::where(a > 4, a) = 0;
+    slb::where(a < 2, a) += 10;
+    slb::where(a == 3, a) *= V(5);
+    slb::where(a == 2, a)++;
+    int const expected[8] = {10, 11, 3, 15, 4, 10, 10, 10};
+    for (std::size_t i = 0; i < V::size(); ++i) {
+      CHECK(a[i] == expected[i]);
+    }
+  }
+
+  // the unselected lanes are not divided
+  {
+    V a = iota + 1;
+    V const divisor = iota & 1;
+    slb::where(divisor != 0, a) /= divisor;
+    slb::where(divisor != 0, a) %= 3;
+    for (std::size_t i = 0; i < V::size(); ++i) {
+      CHECK(a[i] == ((i & 1) ? static_cast<int>(i + 1) % 3
+                             : static_cast<int>(i + 1)));
+    }
+  }
+
+  // masked loads and stores
+  {
+    int const values[5] = {10, 11, 12, 13, 14};
+    V a(-1);
+    slb::where(iota < 5, a).copy_from(values, slb::element_aligned);
+    for (std::size_t i = 0; i < V::size(); ++i) {
+      CHECK(a[i] == (i < 5 ? values[i] : -1));
+    }
+
+    int out[5] = {};
+    slb::where(iota < 5, a + 1).copy_to(out, slb::element_aligned);
+    CHECK(out[0] == 11);
+    CHECK(out[4] == 15);
+
+    V const b = -slb::where(iota < 2, iota);
+    CHECK(b[1] == -1);
+    CHECK(b[2] == 2);
+  }
+
+  // masked reduction
+  {
+    CHECK(slb::reduce(slb::where(iota > 5, iota), 0, std::plus<int>()) == 13);
+    CHECK(slb::reduce(slb::where(iota < 0, iota), 1, std::multiplies<int>()) ==
+          1);
+  }
+}
+
+TEST_CASE("simd(reduce)", "[simd.reductions]") {
+  slb::native_simd<int> const a = slb::native_simd<int>(simd::Iota{}) + 1;
+  int const n = static_cast<int>(a.size());
+  CHECK(slb::reduce(a) == n * (n + 1) / 2);
+  int bits = 0;
+  for (int i = 1; i <= n; ++i) {
+    bits ^= i;
+  }
+  CHECK(slb::reduce(a, std::bit_xor<int>()) == bits);
+  CHECK(slb::hmin(a) == 1);
+  CHECK(slb::hmax(a) == n);
+
+  slb::fixed_size_simd<double, 5> const b(simd::Iota{});
+  CHECK(slb::reduce(b) == 10.0);
+  CHECK(slb::hmin(-b) == -4.0);
+  CHECK(slb::hmax(b) == 4.0);
+
+  CHECK(slb::reduce(slb::simd<float, slb::simd_abi::scalar>(2.f)) == 2.f);
+
+  slb::native_simd<float> const x(simd::Iota{});
+  slb::native_simd<float> const y = 2.f - x;
+  slb::native_simd<float> const lo = slb::min(x, y);
+  slb::native_simd<float> const hi = slb::max(x, y);
+  std::pair<slb::native_simd<float>, slb::native_simd<float>> const mm =
+      slb::minmax(x, y);
+  slb::native_simd<float> const c =
+      slb::clamp(x, slb::native_simd<float>(1.f), slb::native_simd<float>(2.f));
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    CHECK(lo[i] == (x[i] < y[i] ? x[i] : y[i]));
+    CHECK(hi[i] == (x[i] < y[i] ? y[i] : x[i]));
+    CHECK(mm.first[i] == lo[i]);
+    CHECK(mm.second[i] == hi[i]);
+    CHECK(c[i] == (x[i] < 1.f ? 1.f : x[i] > 2.f ? 2.f : x[i]));
+  }
+}
+
+namespace simd {
+
+template <typename T>
+T dot(T const* a, T const* b, std::size_t n) {
+  using V = slb::native_simd<T>;
+  V acc(0);
+  std::size_t i = 0;
+  for (; i + V::size() <= n; i += V::size()) {
+    acc += V(a + i, slb::element_aligned) * V(b + i, slb::element_aligned);
+  }
+  T result = slb::reduce(acc);
+  for (; i < n; ++i) {
+    result += a[i] * b[i];
+  }
+  return result;
+}
+
+template <typename T>
+std::pair<T, T> minmax_element_values(T const* a, std::size_t n) {
+  using V = slb::native_simd<T>;
+  V lo(a[0]);
+  V hi(a[0]);
+  std::size_t i = 0;
+  for (; i + V::size() <= n; i += V::size()) {
+    V const x(a + i, slb::element_aligned);
+    lo = slb::min(lo, x);
+    hi = slb::max(hi, x);
+  }
+  std::pair<T, T> result(slb::hmin(lo), slb::hmax(hi));
+  for (; i < n; ++i) {
+    result.first = a[i] < result.first ? a[i] : result.first;
+    result.second = result.second < a[i] ? a[i] : result.second;
+  }
+  return result;
+}
+
+std::size_t find_byte(char const* s, std::size_t n, char c) {
+  using V = slb::native_simd<char>;
+  std::size_t i = 0;
+  for (; i + V::size() <= n; i += V::size()) {
+    V::mask_type const m = V(s + i, slb::element_aligned) == V(c);
+    if (slb::any_of(m)) {
+      return i + static_cast<std::size_t>(slb::find_first_set(m));
+    }
+  }
+  for (; i < n; ++i) {
+    if (s[i] == c) {
+      return i;
+    }
+  }
+  return n;
+}
+
+} // namespace simd
+
+TEST_CASE("simd(kernels)", "[simd]") {
+  // dot product
+  {
+    float a[103];
+    float b[103];
+    float expected = 0;
+    for (int i = 0; i < 103; ++i) {
+      a[i] = static_cast<float>(i % 7);
+      b[i] = static_cast<float>(i % 5) - 2;
+      expected += a[i] * b[i];
+    }
+    CHECK(simd::dot(a, b, 103) == expected);
+
+    int x[50];
+    for (int i = 0; i < 50; ++i) {
+      x[i] = i;
+    }
+    CHECK(simd::dot(x, x, 50) == 40425);
+  }
+
+  // min/max
+  {
+    int a[77];
+    for (int i = 0; i < 77; ++i) {
+      a[i] = (i * 37) % 101 - 50;
+    }
+    a[60] = -1000;
+    a[76] = 1000;
+    std::pair<int, int> const mm = simd::minmax_element_values(a, 77);
+    CHECK(mm.first == -1000);
+    CHECK(mm.second == 1000);
+
+    double b[9] = {3, 1, 4, 1, 5, 9, 2, 6, 5};
+    std::pair<double, double> const mmb = simd::minmax_element_values(b, 9);
+    CHECK(mmb.first == 1.0);
+    CHECK(mmb.second == 9.0);
+  }
+
+  // byte search
+  {
+    char text[200];
+    std::memset(text, 'a', sizeof(text));
+    CHECK(simd::find_byte(text, sizeof(text), 'z') == sizeof(text));
+    for (std::size_t pos : {0, 1, 15, 16, 17, 63, 64, 130, 199}) {
+      text[pos] = 'z';
+      CHECK(simd::find_byte(text, sizeof(text), 'z') == pos);
+      text[pos] = 'a';
+    }
+    text[150] = 'z';
+    text[180] = 'z';
+    CHECK(simd::find_byte(text, sizeof(text), 'z') == 150);
+  }
+}
@@ -0,0 +1,305 @@
+/*
+  SLB.SmallVector
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/small_vector.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "catch.hpp"
+
+namespace small_vector {
+
+// Tracks the number of live objects, and optionally throws on the N-th copy.
+struct Counted {
+  static int live;
+  static int throw_countdown;
+
+  int value;
+
+  Counted(int value = 0) : value(value) { ++live; }
+  Counted(Counted const& that) : value(that.value) {
+    if (throw_countdown > 0 && --throw_countdown == 0) {
+      throw 0;
+    }
+    ++live;
+  }
+  // Not `noexcept`, so growth copies rather than moves.
+  Counted(Counted&& that) : value(that.value) {
+    ++live;
+    that.value = -1;
+  }
+  Counted& operator=(Counted const&) = default;
+  Counted& operator=(Counted&&) = default;
+  ~Counted() { --live; }
+
+  friend bool operator==(Counted const& lhs, Counted const& rhs) {
+    return lhs.value == rhs.value;
+  }
+};
+
+int Counted::live = 0;
+int Counted::throw_countdown = 0;
+
+// Counts the outstanding allocations.
+template <typename T>
+struct counting_allocator {
+  using value_type = T;
+
+  static int allocations;
+
+  counting_allocator() = default;
+  template <typename U>
+  counting_allocator(counting_allocator<U> const&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    ++allocations;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept {
+    --allocations;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  friend bool operator==(counting_allocator const&, counting_allocator const&) {
+    return true;
+  }
+  friend bool operator!=(counting_allocator const&, counting_allocator const&) {
+    return false;
+  }
+};
+
+template <typename T>
+int counting_allocator<T>::allocations = 0;
+
+} // namespace small_vector
+
+TEST_CASE("small_vector(layout)", "[small_vector]") {
+  using alloc = small_vector::counting_allocator<int>;
+  // Empty allocators take no space.
+  CHECK((sizeof(slb::small_vector<int, 4, alloc>) ==
+         sizeof(int*) + 2 * sizeof(std::size_t) + 4 * sizeof(int)));
+  CHECK((sizeof(slb::small_vector<int, 0>) ==
+         sizeof(int*) + 2 * sizeof(std::size_t)));
+  CHECK((std::is_nothrow_move_constructible<
+         slb::small_vector<std::string, 4>>::value));
+  CHECK((std::is_nothrow_default_constructible<
+         slb::small_vector<std::string, 4>>::value));
+}
+
+TEST_CASE("small_vector(construct)", "[small_vector]") {
+  using small_vector::Counted;
+  using alloc = small_vector::counting_allocator<Counted>;
+
+  /* default */ {
+    slb::small_vector<int, 4> const v;
+    CHECK(v.empty());
+    CHECK(v.capacity() == 4);
+    CHECK(v.is_inline());
+  }
+
+  /* count */ {
+    slb::small_vector<int, 4> const v(3);
+    CHECK(v.size() == 3);
+    CHECK(v[2] == 0);
+    CHECK(v.is_inline());
+
+    slb::small_vector<int, 4> const w(6, 7);
+    CHECK(w.size() == 6);
+    CHECK(w[5] == 7);
+    CHECK_FALSE(w.is_inline());
+  }
+
+  /* range */ {
+    int const arr[] = {1, 2, 3, 4, 5};
+    slb::small_vector<int, 4> const v(arr, arr + 5);
+    CHECK(v.size() == 5);
+    CHECK(v.back() == 5);
+
+    std::istringstream in("4 5 6");
+    slb::small_vector<int, 2> const w((std::istream_iterator<int>(in)),
+                                      std::istream_iterator<int>());
+    CHECK(w.size() == 3);
+    CHECK(w.front() == 4);
+  }
+
+  /* copy and move */ {
+    {
+      slb::small_vector<Counted, 2, alloc> inline_ = {1, 2};
+      slb::small_vector<Counted, 2, alloc> heap = {1, 2, 3};
+      CHECK(alloc::allocations == 1);
+      CHECK(Counted::live == 5);
+
+      slb::small_vector<Counted, 2, alloc> copy = heap;
+      CHECK(copy == heap);
+      CHECK(alloc::allocations == 2);
+
+      // Heap storage is taken over, inline elements are moved.
+      Counted const* const data = heap.data();
+      slb::small_vector<Counted, 2, alloc> moved = std::move(heap);
+      CHECK(moved.data() == data);
+      CHECK(heap.empty());
+      CHECK(heap.is_inline());
+      CHECK(alloc::allocations == 2);
+
+      slb::small_vector<Counted, 2, alloc> moved_inline = std::move(inline_);
+      CHECK(moved_inline.is_inline());
+      CHECK(moved_inline == (slb::small_vector<Counted, 2, alloc>{1, 2}));
+      CHECK(inline_.empty());
+      CHECK(Counted::live == 8);
+
+      copy = moved_inline;
+      CHECK(copy == moved_inline);
+      CHECK(Counted::live == 7);
+      moved_inline = std::move(moved);
+      CHECK(moved_inline.data() == data);
+      CHECK(alloc::allocations == 2);
+      CHECK(Counted::live == 5);
+      copy = std::move(heap);
+      CHECK(copy.empty());
+      CHECK(Counted::live == 3);
+    }
+    CHECK(Counted::live == 0);
+    CHECK(alloc::allocations == 0);
+  }
+}
+
+TEST_CASE("small_vector(capacity)", "[small_vector]") {
+  using alloc = small_vector::counting_allocator<int>;
+
+  slb::small_vector<int, 4, alloc> v = {1, 2};
+  v.reserve(3);
+  CHECK(v.is_inline());
+  v.reserve(10);
+  CHECK(v.capacity() == 10);
+  CHECK(alloc::allocations == 1);
+  CHECK(v == (slb::small_vector<int, 4, alloc>{1, 2}));
+
+  v.shrink_to_fit();
+  CHECK(v.is_inline());
+  CHECK(alloc::allocations == 0);
+  CHECK(v == (slb::small_vector<int, 4, alloc>{1, 2}));
+
+  v.resize(6, 3);
+  CHECK(v.size() == 6);
+  CHECK(v[5] == 3);
+  v.resize(5);
+  v.shrink_to_fit();
+  CHECK(v.capacity() == 5);
+  v.resize(7);
+  CHECK(v[6] == 0);
+  CHECK(v.capacity() == 10);
+
+  CHECK(v.at(6) == 0);
+  CHECK_THROWS_AS(v.at(7), std::out_of_range);
+  CHECK(v.end() - v.begin() == 7);
+  CHECK(*v.rbegin() == 0);
+  CHECK(v.crend() - v.crbegin() == 7);
+}
+
+TEST_CASE("small_vector(modifiers)", "[small_vector]") {
+  using small_vector::Counted;
+
+  /* append */ {
+    slb::small_vector<std::unique_ptr<int>, 2> v;
+    for (int i = 0; i < 100; ++i) {
+      v.emplace_back(new int(i));
+    }
+    CHECK(v.size() == 100);
+    CHECK(*v[99] == 99);
+    v.pop_back();
+    CHECK(*v.back() == 98);
+
+    // Appending an element of the vector itself while growing.
+    slb::small_vector<std::string, 2> s = {"a", "b"};
+    s.push_back(s.front());
+    s.push_back(s.back());
+    CHECK(s == (slb::small_vector<std::string, 2>{"a", "b", "a", "a"}));
+  }
+
+  /* insert */ {
+    slb::small_vector<int, 4> v = {1, 5};
+    CHECK(*v.insert(v.begin() + 1, 2) == 2);
+    int const arr[] = {3, 4};
+    CHECK(*v.insert(v.begin() + 2, arr, arr + 2) == 3);
+    CHECK(*v.emplace(v.end(), 6) == 6);
+    CHECK(*v.insert(v.begin(), 2, 0) == 0);
+    CHECK(*v.insert(v.end(), {7, 8}) == 7);
+    CHECK(v == (slb::small_vector<int, 4>{0, 0, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+    slb::small_vector<std::string, 4> s = {"a", "b"};
+    s.insert(s.begin(), s.back());
+    s.insert(s.begin() + 1, 2, s.back());
+    CHECK(s == (slb::small_vector<std::string, 4>{"b", "b", "b", "a", "b"}));
+  }
+
+  /* erase */ {
+    slb::small_vector<int, 4> v = {0, 1, 2, 3, 4, 5};
+    CHECK(*v.erase(v.begin()) == 1);
+    CHECK(*v.erase(v.begin() + 1, v.begin() + 3) == 4);
+    CHECK(v == (slb::small_vector<int, 4>{1, 4, 5}));
+    CHECK(slb::erase(v, 4) == 1);
+    CHECK(slb::erase_if(v, [](int x) { return x < 2; }) == 1);
+    CHECK(v.size() == 1);
+    v.clear();
+    CHECK(v.empty());
+  }
+
+  /* swap */ {
+    {
+      slb::small_vector<Counted, 2> a = {1};
+      slb::small_vector<Counted, 2> b = {2, 3, 4};
+      swap(a, b);
+      CHECK(a == (slb::small_vector<Counted, 2>{2, 3, 4}));
+      CHECK(b == (slb::small_vector<Counted, 2>{1}));
+      CHECK(b.is_inline());
+      slb::small_vector<Counted, 2> c = {5, 6};
+      b.swap(c);
+      CHECK(b == (slb::small_vector<Counted, 2>{5, 6}));
+      CHECK(c == (slb::small_vector<Counted, 2>{1}));
+      CHECK(Counted::live == 6);
+    }
+    CHECK(Counted::live == 0);
+  }
+
+  /* exception safety */ {
+    {
+      slb::small_vector<Counted, 2> v = {1, 2};
+      Counted::throw_countdown = 2;
+      CHECK_THROWS(v.push_back(3));
+      CHECK(v == (slb::small_vector<Counted, 2>{1, 2}));
+      CHECK(v.is_inline());
+      CHECK(Counted::live == 2);
+      Counted::throw_countdown = 0;
+    }
+    CHECK(Counted::live == 0);
+  }
+}
+
+TEST_CASE("small_vector(compare)", "[small_vector]") {
+  slb::small_vector<int, 2> const a = {1, 2, 3};
+  slb::small_vector<int, 2> const b = {1, 2, 4};
+  slb::small_vector<int, 2> const c = {1, 2};
+  CHECK(a == a);
+  CHECK(a != b);
+  CHECK(a < b);
+  CHECK(c < a);
+  CHECK(b > a);
+  CHECK(a <= a);
+  CHECK(b >= a);
+}
@@ -0,0 +1,209 @@
+/*
+  SLB.Span
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/span.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace span {
+
+struct Base {};
+struct Derived : Base {};
+
+constexpr int array[] = {0, 1, 2, 3, 4};
+
+} // namespace span
+
+// [views.span], class template span
+
+TEST_CASE("span(layout)", "[views.span]") {
+  // A static extent is part of the type and is not stored.
+  CHECK(sizeof(slb::span<int, 4>) == sizeof(int*));
+  CHECK(sizeof(slb::span<int>) == sizeof(int*) + sizeof(std::size_t));
+  CHECK(std::is_trivially_copyable<slb::span<int, 4>>::value);
+  CHECK(std::is_trivially_copyable<slb::span<int>>::value);
+
+  CHECK(slb::span<int, 4>::extent == 4);
+  CHECK(slb::span<int>::extent == slb::dynamic_extent);
+  CHECK(slb::dynamic_extent == static_cast<std::size_t>(-1));
+}
+
+// [span.cons], constructors, copy, and assignment
+TEST_CASE("span(construct)", "[span.cons]") {
+  /* default */ {
+    slb::span<int> const s;
+    CHECK(s.data() == nullptr);
+    CHECK(s.size() == 0);
+    CHECK(std::is_default_constructible<slb::span<int, 0>>::value);
+    CHECK_FALSE(std::is_default_constructible<slb::span<int, 1>>::value);
+  }
+
+  int arr[] = {1, 2, 3};
+  /* pointer and size */ {
+    slb::span<int> const s(arr, 2);
+    CHECK(s.data() == arr);
+    CHECK(s.size() == 2);
+    slb::span<int, 2> const fixed(arr, 2);
+    CHECK(fixed.data() == arr);
+    CHECK(fixed.size() == 2);
+    CHECK(std::is_convertible<int*, slb::span<int>>::value == false);
+  }
+
+  /* pointer range */ {
+    slb::span<int> const s(arr, arr + 3);
+    CHECK(s.size() == 3);
+    slb::span<int const, 3> const fixed(arr, arr + 3);
+    CHECK(fixed.data() == arr);
+  }
+
+  /* array */ {
+    slb::span<int> const s = arr;
+    CHECK(s.size() == 3);
+    slb::span<int, 3> const fixed = arr;
+    CHECK(fixed.data() == arr);
+    CHECK_FALSE((std::is_constructible<slb::span<int, 2>, int(&)[3]>::value));
+
+    std::array<int, 3> a = {{1, 2, 3}};
+    slb::span<int, 3> const from_array = a;
+    CHECK(from_array.data() == a.data());
+    std::array<int, 3> const& ca = a;
+    slb::span<int const> const from_const_array = ca;
+    CHECK(from_const_array.size() == 3);
+    CHECK_FALSE((std::is_constructible<slb::span<int>,
+                                       std::array<int, 3> const&>::value));
+  }
+
+  /* range */ {
+    std::vector<int> v = {1, 2, 3, 4};
+    slb::span<int> const s = v;
+    CHECK(s.data() == v.data());
+    CHECK(s.size() == 4);
+    slb::span<int, 4> const fixed(v);
+    CHECK(fixed.data() == v.data());
+    CHECK_FALSE((std::is_convertible<std::vector<int>&,
+                                     slb::span<int, 4>>::value));
+
+    std::string const str("abc");
+    slb::span<char const> const cs = str;
+    CHECK(cs.size() == 3);
+
+    // Temporaries only bind to spans of const elements.
+    CHECK((std::is_constructible<slb::span<int const>,
+                                 std::vector<int>&&>::value));
+    CHECK_FALSE(
+        (std::is_constructible<slb::span<int>, std::vector<int>&&>::value));
+  }
+
+  /* conversion */ {
+    slb::span<int, 3> const fixed = arr;
+    slb::span<int const> const s = fixed;
+    CHECK(s.size() == 3);
+    slb::span<int const, 3> const back(s);
+    CHECK(back.data() == arr);
+    CHECK_FALSE((std::is_convertible<slb::span<int>,
+                                     slb::span<int, 3>>::value));
+    CHECK_FALSE((std::is_convertible<slb::span<int const>,
+                                     slb::span<int>>::value));
+    CHECK_FALSE((std::is_convertible<slb::span<span::Derived>,
+                                     slb::span<span::Base>>::value));
+  }
+
+  /* constexpr */ {
+    constexpr slb::span<int const, 5> s = span::array;
+    static_assert(s.size() == 5, "");
+    static_assert(s[2] == 2, "");
+    static_assert(s.last<2>().front() == 3, "");
+  }
+}
+
+// [span.sub], subviews
+TEST_CASE("span(subviews)", "[span.sub]") {
+  int arr[] = {0, 1, 2, 3, 4, 5};
+  slb::span<int, 6> const fixed = arr;
+  slb::span<int> const s = arr;
+
+  auto const first = fixed.first<2>();
+  CHECK((std::is_same<decltype(first), slb::span<int, 2> const>::value));
+  CHECK(first.data() == arr);
+
+  auto const last = s.last<2>();
+  CHECK((std::is_same<decltype(last), slb::span<int, 2> const>::value));
+  CHECK(last.data() == arr + 4);
+
+  auto const sub = fixed.subspan<1>();
+  CHECK((std::is_same<decltype(sub), slb::span<int, 5> const>::value));
+  CHECK(sub.data() == arr + 1);
+
+  auto const dsub = s.subspan<1>();
+  CHECK((std::is_same<decltype(dsub),
+                      slb::span<int, slb::dynamic_extent> const>::value));
+  CHECK(dsub.size() == 5);
+
+  auto const sub2 = s.subspan<1, 3>();
+  CHECK((std::is_same<decltype(sub2), slb::span<int, 3> const>::value));
+  CHECK(sub2.back() == 3);
+
+  CHECK(fixed.first(3).size() == 3);
+  CHECK(fixed.last(3).front() == 3);
+  CHECK(fixed.subspan(2).size() == 4);
+  CHECK(fixed.subspan(2, 2).back() == 3);
+  CHECK((std::is_same<decltype(fixed.first(3)), slb::span<int>>::value));
+}
+
+// [span.obs], observers
+// [span.elem], element access
+// [span.iterators], iterator support
+TEST_CASE("span(access)", "[span.elem]") {
+  int arr[] = {1, 2, 3};
+  slb::span<int, 3> const s = arr;
+  CHECK(s.size() == 3);
+  CHECK(s.size_bytes() == 3 * sizeof(int));
+  CHECK_FALSE(s.empty());
+  CHECK(slb::span<int>().empty());
+
+  s[1] = 5;
+  CHECK(arr[1] == 5);
+  CHECK(s.front() == 1);
+  CHECK(s.back() == 3);
+
+  int sum = 0;
+  for (int x : s) {
+    sum += x;
+  }
+  CHECK(sum == 9);
+  CHECK(s.end() - s.begin() == 3);
+  CHECK(*s.rbegin() == 3);
+  CHECK(s.rend() - s.rbegin() == 3);
+}
+
+// [span.objectrep], views of object representation
+TEST_CASE("as_bytes", "[span.objectrep]") {
+  unsigned int arr[] = {0u, 0u};
+  slb::span<unsigned int, 2> const s = arr;
+
+  auto const bytes = slb::as_bytes(s);
+  CHECK(bytes.size() == 2 * sizeof(unsigned int));
+  CHECK(static_cast<void const*>(bytes.data()) ==
+        static_cast<void const*>(arr));
+  CHECK(decltype(bytes)::extent == 2 * sizeof(unsigned int));
+  CHECK(decltype(slb::as_bytes(slb::span<int>()))::extent ==
+        slb::dynamic_extent);
+
+  auto const writable = slb::as_writable_bytes(s);
+  writable[0] = decltype(writable)::value_type(1);
+  writable[sizeof(unsigned int) - 1] = decltype(writable)::value_type(1);
+  CHECK(arr[0] == (1u | (1u << (8 * (sizeof(unsigned int) - 1)))));
+}
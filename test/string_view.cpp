@@ -0,0 +1,340 @@
+/*
+  SLB.StringView
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/string_view.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "catch.hpp"
+
+namespace string_view {
+
+// The searching functions are checked against `std::string`, for every
+// starting position.
+char const* const haystacks[] = {"",
+                                 "a",
+                                 "abc",
+                                 "aaaa",
+                                 "abcabcabd",
+                                 "hello, world",
+                                 "\x80\xff\x01 mixed \xfe bytes \x80"};
+
+char const* const needles[] = {
+    "", "a", "b", "ab", "abd", "cab", "xyz", "o", "lo", " ", "\x80", "\xff\x01"};
+
+template <typename F, typename G>
+void check_search(F f, G g) {
+  for (char const* h : haystacks) {
+    std::string const str(h);
+    slb::string_view const sv(h);
+    for (char const* n : needles) {
+      for (std::size_t pos = 0; pos <= str.size() + 1; ++pos) {
+        CHECK(f(sv, n, pos) == g(str, n, pos));
+      }
+      CHECK(f(sv, n, slb::string_view::npos) ==
+            g(str, n, std::string::npos));
+    }
+  }
+}
+
+} // namespace string_view
+
+// [string.view.cons], construction and assignment
+
+// constexpr basic_string_view() noexcept;
+// constexpr basic_string_view(const charT* str);
+// constexpr basic_string_view(const charT* str, size_type len);
+TEST_CASE("basic_string_view(construct)", "[string.view.cons]") {
+  slb::string_view const empty;
+  CHECK(empty.data() == nullptr);
+  CHECK(empty.size() == 0);
+  CHECK(empty.empty());
+
+  char const* str = "hello";
+  slb::string_view const sv(str);
+  CHECK(sv.data() == str);
+  CHECK(sv.size() == 5);
+  CHECK(sv.length() == 5);
+  CHECK_FALSE(sv.empty());
+
+  slb::string_view const part(str, 3);
+  CHECK(part.data() == str);
+  CHECK(part.size() == 3);
+
+  slb::wstring_view const wsv(L"wide");
+  CHECK(wsv.size() == 4);
+  slb::u16string_view const u16sv(u"utf16");
+  CHECK(u16sv.size() == 5);
+  slb::u32string_view const u32sv(U"utf32");
+  CHECK(u32sv.size() == 5);
+
+  std::string const s("string");
+  slb::string_view const from_string = s;
+  CHECK(from_string.data() == s.data());
+  CHECK(from_string.size() == s.size());
+  CHECK(std::string(from_string) == s);
+
+#if __cpp_lib_string_view || SLB_HAS_IS_CONSTANT_EVALUATED
+  /* constexpr */ {
+    constexpr slb::string_view csv("hello");
+    static_assert(csv.size() == 5, "");
+    static_assert(csv[1] == 'e', "");
+    static_assert(csv.substr(1, 3).size() == 3, "");
+  }
+#endif
+}
+
+// [string.view.iterators], iterator support
+TEST_CASE("basic_string_view(iterators)", "[string.view.iterators]") {
+  slb::string_view const sv("abc");
+  CHECK(sv.end() - sv.begin() == 3);
+  CHECK(*sv.begin() == 'a');
+  CHECK(sv.cbegin() == sv.begin());
+  CHECK(sv.cend() == sv.end());
+  CHECK(std::string(sv.rbegin(), sv.rend()) == "cba");
+  CHECK(std::string(sv.crbegin(), sv.crend()) == "cba");
+}
+
+// [string.view.access], element access
+TEST_CASE("basic_string_view(access)", "[string.view.access]") {
+  slb::string_view const sv("abc");
+  CHECK(sv[0] == 'a');
+  CHECK(sv.at(2) == 'c');
+  CHECK_THROWS_AS(sv.at(3), std::out_of_range);
+  CHECK(sv.front() == 'a');
+  CHECK(sv.back() == 'c');
+}
+
+// [string.view.modifiers], modifiers
+TEST_CASE("basic_string_view(modifiers)", "[string.view.modifiers]") {
+  slb::string_view sv("hello, world");
+  sv.remove_prefix(7);
+  CHECK(sv == "world");
+  sv.remove_suffix(2);
+  CHECK(sv == "wor");
+
+  slb::string_view other("x");
+  sv.swap(other);
+  CHECK(sv == "x");
+  CHECK(other == "wor");
+}
+
+// size_type copy(charT* s, size_type n, size_type pos = 0) const;
+// constexpr basic_string_view substr(size_type pos = 0,
+//                                    size_type n = npos) const;
+TEST_CASE("basic_string_view(copy)", "[string.view.ops]") {
+  slb::string_view const sv("hello");
+  char buffer[8] = {};
+  CHECK(sv.copy(buffer, 3, 1) == 3);
+  CHECK(std::string(buffer) == "ell");
+  CHECK(sv.copy(buffer, 8, 4) == 1);
+  CHECK(buffer[0] == 'o');
+  CHECK(sv.copy(buffer, 8, 5) == 0);
+  CHECK_THROWS_AS(sv.copy(buffer, 1, 6), std::out_of_range);
+
+  CHECK(sv.substr() == "hello");
+  CHECK(sv.substr(1) == "ello");
+  CHECK(sv.substr(1, 2) == "el");
+  CHECK(sv.substr(5).empty());
+  CHECK_THROWS_AS(sv.substr(6), std::out_of_range);
+}
+
+// constexpr int compare(basic_string_view s) const noexcept;
+TEST_CASE("basic_string_view(compare)", "[string.view.ops]") {
+  slb::string_view const sv("abc");
+  CHECK(sv.compare("abc") == 0);
+  CHECK(sv.compare("abd") < 0);
+  CHECK(sv.compare("abb") > 0);
+  CHECK(sv.compare("ab") > 0);
+  CHECK(sv.compare("abcd") < 0);
+  CHECK(sv.compare(1, 2, "bc") == 0);
+  CHECK(sv.compare(1, 2, "xbcx", 1, 2) == 0);
+  CHECK(sv.compare(0, 2, "abx", 2) == 0);
+  CHECK_THROWS_AS(sv.compare(4, 1, "a"), std::out_of_range);
+
+  // `char_traits<char>` compares as `unsigned char`.
+  CHECK(slb::string_view("\xff").compare("\x01") > 0);
+  CHECK(slb::string_view("").compare("") == 0);
+}
+
+#if !__cpp_lib_string_view || __cpp_lib_starts_ends_with
+TEST_CASE("basic_string_view(starts_with)", "[string.view.ops]") {
+  slb::string_view const sv("hello");
+  CHECK(sv.starts_with("he"));
+  CHECK(sv.starts_with(slb::string_view("")));
+  CHECK_FALSE(sv.starts_with("hello!"));
+  CHECK(sv.starts_with('h'));
+  CHECK_FALSE(sv.starts_with('e'));
+  CHECK_FALSE(slb::string_view().starts_with('h'));
+
+  CHECK(sv.ends_with("llo"));
+  CHECK_FALSE(sv.ends_with("ell"));
+  CHECK(sv.ends_with('o'));
+  CHECK_FALSE(slb::string_view().ends_with('o'));
+}
+#endif
+
+#if !__cpp_lib_string_view || __cpp_lib_string_contains
+TEST_CASE("basic_string_view(contains)", "[string.view.ops]") {
+  slb::string_view const sv("hello");
+  CHECK(sv.contains("ell"));
+  CHECK(sv.contains(slb::string_view("")));
+  CHECK_FALSE(sv.contains("elo"));
+  CHECK(sv.contains('o'));
+  CHECK_FALSE(sv.contains('x'));
+}
+#endif
+
+// [string.view.find], searching
+TEST_CASE("basic_string_view(find)", "[string.view.find]") {
+  string_view::check_search(
+      [](slb::string_view sv, char const* n, std::size_t pos) {
+        return sv.find(n, pos);
+      },
+      [](std::string const& s, char const* n, std::size_t pos) {
+        return s.find(n, pos);
+      });
+  string_view::check_search(
+      [](slb::string_view sv, char const* n, std::size_t pos) {
+        return sv.find(n[0], pos);
+      },
+      [](std::string const& s, char const* n, std::size_t pos) {
+        return s.find(n[0], pos);
+      });
+  string_view::check_search(
+      [](slb::string_view sv, char const* n, std::size_t pos) {
+        return sv.rfind(n, pos);
+      },
+      [](std::string const& s, char const* n, std::size_t pos) {
+        return s.rfind(n, pos);
+      });
+  string_view::check_search(
+      [](slb::string_view sv, char const* n, std::size_t pos) {
+        return sv.rfind(n[0], pos);
+      },
+      [](std::string const& s, char const* n, std::size_t pos) {
+        return s.rfind(n[0], pos);
+      });
+
+  slb::wstring_view const wsv(L"abcabc");
+  CHECK(wsv.find(L"ca") == 2);
+  CHECK(wsv.rfind(L'b') == 4);
+  CHECK(wsv.find(L"cb") == slb::wstring_view::npos);
+}
+
+TEST_CASE("basic_string_view(find_of)", "[string.view.find]") {
+  string_view::check_search(
+      [](slb::string_view sv, char const* n, std::size_t pos) {
+        return sv.find_first_of(n, pos);
+      },
+      [](std::string const& s, char const* n, std::size_t pos) {
+        return s.find_first_of(n, pos);
+      });
+  string_view::check_search(
+      [](slb::string_view sv, char const* n, std::size_t pos) {
+        return sv.find_last_of(n, pos);
+      },
+      [](std::string const& s, char const* n, std::size_t pos) {
+        return s.find_last_of(n, pos);
+      });
+  string_view::check_search(
+      [](slb::string_view sv, char const* n, std::size_t pos) {
+        return sv.find_first_not_of(n, pos);
+      },
+      [](std::string const& s, char const* n, std::size_t pos) {
+        return s.find_first_not_of(n, pos);
+      });
+  string_view::check_search(
+      [](slb::string_view sv, char const* n, std::size_t pos) {
+        return sv.find_last_not_of(n, pos);
+      },
+      [](std::string const& s, char const* n, std::size_t pos) {
+        return s.find_last_not_of(n, pos);
+      });
+  string_view::check_search(
+      [](slb::string_view sv, char const* n, std::size_t pos) {
+        return sv.find_first_not_of(n[0], pos);
+      },
+      [](std::string const& s, char const* n, std::size_t pos) {
+        return s.find_first_not_of(n[0], pos);
+      });
+  string_view::check_search(
+      [](slb::string_view sv, char const* n, std::size_t pos) {
+        return sv.find_last_not_of(n[0], pos);
+      },
+      [](std::string const& s, char const* n, std::size_t pos) {
+        return s.find_last_not_of(n[0], pos);
+      });
+
+  slb::u16string_view const u16sv(u"hello, world");
+  CHECK(u16sv.find_first_of(u"ow") == 4);
+  CHECK(u16sv.find_last_of(u"ow") == 8);
+  CHECK(u16sv.find_first_not_of(u"hel") == 4);
+  CHECK(u16sv.find_last_not_of(u"dl") == 9);
+}
+
+// [string.view.comparison], non-member comparison functions
+TEST_CASE("basic_string_view(comparison)", "[string.view.comparison]") {
+  slb::string_view const sv("abc");
+  std::string const s("abd");
+
+  CHECK(sv == slb::string_view("abc"));
+  CHECK(sv == "abc");
+  CHECK("abc" == sv);
+  CHECK(sv != s);
+  CHECK(s != sv);
+  CHECK(sv < s);
+  CHECK(s > sv);
+  CHECK(sv <= "abc");
+  CHECK("abc" >= sv);
+  CHECK_FALSE(sv == "ab");
+  CHECK(slb::string_view("ab") < sv);
+}
+
+// [string.view.io], inserters and extractors
+TEST_CASE("basic_string_view(io)", "[string.view.io]") {
+  std::ostringstream os;
+  os << slb::string_view("abc");
+  CHECK(os.str() == "abc");
+
+  os.str("");
+  os.width(6);
+  os.fill('.');
+  os << slb::string_view("abc") << slb::string_view("d");
+  CHECK(os.str() == "...abcd");
+
+  os.str("");
+  os.width(5);
+  os << std::left << slb::string_view("ab");
+  CHECK(os.str() == "ab...");
+}
+
+// [string.view.hash], hash support
+TEST_CASE("hash(string_view)", "[string.view.hash]") {
+  std::hash<slb::string_view> const h;
+  std::string const s1("the quick brown fox");
+  std::string const s2("the quick brown fox");
+  CHECK(h(s1) == h(s2));
+  CHECK(h(slb::string_view(s1).substr(0, 9)) ==
+        h(slb::string_view("the quick")));
+  CHECK(h("abc") != h("abd"));
+
+  CHECK(std::hash<slb::wstring_view>()(L"wide") ==
+        std::hash<slb::wstring_view>()(std::wstring(L"wide")));
+  CHECK(std::hash<slb::u16string_view>()(u"a") !=
+        std::hash<slb::u16string_view>()(u"b"));
+  CHECK(std::hash<slb::u32string_view>()(U"a") !=
+        std::hash<slb::u32string_view>()(U"b"));
+}
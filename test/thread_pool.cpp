@@ -0,0 +1,222 @@
+/*
+  SLB.ThreadPool
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/thread_pool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace thread_pool {
+
+struct Accumulator {
+  int add(int x) const { return base + x; }
+
+  int base;
+};
+
+// Sums the integers from `lo` up to, but excluding, `hi` by splitting the
+// range with nested calls to `parallel_for`, which run on the workers.
+long long sum_range(slb::thread_pool& pool, long long lo, long long hi) {
+  if (hi - lo <= 16) {
+    long long sum = 0;
+    for (long long i = lo; i < hi; ++i) {
+      sum += i;
+    }
+    return sum;
+  }
+  long long const mid = lo + (hi - lo) / 2;
+  long long sums[2] = {};
+  pool.parallel_for(0, 2, 1, [&](int half) {
+    sums[half] = half == 0 ? sum_range(pool, lo, mid)
+                           : sum_range(pool, mid, hi);
+  });
+  return sums[0] + sums[1];
+}
+
+// While nonzero, allocations of at least this many bytes by the thread that
+// set it fail, so that the pool's queues can't grow.
+thread_local std::size_t fail_size = 0;
+
+// Counts the live copies of a callable.
+struct Tracked {
+  Tracked() noexcept { ++live; }
+  Tracked(Tracked const&) noexcept { ++live; }
+  ~Tracked() { --live; }
+
+  void operator()() const {}
+
+  static std::atomic<int> live;
+};
+
+std::atomic<int> Tracked::live(0);
+
+} // namespace thread_pool
+
+void* operator new(std::size_t size) {
+  if (thread_pool::fail_size != 0 && size >= thread_pool::fail_size) {
+    throw std::bad_alloc();
+  }
+  if (void* p = std::malloc(size != 0 ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+// GCC pairs the `new` expressions it inlines this into with `free`.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+#if __cpp_sized_deallocation
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+TEST_CASE("thread_pool", "[thread.pool]") {
+  slb::thread_pool pool(4);
+  CHECK(pool.size() == 4);
+
+  std::future<int> sum = pool.submit([](int a, int b) { return a + b; }, 2, 3);
+  CHECK(sum.get() == 5);
+
+  // Arguments are decayed copies, passed as rvalues, and member pointers are
+  // invoked as with `invoke`.
+  std::unique_ptr<int> owned(new int(42));
+  std::future<int> moved =
+      pool.submit([](std::unique_ptr<int> p) { return *p; }, std::move(owned));
+  CHECK(moved.get() == 42);
+  thread_pool::Accumulator const acc = {10};
+  CHECK(pool.submit(&thread_pool::Accumulator::add, acc, 5).get() == 15);
+
+  std::future<void> done = pool.submit([] {});
+  done.get();
+
+  std::future<std::string> failed =
+      pool.submit([]() -> std::string { throw std::runtime_error("boom"); });
+  CHECK_THROWS_AS(failed.get(), std::runtime_error);
+
+  // Tasks posted from outside and from within the workers all run.
+  std::atomic<int> count(0);
+  std::promise<void> all_posted;
+  pool.post([&pool, &count, &all_posted] {
+    for (int i = 0; i < 100; ++i) {
+      pool.post([&count] { ++count; });
+    }
+    all_posted.set_value();
+  });
+  all_posted.get_future().get();
+  for (int i = 0; i < 100; ++i) {
+    pool.post([&count](int n) { count += n; }, 1);
+  }
+  while (count.load() != 200) {
+    std::this_thread::yield();
+  }
+
+  slb::thread_pool single(0);
+  CHECK(single.size() == 1);
+}
+
+TEST_CASE("thread_pool(destructor)", "[thread.pool]") {
+  // The destructor runs the tasks still queued, including the ones they post.
+  std::atomic<int> count(0);
+  {
+    slb::thread_pool pool(2);
+    for (int i = 0; i < 1000; ++i) {
+      pool.post([&pool, &count, i] {
+        if (i % 10 == 0) {
+          pool.post([&count] { ++count; });
+        }
+        ++count;
+      });
+    }
+  }
+  CHECK(count.load() == 1100);
+}
+
+TEST_CASE("thread_pool(push-failure)", "[thread.pool]") {
+  // A task that can't be queued is destroyed along with its callable.
+  using thread_pool::Tracked;
+  {
+    slb::thread_pool pool(1);
+    std::promise<void> gate;
+    std::shared_future<void> open = gate.get_future().share();
+    pool.post([open] { open.wait(); });
+
+    bool failed = false;
+    thread_pool::fail_size = 256;
+    for (int i = 0; i < 10000 && !failed; ++i) {
+      try {
+        pool.post(Tracked());
+      } catch (std::bad_alloc const&) {
+        failed = true;
+      }
+    }
+    thread_pool::fail_size = 0;
+    CHECK(failed);
+    gate.set_value();
+  }
+  CHECK(Tracked::live.load() == 0);
+}
+
+TEST_CASE("thread_pool(parallel_for)", "[thread.pool]") {
+  slb::thread_pool pool(4);
+
+  std::vector<int> hits(10000);
+  pool.parallel_for(std::size_t(0), hits.size(), std::size_t(64),
+                    [&hits](std::size_t i) { ++hits[i]; });
+  int total = 0;
+  bool once = true;
+  for (int h : hits) {
+    total += h;
+    once = once && h == 1;
+  }
+  CHECK(total == 10000);
+  CHECK(once);
+
+  // Empty ranges and a grain of zero.
+  int calls = 0;
+  pool.parallel_for(5, 5, 1, [&calls](int) { ++calls; });
+  pool.parallel_for(5, 3, 1, [&calls](int) { ++calls; });
+  CHECK(calls == 0);
+  std::atomic<int> small(0);
+  pool.parallel_for(-3, 3, 0, [&small](int i) { small += i + 3; });
+  CHECK(small.load() == 15);
+
+  // The first exception is rethrown once all chunks are done or skipped.
+  std::atomic<int> ran(0);
+  CHECK_THROWS_AS(pool.parallel_for(0, 1000, 10,
+                                    [&ran](int i) {
+                                      ++ran;
+                                      if (i == 500) {
+                                        throw std::runtime_error("boom");
+                                      }
+                                    }),
+                  std::runtime_error);
+  CHECK(ran.load() <= 1000);
+}
+
+TEST_CASE("thread_pool(fork-join)", "[thread.pool]") {
+  for (std::size_t threads = 1; threads <= 8; threads *= 2) {
+    slb::thread_pool pool(threads);
+    CHECK(thread_pool::sum_range(pool, 0, 100000) == 4999950000LL);
+  }
+}
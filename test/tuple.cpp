@@ -0,0 +1,152 @@
+/*
+  SLB.Tuple
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/tuple.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "catch.hpp"
+
+namespace user {
+struct Point {
+  int x;
+  int y;
+};
+
+template <std::size_t I>
+constexpr int const& get(Point const& p) noexcept {
+  return I == 0 ? p.x : p.y;
+}
+} // namespace user
+
+namespace std {
+template <>
+struct tuple_size<user::Point> : std::integral_constant<std::size_t, 2> {};
+} // namespace std
+
+struct Counted {
+  static int copies;
+  static int moves;
+  Counted() = default;
+  Counted(Counted const&) { ++copies; }
+  Counted(Counted&&) { ++moves; }
+};
+int Counted::copies = 0;
+int Counted::moves = 0;
+
+constexpr int sum(int a, int b) { return a + b; }
+
+// [tuple.apply], calling a function with a tuple of arguments
+
+// template<class F, class Tuple>
+//   constexpr decltype(auto) apply(F&& f, Tuple&& t);
+TEST_CASE("apply", "[tuple.apply]") {
+  CHECK(slb::apply(sum, std::make_tuple(1, 2)) == 3);
+  CHECK(slb::apply(sum, std::make_pair(1, 2)) == 3);
+  CHECK(slb::apply(sum, std::array<int, 2>{{1, 2}}) == 3);
+  CHECK(slb::apply([] { return 42; }, std::tuple<>{}) == 42);
+
+  /* user-defined tuple-like */ {
+    constexpr user::Point p = {1, 2};
+    constexpr int r = slb::apply(sum, p);
+    CHECK(r == 3);
+  }
+
+  /* returns references */ {
+    std::tuple<int> t(0);
+    int& r = slb::apply([](int& i) -> int& { return i; }, t);
+    CHECK(&r == &std::get<0>(t));
+  }
+
+  /* pointer to member */ {
+    struct S {
+      int val;
+      int get(int x) const { return val + x; }
+    } s = {40};
+    CHECK(slb::apply(&S::get, std::make_tuple(s, 2)) == 42);
+    CHECK(slb::apply(&S::get, std::make_tuple(&s, 2)) == 42);
+    CHECK(slb::apply(&S::val, std::make_tuple(std::ref(s))) == 40);
+  }
+
+  /* noexcept */ {
+    struct NothrowF {
+      void operator()(int) noexcept {}
+    };
+    struct F {
+      void operator()(int) {}
+    };
+    std::tuple<int> t(0);
+    CHECK(noexcept(slb::apply(NothrowF{}, t)));
+    CHECK_FALSE(noexcept(slb::apply(F{}, t)));
+  }
+
+  /* no intermediate copies */ {
+    Counted::copies = Counted::moves = 0;
+    std::tuple<Counted, Counted> t;
+    slb::apply([](Counted const&, Counted const&) {}, t);
+    CHECK(Counted::copies == 0);
+    CHECK(Counted::moves == 0);
+
+    slb::apply([](Counted, Counted) {}, std::move(t));
+    CHECK(Counted::copies == 0);
+    CHECK(Counted::moves == 2);
+  }
+}
+
+// template<class T, class Tuple>
+//   constexpr T make_from_tuple(Tuple&& t);
+TEST_CASE("make_from_tuple", "[tuple.apply]") {
+  struct S {
+    int a;
+    std::string b;
+    S(int a, std::string b) : a(a), b(std::move(b)) {}
+  };
+  S s = slb::make_from_tuple<S>(std::make_tuple(42, "42"));
+  CHECK(s.a == 42);
+  CHECK(s.b == "42");
+
+  CHECK(slb::make_from_tuple<std::pair<int, int>>(std::array<int, 2>{{1, 2}})
+            .second == 2);
+
+  /* user-defined tuple-like */ {
+    struct C {
+      int v;
+      constexpr C(int x, int y) : v(x * 10 + y) {}
+    };
+    constexpr user::Point p = {1, 2};
+    constexpr C c = slb::make_from_tuple<C>(p);
+    CHECK(c.v == 12);
+  }
+
+  /* single element */ {
+    struct E {
+      explicit E(int v) : v(v) {}
+      int v;
+    };
+    CHECK(slb::make_from_tuple<E>(std::make_tuple(3)).v == 3);
+    CHECK(slb::make_from_tuple<long>(std::make_tuple(4)) == 4L);
+  }
+
+  /* no intermediate copies */ {
+    struct T {
+      T(Counted, Counted const&) {}
+    };
+    Counted::copies = Counted::moves = 0;
+    std::tuple<Counted, Counted> t;
+    slb::make_from_tuple<T>(std::move(t));
+    CHECK(Counted::copies == 0);
+    CHECK(Counted::moves == 1);
+  }
+}
@@ -294,6 +294,45 @@ TEST_CASE("is_trivially_copyable", "[meta.unary.prop]") {
 }
 #endif
 
+// template<class T> struct is_trivially_relocatable;
+struct Relocatable {
+  int* p;
+  Relocatable() : p(nullptr) {}
+  Relocatable(Relocatable&& that) noexcept : p(that.p) { that.p = nullptr; }
+  ~Relocatable() {}
+};
+
+namespace slb {
+template <>
+struct is_trivially_relocatable<Relocatable> : slb::true_type {};
+} // namespace slb
+
+TEST_CASE("is_trivially_relocatable", "[meta.unary.prop]") {
+  struct NonTrivial {
+    NonTrivial(NonTrivial&&) {}
+  };
+
+  CHECK(std::is_base_of<slb::true_type,
+                        slb::is_trivially_relocatable<int>>::value);
+  CHECK(std::is_base_of<slb::true_type,
+                        slb::is_trivially_relocatable<int*>>::value);
+  CHECK(std::is_base_of<slb::false_type,
+                        slb::is_trivially_relocatable<NonTrivial>>::value);
+
+  /* user specialization */ {
+    CHECK(slb::is_trivially_relocatable<Relocatable>::value);
+  }
+
+#if SLB_TRIVIALITY_TRAITS
+  struct Pod {
+    int x;
+    double y;
+  };
+  CHECK(slb::is_trivially_relocatable<Pod>::value);
+  CHECK(slb::is_trivially_relocatable<Pod[4]>::value);
+#endif
+}
+
 // template<class T> struct is_standard_layout;
 TEST_CASE("is_standard_layout", "[meta.unary.prop]") {
   CHECK(std::is_base_of<slb::true_type, slb::is_standard_layout<int>>::value);
@@ -740,6 +779,53 @@ TEST_CASE("is_move_assignable", "[meta.unary.prop]") {
   CHECK(std::is_base_of<slb::true_type, slb::is_move_assignable<int>>::value);
 }
 
+namespace swappable {
+struct NonSwappable {
+  NonSwappable& operator=(NonSwappable const&) = delete;
+};
+
+struct ThrowingSwap {};
+void swap(ThrowingSwap&, ThrowingSwap&) {}
+
+struct A {};
+struct B {};
+void swap(A&, B&) noexcept {}
+void swap(B&, A&) noexcept {}
+} // namespace swappable
+
+// template<class T, class U> struct is_swappable_with;
+TEST_CASE("is_swappable_with", "[meta.unary.prop]") {
+  CHECK(std::is_base_of<slb::true_type,
+                        slb::is_swappable_with<int&, int&>>::value);
+  CHECK(std::is_base_of<slb::false_type,
+                        slb::is_swappable_with<int, int>>::value);
+  CHECK(std::is_base_of<slb::false_type,
+                        slb::is_swappable_with<int&, long&>>::value);
+  CHECK(std::is_base_of<
+        slb::true_type,
+        slb::is_swappable_with<swappable::A&, swappable::B&>>::value);
+  CHECK(std::is_base_of<
+        slb::true_type,
+        slb::is_swappable_with<swappable::A&, swappable::A&>>::value);
+  CHECK(std::is_base_of<slb::false_type,
+                        slb::is_swappable_with<void, void>>::value);
+}
+
+// template<class T> struct is_swappable;
+TEST_CASE("is_swappable", "[meta.unary.prop]") {
+  CHECK(std::is_base_of<slb::true_type, slb::is_swappable<int>>::value);
+  CHECK(std::is_base_of<slb::true_type, slb::is_swappable<int[4]>>::value);
+  CHECK(std::is_base_of<slb::true_type, slb::is_swappable<int&>>::value);
+  CHECK(std::is_base_of<slb::false_type,
+                        slb::is_swappable<int const>>::value);
+  CHECK(std::is_base_of<slb::false_type, slb::is_swappable<void>>::value);
+  CHECK(std::is_base_of<
+        slb::false_type,
+        slb::is_swappable<swappable::NonSwappable>>::value);
+  CHECK(std::is_base_of<slb::true_type,
+                        slb::is_swappable<swappable::ThrowingSwap>>::value);
+}
+
 #if SLB_TRIVIALITY_TRAITS
 // template<class T, class U> struct is_trivially_assignable;
 TEST_CASE("is_trivially_assignable", "[meta.unary.prop]") {
@@ -846,6 +932,31 @@ TEST_CASE("is_nothrow_move_assignable", "[meta.unary.prop]") {
                         slb::is_nothrow_move_assignable<int>>::value);
 }
 
+// template<class T, class U> struct is_nothrow_swappable_with;
+TEST_CASE("is_nothrow_swappable_with", "[meta.unary.prop]") {
+  CHECK(std::is_base_of<slb::true_type,
+                        slb::is_nothrow_swappable_with<int&, int&>>::value);
+  CHECK(std::is_base_of<slb::false_type,
+                        slb::is_nothrow_swappable_with<int, int>>::value);
+  CHECK(std::is_base_of<
+        slb::true_type,
+        slb::is_nothrow_swappable_with<swappable::A&, swappable::B&>>::value);
+}
+
+// template<class T> struct is_nothrow_swappable;
+TEST_CASE("is_nothrow_swappable", "[meta.unary.prop]") {
+  CHECK(std::is_base_of<slb::true_type,
+                        slb::is_nothrow_swappable<int>>::value);
+  CHECK(std::is_base_of<slb::true_type,
+                        slb::is_nothrow_swappable<int[4]>>::value);
+  CHECK(std::is_base_of<
+        slb::false_type,
+        slb::is_nothrow_swappable<swappable::NonSwappable>>::value);
+  CHECK(std::is_base_of<
+        slb::false_type,
+        slb::is_nothrow_swappable<swappable::ThrowingSwap>>::value);
+}
+
 // template<class T> struct has_virtual_destructor;
 TEST_CASE("has_virtual_destructor", "[meta.unary.prop]") {
   class WithVirtualDestructor {
@@ -1300,6 +1411,191 @@ TEST_CASE("remove_cvref", "[meta.trans.other]") {
       std::is_same<slb::remove_cvref<int const volatile&&>::type, int>::value);
 }
 
+template <typename T>
+struct no_result_void {
+  using type = void;
+};
+
+template <typename T, typename Enable = void>
+struct no_result : std::true_type {};
+
+template <typename T>
+struct no_result<T, typename no_result_void<typename T::type>::type>
+    : std::false_type {};
+
+// template<class... T> struct common_type;
+namespace common_type_ns {
+struct A {};
+struct B {
+  B(A) {}
+};
+struct C {};
+} // namespace common_type_ns
+
+// A chain of conversions, `A` to `B` to `C`, which only a left fold follows.
+namespace common_type_fold_ns {
+struct C {};
+struct B {
+  operator C() const { return C{}; }
+};
+struct A {
+  operator B() const { return B{}; }
+};
+} // namespace common_type_fold_ns
+
+namespace slb {
+template <>
+struct common_type<common_type_ns::A, common_type_ns::C> {
+  using type = common_type_ns::C;
+};
+} // namespace slb
+
+TEST_CASE("common_type", "[meta.trans.other]") {
+  using common_type_ns::A;
+  using common_type_ns::B;
+  using common_type_ns::C;
+
+  CHECK(no_result<slb::common_type<>>::value);
+
+  CHECK(std::is_same<slb::common_type<int>::type, int>::value);
+  CHECK(std::is_same<slb::common_type<int const&>::type, int>::value);
+  CHECK(std::is_same<slb::common_type<int[2]>::type, int*>::value);
+
+  CHECK(std::is_same<slb::common_type<int, long>::type, long>::value);
+  CHECK(std::is_same<slb::common_type<int&, int&&>::type, int>::value);
+  CHECK(std::is_same<slb::common_type<int const&, int volatile&>::type,
+                     int>::value);
+  CHECK(std::is_same<slb::common_type<void, void>::type, void>::value);
+  CHECK(std::is_same<slb::common_type<A, B>::type, B>::value);
+  CHECK(std::is_same<slb::common_type<B, A>::type, B>::value);
+  CHECK(
+      std::is_same<slb::common_type<int*, std::nullptr_t>::type, int*>::value);
+
+  CHECK(std::is_same<slb::common_type<char, short, int, long, long long>::type,
+                     long long>::value);
+  CHECK(std::is_same<slb::common_type<int, float, double>::type,
+                     double>::value);
+  CHECK(std::is_same<slb::common_type<A, B, B, A, B>::type, B>::value);
+
+  /* left fold */ {
+    using common_type_fold_ns::A;
+    using common_type_fold_ns::B;
+    using common_type_fold_ns::C;
+
+    CHECK(std::is_same<slb::common_type<A, B, C>::type, C>::value);
+    CHECK(no_result<slb::common_type<A, C>>::value);
+  }
+
+  /* program-defined specializations */ {
+    CHECK(std::is_same<slb::common_type<A, C>::type, C>::value);
+    CHECK(std::is_same<slb::common_type<A const&, C&&>::type, C>::value);
+    CHECK(std::is_same<slb::common_type<A, C, C>::type, C>::value);
+    CHECK(no_result<slb::common_type<C, A>>::value);
+  }
+
+  /* sfinae */ {
+    CHECK(no_result<slb::common_type<int, A>>::value);
+    CHECK(no_result<slb::common_type<void, int>>::value);
+    CHECK(no_result<slb::common_type<int, int, A>>::value);
+    CHECK(no_result<slb::common_type<A, int, int>>::value);
+    CHECK(no_result<slb::common_type<int, A, long, long>>::value);
+  }
+}
+
+// template<class T, class U, template<class> class TQual,
+//          template<class> class UQual>
+//   struct basic_common_reference { };
+// template<class... T> struct common_reference;
+namespace common_reference_ns {
+struct Base {};
+struct Derived : Base {};
+
+struct X {};
+struct Y {};
+struct Z {};
+} // namespace common_reference_ns
+
+namespace slb {
+template <template <typename> class XQual, template <typename> class YQual>
+struct basic_common_reference<common_reference_ns::X,
+                              common_reference_ns::Y,
+                              XQual,
+                              YQual> {
+  using type = XQual<common_reference_ns::Z>;
+};
+} // namespace slb
+
+TEST_CASE("common_reference", "[meta.trans.other]") {
+  using common_reference_ns::Base;
+  using common_reference_ns::Derived;
+  using common_reference_ns::X;
+  using common_reference_ns::Y;
+  using common_reference_ns::Z;
+
+  CHECK(no_result<slb::common_reference<>>::value);
+
+  CHECK(std::is_same<slb::common_reference<int>::type, int>::value);
+  CHECK(std::is_same<slb::common_reference<int&>::type, int&>::value);
+  CHECK(std::is_same<slb::common_reference<int const&&>::type,
+                     int const&&>::value);
+
+  /* COMMON-REF */ {
+    CHECK(std::is_same<slb::common_reference<int&, int&>::type, int&>::value);
+    CHECK(std::is_same<slb::common_reference<int&, int const&>::type,
+                       int const&>::value);
+    CHECK(std::is_same<slb::common_reference<int const&, int volatile&>::type,
+                       int const volatile&>::value);
+    CHECK(
+        std::is_same<slb::common_reference<int&&, int&&>::type, int&&>::value);
+    CHECK(std::is_same<slb::common_reference<int const&&, int&&>::type,
+                       int const&&>::value);
+    CHECK(std::is_same<slb::common_reference<int&&, int&>::type,
+                       int const&>::value);
+    CHECK(std::is_same<slb::common_reference<int&, int&&>::type,
+                       int const&>::value);
+    CHECK(std::is_same<slb::common_reference<Base&, Derived&>::type,
+                       Base&>::value);
+    CHECK(std::is_same<slb::common_reference<Derived&&, Base&&>::type,
+                       Base&&>::value);
+    CHECK(std::is_same<slb::common_reference<Derived const&, Base&>::type,
+                       Base const&>::value);
+  }
+
+  /* basic_common_reference */ {
+    CHECK(std::is_same<slb::common_reference<X, Y>::type, Z>::value);
+    CHECK(std::is_same<slb::common_reference<X&, Y>::type, Z&>::value);
+    CHECK(std::is_same<slb::common_reference<X const&, Y&&>::type,
+                       Z const&>::value);
+    CHECK(std::is_same<slb::common_reference<X&&, Y&>::type, Z&&>::value);
+    CHECK(no_result<slb::common_reference<Y, X>>::value);
+  }
+
+  /* COND-RES */ {
+    CHECK(std::is_same<slb::common_reference<int, int&>::type, int>::value);
+    CHECK(std::is_same<slb::common_reference<int&, long&>::type, long>::value);
+    CHECK(std::is_same<slb::common_reference<void, void>::type, void>::value);
+  }
+
+  /* common_type */ {
+    CHECK(std::is_same<slb::common_reference<int, long>::type, long>::value);
+  }
+
+  /* fold */ {
+    CHECK(std::is_same<slb::common_reference<int&, int&, int const&>::type,
+                       int const&>::value);
+    CHECK(std::is_same<slb::common_reference<Derived&, Base&, Base&&>::type,
+                       Base const&>::value);
+    CHECK(std::is_same<slb::common_reference<int&, int&, long>::type,
+                       long>::value);
+  }
+
+  /* sfinae */ {
+    CHECK(no_result<slb::common_reference<int, X>>::value);
+    CHECK(no_result<slb::common_reference<int&, int&, X>>::value);
+    CHECK(no_result<slb::common_reference<X, int&, int&>>::value);
+  }
+}
+
 // template<class T>
 //   using type_identity_t  = typename type_identity<T>::type;
 TEST_CASE("type_identity_t", "[meta.trans.other]") {
@@ -1363,6 +1659,13 @@ TEST_CASE("common_type_t", "[meta.trans.other]") {
                      std::common_type<int, float, double>::type>::value);
 }
 
+// template<class... T>
+//   using common_reference_t = typename common_reference<T...>::type;
+TEST_CASE("common_reference_t", "[meta.trans.other]") {
+  CHECK(std::is_same<slb::common_reference_t<int&, int const&>,
+                     slb::common_reference<int&, int const&>::type>::value);
+}
+
 // template<class T>
 //   using underlying_type_t = typename underlying_type<T>::type;
 TEST_CASE("underlying_type_t", "[meta.trans.other]") {
@@ -1372,18 +1675,6 @@ TEST_CASE("underlying_type_t", "[meta.trans.other]") {
 }
 
 // template <class Fn, class... ArgTypes> struct invoke_result;
-template <typename T>
-struct no_result_void {
-  using type = void;
-};
-
-template <typename T, typename Enable = void>
-struct no_result : std::true_type {};
-
-template <typename T>
-struct no_result<T, typename no_result_void<typename T::type>::type>
-    : std::false_type {};
-
 TEST_CASE("invoke_result", "[meta.trans.other]") {
   struct C {};
   struct D : C {};
@@ -1980,6 +2271,18 @@ TEST_CASE("is_trivially_copyable_v", "[meta.unary.prop]") {
 }
 #endif
 
+// template<class T>
+//   inline constexpr bool is_trivially_relocatable_v
+//     = is_trivially_relocatable<T>::value;
+TEST_CASE("is_trivially_relocatable_v", "[meta.unary.prop]") {
+  CHECK(std::is_same<decltype(slb::is_trivially_relocatable_v<int>),
+                     bool const>::value);
+  CHECK(slb::is_trivially_relocatable_v<int> ==
+        slb::is_trivially_relocatable<int>::value);
+  constexpr bool v = slb::is_trivially_relocatable_v<int>;
+  (void)v;
+}
+
 // template<class T>
 //   inline constexpr bool is_standard_layout_v = is_standard_layout<T>::value;
 TEST_CASE("is_standard_layout_v", "[meta.unary.prop]") {
@@ -2155,6 +2458,27 @@ TEST_CASE("is_move_assignable_v", "[meta.unary.prop]") {
   (void)v;
 }
 
+// template<class T, class U>
+//   inline constexpr bool is_swappable_with_v
+//     = is_swappable_with<T, U>::value;
+TEST_CASE("is_swappable_with_v", "[meta.unary.prop]") {
+  CHECK(std::is_same<decltype(slb::is_swappable_with_v<int&, int&>),
+                     bool const>::value);
+  CHECK(slb::is_swappable_with_v<int&, int&> ==
+        slb::is_swappable_with<int&, int&>::value);
+  constexpr bool v = slb::is_swappable_with_v<int&, int&>;
+  (void)v;
+}
+
+// template<class T>
+//   inline constexpr bool is_swappable_v = is_swappable<T>::value;
+TEST_CASE("is_swappable_v", "[meta.unary.prop]") {
+  CHECK(std::is_same<decltype(slb::is_swappable_v<int>), bool const>::value);
+  CHECK(slb::is_swappable_v<int> == slb::is_swappable<int>::value);
+  constexpr bool v = slb::is_swappable_v<int>;
+  (void)v;
+}
+
 // template<class T>
 //   inline constexpr bool is_destructible_v = is_destructible<T>::value;
 TEST_CASE("is_destructible_v", "[meta.unary.prop]") {
@@ -2348,6 +2672,30 @@ TEST_CASE("is_nothrow_move_assignable_v", "[meta.unary.prop]") {
   (void)v;
 }
 
+// template<class T, class U>
+//   inline constexpr bool is_nothrow_swappable_with_v
+//     = is_nothrow_swappable_with<T, U>::value;
+TEST_CASE("is_nothrow_swappable_with_v", "[meta.unary.prop]") {
+  CHECK(std::is_same<decltype(slb::is_nothrow_swappable_with_v<int&, int&>),
+                     bool const>::value);
+  CHECK(slb::is_nothrow_swappable_with_v<int&, int&> ==
+        slb::is_nothrow_swappable_with<int&, int&>::value);
+  constexpr bool v = slb::is_nothrow_swappable_with_v<int&, int&>;
+  (void)v;
+}
+
+// template<class T>
+//   inline constexpr bool is_nothrow_swappable_v
+//     = is_nothrow_swappable<T>::value;
+TEST_CASE("is_nothrow_swappable_v", "[meta.unary.prop]") {
+  CHECK(std::is_same<decltype(slb::is_nothrow_swappable_v<int>),
+                     bool const>::value);
+  CHECK(slb::is_nothrow_swappable_v<int> ==
+        slb::is_nothrow_swappable<int>::value);
+  constexpr bool v = slb::is_nothrow_swappable_v<int>;
+  (void)v;
+}
+
 // template<class T>
 //   inline constexpr bool is_nothrow_destructible_v
 //     = is_nothrow_destructible<T>::value;
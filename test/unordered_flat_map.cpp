@@ -0,0 +1,391 @@
+/*
+  SLB.UnorderedFlatMap
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/unordered_flat_map.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "catch.hpp"
+
+namespace unordered_flat_map {
+
+struct string_hash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string const& x) const {
+    return std::hash<std::string>()(x);
+  }
+  std::size_t operator()(char const* x) const {
+    return std::hash<std::string>()(x);
+  }
+};
+
+struct string_equal {
+  using is_transparent = void;
+
+  bool operator()(std::string const& x, std::string const& y) const {
+    return x == y;
+  }
+  bool operator()(std::string const& x, char const* y) const {
+    return std::strcmp(x.c_str(), y) == 0;
+  }
+  bool operator()(char const* x, std::string const& y) const {
+    return std::strcmp(x, y.c_str()) == 0;
+  }
+};
+
+// Sends every key to the same group with the same control byte.
+struct constant_hash {
+  using is_avalanching = void;
+
+  std::size_t operator()(int) const { return 42; }
+};
+
+// Hashes differently for each salt.
+struct salted_hash {
+  explicit salted_hash(std::size_t salt = 0) : salt(salt) {}
+
+  std::size_t operator()(int x) const {
+    return std::hash<int>()(x) * 31 + salt;
+  }
+
+  std::size_t salt;
+};
+
+// Throws from a copy, or from the call that exhausts `calls_left`.
+struct throwing_hash {
+  throwing_hash() = default;
+  throwing_hash(throwing_hash const&) {
+    if (fail_copy) {
+      throw std::runtime_error("copy");
+    }
+  }
+  throwing_hash& operator=(throwing_hash const&) = default;
+
+  std::size_t operator()(int x) const {
+    if (calls_left >= 0 && calls_left-- == 0) {
+      throw std::runtime_error("hash");
+    }
+    return std::hash<int>()(x);
+  }
+
+  static bool fail_copy;
+  static int calls_left;
+};
+
+bool throwing_hash::fail_copy = false;
+int throwing_hash::calls_left = -1;
+
+// Allocators with different tags compare unequal, and don't propagate on
+// move assignment.
+template <typename T>
+struct tagged_allocator {
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::false_type;
+
+  explicit tagged_allocator(int tag) : tag(tag) {}
+  template <typename U>
+  tagged_allocator(tagged_allocator<U> const& other) : tag(other.tag) {}
+
+  T* allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+  void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+  int tag;
+};
+
+template <typename T, typename U>
+bool operator==(tagged_allocator<T> const& x, tagged_allocator<U> const& y) {
+  return x.tag == y.tag;
+}
+
+template <typename T, typename U>
+bool operator!=(tagged_allocator<T> const& x, tagged_allocator<U> const& y) {
+  return x.tag != y.tag;
+}
+
+using map = slb::unordered_flat_map<int, std::string>;
+
+} // namespace unordered_flat_map
+
+TEST_CASE("unordered_flat_map(iterator)", "[unord.flat.map]") {
+  using unordered_flat_map::map;
+  CHECK((std::is_same<std::iterator_traits<map::iterator>::iterator_category,
+                      std::forward_iterator_tag>::value));
+  CHECK((std::is_convertible<map::iterator, map::const_iterator>::value));
+  CHECK_FALSE(
+      (std::is_convertible<map::const_iterator, map::iterator>::value));
+
+  map m = {{1, "a"}, {2, "b"}, {3, "c"}};
+  CHECK(std::distance(m.begin(), m.end()) == 3);
+  for (map::iterator it = m.begin(); it != m.end(); ++it) {
+    it->second += "!";
+  }
+  CHECK(m.at(2) == "b!");
+  map::const_iterator cit = m.begin();
+  CHECK(cit == m.begin());
+  CHECK(m.cbegin() != m.cend());
+
+  map const e;
+  CHECK(e.begin() == e.end());
+}
+
+TEST_CASE("unordered_flat_map(construct)", "[unord.flat.map]") {
+  using unordered_flat_map::map;
+
+  /* default */ {
+    map const m;
+    CHECK(m.empty());
+    CHECK(m.size() == 0);
+    CHECK(m.bucket_count() == 0);
+    CHECK(m.find(1) == m.end());
+  }
+
+  /* bucket count */ {
+    map const m(100);
+    CHECK(m.empty());
+    CHECK(m.bucket_count() >= 100);
+  }
+
+  /* range */ {
+    std::pair<int, std::string> const arr[] = {{5, "e"}, {1, "a"}, {5, "x"}};
+    map const m(arr, arr + 3);
+    CHECK(m.size() == 2);
+    CHECK(m.at(5) == "e");
+  }
+
+  /* copy, move */ {
+    map m = {{1, "a"}, {2, "b"}};
+    map c = m;
+    CHECK(c == m);
+    map n = std::move(m);
+    CHECK(n == c);
+    CHECK(m.empty());
+    m = n;
+    CHECK(m == n);
+    c = {{3, "c"}};
+    CHECK(c.size() == 1);
+    n = std::move(c);
+    CHECK(n.at(3) == "c");
+  }
+
+  /* move assignment, unequal allocators */ {
+    using unordered_flat_map::salted_hash;
+    using alloc = unordered_flat_map::tagged_allocator<
+        std::pair<int const, std::string>>;
+    using salted_map =
+        slb::unordered_flat_map<int, std::string, salted_hash,
+                                std::equal_to<int>, alloc>;
+    salted_map m(0, salted_hash(1), alloc(1));
+    salted_map n(0, salted_hash(2), alloc(2));
+    for (int i = 0; i < 100; ++i) {
+      n.emplace(i, std::to_string(i));
+    }
+    m = std::move(n);
+    CHECK(m.get_allocator().tag == 1);
+    CHECK(m.hash_function().salt == 2);
+    CHECK(m.size() == 100);
+    for (int i = 0; i < 100; ++i) {
+      CHECK(m.count(i) == 1);
+    }
+  }
+}
+
+TEST_CASE("unordered_flat_map(modifiers)", "[unord.flat.map]") {
+  using unordered_flat_map::map;
+
+  map m;
+  m[2] = "b";
+  m[1] = "a";
+  CHECK(m.size() == 2);
+  CHECK(m.at(1) == "a");
+  CHECK_THROWS_AS(m.at(3), std::out_of_range);
+
+  std::pair<map::iterator, bool> r = m.insert({3, "c"});
+  CHECK(r.second);
+  CHECK(r.first->second == "c");
+  r = m.insert(std::make_pair(3, "z"));
+  CHECK_FALSE(r.second);
+  CHECK(r.first->second == "c");
+  CHECK(m.emplace(0, "0").second);
+  CHECK(m.try_emplace(0, "z").second == false);
+  CHECK(m.try_emplace(4, 2, 'd').first->second == "dd");
+  CHECK_FALSE(m.insert_or_assign(4, "d").second);
+  CHECK(m.at(4) == "d");
+  CHECK(m.insert_or_assign(m.end(), 5, "e")->first == 5);
+  CHECK(m.size() == 6);
+
+  CHECK(m.erase(3) == 1);
+  CHECK(m.erase(3) == 0);
+  m.erase(m.find(4));
+  CHECK_FALSE(m.contains(4));
+  CHECK(m.erase(m.cbegin(), m.cend()) == m.end());
+  CHECK(m.empty());
+
+  m = {{1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}};
+  CHECK(slb::erase_if(m, [](map::const_reference x) {
+          return x.first % 2 == 0;
+        }) == 2);
+  CHECK(m.size() == 2);
+  CHECK(m.contains(1));
+  CHECK(m.contains(3));
+
+  map n = {{1, "a"}};
+  swap(m, n);
+  CHECK(m.size() == 1);
+  CHECK(n.size() == 2);
+  n.clear();
+  CHECK(n.empty());
+  CHECK(n.find(1) == n.end());
+}
+
+TEST_CASE("unordered_flat_map(lookup)", "[unord.flat.map]") {
+  using unordered_flat_map::map;
+
+  map const m = {{1, "a"}, {3, "c"}, {5, "e"}};
+  CHECK(m.find(3)->second == "c");
+  CHECK(m.find(2) == m.end());
+  CHECK(m.count(5) == 1);
+  CHECK(m.count(4) == 0);
+  CHECK(m.contains(1));
+  CHECK_FALSE(m.contains(0));
+  CHECK(m.equal_range(3).first == m.find(3));
+  CHECK(std::distance(m.equal_range(3).first, m.equal_range(3).second) == 1);
+  CHECK(m.equal_range(4).first == m.equal_range(4).second);
+  CHECK(m.key_eq()(1, 1));
+
+  slb::unordered_flat_map<std::string, int, unordered_flat_map::string_hash,
+                          unordered_flat_map::string_equal>
+      t = {{"b", 2}, {"a", 1}};
+  CHECK(t.contains("a"));
+  CHECK(t.find("b")->second == 2);
+  CHECK(t.count("c") == 0);
+  CHECK(t.at("a") == 1);
+  CHECK(t.equal_range("c").first == t.end());
+  t["c"] = 3;
+  CHECK(t.try_emplace("d", 4).second);
+  CHECK_FALSE(t.insert_or_assign("d", 5).second);
+  CHECK(t.at("d") == 5);
+  CHECK(t.erase("a") == 1);
+  CHECK(t.size() == 3);
+}
+
+TEST_CASE("unordered_flat_map(rehash)", "[unord.flat.map]") {
+  using unordered_flat_map::map;
+
+  map m;
+  m.reserve(100);
+  std::size_t const buckets = m.bucket_count();
+  CHECK(buckets >= 100);
+  for (int i = 0; i < 100; ++i) {
+    m.emplace(i, std::to_string(i));
+  }
+  CHECK(m.bucket_count() == buckets);
+  CHECK(m.load_factor() <= m.max_load_factor());
+
+  m.rehash(1000);
+  CHECK(m.bucket_count() >= 1000);
+  CHECK(m.size() == 100);
+  for (int i = 0; i < 100; ++i) {
+    CHECK(m.at(i) == std::to_string(i));
+  }
+
+  // Never fewer buckets than the elements need.
+  m.rehash(0);
+  CHECK(m.bucket_count() >= 100);
+  CHECK(m.bucket_count() < 1000);
+  CHECK(m.at(99) == "99");
+
+  m.clear();
+  m.rehash(0);
+  CHECK(m.bucket_count() == 0);
+
+  // Inserting an element of the table itself as the table grows.
+  map g = {{0, "x"}};
+  for (int i = 1; i < 100; ++i) {
+    g.emplace(i, g.at(i - 1));
+  }
+  CHECK(g.at(99) == "x");
+
+  /* throwing hasher */ {
+    using unordered_flat_map::throwing_hash;
+    slb::unordered_flat_map<int, int, throwing_hash> t;
+    for (int i = 0; i < 10; ++i) {
+      t.emplace(i, i);
+    }
+    std::size_t const before = t.bucket_count();
+
+    throwing_hash::calls_left = 5;
+    CHECK_THROWS_AS(t.rehash(1000), std::runtime_error);
+    throwing_hash::calls_left = -1;
+    throwing_hash::fail_copy = true;
+    CHECK_THROWS_AS(t.rehash(1000), std::runtime_error);
+    throwing_hash::fail_copy = false;
+
+    CHECK(t.bucket_count() == before);
+    CHECK(t.size() == 10);
+    for (int i = 0; i < 10; ++i) {
+      CHECK(t.at(i) == i);
+    }
+  }
+}
+
+TEST_CASE("unordered_flat_map(probing)", "[unord.flat.map]") {
+  // Interleaves insertions and erasures across growth, tombstones, and
+  // rehashing in place, and checks the table against `std::map`.
+  slb::unordered_flat_map<int, int> m;
+  slb::unordered_flat_map<int, int, unordered_flat_map::constant_hash> c;
+  std::map<int, int> ref;
+  unsigned state = 1;
+  for (int n = 0; n < 5000; ++n) {
+    state = state * 1103515245u + 12345u;
+    int const key = static_cast<int>((state >> 16) % 300);
+    if ((state >> 8) % 3 == 0) {
+      std::size_t const erased = ref.erase(key);
+      CHECK(m.erase(key) == erased);
+      CHECK(c.erase(key) == erased);
+    } else {
+      bool const inserted = ref.emplace(key, n).second;
+      CHECK(m.emplace(key, n).second == inserted);
+      CHECK(c.emplace(key, n).second == inserted);
+    }
+  }
+  CHECK(m.size() == ref.size());
+  CHECK(c.size() == ref.size());
+  for (std::map<int, int>::value_type const& x : ref) {
+    CHECK(m.at(x.first) == x.second);
+    CHECK(c.at(x.first) == x.second);
+  }
+  std::size_t count = 0;
+  for (slb::unordered_flat_map<int, int>::value_type const& x : m) {
+    CHECK(ref.count(x.first) == 1);
+    ++count;
+  }
+  CHECK(count == ref.size());
+}
+
+TEST_CASE("unordered_flat_map(compare)", "[unord.flat.map]") {
+  using unordered_flat_map::map;
+  map const a = {{1, "a"}, {2, "b"}};
+  map const b = {{2, "b"}, {1, "a"}};
+  map const c = {{1, "a"}, {2, "c"}};
+  map const d = {{1, "a"}};
+  CHECK(a == b);
+  CHECK(a != c);
+  CHECK(a != d);
+}
@@ -0,0 +1,195 @@
+/*
+  SLB.UnorderedFlatSet
+
+  Copyright Michael Park, 2017
+  Copyright Agustin Berge, 2017
+
+  Distributed under the Boost Software License, Version 1.0.
+  (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+*/
+
+#include <slb/unordered_flat_set.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "catch.hpp"
+
+namespace unordered_flat_set {
+
+struct string_hash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string const& x) const {
+    return std::hash<std::string>()(x);
+  }
+  std::size_t operator()(char const* x) const {
+    return std::hash<std::string>()(x);
+  }
+};
+
+struct string_equal {
+  using is_transparent = void;
+
+  bool operator()(std::string const& x, std::string const& y) const {
+    return x == y;
+  }
+  bool operator()(std::string const& x, char const* y) const {
+    return std::strcmp(x.c_str(), y) == 0;
+  }
+  bool operator()(char const* x, std::string const& y) const {
+    return std::strcmp(x, y.c_str()) == 0;
+  }
+};
+
+// Copies succeed until `throw_countdown` reaches zero. Moves may throw as
+// well, so that rehashing copies rather than moves.
+int throw_countdown = -1;
+
+struct Throwing {
+  int value;
+
+  Throwing(int v) : value(v) {}
+  Throwing(Throwing const& other) : value(other.value) {
+    if (throw_countdown >= 0 && throw_countdown-- == 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+
+  friend bool operator==(Throwing const& x, Throwing const& y) {
+    return x.value == y.value;
+  }
+};
+
+struct throwing_hash {
+  std::size_t operator()(Throwing const& x) const {
+    return std::hash<int>()(x.value);
+  }
+};
+
+} // namespace unordered_flat_set
+
+TEST_CASE("unordered_flat_set(construct)", "[unord.flat.set]") {
+  /* default */ {
+    slb::unordered_flat_set<int> const s;
+    CHECK(s.empty());
+    CHECK(s.size() == 0);
+    CHECK_FALSE(s.contains(0));
+  }
+
+  /* range */ {
+    int const arr[] = {5, 3, 5, 1};
+    slb::unordered_flat_set<int> const s(arr, arr + 4);
+    CHECK(s.size() == 3);
+    CHECK(s.contains(3));
+  }
+
+  /* copy, move */ {
+    slb::unordered_flat_set<int> s = {1, 2, 3};
+    slb::unordered_flat_set<int> c = s;
+    CHECK(c == s);
+    slb::unordered_flat_set<int> m = std::move(s);
+    CHECK(m == c);
+    CHECK(s.empty());
+  }
+
+  CHECK((std::is_same<slb::unordered_flat_set<int>::iterator,
+                      slb::unordered_flat_set<int>::const_iterator>::value));
+}
+
+TEST_CASE("unordered_flat_set(modifiers)", "[unord.flat.set]") {
+  slb::unordered_flat_set<int> s = {1, 3};
+  std::pair<slb::unordered_flat_set<int>::iterator, bool> r = s.insert(2);
+  CHECK(r.second);
+  CHECK(*r.first == 2);
+  r = s.insert(2);
+  CHECK_FALSE(r.second);
+  CHECK(*s.emplace(0).first == 0);
+  CHECK(*s.insert(s.end(), 4) == 4);
+  CHECK(s.size() == 5);
+
+  CHECK(s.erase(3) == 1);
+  CHECK(s.erase(3) == 0);
+  s.erase(s.find(4));
+  CHECK(s.size() == 3);
+
+  CHECK(slb::erase_if(s, [](int x) { return x % 2 == 0; }) == 2);
+  CHECK(s.size() == 1);
+  CHECK(s.contains(1));
+
+  slb::unordered_flat_set<int> t = {5, 6};
+  swap(s, t);
+  CHECK(s.size() == 2);
+  CHECK(t.size() == 1);
+  t.clear();
+  CHECK(t.empty());
+}
+
+TEST_CASE("unordered_flat_set(lookup)", "[unord.flat.set]") {
+  // Large enough to span several groups, and to have grown a few times.
+  std::set<int> ref;
+  slb::unordered_flat_set<int> s;
+  for (int i = 0; i < 1000; i += 3) {
+    ref.insert(i);
+    s.insert(i);
+  }
+  for (int i = -1; i <= 1000; ++i) {
+    CHECK(s.contains(i) == (ref.count(i) == 1));
+    CHECK(s.count(i) == ref.count(i));
+  }
+  CHECK(s.equal_range(3).first == s.find(3));
+  CHECK(s.equal_range(4).first == s.end());
+
+  slb::unordered_flat_set<std::string, unordered_flat_set::string_hash,
+                          unordered_flat_set::string_equal>
+      t = {"b", "c", "a"};
+  CHECK(t.contains("b"));
+  CHECK(*t.find("c") == "c");
+  CHECK(t.count("d") == 0);
+  CHECK(t.equal_range("a").first == t.find("a"));
+  CHECK(t.erase("a") == 1);
+  CHECK(t.size() == 2);
+}
+
+TEST_CASE("unordered_flat_set(exceptions)", "[unord.flat.set]") {
+  using unordered_flat_set::Throwing;
+  using unordered_flat_set::throw_countdown;
+  slb::unordered_flat_set<Throwing, unordered_flat_set::throwing_hash> s;
+  for (int i = 0; i < 14; ++i) {
+    s.insert(Throwing(i));
+  }
+  std::size_t const buckets = s.bucket_count();
+
+  // Growing copies the elements; a failure leaves the set as it was.
+  throw_countdown = 5;
+  CHECK_THROWS_AS(s.insert(Throwing(14)), std::runtime_error);
+  throw_countdown = -1;
+  CHECK(s.size() == 14);
+  CHECK(s.bucket_count() == buckets);
+  for (int i = 0; i < 14; ++i) {
+    CHECK(s.contains(Throwing(i)));
+  }
+
+  throw_countdown = 5;
+  CHECK_THROWS_AS(
+      (slb::unordered_flat_set<Throwing, unordered_flat_set::throwing_hash>(s)),
+      std::runtime_error);
+  throw_countdown = -1;
+}
+
+TEST_CASE("unordered_flat_set(compare)", "[unord.flat.set]") {
+  slb::unordered_flat_set<int> const a = {1, 2, 3};
+  slb::unordered_flat_set<int> const b = {3, 2, 1};
+  slb::unordered_flat_set<int> const c = {1, 2, 4};
+  slb::unordered_flat_set<int> const d = {1, 2};
+  CHECK(a == b);
+  CHECK(a != c);
+  CHECK(a != d);
+}
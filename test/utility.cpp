@@ -11,6 +11,7 @@
 #include <slb/utility.hpp>
 
 #include <cstddef>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -24,6 +25,151 @@
       check_cxx14_constexpr_helper_##Tag::check();                             \
   CHECK(check_cxx14_constexpr_##Tag)
 
+// [utility.swap], swap
+
+namespace swap_adl {
+struct Counted {
+  int val;
+  static int swaps;
+};
+int Counted::swaps = 0;
+
+void swap(Counted& a, Counted& b) {
+  ++Counted::swaps;
+  int tmp = a.val;
+  a.val = b.val;
+  b.val = tmp;
+}
+} // namespace swap_adl
+
+namespace swap_tail_padding {
+// Not a POD, so that a derived class may place its members in the tail
+// padding.
+struct Base {
+  int vals[20];
+
+private:
+  char tag = 0;
+};
+
+struct Derived : Base {
+  char extra;
+};
+} // namespace swap_tail_padding
+
+// template<class T>
+//   void swap(T& a, T& b) noexcept(see below);
+TEST_CASE("swap", "[utility.swap]") {
+  {
+    int a = 1, b = 2;
+    CHECK(noexcept(slb::swap(a, b)));
+    slb::swap(a, b);
+    CHECK(a == 2);
+    CHECK(b == 1);
+  }
+
+  /* trivially copyable, larger than a block */ {
+    struct Big {
+      int vals[67];
+    } a, b;
+    for (int i = 0; i < 67; ++i) {
+      a.vals[i] = i;
+      b.vals[i] = -i;
+    }
+    slb::swap(a, b);
+    bool swapped = true;
+    for (int i = 0; i < 67; ++i) {
+      swapped = swapped && a.vals[i] == -i && b.vals[i] == i;
+    }
+    CHECK(swapped);
+
+    slb::swap(a, a);
+    CHECK(a.vals[1] == -1);
+  }
+
+  /* base class subobject, larger than a block */ {
+    swap_tail_padding::Derived a, b;
+    a.vals[0] = 1;
+    a.extra = 'a';
+    b.vals[0] = 2;
+    b.extra = 'b';
+    slb::swap(static_cast<swap_tail_padding::Base&>(a),
+              static_cast<swap_tail_padding::Base&>(b));
+    CHECK(a.vals[0] == 2);
+    CHECK(b.vals[0] == 1);
+    CHECK(a.extra == 'a');
+    CHECK(b.extra == 'b');
+  }
+
+  /* not trivially copyable */ {
+    std::string a = "a", b = "b";
+    slb::swap(a, b);
+    CHECK(a == "b");
+    CHECK(b == "a");
+  }
+
+  /* may throw */ {
+    struct T {
+      T() = default;
+      T(T&&) {}
+      T& operator=(T&&) = default;
+    };
+    T a, b;
+    CHECK_FALSE(noexcept(slb::swap(a, b)));
+  }
+
+  /* does not hijack argument-dependent lookup */ {
+    slb::index_sequence<0, 1> a, b;
+    using std::swap;
+    swap(a, b);
+  }
+}
+
+// template<class T, size_t N>
+//   void swap(T (&a)[N], T (&b)[N]) noexcept(is_nothrow_swappable_v<T>);
+TEST_CASE("swap(array)", "[utility.swap]") {
+  /* trivially copyable */ {
+    int a[100], b[100];
+    for (int i = 0; i < 100; ++i) {
+      a[i] = i;
+      b[i] = -i;
+    }
+    CHECK(noexcept(slb::swap(a, b)));
+    slb::swap(a, b);
+    bool swapped = true;
+    for (int i = 0; i < 100; ++i) {
+      swapped = swapped && a[i] == -i && b[i] == i;
+    }
+    CHECK(swapped);
+  }
+
+  /* multi-dimensional */ {
+    double a[3][5] = {{1.0}}, b[3][5] = {{2.0}};
+    slb::swap(a, b);
+    CHECK(a[0][0] == 2.0);
+    CHECK(b[0][0] == 1.0);
+  }
+
+  /* not trivially copyable */ {
+    std::string a[2] = {"a", "b"}, b[2] = {"c", "d"};
+    slb::swap(a, b);
+    CHECK(a[0] == "c");
+    CHECK(a[1] == "d");
+    CHECK(b[0] == "a");
+    CHECK(b[1] == "b");
+  }
+
+  /* user-provided swap */ {
+    swap_adl::Counted a[3] = {{1}, {2}, {3}}, b[3] = {{4}, {5}, {6}};
+    swap_adl::Counted::swaps = 0;
+    CHECK_FALSE(noexcept(slb::swap(a, b)));
+    slb::swap(a, b);
+    CHECK(swap_adl::Counted::swaps == 3);
+    CHECK(a[0].val == 4);
+    CHECK(b[2].val == 3);
+  }
+}
+
 // [utility.exchange], exchange
 
 // template<class T, class U = T>
@@ -597,3 +743,21 @@ TEST_CASE("index_sequence_for", "[utility.syn]") {
   CHECK(std::is_same<slb::index_sequence_for<void, void, void>,
                      slb::index_sequence<0, 1, 2>>::value);
 }
+
+// struct in_place_t;
+// template<class T> struct in_place_type_t;
+// template<size_t I> struct in_place_index_t;
+TEST_CASE("in_place", "[utility.syn]") {
+  CHECK((std::is_same<decltype(slb::in_place), slb::in_place_t const>::value));
+  CHECK_FALSE((std::is_convertible<slb::in_place_t const&, int>::value));
+  CHECK(std::is_default_constructible<slb::in_place_t>::value);
+  CHECK(std::is_empty<slb::in_place_type_t<int>>::value);
+  CHECK(std::is_empty<slb::in_place_index_t<0>>::value);
+
+#if SLB_HAS_CXX14_VARIABLE_TEMPLATES
+  CHECK((std::is_same<decltype(slb::in_place_type<int>),
+                      slb::in_place_type_t<int> const>::value));
+  CHECK((std::is_same<decltype(slb::in_place_index<1>),
+                      slb::in_place_index_t<1> const>::value));
+#endif
+}